@@ -0,0 +1,39 @@
+// Host benchmarks for the hot paths that can run off the device. Every
+// result is printed as one JSON object per line so runs can be collected
+// and compared, e.g.
+//   {"bench":"version.parse","iters":200000,"ns_per_op":9.8}
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+
+namespace Bench {
+
+// Keep the compiler from dropping a result nobody reads
+template <typename T>
+inline void keep(const T &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Run fn() iters times and return the mean cost in nanoseconds
+template <typename Fn>
+double nsPerOp(uint32_t iters, Fn fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iters; ++i) fn(i);
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  return (double)ns / iters;
+}
+
+// Print one result line; extra is empty or more members like ,"bytes":123
+void report(const char *name, uint32_t iters, double nsPerOp, const char *extra = "");
+
+} // namespace Bench
+
+void benchVersion();
+void benchReleaseParser();
+void benchUi();
+void benchOta();
+void benchUploader();
+void benchBleAdv();
+void benchAudioDsp();
+void benchWeightFilter();
@@ -0,0 +1,49 @@
+// AudioDsp on the portable FFT: one transform, and one frame through the
+// window, transform and band accumulation, against the 81.9 ms a frame
+// takes to capture at 12.5 kHz
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "audio_dsp.h"
+#include "bench.h"
+
+void benchAudioDsp() {
+  AudioDsp::begin();
+  // Worker buzz with harmonics, the typical hive spectrum
+  static int16_t frame[AudioDsp::FFT_N];
+  for (uint16_t i = 0; i < AudioDsp::FFT_N; ++i) {
+    float t = (float)i / AudioDsp::SAMPLE_RATE;
+    float v = 0.3f * sinf(2 * (float)M_PI * 250 * t) + 0.15f * sinf(2 * (float)M_PI * 500 * t);
+    frame[i] = (int16_t)lrintf(v * 32767.0f);
+  }
+  static int16_t work[2 * AudioDsp::FFT_N];
+  const double frameNs = 1e9 * AudioDsp::FFT_N / AudioDsp::SAMPLE_RATE;
+  char extra[96];
+
+  const uint32_t iters = 20000;
+  double ns = Bench::nsPerOp(iters, [&](uint32_t) {
+    for (uint16_t i = 0; i < AudioDsp::FFT_N; ++i) {
+      work[2 * i] = frame[i];
+      work[2 * i + 1] = 0;
+    }
+    AudioDsp::fft(work);
+    Bench::keep(work);
+  });
+  snprintf(extra, sizeof(extra), ",\"points\":%u", (unsigned)AudioDsp::FFT_N);
+  Bench::report("audio_dsp.fft", iters, ns, extra);
+
+  AudioDsp::BandEnergy energy;
+  energy.reset();
+  ns = Bench::nsPerOp(iters, [&](uint32_t) {
+    memcpy(work, frame, sizeof(frame));
+    energy.addFrame(work, work);
+  });
+  uint16_t bands[AudioDsp::BANDS], total;
+  energy.result(bands, total);
+  Bench::keep(bands);
+  snprintf(extra, sizeof(extra), ",\"frame_ms\":%.1f,\"realtime_x\":%.0f,\"s_tot\":%u", frameNs / 1e6, frameNs / ns,
+           (unsigned)total);
+  Bench::report("audio_dsp.frame", iters, ns, extra);
+}
@@ -0,0 +1,62 @@
+// BleAdv::decode / BleAdv::hash over a mix of captured advertisements, as
+// the scan callback sees them: sensor payloads, foreign beacons that are
+// rejected early, and padded scan responses
+
+#include <stdio.h>
+#include <vector>
+
+#include "bench.h"
+#include "ble_adv.h"
+
+static const char *const ADVERTS[] = {
+  "0201061BFF99040512FC5394C37C0004FFFC040CAC364200CDCBB8334C884F",          // Ruuvi RAWv2
+  "0201061116D2FC4002CA0903BF1304138A010C020C",                              // BTHome v2
+  "0201060C16D2FC40065E1F073E1D2E23",                                        // BTHome scale
+  "12161A18B96C0A38C1A41009EC138A0B5A0704",                                  // pvvx
+  "10161A18A4C1380A6CB9FF9C335A0B8A07",                                      // ATC1441
+  "0201061AFF4C000215FDA50693A4E24FB1AFCFC6EB0764782500010002C5",            // iBeacon
+  "0201060E16D2FC41A47E7F50A0B1C2D3E4F5",                                    // BTHome encrypted
+  "0201060709487665546167" "0716D2FC4002CA09" "0616D2FC402E23" "0000000000", // padded
+};
+static const uint32_t ADVERT_COUNT = sizeof(ADVERTS) / sizeof(ADVERTS[0]);
+
+static std::vector<uint8_t> hex(const char *s) {
+  std::vector<uint8_t> out;
+  for (; s[0] && s[1]; s += 2) {
+    auto nibble = [](char c) { return (uint8_t)(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10); };
+    out.push_back((uint8_t)(nibble(s[0]) << 4 | nibble(s[1])));
+  }
+  return out;
+}
+
+void benchBleAdv() {
+  std::vector<std::vector<uint8_t>> adverts;
+  uint32_t bytes = 0;
+  for (uint32_t i = 0; i < ADVERT_COUNT; ++i) {
+    adverts.push_back(hex(ADVERTS[i]));
+    bytes += adverts.back().size();
+  }
+
+  const uint32_t iters = 2000000;
+  char extra[96];
+  uint32_t readings = 0;
+  BleAdv::Reading out[BleAdv::MAX_READINGS];
+  double ns = Bench::nsPerOp(iters, [&](uint32_t i) {
+    const std::vector<uint8_t> &a = adverts[i % ADVERT_COUNT];
+    readings += BleAdv::decode(a.data(), (uint8_t)a.size(), out);
+    Bench::keep(out);
+  });
+  double avgBytes = (double)bytes / ADVERT_COUNT;
+  snprintf(extra, sizeof(extra), ",\"avg_bytes\":%.1f,\"mb_per_s\":%.1f,\"readings_per_op\":%.2f", avgBytes,
+           avgBytes * 1000.0 / ns, (double)readings / iters);
+  Bench::report("ble_adv.decode", iters, ns, extra);
+
+  // Duplicate filter: one hash per advertisement before decoding
+  ns = Bench::nsPerOp(iters, [&](uint32_t i) {
+    const std::vector<uint8_t> &a = adverts[i % ADVERT_COUNT];
+    uint32_t h = BleAdv::hash(a.data(), (uint8_t)a.size());
+    Bench::keep(h);
+  });
+  snprintf(extra, sizeof(extra), ",\"avg_bytes\":%.1f,\"mb_per_s\":%.1f", avgBytes, avgBytes * 1000.0 / ns);
+  Bench::report("ble_adv.hash", iters, ns, extra);
+}
@@ -0,0 +1,81 @@
+// OtaEngine throughput from the HTTP stand-in into the file-backed slot,
+// with the chunk ring's peak occupancy and stall counts of each run
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <zlib.h>
+
+#include "bench.h"
+#include "host.h"
+#include "ota_engine.h"
+
+static std::string makeImage(size_t size) {
+  std::string img(size, '\0');
+  uint32_t x = 7;
+  for (size_t i = 0; i < size; ++i) {
+    x = x * 1103515245u + 12345u;
+    img[i] = (char)("HiveSync firmware "[(x >> 16) % 18] ^ ((i / 4096) & 3));
+  }
+  img[0] = (char)0xE9;
+  return img;
+}
+
+static std::string gzip(const std::string &data) {
+  z_stream z = {};
+  deflateInit2(&z, 9, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  std::string out(deflateBound(&z, data.size()), '\0');
+  z.next_in = (Bytef *)data.data();
+  z.avail_in = (uInt)data.size();
+  z.next_out = (Bytef *)&out[0];
+  z.avail_out = (uInt)out.size();
+  deflate(&z, Z_FINISH);
+  out.resize(z.total_out);
+  deflateEnd(&z);
+  return out;
+}
+
+static void run(const char *name, const std::string &body, OtaEngine::ImageFormat fmt, size_t segment) {
+  Host::setHttpHandler([&](const Host::HttpRequest &) {
+    Host::HttpReply r;
+    r.headers = {{"Content-Length", std::to_string(body.size())}};
+    r.body = body;
+    r.segment = segment;
+    return r;
+  });
+  const uint32_t iters = 3;
+  OtaEngine::Event ev = {};
+  uint8_t peak = 0;
+  uint32_t readerStalls = 0, writerStalls = 0;
+  bool ok = true;
+  double ns = Bench::nsPerOp(iters, [&](uint32_t) {
+    Host::resetFlash();
+    Host::clearNvs();
+    OtaEngine::start("https://objects.githubusercontent.com/firmware.bin", fmt);
+    do {
+      while (!OtaEngine::pollEvent(ev)) std::this_thread::sleep_for(std::chrono::microseconds(100));
+    } while (ev.type != OtaEngine::EventType::Finished && ev.type != OtaEngine::EventType::Failed);
+    while (OtaEngine::busy()) std::this_thread::sleep_for(std::chrono::microseconds(100));
+    ok = ok && ev.type == OtaEngine::EventType::Finished;
+    if (ev.peakFilled > peak) peak = ev.peakFilled;
+    readerStalls += ev.readerStalls;
+    writerStalls += ev.writerStalls;
+  });
+  char extra[200];
+  snprintf(extra, sizeof(extra),
+           ",\"bytes\":%u,\"segment\":%u,\"mb_per_s\":%.1f,\"peak_filled\":%u,\"reader_stalls\":%u,"
+           "\"writer_stalls\":%u,\"ok\":%s",
+           (unsigned)body.size(), (unsigned)segment, body.size() / (ns / 1000.0), (unsigned)peak,
+           (unsigned)(readerStalls / iters), (unsigned)(writerStalls / iters), ok ? "true" : "false");
+  Bench::report(name, iters, ns, extra);
+  Host::setHttpHandler(nullptr);
+}
+
+void benchOta() {
+  const std::string image = makeImage(1024 * 1024);
+  const std::string gz = gzip(image);
+  run("ota.raw", image, OtaEngine::ImageFormat::Raw, 1436);
+  run("ota.raw_small_segments", image, OtaEngine::ImageFormat::Raw, 256);
+  run("ota.gzip", gz, OtaEngine::ImageFormat::Gzip, 1436);
+}
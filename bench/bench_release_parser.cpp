@@ -0,0 +1,96 @@
+// ReleaseParser over a "latest release" document laid out like the GitHub
+// API's, fed in TCP-segment sized pieces as the updater reads it
+
+#include <stdio.h>
+#include <string>
+
+#include "bench.h"
+#include "release_parser.h"
+
+static std::string uploader() {
+  return "{\"login\":\"github-actions[bot]\",\"id\":41898282,\"node_id\":\"MDM6Qm90NDE4OTgyODI=\","
+         "\"avatar_url\":\"https://avatars.githubusercontent.com/in/15368?v=4\",\"gravatar_id\":\"\","
+         "\"url\":\"https://api.github.com/users/github-actions%5Bbot%5D\",\"type\":\"Bot\",\"site_admin\":false}";
+}
+
+static std::string asset(uint32_t id, const char *name, const char *type, uint32_t size) {
+  char buf[768];
+  snprintf(buf, sizeof(buf),
+           "{\"url\":\"https://api.github.com/repos/dodichri/HiveSync-32/releases/assets/%u\",\"id\":%u,"
+           "\"node_id\":\"RA_kwDOL%06u\",\"name\":\"%s\",\"label\":\"\",\"uploader\":%s,"
+           "\"content_type\":\"%s\",\"state\":\"uploaded\",\"size\":%u,\"download_count\":%u,"
+           "\"created_at\":\"2024-05-01T10:00:00Z\",\"updated_at\":\"2024-05-01T10:00:02Z\","
+           "\"browser_download_url\":\"https://github.com/dodichri/HiveSync-32/releases/download/v0.4.0/%s\"}",
+           (unsigned)id, (unsigned)id, (unsigned)(id % 1000000), name, uploader().c_str(), type, (unsigned)size,
+           (unsigned)(id % 97), name);
+  return buf;
+}
+
+static std::string releaseDocument() {
+  std::string doc =
+      "{\"url\":\"https://api.github.com/repos/dodichri/HiveSync-32/releases/154000000\","
+      "\"assets_url\":\"https://api.github.com/repos/dodichri/HiveSync-32/releases/154000000/assets\","
+      "\"html_url\":\"https://github.com/dodichri/HiveSync-32/releases/tag/v0.4.0\",\"id\":154000000,"
+      "\"author\":" + uploader() + ",\"node_id\":\"RE_kwDOLabcde4JLx1A\",\"tag_name\":\"v0.4.0\","
+      "\"target_commitish\":\"main\",\"name\":\"HiveSync 0.4.0\",\"draft\":false,\"prerelease\":false,"
+      "\"created_at\":\"2024-05-01T09:58:00Z\",\"published_at\":\"2024-05-01T10:01:00Z\",\"assets\":[";
+  static const char *const NAMES[] = {"firmware.elf", "firmware.map", "littlefs.bin", "firmware.bin.hsd",
+                                      "firmware.bin.gz", "firmware.bin"};
+  for (uint32_t i = 0; i < sizeof(NAMES) / sizeof(NAMES[0]); ++i) {
+    if (i) doc += ",";
+    doc += asset(170000000 + i, NAMES[i], "application/octet-stream", 900000 + i * 1000);
+  }
+  doc += "],\"tarball_url\":\"https://api.github.com/repos/dodichri/HiveSync-32/tarball/v0.4.0\","
+         "\"zipball_url\":\"https://api.github.com/repos/dodichri/HiveSync-32/zipball/v0.4.0\",\"body\":\"";
+  for (int i = 0; i < 20; ++i) doc += "* Fix \\\"scale\\\" drift \\u2013 see #12\\r\\n";
+  doc += "\"}";
+  return doc;
+}
+
+void benchReleaseParser() {
+  const std::string doc = releaseDocument();
+  const size_t SEGMENT = 1436;  // typical TLS record payload over Wi-Fi
+  static const char *const WANT[] = {"firmware.bin.hsd", "firmware.bin.gz", "firmware.bin"};
+
+  // Whole document, as when the caller does not stop at complete()
+  const uint32_t iters = 2000;
+  ReleaseParser parser(WANT, 3);
+  double ns = Bench::nsPerOp(iters, [&](uint32_t) {
+    parser.reset();
+    for (size_t off = 0; off < doc.size(); off += SEGMENT) {
+      size_t n = doc.size() - off < SEGMENT ? doc.size() - off : SEGMENT;
+      parser.feed((const uint8_t *)doc.data() + off, n);
+    }
+    Bench::keep(parser.assetIndex());
+  });
+  char extra[96];
+  snprintf(extra, sizeof(extra), ",\"bytes\":%u,\"mb_per_s\":%.1f,\"asset_index\":%d", (unsigned)doc.size(),
+           doc.size() / (ns / 1000.0), parser.assetIndex());
+  Bench::report("release_parser.document", iters, ns, extra);
+
+  // One byte per call, the worst case of a chunked body read byte-wise
+  ns = Bench::nsPerOp(iters, [&](uint32_t) {
+    parser.reset();
+    for (char c : doc) parser.feed(c);
+    Bench::keep(parser.assetIndex());
+  });
+  snprintf(extra, sizeof(extra), ",\"bytes\":%u,\"ns_per_byte\":%.2f", (unsigned)doc.size(), ns / doc.size());
+  Bench::report("release_parser.bytewise", iters, ns, extra);
+
+  // Up to complete(), as the updater reads it: the best asset comes first
+  // in the preference list, so the body and later assets are skipped
+  size_t consumed = 0;
+  ns = Bench::nsPerOp(iters, [&](uint32_t) {
+    parser.reset();
+    size_t off = 0;
+    while (off < doc.size() && !parser.complete()) {
+      size_t n = doc.size() - off < SEGMENT ? doc.size() - off : SEGMENT;
+      parser.feed((const uint8_t *)doc.data() + off, n);
+      off += n;
+    }
+    consumed = off;
+  });
+  snprintf(extra, sizeof(extra), ",\"bytes\":%u,\"complete\":%s", (unsigned)consumed,
+           parser.complete() ? "true" : "false");
+  Bench::report("release_parser.until_complete", iters, ns, extra);
+}
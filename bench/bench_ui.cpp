@@ -0,0 +1,78 @@
+// UI drawing: the 1bpp bitmap blit on its own, then UI::printLine and the
+// status band end to end through the UI task, timed by their trace spans
+// and with the pixels each one sends to the (stand-in) panel
+
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include <stdio.h>
+#include <thread>
+
+#include "bench.h"
+#include "fa_wifi_icon.h"
+#include "host.h"
+#include "trace.h"
+#include "ui.h"
+#include "ui_draw.h"
+
+static uint32_t spanCount(const char *name) {
+  Trace::Site site(name);
+  return Trace::snapshot(name, site) ? site.count : 0;
+}
+
+// Wait until the UI task has finished `count` spans of the given name
+static void waitSpans(const char *name, uint32_t count) {
+  while (spanCount(name) < count) std::this_thread::sleep_for(std::chrono::microseconds(20));
+}
+
+static void reportSpan(const char *bench, const char *span, uint32_t iters) {
+  Trace::Site site(span);
+  Trace::snapshot(span, site);
+  Host::PanelStats panel = Host::panelStats();
+  // Bucket bounds, capped by the slowest span actually seen
+  uint32_t p50 = Trace::percentileUs(site, 500), p99 = Trace::percentileUs(site, 990);
+  if (p50 > site.maxUs) p50 = site.maxUs;
+  if (p99 > site.maxUs) p99 = site.maxUs;
+  char extra[160];
+  snprintf(extra, sizeof(extra), ",\"p50_us\":%u,\"p99_us\":%u,\"max_us\":%u,\"pixels_per_op\":%u,\"windows_per_op\":%u",
+           (unsigned)p50, (unsigned)p99, (unsigned)site.maxUs,
+           (unsigned)(panel.pixels / iters), (unsigned)(panel.windows / iters));
+  Bench::report(bench, iters, site.count ? site.totalUs * 1000.0 / site.count : 0.0, extra);
+}
+
+void benchUi() {
+  // Blit into a canvas the size of the status band
+  GFXcanvas16 canvas(110, 24);
+  uint32_t iters = 200000;
+  double ns = Bench::nsPerOp(iters, [&](uint32_t i) {
+    UI::drawMonoBitmap1BPP(canvas, (int16_t)(i & 63), 0, FA_WIFI_ICON_WIDTH, FA_WIFI_ICON_HEIGHT,
+                           FA_WIFI_ICON_BITMAP, UI::COLOR_SIGNAL_BLUE, UI::COLOR_BG);
+  });
+  char extra[64];
+  snprintf(extra, sizeof(extra), ",\"pixels\":%u", (unsigned)(FA_WIFI_ICON_WIDTH * FA_WIFI_ICON_HEIGHT));
+  Bench::report("ui.draw_mono_bitmap_1bpp", iters, ns, extra);
+
+  UI::init();
+  while (!UI::ready()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // A status line whose counter changes every time, as during an OTA
+  Trace::reset();
+  Host::resetPanelStats();
+  iters = 500;
+  for (uint32_t i = 0; i < iters; ++i) {
+    char msg[32];
+    snprintf(msg, sizeof(msg), "OTA: %u%% (%u KB)", (unsigned)(i % 101), (unsigned)(i * 4));
+    UI::printLine(2, msg);
+    waitSpans("ui.print_line", i + 1);
+  }
+  reportSpan("ui.print_line", "ui.print_line", iters);
+
+  // Status band: Wi-Fi icon with a changing battery percent
+  Trace::reset();
+  Host::resetPanelStats();
+  for (uint32_t i = 0; i < iters; ++i) {
+    UI::setBatteryPercent((int)(i % 100));
+    UI::drawWifiIcon(i & 1);
+    waitSpans("ui.wifi_icon", i + 1);
+  }
+  reportSpan("ui.status_band", "ui.wifi_icon", iters);
+}
@@ -0,0 +1,96 @@
+// Uploader against the HTTP and LittleFS stand-ins: cost per reading from
+// publish to acknowledged POST, with the requests, flash and NVS writes and
+// peak heap it takes per reading
+
+#include <Arduino.h>
+#include <atomic>
+#include <malloc.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "host.h"
+#include "measurement.h"
+#include "uploader.h"
+
+// Heap in use while tracking is on (uploader plus the HTTP stand-in)
+static std::atomic<bool> s_track(false);
+static std::atomic<int64_t> s_heap(0);
+static std::atomic<int64_t> s_heapPeak(0);
+
+void *operator new(size_t n) {
+  void *p = malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  if (s_track.load(std::memory_order_relaxed)) {
+    int64_t now = s_heap += (int64_t)malloc_usable_size(p);
+    int64_t peak = s_heapPeak.load();
+    while (now > peak && !s_heapPeak.compare_exchange_weak(peak, now)) {}
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  if (p && s_track.load(std::memory_order_relaxed)) s_heap -= (int64_t)malloc_usable_size(p);
+  free(p);
+}
+
+static const char *const KEYS[] = {"weight_kg", "t_i", "h", "bv"};
+
+static void publish(uint32_t i) {
+  Measurement m;
+  m.time = 1700000000 + (i / 4) * 60;
+  m.value = 40.0f + (i % 4) + (i / 4) * 0.01f;
+  strlcpy(m.key, KEYS[i % 4], sizeof(m.key));
+  Measurements::publish(m);
+}
+
+// online: readings arrive while connected; else they queue up offline and
+// go out in one burst once the link comes up
+static void run(const char *name, bool online) {
+  const uint32_t readings = 1024;
+  Host::setHttpHandler([](const Host::HttpRequest &) {
+    Host::HttpReply r;
+    r.body = "{\"result\":\"ok\"}";
+    return r;
+  });
+  Host::resetHttpStats();
+  Host::resetFsStats();
+  Host::resetNvsStats();
+  Host::setWifiConnected(online);
+  const Uploader::Stats before = Uploader::stats();
+  s_heap = 0;
+  s_heapPeak = 0;
+  s_track = true;
+  double ns = Bench::nsPerOp(readings, [](uint32_t i) {
+    publish(i);
+    Uploader::loop();
+  });
+  auto start = std::chrono::steady_clock::now();
+  Host::setWifiConnected(true);
+  for (int i = 0; i < 10000 && Uploader::stats().pending; ++i) Uploader::loop();
+  ns += (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() /
+        readings;
+  s_track = false;
+
+  const Uploader::Stats st = Uploader::stats();
+  const Host::FsStats fs = Host::fsStats();
+  char extra[320];
+  snprintf(extra, sizeof(extra),
+           ",\"sent\":%u,\"posts_per_reading\":%.3f,\"body_bytes_per_reading\":%.1f,"
+           "\"flash_writes_per_reading\":%.3f,\"flash_bytes_per_reading\":%.1f,\"nvs_writes_per_reading\":%.3f,"
+           "\"connects\":%u,\"heap_peak_bytes\":%lld",
+           (unsigned)(st.sent - before.sent), (double)(st.posts - before.posts) / readings,
+           (double)(st.bodyBytes - before.bodyBytes) / readings, (double)fs.writes / readings,
+           (double)fs.bytesWritten / readings, (double)Host::nvsStats().writes / readings,
+           (unsigned)Host::httpStats().connects, (long long)s_heapPeak.load());
+  Bench::report(name, readings, ns, extra);
+}
+
+void benchUploader() {
+  Host::resetFs();
+  Host::clearNvs();
+  Uploader::begin();
+  run("uploader.online", true);
+  run("uploader.offline_burst", false);
+}
@@ -0,0 +1,28 @@
+// Version::parse / Version::compare on release tags as GitHub reports them
+
+#include "bench.h"
+#include "version.h"
+
+static const char *const TAGS[] = {
+  "v0.1.0", "v0.1.1", "v0.2.0", "0.10.3", "v1.0.0-rc.1", "v1.0.0", "V1.2", "v12.345.6789+build.7",
+};
+static const uint32_t TAG_COUNT = sizeof(TAGS) / sizeof(TAGS[0]);
+
+void benchVersion() {
+  const uint32_t iters = 1000000;
+  // The tag comes through a volatile index so the constexpr parse cannot
+  // be folded at compile time
+  volatile uint32_t pick = 0;
+  double ns = Bench::nsPerOp(iters, [&](uint32_t i) {
+    Version::SemVer v = Version::parse(TAGS[(i + pick) % TAG_COUNT]);
+    Bench::keep(v);
+  });
+  Bench::report("version.parse", iters, ns);
+
+  const Version::SemVer running = Version::parse("v0.10.2");
+  ns = Bench::nsPerOp(iters, [&](uint32_t i) {
+    int c = Version::compare(Version::parse(TAGS[(i + pick) % TAG_COUNT]), running);
+    Bench::keep(c);
+  });
+  Bench::report("version.parse_compare", iters, ns);
+}
@@ -0,0 +1,56 @@
+// WeightFilter::add with the scale's configuration on a raw 80 SPS trace
+// with noise, wind and spikes, against the 12.5 ms between HX711 samples;
+// and the same trace with a load step every few seconds, so the median,
+// Kalman update and step restart are all on the path
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+#include "bench.h"
+#include "weight_filter.h"
+
+static std::vector<int32_t> trace(uint32_t n, int32_t stepEvery) {
+  std::vector<int32_t> out(n);
+  uint32_t s = 1;
+  auto uniform = [&]() {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return (s >> 8) * (1.0f / 16777216.0f);
+  };
+  int32_t level = 850000;
+  for (uint32_t i = 0; i < n; ++i) {
+    if (stepEvery && i && i % stepEvery == 0) level += (i / stepEvery) & 1 ? 15000 : -15000;
+    float t = i / 80.0f;
+    float noise = 100.0f * sqrtf(-2.0f * logf(uniform() + 1e-7f)) * cosf(6.2831853f * uniform());
+    float spike = uniform() < 1.0f / 80 ? 4000.0f : 0.0f;
+    out[i] = level + (int32_t)(600.0f * sinf(1.88f * t) + noise + spike);
+  }
+  return out;
+}
+
+void benchWeightFilter() {
+  const uint32_t iters = 2000000;
+  const uint32_t n = 80 * 600;
+  const double sampleNs = 1e9 / 80;
+  char extra[96];
+
+  std::vector<int32_t> raw = trace(n, 0);
+  WeightFilter f(WeightFilter::SCALE_DEFAULTS);
+  double ns = Bench::nsPerOp(iters, [&](uint32_t i) {
+    WeightFilter::Event e = f.add(raw[i % n]);
+    Bench::keep(e);
+  });
+  snprintf(extra, sizeof(extra), ",\"sample_ms\":%.1f,\"realtime_x\":%.0f", sampleNs / 1e6, sampleNs / ns);
+  Bench::report("weight_filter.add", iters, ns, extra);
+
+  raw = trace(n, 80 * 5);
+  f.reset();
+  uint32_t steps = 0;
+  ns = Bench::nsPerOp(iters, [&](uint32_t i) {
+    if (f.add(raw[i % n]) == WeightFilter::Event::Step) steps++;
+  });
+  snprintf(extra, sizeof(extra), ",\"steps\":%u,\"realtime_x\":%.0f", (unsigned)steps, sampleNs / ns);
+  Bench::report("weight_filter.steps", iters, ns, extra);
+}
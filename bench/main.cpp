@@ -0,0 +1,26 @@
+// Host benchmark runner: pio run -e native_bench -t exec
+
+#include <stdio.h>
+
+#include "bench.h"
+
+namespace Bench {
+
+void report(const char *name, uint32_t iters, double nsPerOp, const char *extra) {
+  printf("{\"bench\":\"%s\",\"iters\":%u,\"ns_per_op\":%.1f%s}\n", name, (unsigned)iters, nsPerOp, extra);
+  fflush(stdout);
+}
+
+} // namespace Bench
+
+int main() {
+  benchVersion();
+  benchReleaseParser();
+  benchUi();
+  benchOta();
+  benchUploader();
+  benchBleAdv();
+  benchAudioDsp();
+  benchWeightFilter();
+  return 0;
+}
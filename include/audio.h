@@ -0,0 +1,25 @@
+// Hive sound capture from an I2S MEMS microphone (INMP441 / SPH0645 class)
+#pragma once
+
+#include <Arduino.h>
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+#ifndef HS_AUDIO
+#define HS_AUDIO 0
+#endif
+// Seconds between two sound captures
+#ifndef AUDIO_PERIOD_S
+#define AUDIO_PERIOD_S 600
+#endif
+
+namespace Audio {
+
+// Install the I2S driver and start the capture task. Returns false when
+// the driver cannot be installed (or audio is compiled out).
+bool begin();
+
+// Scheduler job: start one capture of a few seconds on the audio task.
+// The band energies are published as BEEP s_bin*Hz / s_tot values.
+void capture();
+
+} // namespace Audio
@@ -0,0 +1,48 @@
+// Fixed-point FFT reduction of microphone frames to BEEP sound bands
+// Free of Arduino headers so it builds on the host.
+#pragma once
+
+#include <stdint.h>
+
+namespace AudioDsp {
+
+static const uint8_t FFT_BITS = 10;
+static const uint16_t FFT_N = 1 << FFT_BITS;
+// 12.5 kHz / 1024 = 12.2 Hz per bin, so each 48.8 Hz BEEP band
+// (s_bin098_146Hz .. s_bin537_586Hz) is exactly four bins starting at bin 8
+static const uint32_t SAMPLE_RATE = 12500;
+static const uint8_t BANDS = 10;
+
+// Build the Hann window and twiddle tables; call once before use.
+void begin();
+
+// In-place radix-2 FFT of FFT_N interleaved Q15 complex values (re, im),
+// scaled by 1/2 per stage so it cannot overflow. Uses esp-dsp (with the
+// ESP32-S3 vector unit) when available, a portable version otherwise.
+void fft(int16_t *data);
+
+// Averages band power over a capture of many frames
+class BandEnergy {
+public:
+  void reset();
+
+  // Window, transform and accumulate one frame of FFT_N Q15 samples.
+  // work must hold 2 * FFT_N values; samples may alias it.
+  void addFrame(const int16_t *samples, int16_t *work);
+
+  uint32_t frames() const { return _frames; }
+
+  // Mean power of each band and of all bands together ("s_tot") in dB
+  // relative to a full-scale sine, offset by +100 and clamped at 0, so
+  // quieter hives give smaller non-negative integers.
+  void result(uint16_t bands[BANDS], uint16_t &total) const;
+
+private:
+  uint64_t _power[BANDS];
+  uint32_t _frames;
+};
+
+// BEEP value_key of a band, e.g. "s_bin098_146Hz"
+const char *bandKey(uint8_t band);
+
+} // namespace AudioDsp
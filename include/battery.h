@@ -3,16 +3,40 @@
 
 #include <Arduino.h>
 
+#include "scheduler.h"
+
 namespace Battery {
 
 // Initialize I2C and fuel gauge. Returns true if detected.
 bool begin();
 
-// Poll the gauge periodically. Internally rate-limited.
+// Service gauge alerts and refresh the charge-rate forecast. Cheap when
+// nothing changed: schedule it every pollIntervalMs().
 void update();
 
+// How often update() should run. Longer when the ALRT pin is wired, since
+// the pin then triggers the job registered with setAlertJob().
+uint32_t pollIntervalMs();
+
+// Job to trigger from the ALRT interrupt (HS_GAUGE_ALERT_PIN).
+void setAlertJob(Scheduler::JobId id);
+
 // Last known SoC percent [0..100], or -1 if unknown.
 int percent();
 
-} // namespace Battery
+// Read the cell voltage now (V), or NAN if the gauge is missing.
+float voltage();
+
+enum class Trend : uint8_t { Idle, Charging, Discharging };
 
+// Smoothed charge/discharge direction with hysteresis
+Trend trend();
+
+// Smoothed charge rate in %/h (negative while discharging)
+float chargeRate();
+
+// Forecast runtime in minutes, or -1 when not discharging / charging.
+int32_t minutesToEmpty();
+int32_t minutesToFull();
+
+} // namespace Battery
@@ -0,0 +1,38 @@
+// BLE advertisement payload decoder (BTHome v2, Ruuvi RAWv2, pvvx/ATC)
+// Free of Arduino headers so it builds on the host.
+#pragma once
+
+#include <stdint.h>
+
+namespace BleAdv {
+
+// Quantities we can forward to BEEP
+enum class Kind : uint8_t {
+  Temperature,   // deg C
+  Humidity,      // %RH
+  Pressure,      // hPa
+  Light,         // lux
+  WeightKg,      // kg
+  BatteryVolts   // V
+};
+
+struct Reading {
+  Kind kind;
+  float value;
+};
+
+// Most readings one advertisement can yield; extra ones are dropped
+static const uint8_t MAX_READINGS = 8;
+
+// Decode the AD structures of one advertisement (advertising data plus
+// scan response, back to back). Returns the number of readings written to
+// out; 0 for unknown, encrypted or malformed payloads. No allocation.
+uint8_t decode(const uint8_t *data, uint8_t len, Reading *out, uint8_t max = MAX_READINGS);
+
+// BEEP value_key for a kind ("t", "h", "p", "l", "weight_kg", "bv")
+const char *beepKey(Kind kind);
+
+// FNV-1a over a payload, used to spot repeated advertisements cheaply
+uint32_t hash(const uint8_t *data, uint8_t len);
+
+} // namespace BleAdv
@@ -0,0 +1,28 @@
+// Passive BLE scanner for hive sensor tags (BTHome, Ruuvi, pvvx/ATC)
+#pragma once
+
+#include <Arduino.h>
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+#ifndef HS_BLE_SCAN
+#define HS_BLE_SCAN 1
+#endif
+
+namespace BleScan {
+
+// Periodic job: starts scanning once provisioning no longer needs the
+// radio, then publishes fresh tag readings as "<key>_<mac tail>" (e.g.
+// "t_a1b2") no more often than once per tag per BLE_PUBLISH_S.
+void loop();
+
+struct Stats {
+  uint32_t adverts;     // advertisements received
+  uint32_t duplicates;  // same payload as last time from that tag
+  uint32_t ignored;     // nothing we can decode
+  uint32_t published;   // readings handed to Measurements
+  uint32_t evicted;     // tags pushed out of a full table
+  uint8_t tags;         // tags in the table
+};
+Stats stats();
+
+} // namespace BleScan
@@ -0,0 +1,34 @@
+// Start-up sequencing: boot steps as a dependency graph, with a profile
+#pragma once
+
+#include <Arduino.h>
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+// Log the profile this long after boot even if some steps never finished
+#ifndef BOOT_REPORT_MS
+#define BOOT_REPORT_MS 30000
+#endif
+
+namespace Boot {
+
+struct Step {
+  const char *name;
+  void (*start)();  // kicks the step off; may be null
+  bool (*ready)();  // for steps that finish on another task or in an ISR:
+                    // polled until true. Null = done when start returns.
+  uint32_t after;   // bit i set: steps[i] has to finish first
+};
+
+static const uint8_t MAX_STEPS = 32;
+
+// Start every step whose dependencies have finished, in table order, until
+// nothing more can start, then return. Remaining steps are started by a
+// scheduler job (10 ms resolution) as their dependencies complete. Each
+// step's start offset and duration is logged once all have finished.
+// steps must stay valid until then.
+void run(const Step *steps, uint8_t count);
+
+// True once every step has finished
+bool finished();
+
+} // namespace Boot
@@ -1,4 +1,5 @@
-// Lightweight Serial debug macros with per-module prefix
+// Debug logging macros with per-module prefix. Records are deferred to the
+// Log module's ring and formatted off the caller's task (see log.h).
 #pragma once
 
 #include <Arduino.h>
@@ -12,8 +13,10 @@
 #endif
 
 #if HS_DEBUG
-  #define LOGF(fmt, ...) do { Serial.printf("[" HS_LOG_PREFIX "] " fmt, ##__VA_ARGS__); } while (0)
-  #define LOGLN(msg)     do { Serial.println(String("[" HS_LOG_PREFIX "] ") + (msg)); } while (0)
+  #include "log.h"
+  // fmt must be a literal: its address identifies the record
+  #define LOGF(fmt, ...) do { Log::logf("[" HS_LOG_PREFIX "] " fmt, ##__VA_ARGS__); } while (0)
+  #define LOGLN(msg)     do { Log::logf("[" HS_LOG_PREFIX "] %s\n", (msg)); } while (0)
 #else
   #define LOGF(...)      do {} while (0)
   #define LOGLN(...)     do {} while (0)
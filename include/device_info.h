@@ -5,12 +5,14 @@
 
 namespace DeviceInfo {
 
-// Return uppercase MAC without colons, e.g., AABBCCDDEEFF
-String macNoColonsUpper();
+static const size_t MAC_HEX_LEN = 13;   // 12 hex digits + terminator
+static const size_t NAME_LEN = 16;      // fits "HiveSync-XXXX" / "Hive-XXXXXX"
+
+// Write the uppercase MAC without colons, e.g., AABBCCDDEEFF
+void macNoColonsUpper(char out[MAC_HEX_LEN]);
 
 // Derive service name and POP from MAC
 // serviceName = "HiveSync-" + last4 hex, pop = "Hive-" + last6 hex
-void deriveNames(String &serviceNameOut, String &popOut);
+void deriveNames(char serviceNameOut[NAME_LEN], char popOut[NAME_LEN]);
 
 } // namespace DeviceInfo
-
@@ -0,0 +1,45 @@
+// DS18B20 1-Wire protocol: ROM search, convert-all and scratchpad reads
+// Free of Arduino headers so it builds on the host against a simulated bus.
+#pragma once
+
+#include <stdint.h>
+
+namespace Ds18b20 {
+
+static const uint8_t FAMILY = 0x28;
+static const uint8_t ROM_LEN = 8;
+static const uint8_t SCRATCHPAD_LEN = 9;
+// Conversion time at the power-on 12-bit resolution
+static const uint16_t CONVERT_MS = 750;
+
+// Bit-level access to one 1-Wire line; the byte helpers are built on it
+class Bus {
+public:
+  virtual ~Bus() {}
+  // Reset pulse; true when at least one device answered with presence
+  virtual bool reset() = 0;
+  virtual void writeBit(bool bit) = 0;
+  virtual bool readBit() = 0;
+
+  void writeByte(uint8_t v);
+  uint8_t readByte();
+};
+
+// Dallas/Maxim CRC-8 (x^8 + x^5 + x^4 + 1), table-driven
+uint8_t crc8(const uint8_t *data, uint8_t len);
+
+// Enumerate the DS18B20s on the bus in ROM order, which stays the same
+// between boots for the same probes. A pass that reads a bad CRC is walked
+// once more before that ROM is skipped; other families are skipped too.
+// Returns the number written to roms.
+uint8_t search(Bus &bus, uint8_t roms[][ROM_LEN], uint8_t max);
+
+// Skip ROM + Convert T: every probe starts converting at once. Results
+// are ready CONVERT_MS later. False when nothing answers the reset.
+bool convertAll(Bus &bus);
+
+// Match ROM + Read Scratchpad. Writes the temperature in centi-deg C and
+// returns true only for a scratchpad with a valid CRC.
+bool readCentiC(Bus &bus, const uint8_t rom[ROM_LEN], int16_t &centiC);
+
+} // namespace Ds18b20
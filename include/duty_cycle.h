@@ -0,0 +1,34 @@
+// Deep-sleep duty-cycle operating mode (HS_DUTY_CYCLE=1)
+#pragma once
+
+#include <Arduino.h>
+
+namespace DutyCycle {
+
+// Call first in setup(). On a deep-sleep timer wake this samples the
+// sensors into RTC memory, uploads the buffered readings when a batch is
+// due and goes straight back to sleep, skipping the display, the BOOT
+// button window and provisioning. Returns immediately on any other boot,
+// on periodic full-boot cycles, or when duty cycling is compiled out.
+void fastBootIfTimerWake();
+
+// Call at the end of a normal setup(): schedules the switch to deep sleep
+// once the awake window has passed.
+void begin();
+
+// Flush the stores and deep-sleep until the next cycle. Does not return.
+void sleep();
+
+// The cycle sleep() last ended and its average supply current estimate
+// from the DUTY_I_* figures
+struct Stats {
+  uint32_t cycle;      // timer wakes since the last full boot
+  uint32_t awakeMs;
+  uint32_t wifiMs;     // part of awakeMs with the radio up
+  uint32_t sleepMs;
+  uint32_t microAmps;  // over awakeMs + sleepMs
+  uint8_t buffered;    // readings waiting in RTC memory
+};
+Stats stats();
+
+} // namespace DutyCycle
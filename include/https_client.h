@@ -0,0 +1,83 @@
+// Pooled HTTPS connections with keep-alive, TLS session resumption and
+// handshake/TTFB timing
+#pragma once
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+
+namespace Https {
+
+// Per-request timings (summed over all redirect hops)
+struct Timing {
+  uint32_t handshakeMs;  // TCP connect + TLS handshake; 0 when every hop reused a connection
+  uint32_t ttfbMs;       // request sent until response headers parsed
+  uint8_t handshakes;    // hops that needed a fresh connection
+  uint8_t resumed;       // of those, handshakes that resumed a cached TLS session
+  uint8_t reused;        // hops served on a kept-alive connection
+  uint8_t redirects;
+};
+
+struct Header {
+  const char *name;
+  const char *value;
+};
+
+struct Options {
+  const Header *headers = nullptr;   // extra request headers, sent on every hop
+  uint8_t headerCount = 0;
+  const char **collect = nullptr;    // response headers to keep (HTTPClient::collectHeaders)
+  uint8_t collectCount = 0;
+  uint16_t timeoutMs = 15000;
+  bool followRedirects = true;       // across hosts, each on its own pooled connection
+};
+
+struct Slot;
+
+// A response bound to a pooled connection. Read headers/body through http(),
+// then end() to hand the connection back; it stays open for the next request
+// to the same host when the body was fully read and the server allows it.
+// Going out of scope without end() closes the connection.
+class Response {
+public:
+  Response() {}
+  ~Response() { end(false); }
+  Response(const Response &) = delete;
+  Response &operator=(const Response &) = delete;
+
+  HTTPClient &http();
+  int code() const { return _code; }
+  const Timing &timing() const { return _timing; }
+  void end(bool drained = true);  // drained = whole body consumed
+
+private:
+  friend int request(const char *, const String &, const uint8_t *, size_t, const Options &, Response &);
+  Slot *_slot = nullptr;
+  int _code = 0;
+  Timing _timing = {0, 0, 0, 0, 0, 0};
+};
+
+// Perform a request and leave resp positioned at the response body.
+// Returns the HTTP status code, or a negative HTTPC_ERROR_* value.
+int request(const char *method, const String &url, const uint8_t *body, size_t bodyLen,
+            const Options &opts, Response &resp);
+
+inline int get(const String &url, const Options &opts, Response &resp) {
+  return request("GET", url, nullptr, 0, opts, resp);
+}
+
+// Close connections that have been idle too long (frees TLS buffers).
+// Call regularly from loop().
+void loop();
+
+// Cumulative counters since boot
+struct Stats {
+  uint32_t requests;
+  uint32_t handshakes;
+  uint32_t resumed;      // abbreviated handshakes
+  uint32_t reuses;
+  uint32_t handshakeMsTotal;
+  uint32_t ttfbMsTotal;
+};
+Stats stats();
+
+} // namespace Https
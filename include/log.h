@@ -0,0 +1,61 @@
+// Deferred binary logger behind the LOGF/LOGLN macros
+#pragma once
+
+#include <Arduino.h>
+
+namespace Log {
+
+// One captured printf argument. Strings are copied into the record, so
+// temporaries such as String::c_str() are safe to pass.
+struct Arg {
+  enum Kind : uint8_t { U32 = 1, U64 = 2, F64 = 3, STR = 4 };
+  Kind kind;
+  union {
+    uint32_t u32;
+    uint64_t u64;
+    double f64;
+    const char *str;
+  };
+  Arg(int v) : kind(U32), u32((uint32_t)v) {}
+  Arg(unsigned v) : kind(U32), u32(v) {}
+  Arg(long v) : kind(U32), u32((uint32_t)v) {}
+  Arg(unsigned long v) : kind(U32), u32((uint32_t)v) {}
+  Arg(long long v) : kind(U64), u64((uint64_t)v) {}
+  Arg(unsigned long long v) : kind(U64), u64(v) {}
+  Arg(double v) : kind(F64), f64(v) {}
+  Arg(const char *s) : kind(STR), str(s) {}
+  Arg(const String &s) : kind(STR), str(s.c_str()) {}
+  Arg(const __FlashStringHelper *s) : kind(STR), str(reinterpret_cast<const char *>(s)) {}
+  Arg(const void *p) : kind(U32), u32((uint32_t)(uintptr_t)p) {}
+};
+
+// Append a record to the calling core's ring. Never blocks or allocates;
+// when the ring is full the record is dropped and counted.
+void write(const char *fmt, const Arg *args, uint8_t count);
+
+// fmt must be a string literal: its address is the record's format ID.
+inline void logf(const char *fmt) {
+  write(fmt, nullptr, 0);
+}
+
+template <typename... A>
+inline void logf(const char *fmt, const A &...args) {
+  const Arg packed[] = {Arg(args)...};
+  write(fmt, packed, sizeof...(A));
+}
+
+// Start the low-priority task that formats records to Serial (and, with
+// HS_LOG_PERSIST, appends them to /log.bin). Records written before this
+// wait in the ring.
+void begin();
+
+// Drain the rings on the calling task, e.g. right before deep sleep.
+void flush();
+
+struct Stats {
+  uint32_t records;
+  uint32_t dropped;
+};
+Stats stats();
+
+} // namespace Log
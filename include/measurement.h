@@ -0,0 +1,32 @@
+// Sensor measurements and their fan-out to storage/upload consumers
+#pragma once
+
+#include <Arduino.h>
+
+// One reading in BEEP sensor API terms: value_key=value at a unix time
+struct Measurement {
+  uint32_t time;   // unix seconds, 0 = unknown (server stamps on reception)
+  float value;
+  char key[16];    // BEEP value_key, e.g. "weight_kg", "t_i", "bv"
+};
+
+namespace Measurements {
+
+typedef void (*Sink)(const Measurement &m);
+
+// Register a consumer. Returns false when the sink table is full; a sink
+// that is already registered is not added again.
+bool subscribe(Sink sink);
+
+// Stamp a reading with the wall clock (when synced) and hand it to every
+// sink. Safe to call from any task; sinks must not block.
+void publish(const char *key, float value);
+
+// Hand an already stamped reading (e.g. buffered across deep sleep) to
+// every sink unchanged.
+void publish(const Measurement &m);
+
+// Unix time in seconds, or 0 while the clock has not been set via SNTP.
+uint32_t now();
+
+} // namespace Measurements
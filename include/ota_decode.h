@@ -0,0 +1,90 @@
+// Streaming decoders for compressed (gzip) and delta OTA images
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace OtaDecode {
+
+// Downstream consumer of decoded image bytes
+class ByteSink {
+public:
+  virtual ~ByteSink() {}
+  // Consume the next bytes; false aborts the update (see error())
+  virtual bool write(const uint8_t *data, size_t len) = 0;
+  // Called once after the last byte; false if the stream was truncated/invalid
+  virtual bool finish() = 0;
+  virtual const char *error() const { return _error; }
+
+protected:
+  bool fail(const char *msg) { if (!_error) _error = msg; return false; }
+  const char *_error = nullptr;
+};
+
+// gzip (RFC 1952) member -> raw bytes, using the ROM inflater with a 32 KB
+// circular dictionary. CRC32 and ISIZE from the trailer are verified.
+class GzipDecoder : public ByteSink {
+public:
+  // Allocates the inflater state (~43 KB); false when out of memory
+  bool begin(ByteSink *next);
+  void end();
+
+  bool write(const uint8_t *data, size_t len) override;
+  bool finish() override;
+  const char *error() const override;
+
+private:
+  enum State : uint8_t { HEADER, EXTRA_LEN, EXTRA, NAME, COMMENT, HCRC, BODY, TRAILER, DONE };
+
+  bool headerByte(uint8_t b);
+
+  ByteSink *_next = nullptr;
+  void *_inflator = nullptr;
+  uint8_t *_dict = nullptr;
+  size_t _dictPos = 0;
+  State _state = HEADER;
+  uint8_t _flags = 0;
+  uint16_t _count = 0;
+  uint16_t _extraLen = 0;
+  uint8_t _trailer[8];
+  uint32_t _crc = 0;
+  uint32_t _size = 0;
+};
+
+// HiveSync delta ("HSD1") against the image in the running OTA slot.
+//   header: "HSD1", u32 sourceSize, u32 sourceCrc32, u32 targetSize, u32 targetCrc32
+//   ops:    0x01 COPY u32 srcOffset u32 len  -> bytes from the running slot
+//           0x02 ADD  u32 len, len literal bytes
+//           0x00 END
+// All integers little-endian. Produced by scripts/make_ota_artifacts.py.
+class DeltaDecoder : public ByteSink {
+public:
+  bool begin(ByteSink *next);
+  void end();
+
+  bool write(const uint8_t *data, size_t len) override;
+  bool finish() override;
+  const char *error() const override;
+
+private:
+  enum State : uint8_t { HEADER, OP, COPY_ARGS, ADD_LEN, ADD_DATA, DONE };
+
+  bool onHeader();
+  bool copyFromSource(uint32_t offset, uint32_t len);
+  bool emit(const uint8_t *data, size_t len);
+
+  ByteSink *_next = nullptr;
+  const void *_source = nullptr;   // esp_partition_t of the running slot
+  State _state = HEADER;
+  uint8_t _hdr[20];
+  uint8_t _count = 0;
+  uint32_t _remaining = 0;
+  uint32_t _sourceSize = 0;
+  uint32_t _targetSize = 0;
+  uint32_t _targetCrc = 0;
+  uint32_t _crc = 0;
+  uint32_t _written = 0;
+  uint8_t _buf[1024];
+};
+
+} // namespace OtaDecode
@@ -0,0 +1,47 @@
+// Background OTA download engine: network reader and flash writer tasks
+#pragma once
+
+#include <Arduino.h>
+
+namespace OtaEngine {
+
+enum class EventType : uint8_t {
+  Started,   // HTTP OK, flash slot prepared; total is known
+  Progress,  // another percent of the image written
+  Finished,  // image written, verified and selected for the next boot
+  Failed     // download or flash error; see message
+};
+
+// Encoding of the downloaded asset
+enum class ImageFormat : uint8_t {
+  Raw,        // firmware.bin as is
+  Gzip,       // gzip-compressed firmware.bin
+  Delta,      // HSD1 patch against the running slot
+  GzipDelta   // gzip-compressed HSD1 patch
+};
+
+struct Event {
+  EventType type;
+  uint32_t done;          // downloaded bytes processed so far (incl. resumed ones)
+  uint32_t total;         // download size from Content-Length / Content-Range
+  uint32_t elapsedMs;     // since start()
+  uint16_t readerStalls;  // times the reader waited for a free chunk
+  uint16_t writerStalls;  // times the writer waited for data
+  uint8_t peakFilled;     // max chunks queued between reader and writer
+  uint32_t resumedFrom;   // image offset this attempt continued at, 0 = from the start
+  char message[40];       // error description (Failed only)
+};
+
+// Start downloading url into the inactive OTA slot in the background,
+// decoding it on the fly according to fmt. A raw image continues where an
+// earlier interrupted download of the same URL stopped (HTTP Range).
+// Returns false if an update is already running or resources are missing.
+bool start(const String &url, ImageFormat fmt = ImageFormat::Raw);
+
+// True while the reader or writer task is alive.
+bool busy();
+
+// Pop the next engine event without blocking. Call from loop().
+bool pollEvent(Event &ev);
+
+} // namespace OtaEngine
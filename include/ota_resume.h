@@ -0,0 +1,36 @@
+// Resume bookkeeping for interrupted OTA downloads (HTTP Range)
+// Free of Arduino headers so it builds on the host.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace OtaResume {
+
+static const size_t URL_MAX = 256;  // incl. terminator, as ReleaseParser
+static const size_t ETAG_MAX = 80;
+
+// What NVS remembers about a partly flashed image
+struct Checkpoint {
+  char url[URL_MAX];
+  char etag[ETAG_MAX];  // validator sent back in If-Range
+  uint32_t slot;        // flash address of the OTA slot being written
+  uint32_t size;        // full image size
+  uint32_t offset;      // bytes flashed and committed, sector aligned
+};
+
+// Byte offset to ask for: the checkpoint's when it is for the same URL and
+// slot, carries an ETag and lies inside the image; 0 (start over) otherwise.
+uint32_t resumeFrom(const Checkpoint &cp, const char *url, uint32_t slot);
+
+// Parse a Content-Range value "bytes first-last/total". False when it is
+// malformed or the total is unknown ("*").
+bool parseContentRange(const char *value, uint32_t &first, uint32_t &last, uint32_t &total);
+
+// Largest offset <= written that can be committed: resumed writes must
+// start on an erase-sector boundary
+inline uint32_t committable(uint32_t written, uint32_t sector) {
+  return written - written % sector;
+}
+
+} // namespace OtaResume
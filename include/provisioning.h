@@ -9,16 +9,27 @@ typedef arduino_event_t arduino_event_t;
 namespace Provisioning {
 
 // Start WiFi or BLE provisioning depending on stored credentials
-void beginIfNeeded(const String &serviceName, const String &pop);
+void beginIfNeeded(const char *serviceName, const char *pop);
 
 // Arduino WiFi event handler
 void onEvent(arduino_event_t *sys_event);
 
-// Detect long-press on BOOT (GPIO0) during boot to clear credentials
-bool checkResetProvisioningOnBoot(uint32_t holdMs = 2000);
+// Long-press on BOOT (GPIO0) held from reset clears the credentials.
+// watchResetButton() samples the button and arms an interrupt for its
+// release; resetButton() then tells, without waiting, how it went.
+enum class ResetButton : uint8_t { Pending, Released, LongPress };
+void watchResetButton(uint32_t holdMs = 2000);
+ResetButton resetButton();
 
 // Connection status useful for UI/LED feedback
 bool isConnected();
 
+// True while BLE provisioning is running and other BLE users must wait
+bool provisioningActive();
+
+// Connect with stored credentials without touching the display, waiting up
+// to timeoutMs for an IP. For duty-cycle wakes; returns false without creds.
+bool connectStored(uint32_t timeoutMs);
+
 } // namespace Provisioning
 
@@ -0,0 +1,94 @@
+// Incremental, constant-memory scanner for the GitHub "latest release" JSON
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Feed the response body in arbitrary pieces; the scanner keeps only a small
+// key buffer and the two values it extracts:
+//   - top-level "tag_name"
+//   - "browser_download_url" of the entry in "assets" whose "name" equals
+//     one of the requested asset names; earlier names win (key order inside
+//     the asset is free)
+// String escapes (including \uXXXX) are decoded before comparing/storing.
+class ReleaseParser {
+public:
+  static const size_t TAG_MAX = 32;   // incl. terminator
+  static const size_t URL_MAX = 256;  // incl. terminator
+  static const uint8_t MAX_DEPTH = 32;
+  static const uint8_t MAX_ASSETS = 4;
+
+  explicit ReleaseParser(const char *assetName);
+  // Candidate asset names in order of preference (at most MAX_ASSETS)
+  ReleaseParser(const char *const *assetNames, uint8_t count);
+
+  // Forget everything parsed so far (asset names are kept)
+  void reset();
+
+  // Consume the next bytes of the document
+  void feed(const uint8_t *data, size_t len);
+  void feed(char c);
+
+  // True once nothing better can show up; the rest of the body can be skipped
+  bool complete() const { return _tagLen > 0 && (_bestIndex == 0 || _assetsDone); }
+
+  // Malformed structure or nesting deeper than MAX_DEPTH
+  bool failed() const { return _failed; }
+
+  // Extracted values; empty string when not found (or too long to store)
+  const char *tagName() const { return _tag; }
+  const char *assetUrl() const { return _bestIndex >= 0 ? _url : ""; }
+
+  // Index into the candidate names of the asset returned by assetUrl(), or -1
+  int8_t assetIndex() const { return _bestIndex; }
+
+private:
+  enum Key : uint8_t { KEY_OTHER, KEY_TAG_NAME, KEY_ASSETS, KEY_NAME, KEY_URL };
+  enum Target : uint8_t { TGT_NONE, TGT_KEY, TGT_TAG, TGT_NAME, TGT_URL };
+
+  void onStructural(char c);
+  void beginString();
+  void endString();
+  void emit(uint8_t b);
+  void emitCodepoint(uint32_t cp);
+  Key classifyKey() const;
+
+  const char *_assetNames[MAX_ASSETS];
+  uint8_t _assetCount;
+
+  // Container stack: bit i set = object at depth i+1, clear = array
+  uint32_t _objMask;
+  uint8_t _depth;
+  bool _expectKey;
+  bool _failed;
+
+  // String lexer
+  bool _inString;
+  uint8_t _escape;      // 0 none, 1 after '\', 2..5 collecting \uXXXX digits
+  uint16_t _uni;
+  Target _target;
+
+  // Key being read and the last key seen at the levels we care about
+  char _key[24];
+  uint8_t _keyLen;
+  bool _keyOverflow;
+  Key _rootKey;         // key at depth 1 (release object)
+  Key _assetKey;        // key at depth 3 (asset object)
+  bool _inAssets;       // inside the "assets" array (depth 2)
+  bool _assetsDone;     // "assets" array fully seen
+
+  // Values
+  char _tag[TAG_MAX];
+  uint8_t _tagLen;
+  bool _tagOverflow;
+  char _url[URL_MAX];      // best match so far
+  char _cand[URL_MAX];     // URL of the asset currently being read
+  uint16_t _candLen;
+  bool _candOverflow;
+  int8_t _bestIndex;
+
+  // Streaming comparison of the current asset's "name" against all candidates
+  size_t _namePos;
+  uint8_t _nameMismatch;   // bit i set = candidate i ruled out
+  int8_t _nameMatched;     // candidate index matched by this asset, or -1
+};
@@ -0,0 +1,37 @@
+// Hive scale: HX711 load-cell amplifier sampled at 80 SPS
+#pragma once
+
+#include <Arduino.h>
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+#ifndef HS_SCALE
+#define HS_SCALE 0
+#endif
+
+namespace Scale {
+
+// Configure the pins and start interrupt-driven capture. Returns false
+// when no HX711 answers (or the scale is compiled out).
+bool begin();
+
+// Scheduler job: filter the captured samples and publish settled weights
+// ("w_v" raw counts, plus "weight_kg" once calibrated).
+void loop();
+
+// Deep-sleep wakes, after begin(): filter samples until the estimate
+// settles, publish it and return true, or give up after timeoutMs.
+bool readSettled(uint32_t timeoutMs);
+
+// Cell temperature for drift compensation, e.g. from a probe on the frame
+void setTemperature(float celsius);
+
+struct Stats {
+  uint32_t samples;   // read by the interrupt handler
+  uint32_t overruns;  // lost because the ring was full
+  uint32_t steps;     // load changes detected
+  int32_t counts;     // current filtered value
+  bool settled;
+};
+Stats stats();
+
+} // namespace Scale
@@ -0,0 +1,48 @@
+// Cooperative job scheduler on a hashed timer wheel
+#pragma once
+
+#include <Arduino.h>
+
+namespace Scheduler {
+
+typedef void (*JobFn)();
+
+// Job handle; negative means "no job"
+typedef int8_t JobId;
+
+// Run fn every periodMs, first after firstDelayMs. Register and cancel
+// from the loop task only.
+JobId every(const char *name, uint32_t periodMs, JobFn fn, uint32_t firstDelayMs = 0);
+
+// Run fn once after delayMs.
+JobId after(const char *name, uint32_t delayMs, JobFn fn);
+
+// Move a job's next run to delayMs from now (and change the period of a
+// periodic job when periodMs is non-zero).
+void reschedule(JobId id, uint32_t delayMs, uint32_t periodMs = 0);
+
+void cancel(JobId id);
+
+// Run every job that is due and return the milliseconds until the next
+// deadline. Does not block; usable with a virtual clock.
+uint32_t runDue();
+
+// runDue(), then block the calling task until the next deadline or wake().
+// The idle task (and tickless light sleep, when enabled) gets the gap.
+void run();
+
+// Cut a blocking run() short, e.g. after queueing work for a job.
+void wake();
+void wakeFromISR();
+
+// Make a job due now (periodic jobs keep their period from here) and wake
+// the loop task. Safe from interrupt handlers, e.g. a sensor's ready pin.
+void triggerFromISR(JobId id);
+
+// Replace millis() as the time source (host simulation, tests).
+void setClock(uint32_t (*nowMs)());
+
+// Log wakeups per hour and per-job run counts and lateness.
+void logStats();
+
+} // namespace Scheduler
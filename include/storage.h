@@ -0,0 +1,15 @@
+// LittleFS data partition shared by the on-device stores
+#pragma once
+
+#include <Arduino.h>
+
+namespace Storage {
+
+// Mount the "littlefs" partition, formatting it on first use. Safe to call
+// from every module that needs it; only the first call mounts.
+bool begin();
+
+// True once the partition is mounted.
+bool mounted();
+
+} // namespace Storage
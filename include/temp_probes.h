@@ -0,0 +1,40 @@
+// Hive temperature probes: a DS18B20 chain on one 1-Wire pin
+#pragma once
+
+#include <Arduino.h>
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+#ifndef HS_TEMP_PROBES
+#define HS_TEMP_PROBES 0
+#endif
+// Seconds between two sampling rounds
+#ifndef TEMP_PERIOD_S
+#define TEMP_PERIOD_S 300
+#endif
+
+namespace TempProbes {
+
+// Up to ten probes, published as BEEP t_0 .. t_9 in ROM order
+static const uint8_t MAX_PROBES = 10;
+
+// Set up the 1-Wire pin and enumerate the probes. Returns false when none
+// answers (or the probes are compiled out).
+bool begin();
+
+// Scheduler job: start one conversion on every probe at once and return.
+// A one-shot job collects and publishes the results when it is done.
+void sample();
+
+// Deep-sleep wakes, where the scheduler does not run: convert, wait
+// CONVERT_MS and publish the readings before returning.
+void sampleNow();
+
+struct Stats {
+  uint32_t rounds;     // conversions completed and collected
+  uint32_t badReads;   // scratchpads with a bad CRC or no conversion
+  uint32_t rescans;    // ROM searches after the first
+  uint8_t probes;      // ROM IDs currently cached
+};
+Stats stats();
+
+} // namespace TempProbes
@@ -0,0 +1,40 @@
+// Compressed append-only time-series store on the LittleFS partition
+#pragma once
+
+#include <Arduino.h>
+
+namespace TimeSeries {
+
+// Mount storage, find existing segments and subscribe to Measurements so
+// every timestamped reading is recorded under its BEEP key.
+//
+// Keys get a channel slot on first use, up to TS_MAX_CHANNELS (default 32,
+// about 300 bytes of RAM each). That covers the 24 built-in keys plus two
+// BLE tags publishing four readings each; it is deliberately not sized for
+// BleScan's full 32-tag table, which would take ~48 KB. Readings of keys
+// beyond the limit are counted in Stats::skipped and the first one is
+// logged; raise TS_MAX_CHANNELS for hives with more tags.
+bool begin();
+
+// Call regularly from loop(); writes sealed blocks to flash.
+void loop();
+
+// Seal and write every open block (e.g. before sleep or reboot).
+void flush();
+
+typedef void (*PointFn)(uint32_t time, float value, void *ctx);
+
+// Visit the points of channel key with from <= time <= to, oldest first,
+// including ones not yet written to flash. Returns the number visited.
+uint32_t query(const char *key, uint32_t from, uint32_t to, PointFn fn, void *ctx);
+
+struct Stats {
+  uint32_t points;        // readings recorded since boot
+  uint32_t skipped;       // readings without a wall-clock time or channel slot
+  uint32_t blocks;        // blocks written since boot
+  uint32_t flashBytes;    // bytes appended to segments since boot
+  uint16_t segments;      // segment files on flash
+};
+Stats stats();
+
+} // namespace TimeSeries
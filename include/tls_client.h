@@ -0,0 +1,55 @@
+// TLS client over a WiFiClient socket that keeps the mbedTLS session
+// between connections, so reconnecting to the same host resumes it
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/ssl.h>
+
+class TlsClient : public WiFiClient {
+public:
+  TlsClient();
+  ~TlsClient();
+  TlsClient(const TlsClient &) = delete;
+  TlsClient &operator=(const TlsClient &) = delete;
+
+  // TCP connect and TLS handshake, offering the cached session if any
+  int connect(const char *host, uint16_t port) override { return connect(host, port, 0); }
+  int connect(const char *host, uint16_t port, int32_t timeoutMs);
+  uint8_t connected() override;
+  int available() override;
+  int read() override;
+  int read(uint8_t *buf, size_t size) override;
+  int peek() override;
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t *buf, size_t size) override;
+  using Print::write;
+  void flush() override {}
+  // Closes the connection; the session is kept for the next connect()
+  void stop() override;
+
+  // The last handshake resumed the cached session
+  bool resumed() const { return _resumed; }
+  // Drop the cached session (the client is moving to another host)
+  void forgetSession();
+
+private:
+  static int bioSend(void *ctx, const unsigned char *buf, size_t len);
+  static int bioRecv(void *ctx, unsigned char *buf, size_t len);
+  size_t pending();
+
+  mbedtls_ssl_context _ssl;
+  mbedtls_ssl_config _conf;
+  mbedtls_ssl_session _session;
+  mbedtls_entropy_context _entropy;
+  mbedtls_ctr_drbg_context _drbg;
+  uint32_t _timeoutMs = 0;
+  int _peek = -1;
+  bool _seeded = false;
+  bool _tls = false;          // _ssl/_conf are set up
+  bool _eof = false;          // peer closed or the record layer failed
+  bool _haveSession = false;
+  bool _resumed = false;
+};
@@ -0,0 +1,79 @@
+// Hot-path tracing spans with per-site latency histograms
+// Free of Arduino headers so it builds on the host.
+#pragma once
+
+#include <stdint.h>
+
+class Print;
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+#ifndef HS_TRACE
+#define HS_TRACE 1
+#endif
+
+namespace Trace {
+
+// Power-of-two microsecond buckets: < 1 us, [1,2) us, [2,4) us, ... ; the
+// last one also takes everything longer
+static const uint8_t BUCKETS = 24;
+
+// One instrumented code site. Constant-initialised, so it costs no
+// constructor; it joins the site list on its first recorded span.
+struct Site {
+  const char *name;
+  Site *next;
+  bool registered;
+  uint32_t count;
+  uint64_t totalUs;
+  uint32_t maxUs;
+  uint32_t buckets[BUCKETS];
+
+  constexpr explicit Site(const char *n)
+      : name(n), next(nullptr), registered(false), count(0), totalUs(0), maxUs(0), buckets() {}
+};
+
+// Raw timestamp: CPU cycle counter on the ESP32, steady_clock elsewhere
+uint32_t stamp();
+
+// Add one sample (from stamp() values) to a site's histogram
+void record(Site &site, uint32_t start, uint32_t end);
+
+// Times its enclosing scope into a site
+class Span {
+public:
+  explicit Span(Site &site) : _site(site), _start(stamp()) {}
+  ~Span() { record(_site, _start, stamp()); }
+  Span(const Span &) = delete;
+  Span &operator=(const Span &) = delete;
+
+private:
+  Site &_site;
+  uint32_t _start;
+};
+
+// Print every site's count, mean, percentiles and non-empty buckets.
+void dump(Print &out);
+
+// Copy of the named site's counters taken under the lock; false if no span
+// of that name has been recorded yet
+bool snapshot(const char *name, Site &out);
+
+// Upper bound of the bucket holding the given fraction (per mille) of samples
+uint32_t percentileUs(const Site &site, uint32_t permille);
+
+// Zero all histograms.
+void reset();
+
+} // namespace Trace
+
+#define HS_TRACE_CAT2(a, b) a##b
+#define HS_TRACE_CAT(a, b) HS_TRACE_CAT2(a, b)
+
+// TRACE_SPAN("ui.wifi_icon"); times the rest of the enclosing scope
+#if HS_TRACE
+  #define TRACE_SPAN(name)                                                  \
+    static Trace::Site HS_TRACE_CAT(_traceSite, __LINE__)(name);            \
+    Trace::Span HS_TRACE_CAT(_traceSpan, __LINE__)(HS_TRACE_CAT(_traceSite, __LINE__))
+#else
+  #define TRACE_SPAN(name) do {} while (0)
+#endif
@@ -21,9 +21,16 @@ enum class FontStyle {
   CleanSans
 };
 
-// Initialize display, power rails, backlight, header, and initial WiFi icon
+// Power the display / I2C rail and backlight and start the UI task, which
+// initialises the panel and draws the header and initial Wi-Fi icon while
+// the caller carries on. The drawing calls below are safe from any task,
+// also before the panel is up: they post to the UI task's mailbox and
+// return without touching SPI.
 void init();
 
+// True once the panel is initialised and the first frame is on screen
+bool ready();
+
 // Draw WiFi icon in top-right with state-specific color
 void drawWifiIcon(bool connected);
 
@@ -31,6 +38,18 @@ void drawWifiIcon(bool connected);
 // Pass -1 to hide.
 void setBatteryPercent(int percent);
 
+// Signal bars replace the Wi-Fi icon while connected; rssi in dBm, 0 = none
+void setSignal(int rssi);
+
+// Activity icon shown left of the Wi-Fi indicator
+enum class StatusIcon : uint8_t {
+  None,
+  Ble,
+  Ota,
+  Error
+};
+void setStatusIcon(StatusIcon icon);
+
 // Clear everything except the header band
 void clearContentBelowHeader();
 
@@ -39,6 +58,20 @@ void printHeader();
 
 // Print a message in a 1-based line slot under the header
 // Default color is 0xF7BE (White Smoke) to match existing style
-void printLine(int lineIndex1Based, const String &msg, uint16_t color = 0xF7BE, FontStyle style = FontStyle::Default);
+void printLine(int lineIndex1Based, const char *msg, uint16_t color = 0xF7BE, FontStyle style = FontStyle::Default);
+inline void printLine(int lineIndex1Based, const __FlashStringHelper *msg, uint16_t color = 0xF7BE,
+                      FontStyle style = FontStyle::Default) {
+  printLine(lineIndex1Based, reinterpret_cast<const char *>(msg), color, style);
+}
+
+// Mailbox counters: merged = replaced or wiped before being drawn,
+// dropped = rejected (line out of range)
+struct Stats {
+  uint32_t posted;
+  uint32_t merged;
+  uint32_t dropped;
+  uint32_t frames;
+};
+Stats stats();
 
 } // namespace UI
@@ -0,0 +1,69 @@
+// Canvas drawing helpers of the UI module, kept in a header so the host
+// benches and tests can drive them directly
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <pgmspace.h>
+
+namespace UI {
+
+// Generic 1bpp bitmap drawer (MSB-first per byte), rendered into a canvas
+inline void drawMonoBitmap1BPP(GFXcanvas16 &dst, int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *data, uint16_t fg, uint16_t bg) {
+  uint16_t *buf = dst.getBuffer();
+  if (!buf) return;
+  const int16_t dw = dst.width(), dh = dst.height();
+  int bytesPerRow = (w + 7) / 8;
+  for (int16_t row = 0; row < h; ++row) {
+    int16_t dy = y + row;
+    if (dy < 0 || dy >= dh) continue;
+    uint16_t *out = buf + dy * dw;
+    for (int16_t col = 0; col < w; ++col) {
+      int16_t dx = x + col;
+      if (dx < 0 || dx >= dw) continue;
+      int byteIndex = row * bytesPerRow + (col / 8);
+      uint8_t bits = pgm_read_byte(&data[byteIndex]);
+      bool on = bits & (0x80 >> (col % 8));
+      out[dx] = on ? fg : bg;
+    }
+  }
+}
+
+// Helper: draw 1-bit bitmap where each row is a 16-bit word (fallback 16x12)
+inline void drawMonoBitmap16x12(GFXcanvas16 &dst, int16_t x, int16_t y, const uint16_t *data, uint16_t color, uint16_t bg) {
+  uint16_t *buf = dst.getBuffer();
+  if (!buf) return;
+  const int16_t dw = dst.width(), dh = dst.height();
+  for (int16_t row = 0; row < 12; ++row) {
+    int16_t dy = y + row;
+    if (dy < 0 || dy >= dh) continue;
+    uint16_t *out = buf + dy * dw;
+    uint16_t bits = pgm_read_word(&data[row]);
+    for (int16_t col = 0; col < 16; ++col) {
+      int16_t dx = x + col;
+      if (dx < 0 || dx >= dw) continue;
+      bool on = bits & (1 << (15 - col));
+      out[dx] = on ? color : bg;
+    }
+  }
+}
+
+// Status icons are rows of 2-bit coverage, run-length coded one byte per
+// run as level << 6 | (run - 1). Runs never cross a row, so decoding hands
+// out horizontal spans sink(x, y, run, level) that are filled in one go;
+// level 0 spans are skipped. Returns the byte after the icon's last run.
+template <typename Sink>
+const uint8_t *forEachIconSpan(const uint8_t *rle, uint8_t w, uint8_t h, Sink sink) {
+  const uint8_t *p = rle;
+  for (uint8_t y = 0; y < h; ++y) {
+    for (uint8_t x = 0; x < w;) {
+      uint8_t b = pgm_read_byte(p++);
+      uint8_t run = (b & 0x3F) + 1;
+      if (b >> 6) sink(x, y, run, b >> 6);
+      x += run;
+    }
+  }
+  return p;
+}
+
+} // namespace UI
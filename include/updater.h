@@ -5,7 +5,9 @@
 
 namespace Updater {
 
-// Call regularly from loop(); performs a one-time check after WiFi connects.
+// Call regularly from loop(); checks for releases once Wi-Fi connects and
+// then periodically (conditional requests, rate-limit aware), and relays
+// background OTA progress to the display.
 void loop();
 
 // Expose the current firmware version string (from build flag) for display/logs.
@@ -0,0 +1,32 @@
+// BEEP sensor-data uploader with a flash-backed outbound queue
+#pragma once
+
+#include <Arduino.h>
+
+namespace Uploader {
+
+// Mount storage, restore any queue left from before a reboot and subscribe
+// to Measurements. Does nothing when BEEP_SENSOR_KEY is not configured.
+void begin();
+
+// Call regularly from loop(); moves staged readings to flash and, once
+// Wi-Fi is up, sends them in batches with exponential back-off on failure.
+void loop();
+
+// Persist everything staged and, if Wi-Fi is up, send until the queue is
+// empty, a request fails or timeoutMs passes. Returns true when nothing is
+// left to send. Used before deep sleep.
+bool flush(uint32_t timeoutMs);
+
+struct Stats {
+  uint32_t queued;       // readings accepted since boot
+  uint32_t sent;         // readings acknowledged by the server
+  uint32_t dropped;      // staging overflow, full queue or rejected by the server
+  uint32_t posts;        // HTTP requests made
+  uint32_t flashWrites;  // append operations on the queue file
+  uint32_t bodyBytes;    // request body bytes sent
+  uint32_t pending;      // readings waiting (staged + on flash)
+};
+Stats stats();
+
+} // namespace Uploader
@@ -0,0 +1,58 @@
+// Semantic version parsing usable at compile time (C++11 constexpr)
+#pragma once
+
+#include <stdint.h>
+
+namespace Version {
+
+struct SemVer {
+  uint16_t major;
+  uint16_t minor;
+  uint16_t patch;
+
+  constexpr SemVer(uint16_t ma = 0, uint16_t mi = 0, uint16_t pa = 0) : major(ma), minor(mi), patch(pa) {}
+
+  // Single ordered key: 16 bits per field
+  constexpr uint64_t key() const {
+    return ((uint64_t)major << 32) | ((uint64_t)minor << 16) | patch;
+  }
+};
+
+namespace detail {
+constexpr bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+constexpr const char *skipV(const char *s) {
+  return (*s == 'v' || *s == 'V') ? s + 1 : s;
+}
+constexpr uint16_t number(const char *s, uint32_t acc = 0) {
+  return isDigit(*s) && acc < 6553 ? number(s + 1, acc * 10 + (uint32_t)(*s - '0')) : (uint16_t)acc;
+}
+constexpr const char *skipDigits(const char *s) {
+  return isDigit(*s) ? skipDigits(s + 1) : s;
+}
+// Start of the next dot-separated field; stays put at '-', '+' or the end
+constexpr const char *nextField(const char *s) {
+  return *skipDigits(s) == '.' ? skipDigits(s) + 1 : skipDigits(s);
+}
+} // namespace detail
+
+// Parse "[v]MAJOR[.MINOR[.PATCH]][-suffix]"; missing fields are 0 and any
+// pre-release/build suffix is ignored.
+constexpr SemVer parse(const char *s) {
+  return SemVer(detail::number(detail::skipV(s)),
+                detail::number(detail::nextField(detail::skipV(s))),
+                detail::number(detail::nextField(detail::nextField(detail::skipV(s)))));
+}
+
+// True when s starts with a version number (after an optional 'v')
+constexpr bool valid(const char *s) {
+  return detail::isDigit(*detail::skipV(s));
+}
+
+// -1, 0 or 1 like strcmp
+constexpr int compare(const SemVer &a, const SemVer &b) {
+  return a.key() < b.key() ? -1 : a.key() > b.key() ? 1 : 0;
+}
+
+} // namespace Version
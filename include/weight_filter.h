@@ -0,0 +1,66 @@
+// Fixed-point filter chain for raw load-cell samples
+// Free of Arduino headers so it builds on the host.
+#pragma once
+
+#include <stdint.h>
+
+class WeightFilter {
+public:
+  struct Config {
+    uint32_t noiseVar;     // measurement noise variance (counts^2), Kalman R
+    uint32_t driftVar;     // allowed drift per sample (counts^2), Kalman Q
+    int32_t stepCounts;    // offset from the estimate that counts as a step
+    uint8_t stepConfirm;   // consecutive samples beyond it to accept a step
+    uint16_t settleSamples; // quiet samples after (re)start before settled
+    int32_t tempco;        // counts per deg C the cell drifts by
+    int16_t trefC100;      // temperature (centi-deg C) with no correction
+  };
+
+  enum class Event : uint8_t {
+    None,
+    Settled,  // the estimate has become stable (first time after a reset/step)
+    Step      // the load changed; stepDelta() holds the size, in counts
+  };
+
+  static const uint8_t MEDIAN_N = 5;
+
+  // Scale tuning at 80 SPS: Kalman noise from typical HX711 noise (~100
+  // counts rms), a step must hold for half a second and the estimate
+  // settles in two. No temperature compensation (tempco 0, 20 deg C).
+  static const Config SCALE_DEFAULTS;
+
+  explicit WeightFilter(const Config &config) : _cfg(config) { reset(); }
+
+  void reset();
+
+  // Latest cell temperature for the compensation stage
+  void setTemperature(int16_t centiC) { _tempC100 = centiC; }
+
+  // Median of the last MEDIAN_N samples, temperature correction, then a
+  // scalar Kalman filter. Sustained offsets restart the estimate at the
+  // new level instead of creeping towards it.
+  Event add(int32_t raw);
+
+  int32_t value() const { return (int32_t)(_x >> FRAC_BITS); }
+  bool settled() const { return _quiet >= _cfg.settleSamples; }
+  int32_t stepDelta() const { return _stepDelta; }
+
+private:
+  static const uint8_t FRAC_BITS = 8;  // estimate kept in Q8 counts
+  static const uint8_t GAIN_BITS = 16; // Kalman gain in Q16
+
+  int32_t median(int32_t raw);
+
+  Config _cfg;
+  int32_t _window[MEDIAN_N];
+  uint8_t _filled;
+  uint8_t _next;
+  int64_t _x;         // estimate, Q8
+  uint32_t _p;        // estimate variance (counts^2)
+  bool _started;
+  uint8_t _outliers;  // consecutive samples beyond stepCounts
+  int8_t _outlierSign;
+  uint16_t _quiet;
+  int32_t _stepDelta;
+  int16_t _tempC100;
+};
@@ -0,0 +1,33 @@
+// Wi-Fi fast reconnect from cached AP, channel and IP lease
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+namespace WifiFast {
+
+// Connect with the stored credentials. When an earlier connection left its
+// BSSID/channel (and a recent DHCP lease) behind, join that AP directly
+// with the old address and skip the scan and DHCP; a failure falls back
+// to a scan for the SSID and a DHCP connect to the strongest AP. Requires
+// WIFI_STA mode.
+void begin();
+
+// Wi-Fi event hook: phase timings, cache updates and the fallback.
+void onEvent(arduino_event_t *e);
+
+// Connect-phase timings of the last attempt. The driver posts no event
+// between authentication and association, so those two are one phase
+// (with the WPA handshake); a join without a scan result (hidden SSID)
+// also includes the driver's own scan in it.
+struct Timings {
+  uint32_t scanMs;    // scan for the stored SSID, 0 on a direct connect
+  uint32_t assocMs;   // WiFi.begin() until associated (auth + assoc)
+  uint32_t dhcpMs;    // associated until an IP is usable
+  bool direct;        // joined the cached BSSID/channel without scanning
+  bool staticIp;      // reused the cached lease, no DHCP exchange
+  uint8_t fallbacks;  // direct attempts that had to fall back to a scan
+};
+Timings timings();
+
+} // namespace WifiFast
@@ -0,0 +1,136 @@
+# Decode binary log records persisted by the Log module (/log.bin, /log.old)
+# - Format strings are not stored on the device; each record carries the
+#   address of its format string, which is looked up in the firmware ELF
+#   that produced the log (it must be the exact same build).
+# - Record layout matches src/log.cpp: 12-byte header, then per argument a
+#   kind byte and its payload.
+#
+# Usage:
+#   python scripts/decode_log.py .pio/build/<env>/firmware.elf log.old log.bin
+#
+# Requires pyelftools (pip install pyelftools).
+
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+MAGIC = 0xA5
+HEADER = struct.Struct("<BBBBII")
+KIND_U32, KIND_U64, KIND_F64, KIND_STR = 1, 2, 3, 4
+DROPPED_FMT = "[LOG] %u records dropped\n"
+
+SPEC = re.compile(r"%([-+ #0]*)(\d*)(\.\d+)?(hh|h|ll|l|L|q|j|z|t)?([diouxXcfeEgGaAsp%])")
+
+
+class Strings:
+    """Reads NUL-terminated strings out of the ELF's loadable sections."""
+
+    def __init__(self, path):
+        self.sections = []
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            for sec in elf.iter_sections():
+                addr = sec["sh_addr"]
+                if addr and sec["sh_type"] == "SHT_PROGBITS":
+                    self.sections.append((addr, sec.data()))
+        self.cache = {}
+
+    def get(self, addr):
+        if addr in self.cache:
+            return self.cache[addr]
+        text = None
+        for base, data in self.sections:
+            if base <= addr < base + len(data):
+                end = data.index(b"\0", addr - base)
+                text = data[addr - base:end].decode("utf-8", "replace")
+                break
+        self.cache[addr] = text
+        return text
+
+
+def parse_args(payload, count):
+    args = []
+    pos = 0
+    for _ in range(count):
+        kind = payload[pos]
+        pos += 1
+        if kind == KIND_U32:
+            args.append(struct.unpack_from("<I", payload, pos)[0])
+            pos += 4
+        elif kind == KIND_U64:
+            args.append(struct.unpack_from("<Q", payload, pos)[0])
+            pos += 8
+        elif kind == KIND_F64:
+            args.append(struct.unpack_from("<d", payload, pos)[0])
+            pos += 8
+        elif kind == KIND_STR:
+            n = payload[pos]
+            args.append(payload[pos + 1:pos + 1 + n].decode("utf-8", "replace"))
+            pos += 1 + n
+        else:
+            break
+    return args
+
+
+def render(fmt, args):
+    """printf with Python's % operator, one conversion at a time."""
+    it = iter(args)
+
+    def one(m):
+        flags, width, prec, _length, conv = m.groups()
+        if conv == "%":
+            return "%"
+        value = next(it, None)
+        if value is None:
+            return "<?>"
+        spec = "%" + flags + width + (prec or "")
+        if conv in "di":
+            if isinstance(value, int) and value >= 1 << 31 and value < 1 << 32:
+                value -= 1 << 32
+            return (spec + "d") % int(value)
+        if conv == "p":
+            return "0x%08x" % int(value)
+        if conv == "c":
+            return chr(int(value) & 0xFF)
+        if conv in "ouxX":
+            return (spec + conv) % int(value)
+        if conv in "feEgGaA":
+            return (spec + conv.replace("a", "e").replace("A", "E")) % float(value)
+        return (spec + "s") % value
+
+    return SPEC.sub(one, fmt)
+
+
+def decode(path, strings, out):
+    data = open(path, "rb").read()
+    pos = 0
+    while pos + HEADER.size <= len(data):
+        magic, length, core, count, fmt_addr, ms = HEADER.unpack_from(data, pos)
+        if magic != MAGIC:
+            pos += 1  # torn write; resynchronise on the next header
+            continue
+        payload = data[pos + HEADER.size:pos + HEADER.size + length]
+        pos += HEADER.size + length
+        fmt = DROPPED_FMT if fmt_addr == 0 else strings.get(fmt_addr)
+        if fmt is None:
+            out.write("%10u c%u <unknown format 0x%08x>\n" % (ms, core, fmt_addr))
+            continue
+        out.write("%10u c%u %s" % (ms, core, render(fmt, parse_args(payload, count))))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decode HiveSync binary log files")
+    ap.add_argument("elf", help="firmware.elf of the build that wrote the log")
+    ap.add_argument("logs", nargs="+", help="log files, oldest first")
+    args = ap.parse_args()
+
+    strings = Strings(args.elf)
+    for path in args.logs:
+        decode(path, strings, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -2,6 +2,25 @@
 # - Downloads Font Awesome Free Solid TTF (cached under .pio)
 # - Renders U+F1EB at a target box size
 # - Emits include/fa_wifi_icon.h containing PROGMEM bitmap + defines
+#
+# Also pre-renders the text glyph atlas used by UI::printLine
+# - The Adafruit GFX built-in 5x7 font (glcdfont.c of the installed library,
+#   else the copy of its printable ASCII below), so Default-style text looks
+#   exactly as drawn through GFX
+# - Printable ASCII in 12x16 cells (the 6x8 cell at TEXT_SIZE 2) in the
+#   2-bit coverage format, every pixel fully on or off; needs no Pillow
+# - Emits include/ui_glyph_atlas.h; without it the UI keeps drawing text
+#   through Adafruit GFX. The RoundedSans/CleanSans styles always do.
+#
+# And compiles the status band icons into one run-length coded atlas
+# - Font Awesome glyphs (Wi-Fi, battery levels, download, warning, and
+#   Bluetooth from the Brands font) plus drawn signal-strength bars
+# - 2-bit coverage, each row coded as runs of (level << 6 | run - 1) bytes;
+#   every icon is decoded again and compared with its render before writing
+# - Emits include/ui_icon_atlas.h with an index; without it the band keeps
+#   the single Wi-Fi bitmap above
+# - Emits include/ui_icon_renders.h with the renders the atlas was coded
+#   from, for the host tests of the firmware decoder
 
 from pathlib import Path
 import sys
@@ -23,6 +42,42 @@ FA_TTF_URLS = [
 
 TTF_PATH = CACHE_DIR / "fa-solid-900.ttf"
 
+FA_BRANDS_TTF_URLS = [
+    "https://cdnjs.cloudflare.com/ajax/libs/font-awesome/6.5.1/webfonts/fa-brands-400.ttf",
+    "https://cdnjs.cloudflare.com/ajax/libs/font-awesome/5.15.4/webfonts/fa-brands-400.ttf",
+]
+FA_BRANDS_TTF_PATH = CACHE_DIR / "fa-brands-400.ttf"
+
+ATLAS_OUT = PROJECT_DIR / "include" / "ui_glyph_atlas.h"
+GLCDFONT_GLOB = "*/Adafruit GFX Library/glcdfont.c"
+TEXT_SIZE = 2                # UI::TEXT_SIZE
+GLYPH_W, GLYPH_H = 6 * TEXT_SIZE, 8 * TEXT_SIZE
+GLYPH_FIRST, GLYPH_LAST = 0x20, 0x7E
+
+ICON_ATLAS_OUT = PROJECT_DIR / "include" / "ui_icon_atlas.h"
+ICON_RENDERS_OUT = PROJECT_DIR / "include" / "ui_icon_renders.h"
+ICON_MAX_W, ICON_H = 20, 16  # fits three icons plus "100%" beside the header
+RLE_MAX_RUN = 64
+# (name, source, argument): "solid"/"brands" render a Font Awesome codepoint,
+# "bars" draws that many lit signal bars. Consecutive names stay in order so
+# the firmware can index SIGNAL_0 + n and BATT_0 + n.
+ICONS = [
+    ("WIFI", "solid", 0xF1EB),
+    ("SIGNAL_0", "bars", 0),
+    ("SIGNAL_1", "bars", 1),
+    ("SIGNAL_2", "bars", 2),
+    ("SIGNAL_3", "bars", 3),
+    ("SIGNAL_4", "bars", 4),
+    ("BATT_0", "solid", 0xF244),  # battery-empty
+    ("BATT_1", "solid", 0xF243),  # battery-quarter
+    ("BATT_2", "solid", 0xF242),  # battery-half
+    ("BATT_3", "solid", 0xF241),  # battery-three-quarters
+    ("BATT_4", "solid", 0xF240),  # battery-full
+    ("BLE", "brands", 0xF294),    # bluetooth-b
+    ("OTA", "solid", 0xF019),     # download
+    ("ERROR", "solid", 0xF071),   # triangle-exclamation
+]
+
 def ensure_pillow():
     try:
         import PIL  # noqa: F401
@@ -41,18 +96,18 @@ def ensure_pillow():
         except Exception:
             return False
 
-def download_ttf():
+def download_ttf(urls=FA_TTF_URLS, path=TTF_PATH):
     import urllib.request
-    for url in FA_TTF_URLS:
+    for url in urls:
         try:
-            print(f"[fa-gen] Downloading FA TTF from {url}")
-            with urllib.request.urlopen(url, timeout=20) as r, open(TTF_PATH, "wb") as f:
+            print(f"[fa-gen] Downloading TTF from {url}")
+            with urllib.request.urlopen(url, timeout=20) as r, open(path, "wb") as f:
                 f.write(r.read())
-            if TTF_PATH.stat().st_size > 0:
+            if path.stat().st_size > 0:
                 return True
         except Exception as e:
             print(f"[fa-gen] Fetch failed: {e}")
-    print("[fa-gen] Could not download Font Awesome TTF.")
+    print(f"[fa-gen] Could not download {path.name}.")
     return False
 
 def render_bitmap():
@@ -147,12 +202,255 @@ def emit_header(img):
     print(f"[fa-gen] Wrote header: {HEADER_OUT}")
 
 
-def main():
-    # Try to prepare everything; on any failure, just skip (fallback icon used)
-    ok_pil = ensure_pillow()
-    if not ok_pil:
-        print("[fa-gen] Pillow missing; skipping FA icon generation.")
-        return
+# Columns of Adafruit GFX glcdfont.c (BSD license) for 0x20..0x7E: five
+# bytes per glyph, bit 0 the top row
+GLCDFONT_ASCII = bytes([
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x00,  # ' ' '!'
+    0x00, 0x07, 0x00, 0x07, 0x00, 0x14, 0x7F, 0x14, 0x7F, 0x14,  # '"' '#'
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x23, 0x13, 0x08, 0x64, 0x62,  # '$' '%'
+    0x36, 0x49, 0x56, 0x20, 0x50, 0x00, 0x08, 0x07, 0x03, 0x00,  # '&' "'"
+    0x00, 0x1C, 0x22, 0x41, 0x00, 0x00, 0x41, 0x22, 0x1C, 0x00,  # '(' ')'
+    0x2A, 0x1C, 0x7F, 0x1C, 0x2A, 0x08, 0x08, 0x3E, 0x08, 0x08,  # '*' '+'
+    0x00, 0x80, 0x70, 0x30, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08,  # ',' '-'
+    0x00, 0x00, 0x60, 0x60, 0x00, 0x20, 0x10, 0x08, 0x04, 0x02,  # '.' '/'
+    0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00, 0x42, 0x7F, 0x40, 0x00,  # '0' '1'
+    0x72, 0x49, 0x49, 0x49, 0x46, 0x21, 0x41, 0x49, 0x4D, 0x33,  # '2' '3'
+    0x18, 0x14, 0x12, 0x7F, 0x10, 0x27, 0x45, 0x45, 0x45, 0x39,  # '4' '5'
+    0x3C, 0x4A, 0x49, 0x49, 0x31, 0x41, 0x21, 0x11, 0x09, 0x07,  # '6' '7'
+    0x36, 0x49, 0x49, 0x49, 0x36, 0x46, 0x49, 0x49, 0x29, 0x1E,  # '8' '9'
+    0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x40, 0x34, 0x00, 0x00,  # ':' ';'
+    0x00, 0x08, 0x14, 0x22, 0x41, 0x14, 0x14, 0x14, 0x14, 0x14,  # '<' '='
+    0x00, 0x41, 0x22, 0x14, 0x08, 0x02, 0x01, 0x59, 0x09, 0x06,  # '>' '?'
+    0x3E, 0x41, 0x5D, 0x59, 0x4E, 0x7C, 0x12, 0x11, 0x12, 0x7C,  # '@' 'A'
+    0x7F, 0x49, 0x49, 0x49, 0x36, 0x3E, 0x41, 0x41, 0x41, 0x22,  # 'B' 'C'
+    0x7F, 0x41, 0x41, 0x41, 0x3E, 0x7F, 0x49, 0x49, 0x49, 0x41,  # 'D' 'E'
+    0x7F, 0x09, 0x09, 0x09, 0x01, 0x3E, 0x41, 0x41, 0x51, 0x73,  # 'F' 'G'
+    0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00, 0x41, 0x7F, 0x41, 0x00,  # 'H' 'I'
+    0x20, 0x40, 0x41, 0x3F, 0x01, 0x7F, 0x08, 0x14, 0x22, 0x41,  # 'J' 'K'
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x02, 0x1C, 0x02, 0x7F,  # 'L' 'M'
+    0x7F, 0x04, 0x08, 0x10, 0x7F, 0x3E, 0x41, 0x41, 0x41, 0x3E,  # 'N' 'O'
+    0x7F, 0x09, 0x09, 0x09, 0x06, 0x3E, 0x41, 0x51, 0x21, 0x5E,  # 'P' 'Q'
+    0x7F, 0x09, 0x19, 0x29, 0x46, 0x26, 0x49, 0x49, 0x49, 0x32,  # 'R' 'S'
+    0x03, 0x01, 0x7F, 0x01, 0x03, 0x3F, 0x40, 0x40, 0x40, 0x3F,  # 'T' 'U'
+    0x1F, 0x20, 0x40, 0x20, 0x1F, 0x3F, 0x40, 0x38, 0x40, 0x3F,  # 'V' 'W'
+    0x63, 0x14, 0x08, 0x14, 0x63, 0x03, 0x04, 0x78, 0x04, 0x03,  # 'X' 'Y'
+    0x61, 0x59, 0x49, 0x4D, 0x43, 0x00, 0x7F, 0x41, 0x41, 0x41,  # 'Z' '['
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x41, 0x41, 0x41, 0x7F,  # '\\' ']'
+    0x04, 0x02, 0x01, 0x02, 0x04, 0x40, 0x40, 0x40, 0x40, 0x40,  # '^' '_'
+    0x00, 0x03, 0x07, 0x08, 0x00, 0x20, 0x54, 0x54, 0x78, 0x40,  # '`' 'a'
+    0x7F, 0x28, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x28,  # 'b' 'c'
+    0x38, 0x44, 0x44, 0x28, 0x7F, 0x38, 0x54, 0x54, 0x54, 0x18,  # 'd' 'e'
+    0x00, 0x08, 0x7E, 0x09, 0x02, 0x18, 0xA4, 0xA4, 0x9C, 0x78,  # 'f' 'g'
+    0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, 0x44, 0x7D, 0x40, 0x00,  # 'h' 'i'
+    0x20, 0x40, 0x40, 0x3D, 0x00, 0x7F, 0x10, 0x28, 0x44, 0x00,  # 'j' 'k'
+    0x00, 0x41, 0x7F, 0x40, 0x00, 0x7C, 0x04, 0x78, 0x04, 0x78,  # 'l' 'm'
+    0x7C, 0x08, 0x04, 0x04, 0x78, 0x38, 0x44, 0x44, 0x44, 0x38,  # 'n' 'o'
+    0xFC, 0x18, 0x24, 0x24, 0x18, 0x18, 0x24, 0x24, 0x18, 0xFC,  # 'p' 'q'
+    0x7C, 0x08, 0x04, 0x04, 0x08, 0x48, 0x54, 0x54, 0x54, 0x24,  # 'r' 's'
+    0x04, 0x04, 0x3F, 0x44, 0x24, 0x3C, 0x40, 0x40, 0x20, 0x7C,  # 't' 'u'
+    0x1C, 0x20, 0x40, 0x20, 0x1C, 0x3C, 0x40, 0x30, 0x40, 0x3C,  # 'v' 'w'
+    0x44, 0x28, 0x10, 0x28, 0x44, 0x4C, 0x90, 0x90, 0x90, 0x7C,  # 'x' 'y'
+    0x44, 0x64, 0x54, 0x4C, 0x44, 0x00, 0x08, 0x36, 0x41, 0x00,  # 'z' '{'
+    0x00, 0x00, 0x77, 0x00, 0x00, 0x00, 0x41, 0x36, 0x08, 0x00,  # '|' '}'
+    0x02, 0x01, 0x02, 0x04, 0x02,                                # '~'
+])
+
+
+def glcdfont_columns():
+    """Glyph columns for GLYPH_FIRST..GLYPH_LAST and where they came from."""
+    import re
+    libdeps = Path(env.subst("$PROJECT_LIBDEPS_DIR"))
+    for src in sorted(libdeps.glob(GLCDFONT_GLOB)):
+        table = re.search(r"font\[\]\s*PROGMEM\s*=\s*\{(.*?)\};", src.read_text(), re.S)
+        if not table:
+            continue
+        data = bytes(int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]{2}", table.group(1)))
+        if len(data) >= (GLYPH_LAST + 1) * 5:
+            return data[GLYPH_FIRST * 5:(GLYPH_LAST + 1) * 5], src.name
+    return GLCDFONT_ASCII, "built-in copy of glcdfont.c"
+
+
+def render_atlas(columns):
+    """One GLYPH_W x GLYPH_H cell per character, as GFX drawChar() scales it."""
+    cells = []
+    for code in range(GLYPH_FIRST, GLYPH_LAST + 1):
+        glyph = columns[(code - GLYPH_FIRST) * 5:(code - GLYPH_FIRST + 1) * 5]
+        data = bytearray()
+        for y in range(GLYPH_H):
+            row = y // TEXT_SIZE
+            for x in range(0, GLYPH_W, 4):
+                b = 0
+                for i in range(4):
+                    col = (x + i) // TEXT_SIZE
+                    on = x + i < GLYPH_W and col < 5 and glyph[col] >> row & 1
+                    b = (b << 2) | (3 if on else 0)
+                data.append(b)
+        cells.append((code, data))
+    return cells
+
+
+def emit_atlas(source, cells):
+    with open(ATLAS_OUT, "w", newline="\n") as f:
+        f.write(f"// Auto-generated glyph atlas: Adafruit GFX 5x7 font (glcdfont.c) at size {TEXT_SIZE}\n")
+        f.write("// 2 bits of coverage per pixel, MSB first, rows padded to whole bytes\n")
+        f.write("#pragma once\n\n")
+        f.write("#include <stdint.h>\n")
+        f.write("#include <pgmspace.h>\n\n")
+        f.write("#define UI_GLYPH_ATLAS_AVAILABLE 1\n")
+        f.write(f"#define UI_GLYPH_W {GLYPH_W}\n")
+        f.write(f"#define UI_GLYPH_H {GLYPH_H}\n")
+        f.write(f"#define UI_GLYPH_FIRST 0x{GLYPH_FIRST:02X}\n")
+        f.write(f"#define UI_GLYPH_LAST 0x{GLYPH_LAST:02X}\n")
+        f.write(f"#define UI_GLYPH_BYTES {len(cells[0][1])}\n\n")
+        f.write("static const uint8_t UI_GLYPH_ATLAS[] PROGMEM = {\n")
+        for code, data in cells:
+            f.write(f"    // {chr(code)!r}\n    ")
+            f.write(", ".join(f"0x{b:02X}" for b in data))
+            f.write(",\n")
+        f.write("};\n")
+    print(f"[fa-gen] Wrote glyph atlas: {ATLAS_OUT} (font from {source})")
+
+
+def level_of(p):
+    """8-bit coverage to the 2-bit levels used by the atlases."""
+    return (p * 3 + 127) // 255
+
+
+def render_fa_icon(ttf, codepoint):
+    """Rows of 2-bit levels, ICON_H high and trimmed to the glyph's width."""
+    from PIL import Image, ImageDraw, ImageFont
+
+    big = ICON_H * 4
+    font = ImageFont.truetype(str(ttf), big)
+    img = Image.new("L", (big * 2, big * 2), 0)
+    ImageDraw.Draw(img).text((big // 2, big // 2), chr(codepoint), font=font, fill=255)
+    bbox = img.getbbox()
+    if not bbox:
+        return []
+    glyph = img.crop(bbox)
+    scale = min(ICON_H / glyph.height, ICON_MAX_W / glyph.width)
+    w = max(1, int(round(glyph.width * scale)))
+    h = max(1, int(round(glyph.height * scale)))
+    glyph = glyph.resize((w, h), Image.LANCZOS)
+    out = Image.new("L", (w, ICON_H), 0)
+    out.paste(glyph, (0, (ICON_H - h) // 2))
+    pix = out.load()
+    return [[level_of(pix[x, y]) for x in range(w)] for y in range(ICON_H)]
+
+
+def render_bars(lit):
+    """Four bottom-aligned bars of rising height; unlit ones stay faint."""
+    bar_w, gap, count = 3, 2, 4
+    w = count * bar_w + (count - 1) * gap
+    rows = [[0] * w for _ in range(ICON_H)]
+    for i in range(count):
+        top = ICON_H - (i + 1) * ICON_H // count
+        level = 3 if i < lit else 1
+        for y in range(top, ICON_H):
+            for x in range(i * (bar_w + gap), i * (bar_w + gap) + bar_w):
+                rows[y][x] = level
+    return rows
+
+
+def rle_encode(rows):
+    data = bytearray()
+    for row in rows:
+        x = 0
+        while x < len(row):
+            run = 1
+            while x + run < len(row) and row[x + run] == row[x] and run < RLE_MAX_RUN:
+                run += 1
+            data.append(row[x] << 6 | (run - 1))
+            x += run
+    return data
+
+
+def rle_decode(data, w, h):
+    """Mirror of the firmware decoder (UI forEachSpan) used to check the atlas."""
+    rows = [[0] * w for _ in range(h)]
+    pos = 0
+    for y in range(h):
+        x = 0
+        while x < w:
+            b = data[pos]
+            pos += 1
+            for i in range((b & 0x3F) + 1):
+                rows[y][x + i] = b >> 6
+            x += (b & 0x3F) + 1
+    return rows, pos
+
+
+def compile_icons():
+    fonts = {"solid": TTF_PATH, "brands": FA_BRANDS_TTF_PATH}
+    entries = []
+    renders = []
+    blob = bytearray()
+    for name, source, arg in ICONS:
+        if source == "bars":
+            rows = render_bars(arg)
+        elif fonts[source].exists():
+            rows = render_fa_icon(fonts[source], arg)
+        else:
+            print(f"[fa-gen] {fonts[source].name} missing; icon {name} left empty.")
+            rows = []
+        w = len(rows[0]) if rows else 0
+        h = len(rows) if w else 0
+        data = rle_encode(rows[:h])
+        decoded, used = rle_decode(data, w, h)
+        if decoded != rows[:h] or used != len(data):
+            raise RuntimeError(f"RLE round trip mismatch for {name}")
+        entries.append((name, len(blob), w, h, w * h))
+        renders.append(rows[:h])
+        blob += data
+    return entries, blob, renders
+
+
+def emit_icon_atlas(entries, blob):
+    raw = sum(e[4] for e in entries) // 4
+    with open(ICON_ATLAS_OUT, "w", newline="\n") as f:
+        f.write("// Auto-generated status icon atlas (Font Awesome Free, CC BY 4.0)\n")
+        f.write("// Rows of 2-bit coverage run-length coded as (level << 6 | run - 1),\n")
+        f.write(f"// runs never cross a row; {len(blob)} bytes vs {raw} packed\n")
+        f.write("#pragma once\n\n")
+        f.write("#include <stdint.h>\n")
+        f.write("#include <pgmspace.h>\n\n")
+        f.write("#define UI_ICON_ATLAS_AVAILABLE 1\n")
+        f.write(f"#define UI_ICON_MAX_W {ICON_MAX_W}\n")
+        f.write(f"#define UI_ICON_H {ICON_H}\n")
+        for i, (name, *_rest) in enumerate(entries):
+            f.write(f"#define UI_ICON_{name} {i}\n")
+        f.write(f"#define UI_ICON_COUNT {len(entries)}\n\n")
+        f.write("struct UiIcon {\n  uint16_t offset; // into UI_ICON_RLE\n  uint8_t w;\n  uint8_t h;\n};\n\n")
+        f.write("static const UiIcon UI_ICONS[] PROGMEM = {\n")
+        for name, offset, w, h, _ in entries:
+            f.write(f"    {{{offset}, {w}, {h}}}, // {name}\n")
+        f.write("};\n\n")
+        f.write("static const uint8_t UI_ICON_RLE[] PROGMEM = {\n")
+        for i in range(0, len(blob), 12):
+            f.write("    " + ", ".join(f"0x{b:02X}" for b in blob[i:i + 12]) + ",\n")
+        f.write("};\n")
+    print(f"[fa-gen] Wrote icon atlas: {ICON_ATLAS_OUT} ({len(blob)} bytes)")
+
+
+def emit_icon_renders(entries, renders):
+    """One digit (coverage level) per pixel, a string per icon, row by row."""
+    with open(ICON_RENDERS_OUT, "w", newline="\n") as f:
+        f.write("// Auto-generated renders behind ui_icon_atlas.h, for the host tests\n")
+        f.write("#pragma once\n\n")
+        f.write("static const char *const UI_ICON_RENDERS[] = {\n")
+        for (name, *_rest), rows in zip(entries, renders):
+            f.write(f"    // {name}\n")
+            if not rows:
+                f.write('    "",\n')
+                continue
+            for i, row in enumerate(rows):
+                end = ",\n" if i == len(rows) - 1 else "\n"
+                f.write('    "' + "".join(str(level) for level in row) + '"' + end)
+        f.write("};\n")
+    print(f"[fa-gen] Wrote icon renders: {ICON_RENDERS_OUT}")
+
+
+def gen_wifi_icon():
     if not TTF_PATH.exists():
         if not download_ttf():
             return
@@ -163,5 +461,38 @@ def main():
         print(f"[fa-gen] Generation failed: {e}")
 
 
+def gen_glyph_atlas():
+    try:
+        columns, source = glcdfont_columns()
+        emit_atlas(source, render_atlas(columns))
+    except Exception as e:
+        print(f"[fa-gen] Glyph atlas generation failed: {e}")
+
+
+def gen_icon_atlas():
+    if not TTF_PATH.exists() and not download_ttf():
+        print("[fa-gen] No Font Awesome TTF; band keeps the single Wi-Fi icon.")
+        return
+    if not FA_BRANDS_TTF_PATH.exists():
+        download_ttf(FA_BRANDS_TTF_URLS, FA_BRANDS_TTF_PATH)
+    try:
+        entries, blob, renders = compile_icons()
+        emit_icon_atlas(entries, blob)
+        emit_icon_renders(entries, renders)
+    except Exception as e:
+        print(f"[fa-gen] Icon atlas generation failed: {e}")
+
+
+def main():
+    # Try to prepare everything; on any failure, just skip (fallbacks used)
+    gen_glyph_atlas()
+    ok_pil = ensure_pillow()
+    if not ok_pil:
+        print("[fa-gen] Pillow missing; skipping FA icon generation.")
+        return
+    gen_wifi_icon()
+    gen_icon_atlas()
+
+
 main()
 
@@ -0,0 +1,63 @@
+# Write the WAV fixtures for the AudioDsp host tests (test/test_audio_dsp)
+# - 16-bit mono at the firmware's 12.5 kHz capture rate, four FFT frames
+# - Tones sit on bin centres (12.207 Hz per bin) so the expected band
+#   levels follow from the Hann window alone; the noise is seeded, so
+#   re-running the script reproduces the files byte for byte
+#
+# Usage:
+#   python scripts/make_audio_fixtures.py [--out test/test_audio_dsp/fixtures]
+
+import argparse
+import math
+import random
+import struct
+import wave
+from pathlib import Path
+
+RATE = 12500
+FFT_N = 1024
+SAMPLES = 4 * FFT_N
+BIN_HZ = RATE / FFT_N
+
+
+def tone(bin_index, dbfs):
+    amp = 10 ** (dbfs / 20)
+    return lambda n: amp * math.sin(2 * math.pi * bin_index * BIN_HZ * n / RATE)
+
+
+def write(path, fn):
+    frames = bytearray()
+    for n in range(SAMPLES):
+        v = max(-1.0, min(1.0, fn(n)))
+        frames += struct.pack("<h", max(-32768, min(32767, round(v * 32768))))
+    with wave.open(str(path), "wb") as w:
+        w.setnchannels(1)
+        w.setsampwidth(2)
+        w.setframerate(RATE)
+        w.writeframes(bytes(frames))
+    print(f"wrote {path}")
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--out", default="test/test_audio_dsp/fixtures")
+    out = Path(ap.parse_args().out)
+    out.mkdir(parents=True, exist_ok=True)
+
+    write(out / "silence.wav", lambda n: 0.0)
+    # Bin 22 (268.6 Hz), in the middle of s_bin244_293Hz
+    write(out / "tone_bin22_-6dbfs.wav", tone(22, -6))
+    # Bin 14 (170.9 Hz, s_bin146_195Hz) 20 dB above bin 38 (463.9 Hz, s_bin439_488Hz)
+    a, b = tone(14, -6), tone(38, -26)
+    write(out / "two_tone.wav", lambda n: a(n) + b(n))
+    rng = random.Random(1)
+    noise = [rng.uniform(-0.25, 0.25) for _ in range(SAMPLES)]
+    write(out / "white_noise.wav", lambda n: noise[n])
+    # Worker buzz: 250 Hz fundamental with falling harmonics over noise
+    rng = random.Random(2)
+    hiss = [rng.gauss(0, 0.01) for _ in range(SAMPLES)]
+    write(out / "hive_buzz.wav", lambda n: sum(0.3 / k * math.sin(2 * math.pi * 250 * k * n / RATE)
+                                               for k in (1, 2, 3)) + hiss[n])
+
+
+main()
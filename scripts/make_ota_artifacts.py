@@ -0,0 +1,147 @@
+# Produce compressed and delta OTA artifacts for a firmware release
+# - firmware.bin.gz: gzip of the full image (decoded on-device by OtaDecode::GzipDecoder)
+# - firmware-from-<ver>.hsd.gz: gzip of an HSD1 delta against an older image
+#   (applied on-device against the running slot by OtaDecode::DeltaDecoder)
+# Every artifact is decoded again here and compared byte for byte with the
+# target image before the script reports success.
+#
+# Usage:
+#   python scripts/make_ota_artifacts.py --firmware .pio/build/<env>/firmware.bin \
+#       --out dist [--base 0.1.0=prev/firmware.bin ...]
+
+import argparse
+import gzip
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+MAGIC = b"HSD1"
+OP_END = 0x00
+OP_COPY = 0x01
+OP_ADD = 0x02
+
+BLOCK = 32        # match key length
+STRIDE = 16       # source index granularity
+MIN_COPY = 24     # shorter matches are cheaper as literals
+
+
+def crc32(data):
+    return zlib.crc32(data) & 0xFFFFFFFF
+
+
+def make_delta(source, target):
+    """Greedy block-matching diff producing HSD1 COPY/ADD ops."""
+    index = {}
+    for pos in range(0, len(source) - BLOCK + 1, STRIDE):
+        index.setdefault(source[pos:pos + BLOCK], pos)
+
+    ops = bytearray()
+    literal_start = 0
+    i = 0
+    n = len(target)
+
+    def flush_literal(end):
+        if end > literal_start:
+            ops.append(OP_ADD)
+            ops.extend(struct.pack("<I", end - literal_start))
+            ops.extend(target[literal_start:end])
+
+    while i + BLOCK <= n:
+        src = index.get(target[i:i + BLOCK])
+        if src is None:
+            i += 1
+            continue
+        # Extend the match backwards into pending literals and forwards
+        back = 0
+        while back < i - literal_start and src - back > 0 and source[src - back - 1] == target[i - back - 1]:
+            back += 1
+        length = BLOCK
+        while i + length < n and src + length < len(source) and source[src + length] == target[i + length]:
+            length += 1
+        start, src_start, length = i - back, src - back, length + back
+        if length < MIN_COPY:
+            i += 1
+            continue
+        flush_literal(start)
+        ops.append(OP_COPY)
+        ops += struct.pack("<II", src_start, length)
+        i = start + length
+        literal_start = i
+
+    flush_literal(n)
+    ops.append(OP_END)
+    header = MAGIC + struct.pack("<IIII", len(source), crc32(source), len(target), crc32(target))
+    return header + bytes(ops)
+
+
+def apply_delta(source, patch):
+    """Reference decoder mirroring OtaDecode::DeltaDecoder."""
+    if patch[:4] != MAGIC:
+        raise ValueError("bad magic")
+    src_size, src_crc, dst_size, dst_crc = struct.unpack_from("<IIII", patch, 4)
+    if src_size != len(source) or crc32(source) != src_crc:
+        raise ValueError("base mismatch")
+    out = bytearray()
+    p = 20
+    while True:
+        op = patch[p]
+        p += 1
+        if op == OP_END:
+            break
+        if op == OP_COPY:
+            off, length = struct.unpack_from("<II", patch, p)
+            p += 8
+            out += source[off:off + length]
+        elif op == OP_ADD:
+            (length,) = struct.unpack_from("<I", patch, p)
+            p += 4
+            out += patch[p:p + length]
+            p += length
+        else:
+            raise ValueError(f"bad opcode {op}")
+    if p != len(patch) or len(out) != dst_size or crc32(out) != dst_crc:
+        raise ValueError("output mismatch")
+    return bytes(out)
+
+
+def gz(data):
+    # mtime=0 and no file name keep the artifact reproducible
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Build compressed and delta OTA artifacts")
+    ap.add_argument("--firmware", required=True, type=Path, help="new firmware.bin")
+    ap.add_argument("--out", required=True, type=Path, help="output directory")
+    ap.add_argument("--name", default="firmware.bin", help="asset name of the full image")
+    ap.add_argument("--base", action="append", default=[], metavar="VERSION=PATH",
+                    help="older release image to build a delta from (repeatable)")
+    args = ap.parse_args()
+
+    target = args.firmware.read_bytes()
+    args.out.mkdir(parents=True, exist_ok=True)
+
+    full_gz = gz(target)
+    if gzip.decompress(full_gz) != target:
+        sys.exit("[ota-art] gzip round trip failed")
+    gz_path = args.out / f"{args.name}.gz"
+    gz_path.write_bytes(full_gz)
+    print(f"[ota-art] {gz_path.name}: {len(target)} -> {len(full_gz)} bytes")
+
+    for spec in args.base:
+        version, _, path = spec.partition("=")
+        if not version or not path:
+            sys.exit(f"[ota-art] bad --base '{spec}', expected VERSION=PATH")
+        source = Path(path).read_bytes()
+        patch = make_delta(source, target)
+        patch_gz = gz(patch)
+        if apply_delta(source, gzip.decompress(patch_gz)) != target:
+            sys.exit(f"[ota-art] delta from {version} does not rebuild the image")
+        delta_path = args.out / f"firmware-from-{version}.hsd.gz"
+        delta_path.write_bytes(patch_gz)
+        print(f"[ota-art] {delta_path.name}: {len(target)} -> {len(patch_gz)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,146 @@
+// Hive sound capture implementation
+//
+// The microphone runs only during a capture. I2S DMA fills four 512-sample
+// buffers in turn, two FFT frames' worth, so one frame is being
+// transformed while the next is still arriving. Samples are 24-bit
+// left-justified in 32-bit slots and are cut down to Q15 with a fixed gain.
+// The averaged band energies go to Measurements from the audio task.
+
+#include <Arduino.h>
+
+#include "audio.h"
+#include "audio_dsp.h"
+#include "measurement.h"
+#include "trace.h"
+
+#define HS_LOG_PREFIX "AUDIO"
+#include "debug.h"
+
+#if HS_AUDIO
+#include <driver/i2s.h>
+#endif
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+// Microphone wiring, defaults are the Feather's A0/A1/A2
+#ifndef AUDIO_I2S_BCLK
+#define AUDIO_I2S_BCLK 18
+#endif
+#ifndef AUDIO_I2S_WS
+#define AUDIO_I2S_WS 17
+#endif
+#ifndef AUDIO_I2S_DIN
+#define AUDIO_I2S_DIN 16
+#endif
+// Right shift from the 32-bit slot to Q15; smaller is louder
+#ifndef AUDIO_GAIN_SHIFT
+#define AUDIO_GAIN_SHIFT 14
+#endif
+// FFT frames averaged per capture (82 ms each)
+#ifndef AUDIO_FRAMES
+#define AUDIO_FRAMES 64
+#endif
+// Core of the capture task; pinned so its trace spans read one cycle counter
+#ifndef AUDIO_TASK_CORE
+#define AUDIO_TASK_CORE 1
+#endif
+
+namespace Audio {
+
+#if HS_AUDIO
+
+static const i2s_port_t PORT = I2S_NUM_0;
+static const uint16_t DMA_LEN = 512;       // samples per DMA buffer
+static const uint8_t DMA_COUNT = 4;
+static const uint8_t SETTLE_FRAMES = 2;    // microphone start-up, discarded
+static const uint16_t READ_CHUNK = 256;
+
+static TaskHandle_t s_task = nullptr;
+static int16_t s_work[2 * AudioDsp::FFT_N]; // frame in the first half, then FFT in place
+
+// Fill s_work's first half with one frame of Q15 samples
+static bool readFrame() {
+  int32_t raw[READ_CHUNK];
+  for (uint16_t done = 0; done < AudioDsp::FFT_N; done += READ_CHUNK) {
+    size_t got = 0;
+    if (i2s_read(PORT, raw, sizeof(raw), &got, pdMS_TO_TICKS(500)) != ESP_OK || got != sizeof(raw)) return false;
+    for (uint16_t i = 0; i < READ_CHUNK; ++i) {
+      int32_t s = raw[i] >> AUDIO_GAIN_SHIFT;
+      s_work[done + i] = (int16_t)(s > 32767 ? 32767 : s < -32768 ? -32768 : s);
+    }
+  }
+  return true;
+}
+
+static void audioTask(void *) {
+  AudioDsp::BandEnergy energy;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    i2s_zero_dma_buffer(PORT);
+    i2s_start(PORT);
+    energy.reset();
+    bool ok = true;
+    for (uint16_t f = 0; ok && f < SETTLE_FRAMES + AUDIO_FRAMES; ++f) {
+      ok = readFrame();
+      if (!ok || f < SETTLE_FRAMES) continue;
+      TRACE_SPAN("audio.frame");
+      energy.addFrame(s_work, s_work);
+    }
+    i2s_stop(PORT);
+    if (!ok) {
+      LOGLN("I2S read failed, capture dropped");
+      continue;
+    }
+
+    uint16_t bands[AudioDsp::BANDS], total;
+    energy.result(bands, total);
+    for (uint8_t b = 0; b < AudioDsp::BANDS; ++b) Measurements::publish(AudioDsp::bandKey(b), bands[b]);
+    Measurements::publish("s_tot", total);
+    LOGF("Captured %u frames, s_tot=%u\n", (unsigned)energy.frames(), (unsigned)total);
+  }
+}
+
+bool begin() {
+  AudioDsp::begin();
+
+  i2s_config_t config = {};
+  config.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX);
+  config.sample_rate = AudioDsp::SAMPLE_RATE;
+  config.bits_per_sample = I2S_BITS_PER_SAMPLE_32BIT;
+  config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT; // L/R pin tied low
+  config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+  config.intr_alloc_flags = ESP_INTR_FLAG_LEVEL1;
+  config.dma_buf_count = DMA_COUNT;
+  config.dma_buf_len = DMA_LEN;
+
+  i2s_pin_config_t pins = {};
+  pins.mck_io_num = I2S_PIN_NO_CHANGE;
+  pins.bck_io_num = AUDIO_I2S_BCLK;
+  pins.ws_io_num = AUDIO_I2S_WS;
+  pins.data_out_num = I2S_PIN_NO_CHANGE;
+  pins.data_in_num = AUDIO_I2S_DIN;
+
+  if (i2s_driver_install(PORT, &config, 0, nullptr) != ESP_OK || i2s_set_pin(PORT, &pins) != ESP_OK) {
+    LOGLN("I2S init failed");
+    return false;
+  }
+  i2s_stop(PORT); // runs only while capturing
+  xTaskCreatePinnedToCore(audioTask, "audio", 4096, nullptr, 1, &s_task, AUDIO_TASK_CORE);
+  LOGF("Microphone on BCLK=%d WS=%d DIN=%d\n", AUDIO_I2S_BCLK, AUDIO_I2S_WS, AUDIO_I2S_DIN);
+  return true;
+}
+
+void capture() {
+  if (s_task) xTaskNotifyGive(s_task);
+}
+
+#else
+
+bool begin() {
+  return false;
+}
+
+void capture() {}
+
+#endif // HS_AUDIO
+
+} // namespace Audio
@@ -0,0 +1,144 @@
+// Sound band energy implementation
+//
+// Frames are Hann-windowed in Q15 and transformed as complex data with a
+// zero imaginary part; only the 40 bins of the BEEP bands are read back.
+// Per-stage 1/2 scaling keeps every butterfly inside int16, so a
+// full-scale sine peaks at 8192 (A/2 from the two-sided spectrum, /2 from
+// the window gain) and its bin power of 2^26 is the 0 dB reference.
+
+#include <math.h>
+#include <string.h>
+
+#include "audio_dsp.h"
+
+#if defined(ESP_PLATFORM) && __has_include("esp_dsp.h")
+#include "esp_dsp.h"
+#define AUDIO_DSP_ESP 1
+#else
+#define AUDIO_DSP_ESP 0
+#endif
+
+namespace AudioDsp {
+
+static const uint8_t BAND_FIRST_BIN = 8;
+static const uint8_t BINS_PER_BAND = 4;
+static const float FULL_SCALE_POWER = 67108864.0f; // 2^26
+static const float DB_OFFSET = 100.0f;
+
+static int16_t s_window[FFT_N];
+#if !AUDIO_DSP_ESP
+static int16_t s_twiddle[FFT_N]; // cos, -sin pairs for k < N/2
+#endif
+static bool s_ready = false;
+
+static const char *const BAND_KEYS[BANDS] = {
+  "s_bin098_146Hz", "s_bin146_195Hz", "s_bin195_244Hz", "s_bin244_293Hz", "s_bin293_342Hz",
+  "s_bin342_391Hz", "s_bin391_439Hz", "s_bin439_488Hz", "s_bin488_537Hz", "s_bin537_586Hz",
+};
+
+static int16_t q15(float v) {
+  float s = v * 32768.0f;
+  return (int16_t)(s > 32767.0f ? 32767 : s < -32768.0f ? -32768 : lrintf(s));
+}
+
+void begin() {
+  if (s_ready) return;
+  for (uint16_t i = 0; i < FFT_N; ++i) {
+    s_window[i] = q15(0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / FFT_N));
+  }
+#if AUDIO_DSP_ESP
+  dsps_fft2r_init_sc16(nullptr, FFT_N);
+#else
+  for (uint16_t k = 0; k < FFT_N / 2; ++k) {
+    float a = 2.0f * (float)M_PI * k / FFT_N;
+    s_twiddle[2 * k] = q15(cosf(a));
+    s_twiddle[2 * k + 1] = q15(-sinf(a));
+  }
+#endif
+  s_ready = true;
+}
+
+#if AUDIO_DSP_ESP
+void fft(int16_t *data) {
+  dsps_fft2r_sc16(data, FFT_N); // picks the S3 vector version when built for it
+  dsps_bit_rev_sc16_ansi(data, FFT_N);
+}
+#else
+void fft(int16_t *data) {
+  // Bit-reverse permutation
+  for (uint16_t i = 1, j = 0; i < FFT_N; ++i) {
+    uint16_t bit = FFT_N >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j |= bit;
+    if (i < j) {
+      int16_t re = data[2 * i], im = data[2 * i + 1];
+      data[2 * i] = data[2 * j];
+      data[2 * i + 1] = data[2 * j + 1];
+      data[2 * j] = re;
+      data[2 * j + 1] = im;
+    }
+  }
+  // Decimation-in-time butterflies, halving every stage
+  for (uint16_t half = 1, step = FFT_N / 2; half < FFT_N; half <<= 1, step >>= 1) {
+    for (uint16_t k = 0; k < half; ++k) {
+      int16_t wr = s_twiddle[2 * k * step], wi = s_twiddle[2 * k * step + 1];
+      for (uint16_t i = k; i < FFT_N; i += 2 * half) {
+        int16_t *a = data + 2 * i, *b = data + 2 * (i + half);
+        int32_t tr = ((int32_t)b[0] * wr - (int32_t)b[1] * wi + (1 << 14)) >> 15;
+        int32_t ti = ((int32_t)b[0] * wi + (int32_t)b[1] * wr + (1 << 14)) >> 15;
+        int32_t ar = a[0], ai = a[1];
+        a[0] = (int16_t)((ar + tr) >> 1);
+        a[1] = (int16_t)((ai + ti) >> 1);
+        b[0] = (int16_t)((ar - tr) >> 1);
+        b[1] = (int16_t)((ai - ti) >> 1);
+      }
+    }
+  }
+}
+#endif
+
+void BandEnergy::reset() {
+  memset(_power, 0, sizeof(_power));
+  _frames = 0;
+}
+
+void BandEnergy::addFrame(const int16_t *samples, int16_t *work) {
+  // Back to front, so samples may share work's first half
+  for (int16_t i = FFT_N - 1; i >= 0; --i) {
+    work[2 * i] = (int16_t)(((int32_t)samples[i] * s_window[i]) >> 15);
+    work[2 * i + 1] = 0;
+  }
+  fft(work);
+  for (uint8_t b = 0; b < BANDS; ++b) {
+    uint64_t sum = 0;
+    for (uint8_t k = 0; k < BINS_PER_BAND; ++k) {
+      uint16_t bin = BAND_FIRST_BIN + b * BINS_PER_BAND + k;
+      int32_t re = work[2 * bin], im = work[2 * bin + 1];
+      sum += (uint32_t)(re * re) + (uint32_t)(im * im);
+    }
+    _power[b] += sum;
+  }
+  _frames++;
+}
+
+static uint16_t toDb(float power) {
+  if (power <= 0) return 0;
+  float db = 10.0f * log10f(power / FULL_SCALE_POWER) + DB_OFFSET;
+  return db > 0 ? (uint16_t)lrintf(db) : 0;
+}
+
+void BandEnergy::result(uint16_t bands[BANDS], uint16_t &total) const {
+  float sum = 0;
+  for (uint8_t b = 0; b < BANDS; ++b) {
+    float mean = _frames ? (float)_power[b] / _frames : 0;
+    bands[b] = toDb(mean);
+    sum += mean;
+  }
+  total = toDb(sum);
+}
+
+const char *bandKey(uint8_t band) {
+  return band < BANDS ? BAND_KEYS[band] : "";
+}
+
+} // namespace AudioDsp
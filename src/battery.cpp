@@ -1,58 +1,249 @@
 // Battery fuel gauge (MAX17048/49) module
+//
+// The gauge raises ALRT on a 1% SoC change, on low cell voltage and after
+// a gauge reset, so the SoC is only read when it moved. With the ALRT pin
+// wired (HS_GAUGE_ALERT_PIN) the interrupt triggers the battery job;
+// without it a single CONFIG read per poll checks the alert bit. A slow
+// heartbeat samples CRATE for the time-to-empty / time-to-full forecast.
 
 #include <Arduino.h>
 #include <Wire.h>
 #include <Adafruit_MAX1704X.h>
 
 #include "battery.h"
+#include "measurement.h"
+#include "trace.h"
 
 #define HS_LOG_PREFIX "BATT"
 #include "debug.h"
 
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+// GPIO wired to the gauge's open-drain ALRT output, -1 = poll the alert bit
+#ifndef HS_GAUGE_ALERT_PIN
+#define HS_GAUGE_ALERT_PIN -1
+#endif
+// Low-voltage alert threshold (mV)
+#ifndef BATT_LOW_MV
+#define BATT_LOW_MV 3450
+#endif
+
 namespace Battery {
 
+static const uint8_t GAUGE_ADDR = MAX17048_I2CADDR_DEFAULT;
+static const uint8_t REG_SOC = 0x04;
+static const uint8_t REG_CONFIG = 0x0C;
+static const uint8_t REG_STATUS = 0x1A;
+static const uint16_t CONFIG_ALSC = 0x0040;    // alert on 1% SoC change
+static const uint16_t CONFIG_ALRT = 0x0020;    // alert asserted
+static const uint16_t STATUS_ENVR = 0x4000;    // alert on voltage reset
+static const uint16_t LOW_HYSTERESIS_MV = 100; // re-arm the low alert above this
+static const uint32_t POLL_MS = 5000;          // alert-bit poll without the pin
+static const uint32_t RATE_MS = 60000;         // CRATE sample period
+static const float RATE_ALPHA = 0.25f;         // EMA weight of a new CRATE sample
+static const float TREND_ENTER = 0.5f;         // %/h to call it charging/discharging
+static const float TREND_LEAVE = 0.2f;         // %/h to fall back to idle
+
 static Adafruit_MAX17048 s_gauge;
 static bool s_found = false;
 static int s_percent = -1; // last known percent
-static uint32_t s_lastUpdate = 0;
+static uint32_t s_lastRate = 0;
+static bool s_lowArmed = true;
+#if HS_GAUGE_ALERT_PIN >= 0
+static volatile bool s_alertPending = false;
+#endif
+static Scheduler::JobId s_alertJob = -1;
+
+static float s_rate = 0;       // smoothed %/h
+static bool s_rateValid = false;
+static Trend s_trend = Trend::Idle;
+
+static bool readReg(uint8_t reg, uint16_t &value) {
+  Wire.beginTransmission(GAUGE_ADDR);
+  Wire.write(reg);
+  if (Wire.endTransmission(false) != 0) return false;
+  if (Wire.requestFrom(GAUGE_ADDR, (uint8_t)2) != 2) return false;
+  value = (uint16_t)Wire.read() << 8;
+  value |= (uint8_t)Wire.read();
+  return true;
+}
+
+static bool writeReg(uint8_t reg, uint16_t value) {
+  Wire.beginTransmission(GAUGE_ADDR);
+  Wire.write(reg);
+  Wire.write((uint8_t)(value >> 8));
+  Wire.write((uint8_t)value);
+  return Wire.endTransmission() == 0;
+}
+
+// SOC is 1/256 % per bit; round to whole percent without float math
+static bool readPercent() {
+  uint16_t raw;
+  if (!readReg(REG_SOC, raw)) return false;
+  int ip = (raw + 128) >> 8;
+  if (ip > 100) ip = 100;
+  if (ip == s_percent) return false;
+  s_percent = ip;
+  LOGF("Percent changed -> %d\n", s_percent);
+  return true;
+}
+
+static void armLowAlert(bool armed) {
+  s_lowArmed = armed;
+  // VALRT max at 5.1 V never trips; min 0 disables the low alert
+  s_gauge.setAlertVoltages(armed ? BATT_LOW_MV / 1000.0f : 0.0f, 5.1f);
+}
+
+static void configure() {
+  uint16_t config, status;
+  if (readReg(REG_CONFIG, config)) writeReg(REG_CONFIG, (config | CONFIG_ALSC) & ~CONFIG_ALRT);
+  if (readReg(REG_STATUS, status)) writeReg(REG_STATUS, STATUS_ENVR); // also clears the flags
+  armLowAlert(true);
+}
+
+#if HS_GAUGE_ALERT_PIN >= 0
+static void IRAM_ATTR onAlertPin() {
+  s_alertPending = true;
+  Scheduler::triggerFromISR(s_alertJob);
+}
+#endif
+
+// Read and acknowledge the gauge flags; returns true if SoC may have moved
+static bool serviceAlert() {
+  uint16_t status, config;
+  if (!readReg(REG_STATUS, status)) return false;
+  uint8_t flags = status >> 8;
+  if (flags & MAX1704X_ALERTFLAG_RESET_INDICATOR) {
+    // Power-on reset of the gauge: configuration is back to defaults
+    LOGLN("Gauge reset, reconfiguring");
+    configure();
+    return true;
+  }
+  if (flags & MAX1704X_ALERTFLAG_VOLTAGE_RESET) {
+    LOGLN("Cell voltage reset (battery swapped?)");
+    s_rateValid = false;
+    s_trend = Trend::Idle;
+  }
+  if (flags & MAX1704X_ALERTFLAG_VOLTAGE_LOW) {
+    float v = s_gauge.cellVoltage();
+    LOGF("Low cell voltage: %.3f V\n", v);
+    if (isfinite(v)) Measurements::publish("bv", v);
+    // Stays low for a while; disarm until the cell recovers
+    armLowAlert(false);
+  }
+  writeReg(REG_STATUS, status & STATUS_ENVR);
+  if (readReg(REG_CONFIG, config)) writeReg(REG_CONFIG, config & ~CONFIG_ALRT);
+  return true;
+}
+
+// EMA over CRATE samples, with separate enter/leave thresholds so the trend
+// does not flap around zero
+static void updateRate() {
+  float r = s_gauge.chargeRate();
+  if (!isfinite(r)) return;
+  s_rate = s_rateValid ? s_rate + RATE_ALPHA * (r - s_rate) : r;
+  s_rateValid = true;
+
+  Trend t = s_trend;
+  switch (s_trend) {
+    case Trend::Idle:
+      if (s_rate >= TREND_ENTER) t = Trend::Charging;
+      else if (s_rate <= -TREND_ENTER) t = Trend::Discharging;
+      break;
+    case Trend::Charging:
+      if (s_rate < TREND_LEAVE) t = s_rate <= -TREND_ENTER ? Trend::Discharging : Trend::Idle;
+      break;
+    case Trend::Discharging:
+      if (s_rate > -TREND_LEAVE) t = s_rate >= TREND_ENTER ? Trend::Charging : Trend::Idle;
+      break;
+  }
+  if (t != s_trend) {
+    s_trend = t;
+    LOGF("Trend %s at %.2f %%/h\n", t == Trend::Charging ? "charging" : t == Trend::Discharging ? "discharging" : "idle",
+         s_rate);
+  }
+
+  if (!s_lowArmed) {
+    float v = s_gauge.cellVoltage();
+    if (isfinite(v) && v * 1000.0f > BATT_LOW_MV + LOW_HYSTERESIS_MV) armLowAlert(true);
+  }
+}
 
 bool begin() {
   // Ensure I2C is initialized; use default pins from the board variant
   Wire.begin();
   // Try to initialize the gauge at default address 0x36
   s_found = s_gauge.begin();
-  // First read if available
   if (s_found) {
-    float p = s_gauge.cellPercent();
-    if (isfinite(p)) {
-      int ip = (int)(p + 0.5f);
-      if (ip < 0) ip = 0; if (ip > 100) ip = 100;
-      s_percent = ip;
-    }
-  }
-  LOGLN(String("Gauge ") + (s_found ? "found" : "not found"));
+    configure();
+    readPercent();
+    updateRate();
+    s_lastRate = millis();
+#if HS_GAUGE_ALERT_PIN >= 0
+    pinMode(HS_GAUGE_ALERT_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(HS_GAUGE_ALERT_PIN), onAlertPin, FALLING);
+#endif
+  }
+  LOGF("Gauge %s\n", s_found ? "found" : "not found");
   if (s_found) LOGF("Initial percent=%d\n", s_percent);
   return s_found;
 }
 
 void update() {
   if (!s_found) return;
-  uint32_t now = millis();
-  if (now - s_lastUpdate < 2000) return; // rate-limit
-  s_lastUpdate = now;
+  TRACE_SPAN("batt.update");
 
-  float p = s_gauge.cellPercent();
-  if (!isfinite(p)) return;
-  int ip = (int)(p + 0.5f);
-  if (ip < 0) ip = 0; if (ip > 100) ip = 100;
-  if (ip != s_percent) {
-    s_percent = ip;
-    LOGF("Percent changed -> %d\n", s_percent);
+#if HS_GAUGE_ALERT_PIN >= 0
+  bool alert = s_alertPending || digitalRead(HS_GAUGE_ALERT_PIN) == LOW;
+  s_alertPending = false;
+#else
+  uint16_t config;
+  bool alert = readReg(REG_CONFIG, config) && (config & CONFIG_ALRT);
+#endif
+  if (alert && serviceAlert() && readPercent()) {
+    // Report the cell voltage to BEEP ("bv") whenever the SoC moves
+    float v = s_gauge.cellVoltage();
+    if (isfinite(v)) Measurements::publish("bv", v);
+  }
+
+  uint32_t now = millis();
+  if (now - s_lastRate >= RATE_MS) {
+    s_lastRate = now;
+    updateRate();
   }
 }
 
+uint32_t pollIntervalMs() {
+  return HS_GAUGE_ALERT_PIN >= 0 ? RATE_MS : POLL_MS;
+}
+
+void setAlertJob(Scheduler::JobId id) {
+  s_alertJob = id;
+}
+
 int percent() {
   return s_percent;
 }
 
+float voltage() {
+  return s_found ? s_gauge.cellVoltage() : NAN;
+}
+
+Trend trend() {
+  return s_trend;
+}
+
+float chargeRate() {
+  return s_rateValid ? s_rate : 0.0f;
+}
+
+int32_t minutesToEmpty() {
+  if (s_trend != Trend::Discharging || s_percent < 0) return -1;
+  return (int32_t)(s_percent * 60.0f / -s_rate);
+}
+
+int32_t minutesToFull() {
+  if (s_trend != Trend::Charging || s_percent < 0) return -1;
+  return (int32_t)((100 - s_percent) * 60.0f / s_rate);
+}
+
 } // namespace Battery
@@ -0,0 +1,149 @@
+// BLE advertisement decoder implementation
+//
+// Walks the AD structures once and dispatches on service data UUID or
+// manufacturer ID. Everything works on the caller's buffer with fixed-size
+// tables, so decoding an advertisement costs a few hundred cycles and no
+// allocation.
+
+#include "ble_adv.h"
+
+namespace BleAdv {
+
+static const uint8_t AD_SERVICE_DATA16 = 0x16;
+static const uint8_t AD_MANUFACTURER = 0xFF;
+static const uint16_t UUID_BTHOME = 0xFCD2;
+static const uint16_t UUID_ENV_SENSING = 0x181A; // pvvx / ATC custom firmware
+static const uint16_t COMPANY_RUUVI = 0x0499;
+
+static const uint8_t VAR = 0xFF; // length-prefixed object
+
+// BTHome v2 object sizes by ID (0 = unknown: the rest cannot be parsed)
+static const uint8_t BTHOME_SIZE[] = {
+  1, 1, 2, 2, 3, 3, 2, 2, 2, 1, 3, 3, 2, 2, 2, 1,       // 0x00
+  1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,       // 0x10
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,       // 0x20
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 2, 2, 4, 2,       // 0x30
+  2, 2, 3, 2, 2, 2, 1, 2, 2, 2, 2, 3, 4, 4, 4, 4,       // 0x40
+  4, 2, 2, VAR, VAR, 4, 2, 1, 1, 1, 2, 4, 4, 2, 2, 2,   // 0x50
+  1,                                                    // 0x60
+};
+
+static int32_t le(const uint8_t *p, uint8_t n, bool sign) {
+  uint32_t v = 0;
+  for (uint8_t i = 0; i < n; ++i) v |= (uint32_t)p[i] << (8 * i);
+  if (sign && n < 4 && (v & (1UL << (8 * n - 1)))) v |= ~0UL << (8 * n);
+  return (int32_t)v;
+}
+
+static uint16_t be16(const uint8_t *p) {
+  return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+struct Out {
+  Reading *buf;
+  uint8_t max;
+  uint8_t n;
+
+  void add(Kind kind, float value) {
+    if (n < max) buf[n++] = Reading{kind, value};
+  }
+};
+
+static void bthome(const uint8_t *p, uint8_t len, Out &out) {
+  if (len < 1) return;
+  uint8_t info = p[0];
+  if ((info & 0x01) || (info >> 5) != 2) return; // encrypted or not v2
+  uint8_t pos = 1;
+  while (pos < len) {
+    uint8_t id = p[pos++];
+    if (id >= sizeof(BTHOME_SIZE) || BTHOME_SIZE[id] == 0) return;
+    uint8_t size = BTHOME_SIZE[id];
+    if (size == VAR) {
+      if (pos >= len) return;
+      size = 1 + p[pos];
+    }
+    if (pos + size > len) return;
+    const uint8_t *v = p + pos;
+    switch (id) {
+      case 0x02: out.add(Kind::Temperature, le(v, 2, true) * 0.01f); break;
+      case 0x03: out.add(Kind::Humidity, le(v, 2, false) * 0.01f); break;
+      case 0x04: out.add(Kind::Pressure, le(v, 3, false) * 0.01f); break;
+      case 0x05: out.add(Kind::Light, le(v, 3, false) * 0.01f); break;
+      case 0x06: out.add(Kind::WeightKg, le(v, 2, false) * 0.01f); break;
+      case 0x07: out.add(Kind::WeightKg, le(v, 2, false) * 0.01f * 0.45359237f); break; // lb
+      case 0x0C: out.add(Kind::BatteryVolts, le(v, 2, false) * 0.001f); break;
+      case 0x2E: out.add(Kind::Humidity, v[0]); break;
+      case 0x45: out.add(Kind::Temperature, le(v, 2, true) * 0.1f); break;
+      case 0x4A: out.add(Kind::BatteryVolts, le(v, 2, false) * 0.1f); break;
+      case 0x57: out.add(Kind::Temperature, (int8_t)v[0]); break;
+      case 0x58: out.add(Kind::Temperature, (int8_t)v[0] * 0.35f); break;
+      default: break;
+    }
+    pos += size;
+  }
+}
+
+// pvvx "custom" (15 bytes, little-endian) and ATC1441 (13 bytes, big-endian)
+static void envSensing(const uint8_t *p, uint8_t len, Out &out) {
+  if (len == 15) {
+    out.add(Kind::Temperature, le(p + 6, 2, true) * 0.01f);
+    out.add(Kind::Humidity, le(p + 8, 2, false) * 0.01f);
+    out.add(Kind::BatteryVolts, le(p + 10, 2, false) * 0.001f);
+  } else if (len == 13) {
+    out.add(Kind::Temperature, (int16_t)be16(p + 6) * 0.1f);
+    out.add(Kind::Humidity, p[8]);
+    out.add(Kind::BatteryVolts, be16(p + 10) * 0.001f);
+  }
+}
+
+// Ruuvi data format 5; all-ones (or 0x8000) fields mean "not available"
+static void ruuvi(const uint8_t *p, uint8_t len, Out &out) {
+  if (len < 24 || p[0] != 5) return;
+  uint16_t t = be16(p + 1), h = be16(p + 3), pr = be16(p + 5), power = be16(p + 13);
+  if (t != 0x8000) out.add(Kind::Temperature, (int16_t)t * 0.005f);
+  if (h != 0xFFFF) out.add(Kind::Humidity, h * 0.0025f);
+  if (pr != 0xFFFF) out.add(Kind::Pressure, (pr + 50000UL) * 0.01f);
+  if ((power >> 5) != 0x7FF) out.add(Kind::BatteryVolts, ((power >> 5) + 1600) * 0.001f);
+}
+
+uint8_t decode(const uint8_t *data, uint8_t len, Reading *out, uint8_t max) {
+  Out o = {out, max, 0};
+  uint8_t pos = 0;
+  while (pos + 1 < len) {
+    uint8_t adLen = data[pos];
+    if (adLen == 0 || pos + 1 + adLen > len) break; // padding or truncated
+    uint8_t type = data[pos + 1];
+    const uint8_t *p = data + pos + 2;
+    uint8_t n = adLen - 1;
+    if (type == AD_SERVICE_DATA16 && n >= 2) {
+      uint16_t uuid = (uint16_t)(p[0] | p[1] << 8);
+      if (uuid == UUID_BTHOME) bthome(p + 2, n - 2, o);
+      else if (uuid == UUID_ENV_SENSING) envSensing(p + 2, n - 2, o);
+    } else if (type == AD_MANUFACTURER && n >= 2) {
+      uint16_t company = (uint16_t)(p[0] | p[1] << 8);
+      if (company == COMPANY_RUUVI) ruuvi(p + 2, n - 2, o);
+    }
+    pos += 1 + adLen;
+  }
+  return o.n;
+}
+
+const char *beepKey(Kind kind) {
+  switch (kind) {
+    case Kind::Temperature:  return "t";
+    case Kind::Humidity:     return "h";
+    case Kind::Pressure:     return "p";
+    case Kind::Light:        return "l";
+    case Kind::WeightKg:     return "weight_kg";
+    case Kind::BatteryVolts: return "bv";
+  }
+  return "";
+}
+
+uint32_t hash(const uint8_t *data, uint8_t len) {
+  uint32_t h = 2166136261UL;
+  for (uint8_t i = 0; i < len; ++i) h = (h ^ data[i]) * 16777619UL;
+  return h;
+}
+
+} // namespace BleAdv
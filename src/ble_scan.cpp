@@ -0,0 +1,220 @@
+// Passive BLE tag scanner
+//
+// Scanning runs continuously once Wi-Fi is up and BLE provisioning has
+// released the radio, in short windows so Wi-Fi keeps most of the airtime.
+// Advertisements arrive on the Bluetooth host task; a payload identical to
+// the tag's previous one is dropped after a hash compare, anything else is
+// decoded into the tag's slot in a fixed open-addressed table keyed by MAC.
+// The loop task publishes pending readings, at most once per tag per
+// BLE_PUBLISH_S, so chatty tags cannot flood storage or the uploader.
+
+#include <Arduino.h>
+#include <WiFi.h> // arduino_event_t for provisioning.h
+
+#include "ble_scan.h"
+#include "ble_adv.h"
+#include "measurement.h"
+#include "provisioning.h"
+#include "trace.h"
+
+#define HS_LOG_PREFIX "BLE"
+#include "debug.h"
+
+#if HS_BLE_SCAN
+#include <esp_bt.h>
+#include <esp_bt_main.h>
+#include <esp_gap_ble_api.h>
+#endif
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+// Minimum seconds between two publishes of the same tag
+#ifndef BLE_PUBLISH_S
+#define BLE_PUBLISH_S 60
+#endif
+
+namespace BleScan {
+
+#if HS_BLE_SCAN
+
+static const uint8_t TABLE_BITS = 5;
+static const uint8_t TABLE_SIZE = 1 << TABLE_BITS;
+static const uint16_t SCAN_INTERVAL = 0x50; // 50 ms, in 0.625 ms units
+static const uint16_t SCAN_WINDOW = 0x30;   // listen 30 ms of every interval
+
+struct Tag {
+  bool used;          // never cleared, so probe chains stay intact
+  bool pending;       // readings not yet published
+  uint8_t mac[6];
+  uint8_t count;
+  uint32_t hash;      // payload of the last advertisement
+  uint32_t lastSeen;
+  uint32_t lastPublish;
+  BleAdv::Reading readings[BleAdv::MAX_READINGS];
+};
+
+static Tag s_tags[TABLE_SIZE];
+static uint8_t s_tagCount = 0;
+static Stats s_stats = {0, 0, 0, 0, 0, 0};
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool s_started = false;
+
+static uint8_t homeSlot(const uint8_t *mac) {
+  uint32_t k = (uint32_t)mac[2] << 24 | (uint32_t)mac[3] << 16 | (uint32_t)mac[4] << 8 | mac[5];
+  return (uint8_t)((k * 2654435761UL) >> (32 - TABLE_BITS));
+}
+
+// Linear probe for mac. With insert set, a missing tag takes the first free
+// slot, or replaces the longest-silent tag once the table is full.
+// Caller holds s_mux.
+static Tag *find(const uint8_t *mac, bool insert) {
+  uint8_t i = homeSlot(mac);
+  for (uint8_t n = 0; n < TABLE_SIZE; ++n, i = (i + 1) & (TABLE_SIZE - 1)) {
+    Tag &t = s_tags[i];
+    if (!t.used) {
+      if (!insert) return nullptr;
+      s_tagCount++;
+      t.used = true;
+      memcpy(t.mac, mac, 6);
+      return &t;
+    }
+    if (memcmp(t.mac, mac, 6) == 0) return &t;
+  }
+  if (!insert) return nullptr;
+  Tag *oldest = &s_tags[0];
+  for (uint8_t j = 1; j < TABLE_SIZE; ++j) {
+    if ((int32_t)(s_tags[j].lastSeen - oldest->lastSeen) < 0) oldest = &s_tags[j];
+  }
+  s_stats.evicted++;
+  memcpy(oldest->mac, mac, 6);
+  oldest->pending = false;
+  oldest->count = 0;
+  return oldest;
+}
+
+// Bluetooth host task
+static void onAdvert(const uint8_t *mac, const uint8_t *data, uint8_t len) {
+  TRACE_SPAN("ble.adv");
+  uint32_t now = millis();
+  uint32_t h = BleAdv::hash(data, len);
+
+  portENTER_CRITICAL(&s_mux);
+  s_stats.adverts++;
+  Tag *t = find(mac, false);
+  bool duplicate = t && t->hash == h;
+  if (duplicate) {
+    t->lastSeen = now;
+    s_stats.duplicates++;
+  }
+  portEXIT_CRITICAL(&s_mux);
+  if (duplicate) return;
+
+  BleAdv::Reading readings[BleAdv::MAX_READINGS];
+  uint8_t n = BleAdv::decode(data, len, readings);
+
+  portENTER_CRITICAL(&s_mux);
+  if (n == 0) {
+    s_stats.ignored++;
+  } else {
+    t = find(mac, true);
+    if (!t->pending && t->count == 0) t->lastPublish = now - BLE_PUBLISH_S * 1000UL; // new tag: publish soon
+    t->hash = h;
+    t->lastSeen = now;
+    t->count = n;
+    memcpy(t->readings, readings, n * sizeof(readings[0]));
+    t->pending = true;
+  }
+  portEXIT_CRITICAL(&s_mux);
+}
+
+static void onGap(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+  switch (event) {
+    case ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT:
+      esp_ble_gap_start_scanning(0); // 0 = until stopped
+      break;
+    case ESP_GAP_BLE_SCAN_START_COMPLETE_EVT:
+      if (param->scan_start_cmpl.status == ESP_BT_STATUS_SUCCESS) LOGLN("Scanning");
+      else LOGF("Scan start failed: %d\n", (int)param->scan_start_cmpl.status);
+      break;
+    case ESP_GAP_BLE_SCAN_RESULT_EVT:
+      if (param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
+        onAdvert(param->scan_rst.bda, param->scan_rst.ble_adv,
+                 param->scan_rst.adv_data_len + param->scan_rst.scan_rsp_len);
+      } else if (param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
+        esp_ble_gap_start_scanning(0);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// Bring up the controller and Bluedroid (provisioning may have stopped
+// them) and request a passive scan; scanning starts from the GAP callback.
+static bool startRadio() {
+  if (!btStarted() && !btStart()) return false;
+  if (esp_bluedroid_get_status() == ESP_BLUEDROID_STATUS_UNINITIALIZED && esp_bluedroid_init() != ESP_OK) return false;
+  if (esp_bluedroid_get_status() != ESP_BLUEDROID_STATUS_ENABLED && esp_bluedroid_enable() != ESP_OK) return false;
+  if (esp_ble_gap_register_callback(onGap) != ESP_OK) return false;
+
+  esp_ble_scan_params_t params = {};
+  params.scan_type = BLE_SCAN_TYPE_PASSIVE;
+  params.own_addr_type = BLE_ADDR_TYPE_PUBLIC;
+  params.scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ALL;
+  params.scan_interval = SCAN_INTERVAL;
+  params.scan_window = SCAN_WINDOW;
+  params.scan_duplicate = BLE_SCAN_DUPLICATE_DISABLE; // values change, the table dedups
+  return esp_ble_gap_set_scan_params(&params) == ESP_OK;
+}
+
+void loop() {
+  if (!s_started) {
+    if (Provisioning::provisioningActive() || !Provisioning::isConnected()) return;
+    s_started = true;
+    if (!startRadio()) LOGLN("BLE start failed; scanner off");
+    return;
+  }
+
+  uint32_t now = millis();
+  for (uint8_t i = 0; i < TABLE_SIZE; ++i) {
+    Tag snap;
+    portENTER_CRITICAL(&s_mux);
+    Tag &t = s_tags[i];
+    bool due = t.pending && now - t.lastPublish >= BLE_PUBLISH_S * 1000UL;
+    if (due) {
+      snap = t;
+      t.pending = false;
+      t.lastPublish = now;
+    }
+    portEXIT_CRITICAL(&s_mux);
+    if (!due) continue;
+
+    for (uint8_t k = 0; k < snap.count; ++k) {
+      char key[16];
+      snprintf(key, sizeof(key), "%s_%02x%02x", BleAdv::beepKey(snap.readings[k].kind), snap.mac[4], snap.mac[5]);
+      Measurements::publish(key, snap.readings[k].value);
+    }
+    portENTER_CRITICAL(&s_mux);
+    s_stats.published += snap.count;
+    portEXIT_CRITICAL(&s_mux);
+  }
+}
+
+Stats stats() {
+  portENTER_CRITICAL(&s_mux);
+  Stats st = s_stats;
+  st.tags = s_tagCount;
+  portEXIT_CRITICAL(&s_mux);
+  return st;
+}
+
+#else
+
+void loop() {}
+
+Stats stats() {
+  return Stats{0, 0, 0, 0, 0, 0};
+}
+
+#endif // HS_BLE_SCAN
+
+} // namespace BleScan
@@ -0,0 +1,114 @@
+// Start-up sequencing implementation
+//
+// Steps are bits in two masks: started and finished. A pass walks the
+// table in order, starts each step whose dependencies are all finished,
+// and polls the ready() of steps that are still running; passes repeat
+// while they make progress. Slow work (Wi-Fi association, panel init on
+// the UI task) runs elsewhere, so the loop task only ever waits in the
+// scheduler and independent steps overlap.
+
+#include <Arduino.h>
+
+#include "boot.h"
+#include "scheduler.h"
+
+#define HS_LOG_PREFIX "BOOT"
+#include "debug.h"
+
+namespace Boot {
+
+static const uint32_t POLL_MS = 10;
+
+static const Step *s_steps = nullptr;
+static uint8_t s_count = 0;
+static uint32_t s_started = 0;
+static uint32_t s_finished = 0;
+static uint32_t s_startUs[MAX_STEPS];
+static uint32_t s_endUs[MAX_STEPS];
+static Scheduler::JobId s_job = -1;
+static uint32_t s_runMs = 0;
+
+static uint32_t allMask() {
+  return s_count >= 32 ? 0xFFFFFFFFUL : (1UL << s_count) - 1;
+}
+
+bool finished() {
+  return s_count && s_finished == allMask();
+}
+
+static void finish(uint8_t i) {
+  s_endUs[i] = micros();
+  s_finished |= 1UL << i;
+}
+
+static void report() {
+  LOGLN("Boot profile (ms since reset):");
+  for (uint8_t i = 0; i < s_count; ++i) {
+    uint32_t bit = 1UL << i;
+    if (s_finished & bit) {
+      LOGF("  %-10s at %5lu took %5lu\n", s_steps[i].name, (unsigned long)(s_startUs[i] / 1000),
+           (unsigned long)((s_endUs[i] - s_startUs[i]) / 1000));
+    } else if (s_started & bit) {
+      LOGF("  %-10s at %5lu pending\n", s_steps[i].name, (unsigned long)(s_startUs[i] / 1000));
+    } else {
+      LOGF("  %-10s not started\n", s_steps[i].name);
+    }
+  }
+  if (!finished()) return;
+  uint32_t last = 0;
+  for (uint8_t i = 0; i < s_count; ++i) {
+    if (s_endUs[i] > last) last = s_endUs[i];
+  }
+  LOGF("Boot complete at %lu ms\n", (unsigned long)(last / 1000));
+}
+
+// Passes over the table until one makes no progress
+static void advance() {
+  for (bool again = true; again;) {
+    again = false;
+    for (uint8_t i = 0; i < s_count; ++i) {
+      uint32_t bit = 1UL << i;
+      const Step &st = s_steps[i];
+      if (s_finished & bit) continue;
+      if (!(s_started & bit)) {
+        if ((st.after & s_finished) != st.after) continue;
+        s_started |= bit;
+        s_startUs[i] = micros();
+        if (st.start) st.start();
+        if (!st.ready) {
+          finish(i);
+          again = true;
+          continue;
+        }
+      }
+      if (st.ready()) {
+        finish(i);
+        again = true;
+      }
+    }
+  }
+}
+
+static void poll() {
+  advance();
+  if (finished() || millis() - s_runMs >= BOOT_REPORT_MS) {
+    Scheduler::cancel(s_job);
+    s_job = -1;
+    report();
+  }
+}
+
+void run(const Step *steps, uint8_t count) {
+  s_steps = steps;
+  s_count = count > MAX_STEPS ? MAX_STEPS : count;
+  s_started = s_finished = 0;
+  s_runMs = millis();
+  advance();
+  if (finished()) {
+    report();
+    return;
+  }
+  s_job = Scheduler::every("boot", POLL_MS, poll, POLL_MS);
+}
+
+} // namespace Boot
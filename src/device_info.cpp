@@ -10,27 +10,19 @@
 
 namespace DeviceInfo {
 
-String macNoColonsUpper() {
-  String mac = WiFi.macAddress(); // format: AA:BB:CC:DD:EE:FF
-  String out;
-  out.reserve(12);
-  for (size_t i = 0; i < mac.length(); i++) {
-    if (mac[i] != ':') out += (char)toupper((int)mac[i]);
-  }
-  LOGF("MAC raw: %s, cleaned: %s\n", mac.c_str(), out.c_str());
-  return out; // 12 hex chars
+void macNoColonsUpper(char out[MAC_HEX_LEN]) {
+  uint8_t mac[6];
+  WiFi.macAddress(mac);
+  snprintf(out, MAC_HEX_LEN, "%02X%02X%02X%02X%02X%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  LOGF("MAC: %s\n", out);
 }
 
-void deriveNames(String &serviceNameOut, String &popOut) {
-  String mac = macNoColonsUpper();
-  if (mac.length() != 12) {
-    mac = F("000000000000");
-  }
-  String last4 = mac.substring(8);
-  String last6 = mac.substring(6);
-  serviceNameOut = String(F("HiveSync-")) + last4;
-  popOut = String(F("Hive-")) + last6;
-  LOGF("ServiceName=%s POP=%s\n", serviceNameOut.c_str(), popOut.c_str());
+void deriveNames(char serviceNameOut[NAME_LEN], char popOut[NAME_LEN]) {
+  char mac[MAC_HEX_LEN];
+  macNoColonsUpper(mac);
+  snprintf(serviceNameOut, NAME_LEN, "HiveSync-%s", mac + 8);
+  snprintf(popOut, NAME_LEN, "Hive-%s", mac + 6);
+  LOGF("ServiceName=%s POP=%s\n", serviceNameOut, popOut);
 }
 
 } // namespace DeviceInfo
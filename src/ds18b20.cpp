@@ -0,0 +1,133 @@
+// DS18B20 protocol implementation
+//
+// Only the command layer lives here; line timing belongs to the Bus
+// implementation. The ROM search is the standard binary tree walk: each
+// ROM bit is read with its complement, and a conflict (both 0) is resolved
+// by the last-discrepancy bookkeeping so every device is visited once.
+
+#include "ds18b20.h"
+
+namespace Ds18b20 {
+
+static const uint8_t CMD_SEARCH_ROM = 0xF0;
+static const uint8_t CMD_MATCH_ROM = 0x55;
+static const uint8_t CMD_SKIP_ROM = 0xCC;
+static const uint8_t CMD_CONVERT_T = 0x44;
+static const uint8_t CMD_READ_SCRATCHPAD = 0xBE;
+// Passes repeated on a branch whose ROM fails the CRC before giving it up
+// (a device whose ROM really is corrupt must not stall the search)
+static const uint8_t SEARCH_RETRIES = 1;
+
+static const uint8_t CRC_TABLE[256] = {
+  0x00, 0x5e, 0xbc, 0xe2, 0x61, 0x3f, 0xdd, 0x83, 0xc2, 0x9c, 0x7e, 0x20, 0xa3, 0xfd, 0x1f, 0x41,
+  0x9d, 0xc3, 0x21, 0x7f, 0xfc, 0xa2, 0x40, 0x1e, 0x5f, 0x01, 0xe3, 0xbd, 0x3e, 0x60, 0x82, 0xdc,
+  0x23, 0x7d, 0x9f, 0xc1, 0x42, 0x1c, 0xfe, 0xa0, 0xe1, 0xbf, 0x5d, 0x03, 0x80, 0xde, 0x3c, 0x62,
+  0xbe, 0xe0, 0x02, 0x5c, 0xdf, 0x81, 0x63, 0x3d, 0x7c, 0x22, 0xc0, 0x9e, 0x1d, 0x43, 0xa1, 0xff,
+  0x46, 0x18, 0xfa, 0xa4, 0x27, 0x79, 0x9b, 0xc5, 0x84, 0xda, 0x38, 0x66, 0xe5, 0xbb, 0x59, 0x07,
+  0xdb, 0x85, 0x67, 0x39, 0xba, 0xe4, 0x06, 0x58, 0x19, 0x47, 0xa5, 0xfb, 0x78, 0x26, 0xc4, 0x9a,
+  0x65, 0x3b, 0xd9, 0x87, 0x04, 0x5a, 0xb8, 0xe6, 0xa7, 0xf9, 0x1b, 0x45, 0xc6, 0x98, 0x7a, 0x24,
+  0xf8, 0xa6, 0x44, 0x1a, 0x99, 0xc7, 0x25, 0x7b, 0x3a, 0x64, 0x86, 0xd8, 0x5b, 0x05, 0xe7, 0xb9,
+  0x8c, 0xd2, 0x30, 0x6e, 0xed, 0xb3, 0x51, 0x0f, 0x4e, 0x10, 0xf2, 0xac, 0x2f, 0x71, 0x93, 0xcd,
+  0x11, 0x4f, 0xad, 0xf3, 0x70, 0x2e, 0xcc, 0x92, 0xd3, 0x8d, 0x6f, 0x31, 0xb2, 0xec, 0x0e, 0x50,
+  0xaf, 0xf1, 0x13, 0x4d, 0xce, 0x90, 0x72, 0x2c, 0x6d, 0x33, 0xd1, 0x8f, 0x0c, 0x52, 0xb0, 0xee,
+  0x32, 0x6c, 0x8e, 0xd0, 0x53, 0x0d, 0xef, 0xb1, 0xf0, 0xae, 0x4c, 0x12, 0x91, 0xcf, 0x2d, 0x73,
+  0xca, 0x94, 0x76, 0x28, 0xab, 0xf5, 0x17, 0x49, 0x08, 0x56, 0xb4, 0xea, 0x69, 0x37, 0xd5, 0x8b,
+  0x57, 0x09, 0xeb, 0xb5, 0x36, 0x68, 0x8a, 0xd4, 0x95, 0xcb, 0x29, 0x77, 0xf4, 0xaa, 0x48, 0x16,
+  0xe9, 0xb7, 0x55, 0x0b, 0x88, 0xd6, 0x34, 0x6a, 0x2b, 0x75, 0x97, 0xc9, 0x4a, 0x14, 0xf6, 0xa8,
+  0x74, 0x2a, 0xc8, 0x96, 0x15, 0x4b, 0xa9, 0xf7, 0xb6, 0xe8, 0x0a, 0x54, 0xd7, 0x89, 0x6b, 0x35,
+};
+
+void Bus::writeByte(uint8_t v) {
+  for (uint8_t i = 0; i < 8; ++i, v >>= 1) writeBit(v & 1);
+}
+
+uint8_t Bus::readByte() {
+  uint8_t v = 0;
+  for (uint8_t i = 0; i < 8; ++i) v |= (uint8_t)readBit() << i;
+  return v;
+}
+
+uint8_t crc8(const uint8_t *data, uint8_t len) {
+  uint8_t crc = 0;
+  while (len--) crc = CRC_TABLE[crc ^ *data++];
+  return crc;
+}
+
+uint8_t search(Bus &bus, uint8_t roms[][ROM_LEN], uint8_t max) {
+  uint8_t rom[ROM_LEN] = {0};
+  uint8_t count = 0;
+  int8_t lastDiscrepancy = -1;
+  uint8_t retries = 0;
+  // At most one pass per device plus one per corrupted pass
+  for (uint8_t pass = 0; pass < 2 * max + 2 && count < max; ++pass) {
+    if (!bus.reset()) break;
+    bus.writeByte(CMD_SEARCH_ROM);
+    int8_t lastZero = -1;
+    bool ok = true;
+    for (uint8_t i = 0; i < ROM_LEN * 8; ++i) {
+      bool bit = bus.readBit();
+      bool complement = bus.readBit();
+      if (bit && complement) {
+        ok = false; // nobody answered; devices left mid-search
+        break;
+      }
+      if (bit == complement) {
+        // Conflict: retrace the previous choice before the last
+        // discrepancy, take 1 at it, 0 beyond it
+        if (i < lastDiscrepancy) bit = rom[i / 8] >> (i % 8) & 1;
+        else bit = (i == lastDiscrepancy);
+        if (!bit) lastZero = (int8_t)i;
+      }
+      if (bit) rom[i / 8] |= (uint8_t)(1 << (i % 8));
+      else rom[i / 8] &= (uint8_t)~(1 << (i % 8));
+      bus.writeBit(bit);
+    }
+    if (!ok) break;
+    bool valid = crc8(rom, ROM_LEN - 1) == rom[ROM_LEN - 1];
+    if (!valid && retries < SEARCH_RETRIES) {
+      // Likely a glitched slot: walk the same branch again rather than
+      // lose whatever device sits at the end of it
+      retries++;
+      continue;
+    }
+    retries = 0;
+    if (valid && rom[0] == FAMILY) {
+      for (uint8_t b = 0; b < ROM_LEN; ++b) roms[count][b] = rom[b];
+      count++;
+    }
+    lastDiscrepancy = lastZero;
+    if (lastDiscrepancy < 0) break; // every branch visited
+  }
+  return count;
+}
+
+bool convertAll(Bus &bus) {
+  if (!bus.reset()) return false;
+  bus.writeByte(CMD_SKIP_ROM);
+  bus.writeByte(CMD_CONVERT_T);
+  return true;
+}
+
+bool readCentiC(Bus &bus, const uint8_t rom[ROM_LEN], int16_t &centiC) {
+  if (!bus.reset()) return false;
+  bus.writeByte(CMD_MATCH_ROM);
+  for (uint8_t b = 0; b < ROM_LEN; ++b) bus.writeByte(rom[b]);
+  bus.writeByte(CMD_READ_SCRATCHPAD);
+  uint8_t pad[SCRATCHPAD_LEN];
+  uint8_t all = 0;
+  for (uint8_t b = 0; b < SCRATCHPAD_LEN; ++b) {
+    pad[b] = bus.readByte();
+    all |= pad[b];
+  }
+  // An all-zero scratchpad (line stuck low) passes the CRC
+  if (all == 0 || crc8(pad, SCRATCHPAD_LEN - 1) != pad[SCRATCHPAD_LEN - 1]) return false;
+
+  int16_t raw = (int16_t)((uint16_t)pad[1] << 8 | pad[0]);
+  // Configuration register bits 5-6: 9..12-bit, lower bits undefined below 12
+  uint8_t unused = 3 - ((pad[4] >> 5) & 3);
+  raw &= (int16_t)~((1 << unused) - 1);
+  centiC = (int16_t)(((int32_t)raw * 100) / 16);
+  return true;
+}
+
+} // namespace Ds18b20
@@ -0,0 +1,214 @@
+// Deep-sleep duty-cycle implementation
+//
+// A timer wake costs: gauge, probe and scale reads, RTC buffer append,
+// deep sleep. Every DUTY_UPLOAD_EVERY cycles (or when the RTC buffer runs
+// full) the buffered readings are replayed into the time-series store
+// and the upload queue and Wi-Fi comes up just long enough to send them.
+// Every DUTY_FULL_BOOT_EVERY cycles the normal boot runs instead, so
+// release checks and the display still happen now and then. Each cycle's
+// awake and radio time is accumulated in RTC memory and turned into an
+// average current estimate from the DUTY_I_* figures.
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_sleep.h>
+
+#include "duty_cycle.h"
+#include "battery.h"
+#include "scale.h"
+#include "temp_probes.h"
+#include "measurement.h"
+#include "provisioning.h"
+#include "timeseries.h"
+#include "uploader.h"
+#include "scheduler.h"
+#include "ota_engine.h"
+#include "log.h"
+
+#define HS_LOG_PREFIX "DUTY"
+#include "debug.h"
+
+#ifndef HS_DUTY_CYCLE
+#define HS_DUTY_CYCLE 0
+#endif
+// Wake period in seconds
+#ifndef DUTY_SLEEP_S
+#define DUTY_SLEEP_S 900
+#endif
+// Upload on every Nth wake
+#ifndef DUTY_UPLOAD_EVERY
+#define DUTY_UPLOAD_EVERY 4
+#endif
+// Run the full boot (display, release check) on every Nth wake
+#ifndef DUTY_FULL_BOOT_EVERY
+#define DUTY_FULL_BOOT_EVERY 96
+#endif
+// Seconds a full boot stays up before going to sleep
+#ifndef DUTY_AWAKE_S
+#define DUTY_AWAKE_S 600
+#endif
+// Supply current estimates for the energy report
+#ifndef DUTY_I_ACTIVE_MA
+#define DUTY_I_ACTIVE_MA 40
+#endif
+#ifndef DUTY_I_WIFI_MA
+#define DUTY_I_WIFI_MA 110
+#endif
+#ifndef DUTY_I_SLEEP_UA
+#define DUTY_I_SLEEP_UA 80
+#endif
+
+#ifndef TFT_BACKLITE
+#define TFT_BACKLITE 45
+#endif
+#ifndef TFT_I2C_POWER
+#define TFT_I2C_POWER 7
+#endif
+
+namespace DutyCycle {
+
+static const uint32_t RTC_MAGIC = 0x48534443;  // "HSDC"
+static const uint8_t RTC_SAMPLES = 96;
+static const uint8_t SAMPLE_HEADROOM = 16;     // one wake's readings: bv, t_0..t_9, w_v, weight_kg
+static const uint32_t CONNECT_TIMEOUT_MS = 10000;
+static const uint32_t UPLOAD_TIMEOUT_MS = 15000;
+static const uint32_t POSTPONE_MS = 60000;
+static const uint32_t SCALE_SETTLE_MS = 4000;  // the filter needs ~2.5 s at 80 SPS
+
+// Survives deep sleep (lost on power-on and reset)
+struct RtcState {
+  uint32_t magic;
+  uint32_t cycle;          // timer wakes since the last full boot
+  uint8_t count;           // buffered readings
+  Measurement samples[RTC_SAMPLES];
+  uint32_t cycles;         // sleeps since power-on
+  uint32_t awakeMsTotal;
+  uint32_t wifiMsTotal;
+};
+static RTC_DATA_ATTR RtcState s_rtc;
+
+static uint32_t s_wifiMs = 0;
+static Stats s_last = {0, 0, 0, 0, 0, 0};
+
+#if HS_DUTY_CYCLE
+static bool s_buffering = false;
+
+static void rtcSink(const Measurement &m) {
+  if (!s_buffering) return;
+  if (s_rtc.count < RTC_SAMPLES) s_rtc.samples[s_rtc.count++] = m;
+}
+
+// Sensors read on every wake. The probes go first so the scale's drift
+// compensation has the current cell temperature.
+static void sampleAll() {
+  float v = Battery::voltage();
+  if (isfinite(v)) Measurements::publish("bv", v);
+  if (TempProbes::begin()) TempProbes::sampleNow();
+  if (Scale::begin()) Scale::readSettled(SCALE_SETTLE_MS);
+}
+#endif
+
+// Average supply current of one cycle in uA from the awake/radio split
+static uint32_t estimateMicroAmps(uint32_t awakeMs, uint32_t wifiMs, uint32_t sleepMs) {
+  uint64_t charge = (uint64_t)awakeMs * DUTY_I_ACTIVE_MA * 1000ULL +
+                    (uint64_t)wifiMs * (DUTY_I_WIFI_MA - DUTY_I_ACTIVE_MA) * 1000ULL +
+                    (uint64_t)sleepMs * DUTY_I_SLEEP_UA;
+  uint32_t total = awakeMs + sleepMs;
+  return total ? (uint32_t)(charge / total) : 0;
+}
+
+void sleep() {
+  TimeSeries::flush();
+  uint32_t awake = millis();
+  uint32_t period = DUTY_SLEEP_S * 1000UL;
+  uint32_t sleepMs = awake + 1000 < period ? period - awake : 1000;
+
+  s_rtc.cycles++;
+  s_rtc.awakeMsTotal += awake;
+  s_rtc.wifiMsTotal += s_wifiMs;
+  s_last = Stats{s_rtc.cycle, awake, s_wifiMs, sleepMs, estimateMicroAmps(awake, s_wifiMs, sleepMs), s_rtc.count};
+  LOGF("Cycle %u: awake %u ms (Wi-Fi %u ms), est. %u uA avg; lifetime avg awake %u ms\n",
+       (unsigned)s_rtc.cycle, (unsigned)awake, (unsigned)s_wifiMs, (unsigned)s_last.microAmps,
+       (unsigned)(s_rtc.awakeMsTotal / s_rtc.cycles));
+  int32_t tte = Battery::minutesToEmpty();
+  if (tte >= 0) LOGF("Battery %d%%, about %d h to empty\n", Battery::percent(), (int)(tte / 60));
+
+  WiFi.disconnect(true);
+  WiFi.mode(WIFI_OFF);
+  pinMode(TFT_BACKLITE, OUTPUT);
+  digitalWrite(TFT_BACKLITE, LOW);
+  pinMode(TFT_I2C_POWER, OUTPUT);
+  digitalWrite(TFT_I2C_POWER, LOW);
+  Log::flush();
+  esp_sleep_enable_timer_wakeup((uint64_t)sleepMs * 1000ULL);
+  esp_deep_sleep_start();
+}
+
+Stats stats() {
+  return s_last;
+}
+
+void fastBootIfTimerWake() {
+#if HS_DUTY_CYCLE
+  if (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER || s_rtc.magic != RTC_MAGIC) return;
+  s_rtc.cycle++;
+  if (s_rtc.cycle % DUTY_FULL_BOOT_EVERY == 0) {
+    LOGF("Cycle %u: full boot\n", (unsigned)s_rtc.cycle);
+    return;
+  }
+
+  // The gauge sits on the display's I2C rail; power it without the backlight
+  pinMode(TFT_I2C_POWER, OUTPUT);
+  digitalWrite(TFT_I2C_POWER, HIGH);
+  Battery::begin();
+  Measurements::subscribe(rtcSink);
+  s_buffering = true;
+  sampleAll();
+  s_buffering = false;
+
+  bool upload = s_rtc.cycle % DUTY_UPLOAD_EVERY == 0 || s_rtc.count + SAMPLE_HEADROOM > RTC_SAMPLES;
+  s_wifiMs = 0;
+  if (upload) {
+    // Hand the buffered readings to the flash-backed stores first, so
+    // nothing is lost if Wi-Fi is unavailable this time
+    TimeSeries::begin();
+    Uploader::begin();
+    for (uint8_t i = 0; i < s_rtc.count; ++i) Measurements::publish(s_rtc.samples[i]);
+    s_rtc.count = 0;
+    uint32_t t0 = millis();
+    if (Provisioning::connectStored(CONNECT_TIMEOUT_MS)) Uploader::flush(UPLOAD_TIMEOUT_MS);
+    s_wifiMs = millis() - t0;
+  }
+  sleep();
+#endif
+}
+
+#if HS_DUTY_CYCLE
+static void sleepJob() {
+  // Never cut an update short
+  if (OtaEngine::busy()) {
+    Scheduler::after("sleep", POSTPONE_MS, sleepJob);
+    return;
+  }
+  Uploader::flush(UPLOAD_TIMEOUT_MS);
+  s_wifiMs = millis(); // radio was on for the whole full boot
+  sleep();
+}
+#endif
+
+void begin() {
+#if HS_DUTY_CYCLE
+  if (s_rtc.magic != RTC_MAGIC || esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER) {
+    memset(&s_rtc, 0, sizeof(s_rtc));
+    s_rtc.magic = RTC_MAGIC;
+  }
+  // Readings buffered on the wakes before this full boot
+  for (uint8_t i = 0; i < s_rtc.count; ++i) Measurements::publish(s_rtc.samples[i]);
+  s_rtc.count = 0;
+  s_rtc.cycle = 0;
+  LOGF("Duty cycling: sleep in %u s, then wake every %u s\n", (unsigned)DUTY_AWAKE_S, (unsigned)DUTY_SLEEP_S);
+  Scheduler::after("sleep", DUTY_AWAKE_S * 1000UL, sleepJob);
+#endif
+}
+
+} // namespace DutyCycle
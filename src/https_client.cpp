@@ -0,0 +1,236 @@
+// Pooled HTTPS connections implementation
+//
+// Each slot owns a TlsClient + HTTPClient pair bound to one host. A
+// request to a host with an idle, still-open slot goes out on that socket
+// without a new TCP/TLS handshake. Once the server has closed it, the slot
+// reconnects offering the TLS session it cached, so the handshake is
+// usually an abbreviated one. Redirects are followed here rather than
+// inside HTTPClient, so every hop (api.github.com -> github.com ->
+// objects.githubusercontent.com) lands on its own pooled connection instead
+// of tearing down and rebuilding a single one. Connections idle for longer
+// than IDLE_CLOSE_MS are closed from loop() to give the TLS buffers back;
+// their host and session are kept.
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+
+#include "https_client.h"
+#include "tls_client.h"
+#include "trace.h"
+
+#define HS_LOG_PREFIX "HTTPS"
+#include "debug.h"
+
+#ifndef HTTPS_POOL_SLOTS
+#define HTTPS_POOL_SLOTS 2
+#endif
+
+namespace Https {
+
+static const uint32_t IDLE_CLOSE_MS = 20000;  // servers drop idle keep-alives soon after
+static const uint8_t MAX_REDIRECTS = 5;
+static const size_t HOST_MAX = 64;
+
+struct Slot {
+  TlsClient client;
+  HTTPClient http;
+  char host[HOST_MAX];
+  uint16_t port;
+  bool inUse;
+  bool open;             // may hold a live connection; cleared by the idle close
+  uint32_t lastUsedMs;
+};
+
+static Slot s_slots[HTTPS_POOL_SLOTS];
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static Stats s_stats = {0, 0, 0, 0, 0, 0};
+
+// Split "https://host[:port]/path" into host and port; only https is pooled
+static bool parseHost(const String &url, char *host, size_t hostLen, uint16_t &port) {
+  static const char kScheme[] = "https://";
+  if (!url.startsWith(kScheme)) return false;
+  const char *p = url.c_str() + sizeof(kScheme) - 1;
+  size_t n = strcspn(p, ":/?#");
+  if (n == 0 || n >= hostLen) return false;
+  memcpy(host, p, n);
+  host[n] = '\0';
+  port = 443;
+  if (p[n] == ':') {
+    long v = strtol(p + n + 1, nullptr, 10);
+    if (v <= 0 || v > 65535) return false;
+    port = (uint16_t)v;
+  }
+  return true;
+}
+
+// Claim a slot for host: prefer one already bound to it, else the least
+// recently used idle slot. Returns nullptr when every slot is busy.
+static Slot *acquire(const char *host, uint16_t port) {
+  Slot *best = nullptr;
+  portENTER_CRITICAL(&s_mux);
+  for (uint8_t i = 0; i < HTTPS_POOL_SLOTS; ++i) {
+    Slot &s = s_slots[i];
+    if (s.inUse) continue;
+    if (s.port == port && strcmp(s.host, host) == 0) { best = &s; break; }
+    if (!best || (uint32_t)(s.lastUsedMs - best->lastUsedMs) > 0x80000000UL) best = &s;
+  }
+  if (best) best->inUse = true;
+  portEXIT_CRITICAL(&s_mux);
+  if (!best) return nullptr;
+
+  if (best->port != port || strcmp(best->host, host) != 0) {
+    best->client.stop();
+    best->client.forgetSession();
+    strlcpy(best->host, host, sizeof(best->host));
+    best->port = port;
+  }
+  return best;
+}
+
+static void release(Slot *s) {
+  portENTER_CRITICAL(&s_mux);
+  s->lastUsedMs = millis();
+  s->inUse = false;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+static bool isRedirect(int code) {
+  return code == 301 || code == 302 || code == 303 || code == 307 || code == 308;
+}
+
+HTTPClient &Response::http() {
+  return _slot->http;
+}
+
+void Response::end(bool drained) {
+  if (!_slot) return;
+  // Unread body bytes would be parsed as the next response on this socket
+  if (!drained) _slot->client.stop();
+  _slot->http.end();
+  release(_slot);
+  _slot = nullptr;
+}
+
+int request(const char *method, const String &url, const uint8_t *body, size_t bodyLen,
+            const Options &opts, Response &resp) {
+  resp.end(false);
+  resp._code = 0;
+  resp._timing = Timing{0, 0, 0, 0, 0, 0};
+  Timing &t = resp._timing;
+
+  String current = url;
+  for (;;) {
+    char host[HOST_MAX];
+    uint16_t port;
+    if (!parseHost(current, host, sizeof(host), port)) {
+      LOGF("Unsupported URL: %s\n", current.c_str());
+      return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+    Slot *s = acquire(host, port);
+    if (!s) {
+      LOGLN("No free connection slot");
+      return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+
+    // Open the socket ourselves so the handshake can be timed; HTTPClient
+    // then finds it connected and reuses it
+    if (s->client.connected()) {
+      t.reused++;
+      portENTER_CRITICAL(&s_mux);
+      s_stats.reuses++;
+      portEXIT_CRITICAL(&s_mux);
+    } else {
+      uint32_t t0 = millis();
+      bool connected;
+      {
+        TRACE_SPAN("https.handshake");
+        connected = s->client.connect(host, port, opts.timeoutMs);
+      }
+      if (!connected) {
+        LOGF("Connect to %s failed\n", host);
+        release(s);
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+      }
+      uint32_t ms = millis() - t0;
+      t.handshakeMs += ms;
+      t.handshakes++;
+      if (s->client.resumed()) t.resumed++;
+      portENTER_CRITICAL(&s_mux);
+      s->open = true;
+      s_stats.handshakes++;
+      if (s->client.resumed()) s_stats.resumed++;
+      s_stats.handshakeMsTotal += ms;
+      portEXIT_CRITICAL(&s_mux);
+    }
+
+    HTTPClient &http = s->http;
+    if (!http.begin(s->client, current)) {
+      s->client.stop();
+      release(s);
+      return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+    http.setReuse(true);
+    http.setTimeout(opts.timeoutMs);
+    http.setFollowRedirects(HTTPC_DISABLE_FOLLOW_REDIRECTS);
+    for (uint8_t i = 0; i < opts.headerCount; ++i) http.addHeader(opts.headers[i].name, opts.headers[i].value);
+    if (opts.collectCount) http.collectHeaders(opts.collect, opts.collectCount);
+
+    uint32_t t1 = millis();
+    int code = http.sendRequest(method, const_cast<uint8_t *>(body), bodyLen);
+    uint32_t ttfb = millis() - t1;
+    t.ttfbMs += ttfb;
+    portENTER_CRITICAL(&s_mux);
+    s_stats.ttfbMsTotal += ttfb;
+    s_stats.requests++;
+    portEXIT_CRITICAL(&s_mux);
+    LOGF("%s %s -> %d (%s, handshake=%u ms, ttfb=%u ms)\n", method, host, code,
+         t.reused && !t.handshakes ? "reused" : t.resumed ? "resumed" : "new",
+         (unsigned)t.handshakeMs, (unsigned)ttfb);
+
+    String next = (opts.followRedirects && isRedirect(code)) ? http.getLocation() : String();
+    if (next.length() == 0 || t.redirects >= MAX_REDIRECTS) {
+      resp._slot = s;
+      resp._code = code;
+      return code;
+    }
+
+    // Drain the (small) redirect body so the socket stays reusable
+    http.getString();
+    http.end();
+    release(s);
+    current = next;
+    t.redirects++;
+    // A 303 turns the follow-up into a GET
+    if (code == 303) { method = "GET"; body = nullptr; bodyLen = 0; }
+  }
+}
+
+void loop() {
+  for (uint8_t i = 0; i < HTTPS_POOL_SLOTS; ++i) {
+    Slot &s = s_slots[i];
+    bool claim = false;
+    portENTER_CRITICAL(&s_mux);
+    if (!s.inUse && s.open && millis() - s.lastUsedMs > IDLE_CLOSE_MS) {
+      s.inUse = true;
+      claim = true;
+    }
+    portEXIT_CRITICAL(&s_mux);
+    if (!claim) continue;
+    if (s.client.connected()) LOGF("Closing idle connection to %s\n", s.host);
+    s.client.stop();
+    portENTER_CRITICAL(&s_mux);
+    s.open = false;
+    s.inUse = false;
+    portEXIT_CRITICAL(&s_mux);
+  }
+}
+
+// The updater, uploader and OTA reader run on different tasks
+Stats stats() {
+  portENTER_CRITICAL(&s_mux);
+  Stats st = s_stats;
+  portEXIT_CRITICAL(&s_mux);
+  return st;
+}
+
+} // namespace Https
@@ -0,0 +1,315 @@
+// Deferred binary logger implementation
+//
+// LOGF/LOGLN call sites copy the format string's address and their raw
+// arguments into a byte ring owned by the calling core; nothing is
+// formatted and nothing is allocated on the caller's task. Each ring has
+// its own spinlock, held only for a bounded memcpy. The core ID is read
+// before the lock is taken, so a task preempted and migrated in between
+// writes into the other core's ring: still safe under that ring's lock,
+// it just contends with the other core that once. A priority-1 task
+// drains both rings, formats each record with snprintf one conversion at
+// a time and writes it to Serial. With HS_LOG_PERSIST the raw records are
+// also appended to /log.bin, which scripts/decode_log.py turns back into
+// text using firmware.elf.
+//
+// Record: Header, then per argument a Kind byte and its payload (4 bytes
+// for U32, 8 for U64/F64, length byte + bytes for STR). A record with
+// fmt == 0 reports dropped records; its single U32 is the count.
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include "log.h"
+#include "storage.h"
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+// Ring size per core (power of two)
+#ifndef LOG_RING_BYTES
+#define LOG_RING_BYTES 4096
+#endif
+// Also append raw records to /log.bin on the littlefs partition
+#ifndef HS_LOG_PERSIST
+#define HS_LOG_PERSIST 0
+#endif
+#ifndef LOG_FILE_MAX
+#define LOG_FILE_MAX 65536
+#endif
+
+namespace Log {
+
+static const uint8_t RECORD_MAGIC = 0xA5;
+static const uint8_t MAX_STR = 63;        // longer strings are truncated
+static const uint16_t MAX_RECORD = 224;
+static const uint32_t DRAIN_MS = 20;
+static const char *const LOG_FILE = "/log.bin";
+static const char *const LOG_FILE_OLD = "/log.old";
+static const uint16_t PERSIST_BUF = 1024;
+static const uint32_t PERSIST_MS = 10000;
+
+struct Header {
+  uint8_t magic;
+  uint8_t len;       // payload bytes after the header
+  uint8_t core;
+  uint8_t count;     // arguments
+  uint32_t fmt;      // address of the format string
+  uint32_t ms;
+};
+
+struct Ring {
+  uint8_t buf[LOG_RING_BYTES];
+  volatile uint32_t head;   // free-running, written by producers
+  volatile uint32_t tail;   // free-running, written by the drain
+  uint32_t records;
+  uint32_t dropped;
+  uint32_t droppedReported;
+};
+
+static const uint8_t CORES = 2;
+static Ring s_rings[CORES];
+static portMUX_TYPE s_mux[CORES] = {portMUX_INITIALIZER_UNLOCKED, portMUX_INITIALIZER_UNLOCKED};
+static TaskHandle_t s_task = nullptr;
+static SemaphoreHandle_t s_drainLock = nullptr;
+
+#if HS_LOG_PERSIST
+static uint8_t s_persist[PERSIST_BUF];
+static uint16_t s_persistLen = 0;
+static uint32_t s_persistAt = 0;
+#endif
+
+static uint8_t *put(uint8_t *p, const void *src, size_t n) {
+  memcpy(p, src, n);
+  return p + n;
+}
+
+void write(const char *fmt, const Arg *args, uint8_t count) {
+  uint8_t rec[MAX_RECORD];
+  Header h;
+  h.magic = RECORD_MAGIC;
+  h.count = 0;
+  h.fmt = (uint32_t)(uintptr_t)fmt;
+  h.ms = millis();
+  uint8_t *p = rec + sizeof(Header);
+  const uint8_t *end = rec + sizeof(rec);
+  for (uint8_t i = 0; i < count; ++i) {
+    const Arg &a = args[i];
+    size_t need = a.kind == Arg::U32 ? 5 : a.kind == Arg::STR ? 2 : 9;
+    if (p + need > end) break;
+    *p++ = a.kind;
+    switch (a.kind) {
+      case Arg::U32: p = put(p, &a.u32, 4); break;
+      case Arg::U64: p = put(p, &a.u64, 8); break;
+      case Arg::F64: p = put(p, &a.f64, 8); break;
+      case Arg::STR: {
+        const char *s = a.str ? a.str : "(null)";
+        size_t n = strnlen(s, MAX_STR);
+        if (p + 1 + n > end) n = end - p - 1;
+        *p++ = (uint8_t)n;
+        p = put(p, s, n);
+        break;
+      }
+    }
+    h.count++;
+  }
+  h.len = (uint8_t)(p - rec - sizeof(Header));
+  uint32_t n = p - rec;
+
+  h.core = (uint8_t)xPortGetCoreID();
+  memcpy(rec, &h, sizeof(h));
+  Ring &r = s_rings[h.core];
+  portENTER_CRITICAL_SAFE(&s_mux[h.core]);
+  uint32_t head = r.head;
+  if (LOG_RING_BYTES - (head - r.tail) < n) {
+    r.dropped++;
+  } else {
+    uint32_t at = head & (LOG_RING_BYTES - 1);
+    uint32_t first = LOG_RING_BYTES - at < n ? LOG_RING_BYTES - at : n;
+    memcpy(r.buf + at, rec, first);
+    memcpy(r.buf, rec + first, n - first);
+    r.head = head + n;
+    r.records++;
+  }
+  portEXIT_CRITICAL_SAFE(&s_mux[h.core]);
+}
+
+static void copyOut(const Ring &r, uint32_t pos, uint8_t *dst, uint32_t n) {
+  uint32_t at = pos & (LOG_RING_BYTES - 1);
+  uint32_t first = LOG_RING_BYTES - at < n ? LOG_RING_BYTES - at : n;
+  memcpy(dst, r.buf + at, first);
+  memcpy(dst + first, r.buf, n - first);
+}
+
+// Format one conversion at a time; the C type handed to snprintf follows
+// the recorded Kind, so a mismatched argument prints oddly but safely.
+static size_t format(char *out, size_t cap, const char *fmt, const uint8_t *p, const uint8_t *end) {
+  size_t len = 0;
+  char spec[24];
+  while (*fmt && len + 1 < cap) {
+    if (*fmt != '%') {
+      out[len++] = *fmt++;
+      continue;
+    }
+    if (fmt[1] == '%') {
+      out[len++] = '%';
+      fmt += 2;
+      continue;
+    }
+    // %[flags][width][.precision][length]conversion; length is re-derived
+    size_t s = 0;
+    spec[s++] = *fmt++;
+    while (*fmt && strchr("-+ #0123456789.", *fmt) && s < sizeof(spec) - 4) spec[s++] = *fmt++;
+    while (*fmt && strchr("hlLqjzt", *fmt)) fmt++;
+    char conv = *fmt;
+    if (!conv) break;
+    fmt++;
+
+    int n = 0;
+    if (p >= end) {
+      n = snprintf(out + len, cap - len, "<?>");
+    } else {
+      uint8_t kind = *p++;
+      uint32_t u32 = 0;
+      uint64_t u64 = 0;
+      double f64 = 0;
+      const char *str = "";
+      uint8_t slen = 0;
+      if (kind == Arg::U32) { memcpy(&u32, p, 4); p += 4; u64 = u32; f64 = u32; }
+      else if (kind == Arg::U64) { memcpy(&u64, p, 8); p += 8; f64 = (double)u64; }
+      else if (kind == Arg::F64) { memcpy(&f64, p, 8); p += 8; }
+      else if (kind == Arg::STR) { slen = *p++; str = (const char *)p; p += slen; }
+      else break;
+
+      if (strchr("diouxXc", conv)) {
+        if (kind == Arg::U64) { spec[s++] = 'l'; spec[s++] = 'l'; }
+        spec[s++] = conv;
+        spec[s] = '\0';
+        if (kind == Arg::U64) n = snprintf(out + len, cap - len, spec, (long long)u64);
+        else if (kind == Arg::F64) n = snprintf(out + len, cap - len, spec, (int)f64);
+        else n = snprintf(out + len, cap - len, spec, (int)u32);
+      } else if (strchr("feEgGaA", conv)) {
+        spec[s++] = conv;
+        spec[s] = '\0';
+        n = snprintf(out + len, cap - len, spec, f64);
+      } else if (conv == 's' && kind == Arg::STR) {
+        char tmp[MAX_STR + 1];
+        memcpy(tmp, str, slen);
+        tmp[slen] = '\0';
+        spec[s++] = 's';
+        spec[s] = '\0';
+        n = snprintf(out + len, cap - len, spec, tmp);
+      } else if (conv == 'p') {
+        n = snprintf(out + len, cap - len, "0x%08x", (unsigned)u32);
+      } else {
+        n = snprintf(out + len, cap - len, "<?>");
+      }
+    }
+    if (n > 0) len += (size_t)n < cap - len ? (size_t)n : cap - len - 1;
+  }
+  out[len] = '\0';
+  return len;
+}
+
+#if HS_LOG_PERSIST
+static void persistFlush() {
+  if (s_persistLen == 0 || !Storage::begin()) return;
+  File f = LittleFS.open(LOG_FILE, "a");
+  if (f) {
+    f.write(s_persist, s_persistLen);
+    bool full = f.size() >= LOG_FILE_MAX;
+    f.close();
+    if (full) {
+      LittleFS.remove(LOG_FILE_OLD);
+      LittleFS.rename(LOG_FILE, LOG_FILE_OLD);
+    }
+  }
+  s_persistLen = 0;
+  s_persistAt = millis();
+}
+
+static void persist(const uint8_t *rec, uint32_t n) {
+  if (s_persistLen + n > sizeof(s_persist)) persistFlush();
+  memcpy(s_persist + s_persistLen, rec, n);
+  s_persistLen += n;
+}
+#endif
+
+static void emit(const uint8_t *rec, uint32_t n) {
+  Header h;
+  memcpy(&h, rec, sizeof(h));
+  char line[256];
+  const uint8_t *p = rec + sizeof(Header);
+  size_t len = h.fmt ? format(line, sizeof(line), (const char *)(uintptr_t)h.fmt, p, p + h.len)
+                     : format(line, sizeof(line), "[LOG] %u records dropped\n", p, p + h.len);
+  Serial.write((const uint8_t *)line, len);
+#if HS_LOG_PERSIST
+  persist(rec, n);
+#endif
+}
+
+static void drainRing(Ring &r, uint8_t core) {
+  uint8_t rec[MAX_RECORD];
+  uint32_t tail = r.tail;
+  uint32_t head = r.head;
+  while (tail != head) {
+    Header h;
+    copyOut(r, tail, (uint8_t *)&h, sizeof(h));
+    uint32_t n = sizeof(Header) + h.len;
+    copyOut(r, tail, rec, n);
+    emit(rec, n);
+    tail += n;
+    r.tail = tail;
+  }
+
+  uint32_t dropped = r.dropped;
+  if (dropped != r.droppedReported) {
+    uint32_t lost = dropped - r.droppedReported;
+    r.droppedReported = dropped;
+    Header h = {RECORD_MAGIC, 5, core, 1, 0, (uint32_t)millis()};
+    memcpy(rec, &h, sizeof(h));
+    rec[sizeof(h)] = Arg::U32;
+    memcpy(rec + sizeof(h) + 1, &lost, 4);
+    emit(rec, sizeof(h) + 5);
+  }
+}
+
+static void drain() {
+  if (s_drainLock) xSemaphoreTake(s_drainLock, portMAX_DELAY);
+  for (uint8_t c = 0; c < CORES; ++c) drainRing(s_rings[c], c);
+#if HS_LOG_PERSIST
+  if (millis() - s_persistAt >= PERSIST_MS) persistFlush();
+#endif
+  if (s_drainLock) xSemaphoreGive(s_drainLock);
+}
+
+static void drainTask(void *) {
+  for (;;) {
+    drain();
+    vTaskDelay(pdMS_TO_TICKS(DRAIN_MS));
+  }
+}
+
+void begin() {
+  if (s_task) return;
+  s_drainLock = xSemaphoreCreateMutex();
+  xTaskCreate(drainTask, "log", 3072, nullptr, 1, &s_task);
+}
+
+void flush() {
+  drain();
+#if HS_LOG_PERSIST
+  if (s_drainLock) xSemaphoreTake(s_drainLock, portMAX_DELAY);
+  persistFlush();
+  if (s_drainLock) xSemaphoreGive(s_drainLock);
+#endif
+  Serial.flush();
+}
+
+Stats stats() {
+  Stats st = {0, 0};
+  for (uint8_t c = 0; c < CORES; ++c) {
+    st.records += s_rings[c].records;
+    st.dropped += s_rings[c].dropped;
+  }
+  return st;
+}
+
+} // namespace Log
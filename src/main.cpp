@@ -13,19 +13,142 @@
 #include "device_info.h"
 #include "battery.h"
 #include "updater.h"
+#include "https_client.h"
+#include "uploader.h"
+#include "timeseries.h"
+#include "scheduler.h"
+#include "duty_cycle.h"
+#include "log.h"
+#include "trace.h"
+#include "ble_scan.h"
+#include "audio.h"
+#include "scale.h"
+#include "temp_probes.h"
+#include "boot.h"
 
 #define HS_LOG_PREFIX "MAIN"
 #include "debug.h"
 
-void setup() {
-  Serial.begin(115200);
-  delay(50);
-  LOGLN("Booting HiveSync");
+// Blink LED based on connection state
+static Scheduler::JobId s_ledJob = -1;
+static void ledJob() {
+  static bool led = false;
+  static uint32_t period = 250;
+  led = !led;
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, led ? HIGH : LOW);
+  uint32_t want = Provisioning::isConnected() ? 800 : 250;
+  if (want != period) {
+    period = want;
+    Scheduler::reschedule(s_ledJob, period, period);
+  }
+}
 
-  // Initialize display and show header
-  UI::init();
+// Update battery percentage and reflect in UI
+static void batteryJob() {
+  Battery::update();
+  static int lastShown = -2; // force first update
+  int p = Battery::percent();
+  if (p != lastShown) {
+    lastShown = p;
+    UI::setBatteryPercent(p);
+  }
+}
+
+// Follow Wi-Fi signal strength with the status band's bars
+static void signalJob() {
+  UI::setSignal(Provisioning::isConnected() ? WiFi.RSSI() : 0);
+}
+
+// Persist recorded measurements and upload them in batches
+static void storeJob() {
+  TimeSeries::loop();
+  Uploader::loop();
+}
+
+// Serial console: "trace" dumps the span histograms, "trace reset" clears
+// them, "ui", "ble", "scale" and "temp" print the display queue, tag
+// scanner, load-cell and temperature probe counters
+static void consoleJob() {
+  static char line[24];
+  static uint8_t len = 0;
+  while (Serial.available()) {
+    char c = (char)Serial.read();
+    if (c != '\n' && c != '\r') {
+      if (len < sizeof(line) - 1) line[len++] = c;
+      continue;
+    }
+    line[len] = '\0';
+    if (strcmp(line, "trace") == 0) Trace::dump(Serial);
+    else if (strcmp(line, "trace reset") == 0) Trace::reset();
+    else if (strcmp(line, "ui") == 0) {
+      UI::Stats st = UI::stats();
+      Serial.printf("ui posted=%u merged=%u dropped=%u frames=%u\n", (unsigned)st.posted, (unsigned)st.merged,
+                    (unsigned)st.dropped, (unsigned)st.frames);
+    } else if (strcmp(line, "ble") == 0) {
+      BleScan::Stats st = BleScan::stats();
+      Serial.printf("ble adverts=%u dup=%u ignored=%u published=%u evicted=%u tags=%u\n", (unsigned)st.adverts,
+                    (unsigned)st.duplicates, (unsigned)st.ignored, (unsigned)st.published, (unsigned)st.evicted,
+                    (unsigned)st.tags);
+    } else if (strcmp(line, "scale") == 0) {
+      Scale::Stats st = Scale::stats();
+      Serial.printf("scale samples=%u overruns=%u steps=%u counts=%ld settled=%d\n", (unsigned)st.samples,
+                    (unsigned)st.overruns, (unsigned)st.steps, (long)st.counts, st.settled ? 1 : 0);
+    } else if (strcmp(line, "temp") == 0) {
+      TempProbes::Stats st = TempProbes::stats();
+      Serial.printf("temp probes=%u rounds=%u bad=%u rescans=%u\n", (unsigned)st.probes, (unsigned)st.rounds,
+                    (unsigned)st.badReads, (unsigned)st.rescans);
+    }
+    else if (len) Serial.printf("Unknown command: %s\n", line);
+    len = 0;
+  }
+}
+
+// Boot graph: each step starts as soon as the steps in its mask finish
+enum BootStep : uint8_t { BOOT_NAMES, BOOT_WIFI, BOOT_IP, BOOT_BUTTON, BOOT_DISPLAY, BOOT_PANEL, BOOT_GAUGE,
+                          BOOT_STEP_COUNT };
+#define AFTER(step) (1UL << (step))
+
+// BLE service name and POP from the MAC, needed for provisioning
+static char s_serviceName[DeviceInfo::NAME_LEN];
+static char s_pop[DeviceInfo::NAME_LEN];
+static void bootNames() {
+  DeviceInfo::deriveNames(s_serviceName, s_pop);
+  LOGF("BLE name=%s POP=%s\n", s_serviceName, s_pop);
+}
+
+static void bootWifi() {
+  Provisioning::beginIfNeeded(s_serviceName, s_pop);
+  LOGLN("Provisioning begun (or connecting with stored creds)");
+}
 
-  // Initialize battery gauge (if present)
+static void bootButton() {
+  Provisioning::watchResetButton();
+}
+
+// Long-press BOOT to clear credentials
+static bool bootButtonDone() {
+  switch (Provisioning::resetButton()) {
+    case Provisioning::ResetButton::Pending:
+      return false;
+    case Provisioning::ResetButton::Released:
+      return true;
+    case Provisioning::ResetButton::LongPress:
+      break;
+  }
+  UI::clearContentBelowHeader();
+  UI::printLine(2, F("Clearing WiFi credentials..."), ST77XX_YELLOW);
+  WiFi.mode(WIFI_STA);
+  WiFi.disconnect(true, true);
+  delay(200);
+  UI::printLine(3, F("Restarting..."));
+  delay(500);
+  ESP.restart();
+  return true;
+}
+
+// Battery gauge (if present), on the I2C rail UI::init() powers
+static void bootGauge() {
   if (Battery::begin()) {
     UI::setBatteryPercent(Battery::percent());
     LOGF("Battery gauge OK: %d%%\n", Battery::percent());
@@ -33,51 +156,63 @@ void setup() {
     UI::setBatteryPercent(-1); // hide if not detected
     LOGLN("Battery gauge not detected");
   }
+}
 
-  // Derive BLE service name and POP from MAC
-  String serviceName, pop;
-  DeviceInfo::deriveNames(serviceName, pop);
-  LOGF("BLE name=%s POP=%s\n", serviceName.c_str(), pop.c_str());
-
-  // Long-press BOOT to clear credentials
-  if (Provisioning::checkResetProvisioningOnBoot()) {
-    UI::clearContentBelowHeader();
-    UI::printLine(2, F("Clearing WiFi credentials..."), ST77XX_YELLOW);
-    WiFi.mode(WIFI_STA);
-    WiFi.disconnect(true, true);
-    delay(200);
-    UI::printLine(3, F("Restarting..."));
-    delay(500);
-    ESP.restart();
-  }
+static const Boot::Step BOOT_STEPS[BOOT_STEP_COUNT] = {
+  {"names", bootNames, nullptr, 0},
+  {"wifi", bootWifi, nullptr, AFTER(BOOT_NAMES)},
+  {"ip", nullptr, Provisioning::isConnected, AFTER(BOOT_WIFI)},
+  {"button", bootButton, bootButtonDone, AFTER(BOOT_WIFI)},
+  {"display", UI::init, nullptr, AFTER(BOOT_WIFI)},
+  {"panel", nullptr, UI::ready, AFTER(BOOT_DISPLAY)},
+  {"gauge", bootGauge, nullptr, AFTER(BOOT_DISPLAY)},
+};
 
-  // Proceed with normal flow
-  UI::clearContentBelowHeader();
-  UI::printHeader();
-  Provisioning::beginIfNeeded(serviceName, pop);
-  LOGLN("Provisioning begun (or connecting with stored creds)");
-}
+void setup() {
+  Serial.begin(115200);
+  // Format deferred log records off the calling tasks
+  Log::begin();
+  // Timer wakes in duty-cycle mode sample, upload and sleep from here
+  DutyCycle::fastBootIfTimerWake();
+  LOGLN("Booting HiveSync");
+  // Wi-Fi association first; display, gauge and BOOT button alongside it
+  Boot::run(BOOT_STEPS, BOOT_STEP_COUNT);
 
-void loop() {
-  // Blink LED based on connection state
-  static uint32_t lastBlink = 0;
-  static bool led = false;
-  if (millis() - lastBlink > (Provisioning::isConnected() ? 800 : 250)) {
-    lastBlink = millis();
-    led = !led;
-    pinMode(LED_BUILTIN, OUTPUT);
-    digitalWrite(LED_BUILTIN, led ? HIGH : LOW);
-  }
+  // Record hive measurements locally and queue them for upload to BEEP
+  TimeSeries::begin();
+  Uploader::begin();
 
-  // Periodically update battery percentage and reflect in UI
-  Battery::update();
-  static int lastShown = -2; // force first update
-  int p = Battery::percent();
-  if (p != lastShown) {
-    lastShown = p;
-    UI::setBatteryPercent(p);
-  }
+  s_ledJob = Scheduler::every("led", 250, ledJob);
+  // Gauge alerts trigger the battery job; otherwise it polls the alert bit
+  Battery::setAlertJob(Scheduler::every("battery", Battery::pollIntervalMs(), batteryJob));
+  // Release checks run once Wi-Fi is up; also relays OTA progress
+  Scheduler::every("updater", 250, Updater::loop);
+  Scheduler::every("store", 1000, storeJob);
+  Scheduler::every("signal", 10000, signalJob);
+#if HS_BLE_SCAN
+  // Sensor tags over BLE, once provisioning has released the radio
+  Scheduler::every("ble", 1000, BleScan::loop);
+#endif
+#if HS_AUDIO
+  // Hive sound band energies from the I2S microphone
+  if (Audio::begin()) Scheduler::every("audio", AUDIO_PERIOD_S * 1000UL, Audio::capture, 30000);
+#endif
+#if HS_SCALE
+  // Hive weight from the HX711, filtered as samples arrive
+  if (Scale::begin()) Scheduler::every("scale", 100, Scale::loop);
+#endif
+#if HS_TEMP_PROBES
+  // Brood / top / ambient DS18B20s, converted together each round
+  if (TempProbes::begin()) Scheduler::every("temp", TEMP_PERIOD_S * 1000UL, TempProbes::sample, 5000);
+#endif
+  // Release pooled HTTPS connections that went idle
+  Scheduler::every("https", 5000, Https::loop);
+  Scheduler::every("sched", 3600000UL, Scheduler::logStats);
+  Scheduler::every("console", 500, consoleJob);
+  DutyCycle::begin();
+}
 
-  // After Wi-Fi connects, perform a one-time OTA check
-  Updater::loop();
+void loop() {
+  // Run due jobs, then sleep until the next deadline
+  Scheduler::run();
 }
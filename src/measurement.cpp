@@ -0,0 +1,42 @@
+// Sensor measurement fan-out implementation
+
+#include <Arduino.h>
+#include <time.h>
+
+#include "measurement.h"
+
+namespace Measurements {
+
+static const uint8_t MAX_SINKS = 4;
+static const time_t VALID_TIME = 1600000000;  // anything earlier means "not synced"
+
+static Sink s_sinks[MAX_SINKS];
+static uint8_t s_sinkCount = 0;
+
+bool subscribe(Sink sink) {
+  for (uint8_t i = 0; i < s_sinkCount; ++i) {
+    if (s_sinks[i] == sink) return true;
+  }
+  if (s_sinkCount >= MAX_SINKS) return false;
+  s_sinks[s_sinkCount++] = sink;
+  return true;
+}
+
+uint32_t now() {
+  time_t t = time(nullptr);
+  return t >= VALID_TIME ? (uint32_t)t : 0;
+}
+
+void publish(const char *key, float value) {
+  Measurement m;
+  m.time = now();
+  m.value = value;
+  strlcpy(m.key, key, sizeof(m.key));
+  publish(m);
+}
+
+void publish(const Measurement &m) {
+  for (uint8_t i = 0; i < s_sinkCount; ++i) s_sinks[i](m);
+}
+
+} // namespace Measurements
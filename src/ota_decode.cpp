@@ -0,0 +1,292 @@
+// Streaming OTA image decoders implementation
+
+#include <Arduino.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <rom/miniz.h>
+
+#include "ota_decode.h"
+
+#define HS_LOG_PREFIX "DEC"
+#include "debug.h"
+
+namespace OtaDecode {
+
+static inline uint32_t readLE32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ---- gzip -----------------------------------------------------------------
+
+// RFC 1952 header flags
+static const uint8_t GZ_FHCRC = 0x02;
+static const uint8_t GZ_FEXTRA = 0x04;
+static const uint8_t GZ_FNAME = 0x08;
+static const uint8_t GZ_FCOMMENT = 0x10;
+
+bool GzipDecoder::begin(ByteSink *next) {
+  _next = next;
+  _error = nullptr;
+  _inflator = malloc(sizeof(tinfl_decompressor));
+  _dict = (uint8_t *)malloc(TINFL_LZ_DICT_SIZE);
+  if (!_inflator || !_dict) {
+    end();
+    return fail("Inflate: out of memory");
+  }
+  tinfl_init((tinfl_decompressor *)_inflator);
+  _dictPos = 0;
+  _state = HEADER;
+  _flags = 0;
+  _count = 0;
+  _extraLen = 0;
+  _crc = 0;
+  _size = 0;
+  return true;
+}
+
+void GzipDecoder::end() {
+  free(_inflator);
+  free(_dict);
+  _inflator = nullptr;
+  _dict = nullptr;
+}
+
+const char *GzipDecoder::error() const {
+  if (_error) return _error;
+  return _next ? _next->error() : nullptr;
+}
+
+// Consume one header byte; returns false on an unsupported/invalid header
+bool GzipDecoder::headerByte(uint8_t b) {
+  switch (_state) {
+    case HEADER:
+      // ID1 ID2 CM FLG MTIME(4) XFL OS
+      if ((_count == 0 && b != 0x1F) || (_count == 1 && b != 0x8B) || (_count == 2 && b != 8)) {
+        return fail("Not a gzip image");
+      }
+      if (_count == 3) _flags = b;
+      if (++_count < 10) return true;
+      _count = 0;
+      _state = (_flags & GZ_FEXTRA) ? EXTRA_LEN : (_flags & GZ_FNAME) ? NAME
+             : (_flags & GZ_FCOMMENT) ? COMMENT : (_flags & GZ_FHCRC) ? HCRC : BODY;
+      return true;
+    case EXTRA_LEN:
+      _extraLen |= (uint16_t)b << (8 * _count);
+      if (++_count < 2) return true;
+      _count = 0;
+      _state = _extraLen ? EXTRA : (_flags & GZ_FNAME) ? NAME
+             : (_flags & GZ_FCOMMENT) ? COMMENT : (_flags & GZ_FHCRC) ? HCRC : BODY;
+      return true;
+    case EXTRA:
+      if (--_extraLen) return true;
+      _state = (_flags & GZ_FNAME) ? NAME : (_flags & GZ_FCOMMENT) ? COMMENT : (_flags & GZ_FHCRC) ? HCRC : BODY;
+      return true;
+    case NAME:
+      if (b) return true;
+      _state = (_flags & GZ_FCOMMENT) ? COMMENT : (_flags & GZ_FHCRC) ? HCRC : BODY;
+      return true;
+    case COMMENT:
+      if (b) return true;
+      _state = (_flags & GZ_FHCRC) ? HCRC : BODY;
+      return true;
+    case HCRC:
+      if (++_count < 2) return true;
+      _count = 0;
+      _state = BODY;
+      return true;
+    default:
+      return fail("Inflate: bad state");
+  }
+}
+
+bool GzipDecoder::write(const uint8_t *data, size_t len) {
+  if (_error || !_inflator) return false;
+  tinfl_decompressor *inflator = (tinfl_decompressor *)_inflator;
+
+  for (;;) {
+    if (_state == BODY) {
+      size_t inSize = len;
+      size_t outSize = TINFL_LZ_DICT_SIZE - _dictPos;
+      tinfl_status st = tinfl_decompress(inflator, data, &inSize, _dict, _dict + _dictPos, &outSize,
+                                         TINFL_FLAG_HAS_MORE_INPUT);
+      data += inSize;
+      len -= inSize;
+      if (outSize) {
+        _crc = esp_rom_crc32_le(_crc, _dict + _dictPos, outSize);
+        _size += outSize;
+        if (!_next->write(_dict + _dictPos, outSize)) return false;
+        _dictPos = (_dictPos + outSize) & (TINFL_LZ_DICT_SIZE - 1);
+      }
+      if (st == TINFL_STATUS_DONE) {
+        _state = TRAILER;
+        _count = 0;
+        continue;
+      }
+      if (st == TINFL_STATUS_HAS_MORE_OUTPUT) continue;
+      if (st == TINFL_STATUS_NEEDS_MORE_INPUT) return true;
+      return fail("Inflate: corrupt data");
+    }
+
+    if (len == 0) return true;
+    uint8_t b = *data++;
+    len--;
+
+    if (_state == TRAILER) {
+      _trailer[_count++] = b;
+      if (_count == sizeof(_trailer)) _state = DONE;
+    } else if (_state == DONE) {
+      return fail("Inflate: trailing data");
+    } else if (!headerByte(b)) {
+      return false;
+    }
+  }
+}
+
+bool GzipDecoder::finish() {
+  if (_error) return false;
+  if (_state != DONE) return fail("Inflate: truncated image");
+  if (readLE32(_trailer) != _crc) return fail("Inflate: CRC mismatch");
+  if (readLE32(_trailer + 4) != _size) return fail("Inflate: size mismatch");
+  LOGF("Inflated %u bytes\n", (unsigned)_size);
+  return _next->finish();
+}
+
+// ---- delta ----------------------------------------------------------------
+
+static const uint8_t OP_END = 0x00;
+static const uint8_t OP_COPY = 0x01;
+static const uint8_t OP_ADD = 0x02;
+
+bool DeltaDecoder::begin(ByteSink *next) {
+  _next = next;
+  _error = nullptr;
+  _source = esp_ota_get_running_partition();
+  _state = HEADER;
+  _count = 0;
+  _remaining = 0;
+  _crc = 0;
+  _written = 0;
+  if (!_source) return fail("Delta: no running slot");
+  return true;
+}
+
+void DeltaDecoder::end() {
+  _source = nullptr;
+}
+
+const char *DeltaDecoder::error() const {
+  if (_error) return _error;
+  return _next ? _next->error() : nullptr;
+}
+
+bool DeltaDecoder::emit(const uint8_t *data, size_t len) {
+  if (_written + len > _targetSize) return fail("Delta: output overrun");
+  _crc = esp_rom_crc32_le(_crc, data, len);
+  _written += len;
+  return _next->write(data, len);
+}
+
+// Validate the header and make sure the patch was made against this image
+bool DeltaDecoder::onHeader() {
+  if (memcmp(_hdr, "HSD1", 4) != 0) return fail("Not a delta image");
+  _sourceSize = readLE32(_hdr + 4);
+  uint32_t sourceCrc = readLE32(_hdr + 8);
+  _targetSize = readLE32(_hdr + 12);
+  _targetCrc = readLE32(_hdr + 16);
+
+  const esp_partition_t *src = (const esp_partition_t *)_source;
+  if (_sourceSize > src->size) return fail("Delta: base too large");
+  uint32_t crc = 0;
+  for (uint32_t off = 0; off < _sourceSize; off += sizeof(_buf)) {
+    uint32_t n = _sourceSize - off;
+    if (n > sizeof(_buf)) n = sizeof(_buf);
+    if (esp_partition_read(src, off, _buf, n) != ESP_OK) return fail("Delta: base read failed");
+    crc = esp_rom_crc32_le(crc, _buf, n);
+  }
+  if (crc != sourceCrc) return fail("Delta: base mismatch");
+  LOGF("Delta base OK (%u bytes), target=%u bytes\n", (unsigned)_sourceSize, (unsigned)_targetSize);
+  return true;
+}
+
+bool DeltaDecoder::copyFromSource(uint32_t offset, uint32_t len) {
+  if (offset > _sourceSize || len > _sourceSize - offset) return fail("Delta: copy out of range");
+  const esp_partition_t *src = (const esp_partition_t *)_source;
+  while (len) {
+    uint32_t n = len < sizeof(_buf) ? len : sizeof(_buf);
+    if (esp_partition_read(src, offset, _buf, n) != ESP_OK) return fail("Delta: base read failed");
+    if (!emit(_buf, n)) return false;
+    offset += n;
+    len -= n;
+  }
+  return true;
+}
+
+bool DeltaDecoder::write(const uint8_t *data, size_t len) {
+  if (_error) return false;
+  while (len) {
+    switch (_state) {
+      case HEADER:
+        _hdr[_count++] = *data++;
+        len--;
+        if (_count == sizeof(_hdr)) {
+          if (!onHeader()) return false;
+          _state = OP;
+        }
+        break;
+
+      case OP: {
+        uint8_t op = *data++;
+        len--;
+        _count = 0;
+        if (op == OP_COPY) _state = COPY_ARGS;
+        else if (op == OP_ADD) _state = ADD_LEN;
+        else if (op == OP_END) _state = DONE;
+        else return fail("Delta: bad opcode");
+        break;
+      }
+
+      case COPY_ARGS:
+        _hdr[_count++] = *data++;
+        len--;
+        if (_count == 8) {
+          if (!copyFromSource(readLE32(_hdr), readLE32(_hdr + 4))) return false;
+          _state = OP;
+        }
+        break;
+
+      case ADD_LEN:
+        _hdr[_count++] = *data++;
+        len--;
+        if (_count == 4) {
+          _remaining = readLE32(_hdr);
+          _state = _remaining ? ADD_DATA : OP;
+        }
+        break;
+
+      case ADD_DATA: {
+        size_t n = len < _remaining ? len : _remaining;
+        if (!emit(data, n)) return false;
+        data += n;
+        len -= n;
+        _remaining -= n;
+        if (_remaining == 0) _state = OP;
+        break;
+      }
+
+      case DONE:
+        return fail("Delta: trailing data");
+    }
+  }
+  return true;
+}
+
+bool DeltaDecoder::finish() {
+  if (_error) return false;
+  if (_state != DONE) return fail("Delta: truncated patch");
+  if (_written != _targetSize) return fail("Delta: size mismatch");
+  if (_crc != _targetCrc) return fail("Delta: CRC mismatch");
+  return _next->finish();
+}
+
+} // namespace OtaDecode
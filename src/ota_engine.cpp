@@ -0,0 +1,580 @@
+// Background OTA download engine implementation
+//
+// Reader task (core 0, next to the Wi-Fi/lwIP tasks) performs the HTTPS GET
+// and fills pooled chunk buffers from the TLS stream. Writer task (core 1)
+// drains them into Update.write(). The two exchange chunk indices through a
+// pair of single-producer/single-consumer rings (free -> reader -> filled ->
+// writer -> free) and only use task notifications to sleep when a ring is
+// empty, so the data path itself never takes a lock. loop() stays responsive
+// and receives progress through an event queue. Compressed and delta images
+// are decoded by the writer before they reach Update.write().
+//
+// Raw images skip Update and are written straight into the inactive slot.
+// Every OTA_CHECKPOINT_BYTES the flashed prefix is recorded in NVS with
+// the URL, ETag, slot and size, so an attempt that loses the connection is
+// continued by the next one with a Range request (If-Range guards against
+// a changed asset). The slot only becomes bootable once the whole image
+// passes esp_ota_set_boot_partition()'s checksum and SHA-256 verification.
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <Update.h>
+#include <Preferences.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <atomic>
+
+#include "ota_engine.h"
+#include "trace.h"
+#include "ota_decode.h"
+#include "https_client.h"
+#include "ota_resume.h"
+
+#define HS_LOG_PREFIX "OTAE"
+#include "debug.h"
+
+#ifndef OTA_READER_CORE
+#define OTA_READER_CORE 0
+#endif
+#ifndef OTA_WRITER_CORE
+#define OTA_WRITER_CORE 1
+#endif
+// Bytes flashed between two NVS checkpoints of a raw download
+#ifndef OTA_CHECKPOINT_BYTES
+#define OTA_CHECKPOINT_BYTES (64UL * 1024UL)
+#endif
+
+namespace OtaEngine {
+
+static const size_t CHUNK_SIZE = 4096;       // one flash sector per chunk
+static const uint32_t SECTOR_SIZE = 4096;
+static const uint8_t CHUNK_COUNT = 8;        // power of two (ring mask)
+static const uint32_t STALL_WAIT_MS = 100;
+static const uint32_t READ_TIMEOUT_MS = 30000;
+
+// Single-producer/single-consumer ring of chunk indices
+class IndexRing {
+public:
+  void reset() { _head.store(0); _tail.store(0); }
+  bool push(uint8_t idx) {
+    uint32_t h = _head.load(std::memory_order_relaxed);
+    if (h - _tail.load(std::memory_order_acquire) >= CHUNK_COUNT) return false;
+    _slots[h & (CHUNK_COUNT - 1)] = idx;
+    _head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  bool pop(uint8_t &idx) {
+    uint32_t t = _tail.load(std::memory_order_relaxed);
+    if (t == _head.load(std::memory_order_acquire)) return false;
+    idx = _slots[t & (CHUNK_COUNT - 1)];
+    _tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+  uint8_t size() const { return (uint8_t)(_head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire)); }
+
+private:
+  uint8_t _slots[CHUNK_COUNT];
+  std::atomic<uint32_t> _head{0};
+  std::atomic<uint32_t> _tail{0};
+};
+
+struct Chunk {
+  uint8_t *data;
+  uint16_t len;   // 0 marks end of stream
+};
+
+static Chunk s_chunks[CHUNK_COUNT];
+static uint8_t *s_pool = nullptr;
+static IndexRing s_free;
+static IndexRing s_filled;
+
+static QueueHandle_t s_events = nullptr;
+static TaskHandle_t s_reader = nullptr;
+static TaskHandle_t s_writer = nullptr;
+static std::atomic<bool> s_busy{false};
+static std::atomic<bool> s_abort{false};
+static std::atomic<bool> s_writerDone{false};
+static bool s_writerOk = false;
+
+// Final stage of the decoder chain: bytes go to the inactive OTA slot
+class FlashSink : public OtaDecode::ByteSink {
+public:
+  bool write(const uint8_t *data, size_t len) override {
+    TRACE_SPAN("ota.flash_update");
+    if (Update.write(const_cast<uint8_t *>(data), len) != len) return fail(Update.errorString());
+    _flashed += len;
+    return true;
+  }
+  bool finish() override { return true; }
+  void reset() { _error = nullptr; _flashed = 0; }
+  uint32_t flashed() const { return _flashed; }
+
+private:
+  uint32_t _flashed = 0;
+};
+
+// Resume point of an interrupted raw download
+static void loadCheckpoint(OtaResume::Checkpoint &cp) {
+  memset(&cp, 0, sizeof(cp));
+  Preferences prefs;
+  if (!prefs.begin("ota_resume", true)) return; // nothing stored yet
+  prefs.getString("url", cp.url, sizeof(cp.url));
+  prefs.getString("etag", cp.etag, sizeof(cp.etag));
+  cp.slot = prefs.getUInt("slot", 0);
+  cp.size = prefs.getUInt("size", 0);
+  cp.offset = prefs.getUInt("offset", 0);
+  prefs.end();
+}
+
+static void saveCheckpoint(const OtaResume::Checkpoint &cp) {
+  Preferences prefs;
+  if (!prefs.begin("ota_resume", false)) return;
+  prefs.putString("url", cp.url);
+  prefs.putString("etag", cp.etag);
+  prefs.putUInt("slot", cp.slot);
+  prefs.putUInt("size", cp.size);
+  prefs.putUInt("offset", cp.offset);
+  prefs.end();
+}
+
+static void saveOffset(uint32_t offset) {
+  Preferences prefs;
+  if (!prefs.begin("ota_resume", false)) return;
+  prefs.putUInt("offset", offset);
+  prefs.end();
+}
+
+static void clearCheckpoint() {
+  Preferences prefs;
+  if (!prefs.begin("ota_resume", false)) return;
+  prefs.clear();
+  prefs.end();
+}
+
+// Raw images: straight into the inactive slot, erasing sector by sector
+// just ahead of the data, so writing can pick up at any committed sector
+class PartitionSink : public OtaDecode::ByteSink {
+public:
+  bool begin(uint32_t offset, bool checkpoints) {
+    _error = nullptr;
+    _part = esp_ota_get_next_update_partition(nullptr);
+    if (!_part) return fail("No OTA partition");
+    _offset = _erased = _committed = offset;
+    _flashed = 0;
+    _checkpoints = checkpoints;
+    return true;
+  }
+  bool write(const uint8_t *data, size_t len) override {
+    TRACE_SPAN("ota.flash_raw");
+    if (_offset + len > _part->size) return fail("Image too large");
+    while (_erased < _offset + len) {
+      if (esp_partition_erase_range(_part, _erased, SECTOR_SIZE) != ESP_OK) return fail("Flash erase failed");
+      _erased += SECTOR_SIZE;
+    }
+    if (esp_partition_write(_part, _offset, data, len) != ESP_OK) return fail("Flash write failed");
+    _offset += len;
+    _flashed += len;
+    if (_offset - _committed >= OTA_CHECKPOINT_BYTES) commit();
+    return true;
+  }
+  bool finish() override { return true; }
+  // Record the flashed prefix for the next attempt
+  void commit() {
+    uint32_t at = OtaResume::committable(_offset, SECTOR_SIZE);
+    if (!_checkpoints || at <= _committed) return;
+    saveOffset(at);
+    _committed = at;
+  }
+  // Verify the complete image and boot from it next; the slot is left
+  // alone when verification fails
+  bool activate() {
+    _checkpoints = false;
+    if (esp_ota_set_boot_partition(_part) != ESP_OK) return fail("Image verification failed");
+    return true;
+  }
+  uint32_t flashed() const { return _flashed; }
+
+private:
+  const esp_partition_t *_part = nullptr;
+  uint32_t _offset = 0;
+  uint32_t _erased = 0;     // sectors below this are erased or already written
+  uint32_t _committed = 0;
+  uint32_t _flashed = 0;
+  bool _checkpoints = false;
+};
+
+static FlashSink s_flash;
+static PartitionSink s_partition;
+static OtaDecode::GzipDecoder s_gzip;
+static OtaDecode::DeltaDecoder s_delta;
+static OtaDecode::ByteSink *s_sink = nullptr;  // head of the decoder chain
+static ImageFormat s_format = ImageFormat::Raw;
+
+static String s_url;
+static uint32_t s_total = 0;
+static uint32_t s_resumedFrom = 0;
+static OtaResume::Checkpoint s_checkpoint;
+static uint32_t s_startMs = 0;
+static std::atomic<uint32_t> s_written{0};
+static uint16_t s_readerStalls = 0;
+static uint16_t s_writerStalls = 0;
+static uint8_t s_peakFilled = 0;
+static char s_error[sizeof(Event::message)];
+
+static void setError(const char *msg) {
+  if (!msg) msg = "OTA failed";
+  if (s_error[0] == '\0') strlcpy(s_error, msg, sizeof(s_error));
+  s_abort.store(true);
+}
+
+static Event makeEvent(EventType type) {
+  Event ev;
+  ev.type = type;
+  ev.done = s_written.load();
+  ev.total = s_total;
+  ev.elapsedMs = millis() - s_startMs;
+  ev.readerStalls = s_readerStalls;
+  ev.writerStalls = s_writerStalls;
+  ev.peakFilled = s_peakFilled;
+  ev.resumedFrom = s_resumedFrom;
+  strlcpy(ev.message, type == EventType::Failed ? s_error : "", sizeof(ev.message));
+  return ev;
+}
+
+// Progress may be dropped when loop() lags (wait = 0)
+static void postEvent(EventType type, TickType_t wait) {
+  if (!s_events) return;
+  Event ev = makeEvent(type);
+  xQueueSend(s_events, &ev, wait);
+}
+
+static void writerTask(void *) {
+  int lastPct = -1;
+  for (;;) {
+    uint8_t idx;
+    if (!s_filled.pop(idx)) {
+      if (s_abort.load()) break;
+      s_writerStalls++;
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STALL_WAIT_MS));
+      continue;
+    }
+    Chunk &c = s_chunks[idx];
+    // The reader refills the chunk as soon as it is back in the free ring
+    const uint16_t len = c.len;
+    if (len == 0) break; // end of stream
+
+    bool ok = s_sink->write(c.data, len);
+    s_free.push(idx);
+    xTaskNotifyGive(s_reader);
+    if (!ok) {
+      setError(s_sink->error());
+      break;
+    }
+    uint32_t done = s_written.fetch_add(len) + len;
+    int pct = s_total ? (int)((uint64_t)done * 100 / s_total) : 0;
+    if (pct != lastPct) {
+      lastPct = pct;
+      postEvent(EventType::Progress, 0);
+    }
+  }
+
+  bool raw = s_format == ImageFormat::Raw;
+  s_writerOk = false;
+  if (!s_abort.load()) {
+    if (s_written.load() != s_total) {
+      setError("Write incomplete");
+    } else if (!s_sink->finish()) {
+      setError(s_sink->error());
+    } else if (raw) {
+      s_writerOk = s_partition.activate();
+      if (!s_writerOk) setError(s_partition.error());
+      clearCheckpoint(); // a bad image is not worth resuming either
+    } else if (!Update.end(true)) {
+      setError(Update.errorString());
+    } else {
+      s_writerOk = Update.isFinished();
+      if (!s_writerOk) setError("Update not finished");
+    }
+  }
+  if (!s_writerOk) {
+    if (raw) s_partition.commit();
+    else Update.abort();
+  }
+  LOGF("Flashed %u bytes\n", (unsigned)(raw ? s_partition.flashed() : s_flash.flashed()));
+
+  s_writerDone.store(true);
+  xTaskNotifyGive(s_reader);
+  vTaskDelete(nullptr);
+}
+
+// Returns false on timeout/disconnect; fills exactly want bytes otherwise
+static bool readFully(WiFiClient *stream, uint8_t *dst, size_t want) {
+  size_t got = 0;
+  uint32_t lastData = millis();
+  while (got < want) {
+    if (s_abort.load()) return false;
+    int avail = stream->available();
+    if (avail <= 0) {
+      if (!stream->connected()) return false;
+      if (millis() - lastData > READ_TIMEOUT_MS) return false;
+      vTaskDelay(1);
+      continue;
+    }
+    size_t n = want - got;
+    if ((size_t)avail < n) n = avail;
+    int r = stream->read(dst + got, n);
+    if (r > 0) {
+      got += r;
+      lastData = millis();
+    }
+  }
+  return true;
+}
+
+// Build the decoder chain for the current image format
+static bool setupDecoders() {
+  s_flash.reset();
+  switch (s_format) {
+    case ImageFormat::Raw:
+      s_sink = &s_partition;
+      return true;
+    case ImageFormat::Gzip:
+      s_sink = &s_gzip;
+      if (!s_gzip.begin(&s_flash)) { setError(s_gzip.error()); return false; }
+      return true;
+    case ImageFormat::Delta:
+      s_sink = &s_delta;
+      if (!s_delta.begin(&s_flash)) { setError(s_delta.error()); return false; }
+      return true;
+    case ImageFormat::GzipDelta:
+      s_sink = &s_gzip;
+      if (!s_delta.begin(&s_flash) || !s_gzip.begin(&s_delta)) { setError(s_sink->error()); return false; }
+      return true;
+  }
+  return false;
+}
+
+static void readerTask(void *) {
+  static const char *kCollect[] = {"ETag", "Content-Range"};
+  Https::Header headers[3] = {{"User-Agent", "HiveSync-OTA"}};
+  Https::Options opts;
+  opts.headers = headers;
+  opts.headerCount = 1;
+  opts.collect = kCollect;
+  opts.collectCount = 2;
+  opts.timeoutMs = 30000;
+  Https::Response resp;
+
+  // Continue an interrupted raw download of the same asset into the same slot
+  bool raw = s_format == ImageFormat::Raw;
+  const esp_partition_t *slot = esp_ota_get_next_update_partition(nullptr);
+  char range[24];
+  uint32_t from = 0;
+  if (raw && slot) {
+    loadCheckpoint(s_checkpoint);
+    from = OtaResume::resumeFrom(s_checkpoint, s_url.c_str(), slot->address);
+  }
+  if (from) {
+    snprintf(range, sizeof(range), "bytes=%u-", (unsigned)from);
+    headers[opts.headerCount++] = {"Range", range};
+    headers[opts.headerCount++] = {"If-Range", s_checkpoint.etag};
+  }
+
+  bool writerStarted = false;
+  bool drained = false;
+  do {
+    int httpCode = Https::get(s_url, opts, resp);
+    LOGF("OTA GET code: %d (redirects=%u, handshake=%u ms, ttfb=%u ms)\n", httpCode,
+         (unsigned)resp.timing().redirects, (unsigned)resp.timing().handshakeMs,
+         (unsigned)resp.timing().ttfbMs);
+    if (httpCode < 0) {
+      setError("OTA: connect failed");
+      break;
+    }
+    HTTPClient &http = resp.http();
+    if (httpCode == HTTP_CODE_PARTIAL_CONTENT && from) {
+      uint32_t first, last, total;
+      if (!OtaResume::parseContentRange(http.header("Content-Range").c_str(), first, last, total) ||
+          first != from || total != s_checkpoint.size) {
+        clearCheckpoint();
+        setError("Bad Content-Range");
+        break;
+      }
+      s_total = total;
+    } else if (httpCode == HTTP_CODE_OK) {
+      // Whole image: first attempt, or the asset changed (If-Range)
+      from = 0;
+      int contentLen = http.getSize();
+      if (contentLen <= 0) {
+        setError("No Content-Length");
+        break;
+      }
+      s_total = (uint32_t)contentLen;
+      if (raw && slot) {
+        strlcpy(s_checkpoint.url, s_url.c_str(), sizeof(s_checkpoint.url));
+        strlcpy(s_checkpoint.etag, http.header("ETag").c_str(), sizeof(s_checkpoint.etag));
+        s_checkpoint.slot = slot->address;
+        s_checkpoint.size = s_total;
+        s_checkpoint.offset = 0;
+        // Without a validator a resumed range could belong to another file
+        if (s_checkpoint.etag[0]) saveCheckpoint(s_checkpoint);
+        else clearCheckpoint();
+      }
+    } else {
+      if (httpCode == HTTP_CODE_RANGE_NOT_SATISFIABLE) clearCheckpoint();
+      snprintf(s_error, sizeof(s_error), "HTTP %d", httpCode);
+      s_abort.store(true);
+      break;
+    }
+    s_resumedFrom = from;
+    s_written.store(from);
+
+    // Encoded images only reveal their final size at the end
+    LOGF("Starting Update: download=%u bytes from %u format=%u\n", (unsigned)s_total, (unsigned)from,
+         (unsigned)s_format);
+    if (raw) {
+      if (!s_partition.begin(from, s_checkpoint.etag[0] != '\0')) {
+        setError(s_partition.error());
+        break;
+      }
+    } else {
+      // Update rewrites the slot from its start, so a raw checkpoint for
+      // it no longer describes what is flashed there
+      clearCheckpoint();
+      if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
+        setError(Update.errorString());
+        break;
+      }
+    }
+    if (!setupDecoders()) {
+      if (!raw) Update.abort();
+      break;
+    }
+    postEvent(EventType::Started, 0);
+
+    s_reader = xTaskGetCurrentTaskHandle();
+    if (xTaskCreatePinnedToCore(writerTask, "ota_writer", 4096, nullptr, 2, &s_writer, OTA_WRITER_CORE) != pdPASS) {
+      setError("Writer task failed");
+      if (!raw) Update.abort();
+      break;
+    }
+    writerStarted = true;
+
+    WiFiClient *stream = http.getStreamPtr();
+    uint32_t remaining = s_total - from;
+    while (remaining > 0 && !s_abort.load()) {
+      uint8_t idx;
+      if (!s_free.pop(idx)) {
+        s_readerStalls++;
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STALL_WAIT_MS));
+        continue;
+      }
+      Chunk &c = s_chunks[idx];
+      c.len = (uint16_t)(remaining < CHUNK_SIZE ? remaining : CHUNK_SIZE);
+      if (!readFully(stream, c.data, c.len)) {
+        s_free.push(idx);
+        setError("Download interrupted");
+        break;
+      }
+      remaining -= c.len;
+      if (remaining == 0) drained = true;
+      s_filled.push(idx);
+      uint8_t queued = s_filled.size();
+      if (queued > s_peakFilled) s_peakFilled = queued;
+      xTaskNotifyGive(s_writer);
+    }
+
+    // End-of-stream marker (a free slot is always returned by the writer)
+    while (!s_abort.load()) {
+      uint8_t idx;
+      if (s_free.pop(idx)) {
+        s_chunks[idx].len = 0;
+        s_filled.push(idx);
+        xTaskNotifyGive(s_writer);
+        break;
+      }
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STALL_WAIT_MS));
+    }
+  } while (0);
+
+  if (writerStarted) {
+    xTaskNotifyGive(s_writer); // wake it in case it waits on an aborted stream
+    while (!s_writerDone.load()) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STALL_WAIT_MS));
+  }
+  resp.end(drained);
+
+  s_gzip.end();
+  s_delta.end();
+  free(s_pool);
+  s_pool = nullptr;
+
+  bool ok = writerStarted && s_writerOk;
+  LOGF("OTA %s: %u/%u bytes in %u ms, peak=%u, stalls r=%u w=%u\n", ok ? "done" : "failed",
+       (unsigned)s_written.load(), (unsigned)s_total, (unsigned)(millis() - s_startMs),
+       (unsigned)s_peakFilled, (unsigned)s_readerStalls, (unsigned)s_writerStalls);
+  if (!ok && s_error[0] == '\0') strlcpy(s_error, "OTA failed", sizeof(s_error));
+  // Snapshot the result, then release the engine before announcing it so
+  // loop() can start a follow-up download straight from the event.
+  Event result = makeEvent(ok ? EventType::Finished : EventType::Failed);
+  s_writer = nullptr;
+  s_reader = nullptr;
+  s_busy.store(false);
+  xQueueSend(s_events, &result, portMAX_DELAY);
+  vTaskDelete(nullptr);
+}
+
+bool start(const String &url, ImageFormat fmt) {
+  bool expected = false;
+  if (!s_busy.compare_exchange_strong(expected, true)) return false;
+
+  if (!s_events) s_events = xQueueCreate(8, sizeof(Event));
+  s_pool = (uint8_t *)malloc(CHUNK_SIZE * CHUNK_COUNT);
+  if (!s_events || !s_pool) {
+    LOGLN("OTA engine: out of memory");
+    free(s_pool);
+    s_pool = nullptr;
+    s_busy.store(false);
+    return false;
+  }
+
+  s_free.reset();
+  s_filled.reset();
+  for (uint8_t i = 0; i < CHUNK_COUNT; ++i) {
+    s_chunks[i].data = s_pool + i * CHUNK_SIZE;
+    s_chunks[i].len = 0;
+    s_free.push(i);
+  }
+  s_url = url;
+  s_format = fmt;
+  s_total = 0;
+  s_resumedFrom = 0;
+  s_written.store(0);
+  s_startMs = millis();
+  s_readerStalls = s_writerStalls = 0;
+  s_peakFilled = 0;
+  s_error[0] = '\0';
+  s_abort.store(false);
+  s_writerDone.store(false);
+  s_writerOk = false;
+
+  if (xTaskCreatePinnedToCore(readerTask, "ota_reader", 8192, nullptr, 3, &s_reader, OTA_READER_CORE) != pdPASS) {
+    LOGLN("OTA engine: reader task failed");
+    free(s_pool);
+    s_pool = nullptr;
+    s_busy.store(false);
+    return false;
+  }
+  return true;
+}
+
+bool busy() {
+  return s_busy.load();
+}
+
+bool pollEvent(Event &ev) {
+  if (!s_events) return false;
+  return xQueueReceive(s_events, &ev, 0) == pdTRUE;
+}
+
+} // namespace OtaEngine
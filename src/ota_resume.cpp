@@ -0,0 +1,37 @@
+// OTA resume bookkeeping implementation
+
+#include <string.h>
+
+#include "ota_resume.h"
+
+namespace OtaResume {
+
+uint32_t resumeFrom(const Checkpoint &cp, const char *url, uint32_t slot) {
+  if (cp.etag[0] == '\0' || cp.slot != slot || strcmp(cp.url, url) != 0) return 0;
+  if (cp.offset == 0 || cp.offset >= cp.size) return 0;
+  return cp.offset;
+}
+
+// Decimal uint32 at p; advances p, false on no digits or overflow
+static bool parseNumber(const char *&p, uint32_t &out) {
+  if (*p < '0' || *p > '9') return false;
+  uint64_t v = 0;
+  while (*p >= '0' && *p <= '9') {
+    v = v * 10 + (uint32_t)(*p++ - '0');
+    if (v > 0xFFFFFFFFULL) return false;
+  }
+  out = (uint32_t)v;
+  return true;
+}
+
+bool parseContentRange(const char *value, uint32_t &first, uint32_t &last, uint32_t &total) {
+  if (!value || strncmp(value, "bytes ", 6) != 0) return false;
+  const char *p = value + 6;
+  while (*p == ' ') p++;
+  if (!parseNumber(p, first) || *p++ != '-') return false;
+  if (!parseNumber(p, last) || *p++ != '/') return false;
+  if (!parseNumber(p, total)) return false;
+  return *p == '\0' && first <= last && last < total;
+}
+
+} // namespace OtaResume
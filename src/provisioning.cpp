@@ -8,6 +8,10 @@
 
 #include "ui.h"
 #include "provisioning.h"
+#include "wifi_fast.h"
+#include "device_info.h"
+#include "trace.h"
+#include "ble_scan.h"
 
 #define HS_LOG_PREFIX "WIFI"
 #include "debug.h"
@@ -19,19 +23,31 @@
 
 namespace Provisioning {
 
-static String s_serviceName;  // HiveSync-<last4>
-static String s_pop;          // Hive-<last6>
+static char s_serviceName[DeviceInfo::NAME_LEN];  // HiveSync-<last4>
+static char s_pop[DeviceInfo::NAME_LEN];          // Hive-<last6>
 static volatile bool s_connected = false;
+static bool s_headless = false;  // no display on duty-cycle wakes
+static volatile bool s_provActive = false; // BLE provisioning owns the radio
+static volatile bool s_buttonReleased = true; // set by the BOOT release edge
+static bool s_buttonArmed = false;
+static uint32_t s_buttonSince = 0;
+static uint32_t s_buttonHoldMs = 0;
 
 bool isConnected() { return s_connected; }
 
+bool provisioningActive() { return s_provActive; }
+
 void onEvent(arduino_event_t *sys_event) {
+  TRACE_SPAN("wifi.event");
+  char line[48];
   switch (sys_event->event_id) {
     case ARDUINO_EVENT_PROV_START:
       LOGLN("Provisioning start");
       UI::clearContentBelowHeader();
-      UI::printLine(3, String(F("Name: ")) + s_serviceName);
-      UI::printLine(4, String(F("POP:  ")) + s_pop);
+      snprintf(line, sizeof(line), "Name: %s", s_serviceName);
+      UI::printLine(3, line);
+      snprintf(line, sizeof(line), "POP:  %s", s_pop);
+      UI::printLine(4, line);
       break;
 
     case ARDUINO_EVENT_PROV_CRED_RECV:
@@ -50,7 +66,8 @@ void onEvent(arduino_event_t *sys_event) {
       break;
 
     case ARDUINO_EVENT_PROV_END:
-      // Will attempt to connect next
+      // Will attempt to connect next; the BLE service is down by now
+      s_provActive = false;
       break;
 
     case ARDUINO_EVENT_WIFI_STA_CONNECTED:
@@ -63,14 +80,14 @@ void onEvent(arduino_event_t *sys_event) {
       LOGF("Got IP: %s\n", WiFi.localIP().toString().c_str());
       IPAddress ip(sys_event->event_info.got_ip.ip_info.ip.addr);
       // Suppress showing the IP address on the display
-      UI::drawWifiIcon(true);
+      if (!s_headless) UI::drawWifiIcon(true);
       break;
     }
 
     case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
       s_connected = false;
       LOGLN("WiFi STA disconnected");
-      UI::drawWifiIcon(false);
+      if (!s_headless) UI::drawWifiIcon(false);
       break;
 
     default:
@@ -78,47 +95,79 @@ void onEvent(arduino_event_t *sys_event) {
   }
 }
 
-bool checkResetProvisioningOnBoot(uint32_t holdMs) {
+static void IRAM_ATTR onResetButtonRelease() {
+  s_buttonReleased = true;
+}
+
+void watchResetButton(uint32_t holdMs) {
   pinMode(RESET_BUTTON_PIN, INPUT_PULLUP);
-  uint32_t start = millis();
-  if (digitalRead(RESET_BUTTON_PIN) == LOW) {
-    LOGLN("BOOT held; checking for long press...");
-    while (millis() - start < holdMs) {
-      if (digitalRead(RESET_BUTTON_PIN) != LOW) {
-        return false; // released early
-      }
-      delay(10);
-    }
-    LOGLN("Long press detected; will clear creds");
-    return true; // held long enough
+  s_buttonSince = millis();
+  s_buttonHoldMs = holdMs;
+  s_buttonReleased = digitalRead(RESET_BUTTON_PIN) != LOW;
+  if (s_buttonReleased) return;
+  LOGLN("BOOT held; checking for long press...");
+  attachInterrupt(digitalPinToInterrupt(RESET_BUTTON_PIN), onResetButtonRelease, RISING);
+  s_buttonArmed = true;
+  if (digitalRead(RESET_BUTTON_PIN) != LOW) s_buttonReleased = true; // released while arming
+}
+
+ResetButton resetButton() {
+  ResetButton result;
+  if (s_buttonReleased) result = ResetButton::Released;
+  else if (millis() - s_buttonSince >= s_buttonHoldMs) result = ResetButton::LongPress;
+  else return ResetButton::Pending;
+  if (s_buttonArmed) {
+    detachInterrupt(digitalPinToInterrupt(RESET_BUTTON_PIN));
+    s_buttonArmed = false;
   }
-  return false;
+  if (result == ResetButton::LongPress) LOGLN("Long press detected; will clear creds");
+  return result;
 }
 
-void beginIfNeeded(const String &serviceName, const String &pop) {
-  s_serviceName = serviceName;
-  s_pop = pop;
+// Stored SSID straight from the driver config, without a String copy
+static void storedSsid(char out[33]) {
+  wifi_config_t conf;
+  out[0] = '\0';
+  if (esp_wifi_get_config(WIFI_IF_STA, &conf) != ESP_OK) return;
+  memcpy(out, conf.sta.ssid, 32);
+  out[32] = '\0';
+}
 
-  String existing = WiFi.SSID();
-  bool hasCreds = existing.length() > 0;
+void beginIfNeeded(const char *serviceName, const char *pop) {
+  strlcpy(s_serviceName, serviceName, sizeof(s_serviceName));
+  strlcpy(s_pop, pop, sizeof(s_pop));
+
+  // The driver only hands out its stored config once Wi-Fi is initialised
+  WiFi.mode(WIFI_STA);
+  char existing[33];
+  storedSsid(existing);
+  bool hasCreds = existing[0] != '\0';
 
   WiFi.onEvent(onEvent);
-  WiFi.begin();
 
   if (hasCreds) {
-    LOGF("Connecting to saved SSID: %s\n", existing.c_str());
-    UI::printLine(3, String(F("Connecting to: ")) + existing);
+    WifiFast::begin();
+    LOGF("Connecting to saved SSID: %s\n", existing);
+    char line[48];
+    snprintf(line, sizeof(line), "Connecting to: %s", existing);
+    UI::printLine(3, line);
   } else {
+    WiFi.begin();
     LOGLN("Starting BLE provisioning");
     uint8_t uuid[16] = {0xb4, 0xdf, 0x5a, 0x1c, 0x3f, 0x6b, 0xf4, 0xbf,
                         0xea, 0x4a, 0x82, 0x03, 0x04, 0x90, 0x1a, 0x02 };
 
+    s_provActive = true;
     WiFiProv.beginProvision(
       WIFI_PROV_SCHEME_BLE,
+#if HS_BLE_SCAN
+      WIFI_PROV_SCHEME_HANDLER_NONE, // keep BLE memory for the tag scanner
+#else
       WIFI_PROV_SCHEME_HANDLER_FREE_BLE,
+#endif
       WIFI_PROV_SECURITY_1,
-      pop.c_str(),
-      serviceName.c_str(),
+      pop,
+      serviceName,
       nullptr,
       uuid,
       false
@@ -126,4 +175,22 @@ void beginIfNeeded(const String &serviceName, const String &pop) {
   }
 }
 
+bool connectStored(uint32_t timeoutMs) {
+  TRACE_SPAN("wifi.connect");
+  s_headless = true;
+  WiFi.onEvent(onEvent);
+  WiFi.mode(WIFI_STA);
+  char ssid[33];
+  storedSsid(ssid);
+  if (ssid[0] == '\0') {
+    LOGLN("No stored credentials");
+    return false;
+  }
+  WifiFast::begin();
+  uint32_t start = millis();
+  while (!s_connected && millis() - start < timeoutMs) delay(10);
+  LOGF("Headless connect %s after %u ms\n", s_connected ? "ok" : "timed out", (unsigned)(millis() - start));
+  return s_connected;
+}
+
 } // namespace Provisioning
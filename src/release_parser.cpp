@@ -0,0 +1,265 @@
+// Incremental GitHub release JSON scanner implementation
+
+#include <string.h>
+
+#include "release_parser.h"
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+ReleaseParser::ReleaseParser(const char *assetName)
+    : ReleaseParser(&assetName, 1) {}
+
+ReleaseParser::ReleaseParser(const char *const *assetNames, uint8_t count) {
+  _assetCount = count < MAX_ASSETS ? count : MAX_ASSETS;
+  for (uint8_t i = 0; i < _assetCount; ++i) _assetNames[i] = assetNames[i] ? assetNames[i] : "";
+  reset();
+}
+
+void ReleaseParser::reset() {
+  _objMask = 0;
+  _depth = 0;
+  _expectKey = false;
+  _failed = false;
+  _inString = false;
+  _escape = 0;
+  _uni = 0;
+  _target = TGT_NONE;
+  _keyLen = 0;
+  _keyOverflow = false;
+  _rootKey = KEY_OTHER;
+  _assetKey = KEY_OTHER;
+  _inAssets = false;
+  _assetsDone = false;
+  _tag[0] = '\0';
+  _tagLen = 0;
+  _tagOverflow = false;
+  _url[0] = '\0';
+  _cand[0] = '\0';
+  _candLen = 0;
+  _candOverflow = false;
+  _bestIndex = -1;
+  _namePos = 0;
+  _nameMismatch = 0;
+  _nameMatched = -1;
+}
+
+void ReleaseParser::feed(const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len && !_failed; ++i) feed((char)data[i]);
+}
+
+void ReleaseParser::feed(char c) {
+  if (_failed) return;
+
+  if (_inString) {
+    if (_escape == 1) {
+      _escape = 0;
+      switch (c) {
+        case 'b': emit('\b'); break;
+        case 'f': emit('\f'); break;
+        case 'n': emit('\n'); break;
+        case 'r': emit('\r'); break;
+        case 't': emit('\t'); break;
+        case 'u': _escape = 2; _uni = 0; break;
+        default:  emit((uint8_t)c); break; // \" \\ \/
+      }
+      return;
+    }
+    if (_escape >= 2) {
+      int v = hexValue(c);
+      if (v < 0) { _failed = true; return; }
+      _uni = (uint16_t)((_uni << 4) | v);
+      if (++_escape == 6) {
+        _escape = 0;
+        emitCodepoint(_uni);
+      }
+      return;
+    }
+    if (c == '\\') { _escape = 1; return; }
+    if (c == '"') { _inString = false; endString(); return; }
+    emit((uint8_t)c);
+    return;
+  }
+
+  switch (c) {
+    case '"':
+      beginString();
+      break;
+    case '{': case '[': case '}': case ']': case ':': case ',':
+      onStructural(c);
+      break;
+    default:
+      break; // whitespace and number/true/false/null characters
+  }
+}
+
+void ReleaseParser::onStructural(char c) {
+  const bool topIsObject = _depth > 0 && ((_objMask >> (_depth - 1)) & 1u);
+
+  switch (c) {
+    case '{':
+    case '[': {
+      if (_depth >= MAX_DEPTH) { _failed = true; return; }
+      const bool obj = (c == '{');
+      if (obj) _objMask |= (1u << _depth);
+      else     _objMask &= ~(1u << _depth);
+      _depth++;
+      _expectKey = obj;
+      if (!obj && _depth == 2 && _rootKey == KEY_ASSETS) _inAssets = true;
+      if (obj && _depth == 3 && _inAssets) {
+        // New asset entry
+        _assetKey = KEY_OTHER;
+        _nameMatched = -1;
+        _candLen = 0;
+        _cand[0] = '\0';
+      }
+      break;
+    }
+    case '}':
+    case ']': {
+      if (_depth == 0 || topIsObject != (c == '}')) { _failed = true; return; }
+      if (topIsObject && _depth == 3 && _inAssets && _nameMatched >= 0 && _candLen > 0 &&
+          (_bestIndex < 0 || _nameMatched < _bestIndex)) {
+        memcpy(_url, _cand, _candLen + 1);
+        _bestIndex = _nameMatched;
+      }
+      if (!topIsObject && _depth == 2 && _inAssets) {
+        _inAssets = false;
+        _assetsDone = true;
+      }
+      _depth--;
+      _expectKey = false;
+      break;
+    }
+    case ':':
+      _expectKey = false;
+      break;
+    case ',':
+      _expectKey = topIsObject;
+      break;
+  }
+}
+
+void ReleaseParser::beginString() {
+  const bool topIsObject = _depth > 0 && ((_objMask >> (_depth - 1)) & 1u);
+  _inString = true;
+  _escape = 0;
+
+  if (_expectKey && topIsObject) {
+    _target = TGT_KEY;
+    _keyLen = 0;
+    _keyOverflow = false;
+    return;
+  }
+
+  _target = TGT_NONE;
+  if (_depth == 1 && _rootKey == KEY_TAG_NAME) {
+    _target = TGT_TAG;
+    _tagLen = 0;
+    _tagOverflow = false;
+  } else if (_depth == 3 && _inAssets && topIsObject) {
+    if (_assetKey == KEY_NAME) {
+      _target = TGT_NAME;
+      _namePos = 0;
+      _nameMismatch = 0;
+    } else if (_assetKey == KEY_URL) {
+      _target = TGT_URL;
+      _candLen = 0;
+      _candOverflow = false;
+    }
+  }
+}
+
+void ReleaseParser::endString() {
+  switch (_target) {
+    case TGT_KEY: {
+      Key k = classifyKey();
+      if (_depth == 1) _rootKey = k;
+      else if (_depth == 3 && _inAssets) _assetKey = k;
+      break;
+    }
+    case TGT_TAG:
+      if (_tagOverflow) _tagLen = 0;
+      _tag[_tagLen] = '\0';
+      break;
+    case TGT_NAME:
+      _nameMatched = -1;
+      for (uint8_t i = 0; i < _assetCount; ++i) {
+        if (!(_nameMismatch & (1u << i)) && _assetNames[i][_namePos] == '\0') {
+          _nameMatched = (int8_t)i;
+          break;
+        }
+      }
+      break;
+    case TGT_URL:
+      if (_candOverflow) _candLen = 0;
+      _cand[_candLen] = '\0';
+      break;
+    case TGT_NONE:
+      break;
+  }
+  _target = TGT_NONE;
+}
+
+void ReleaseParser::emit(uint8_t b) {
+  switch (_target) {
+    case TGT_KEY:
+      if (_keyLen < sizeof(_key)) _key[_keyLen++] = (char)b;
+      else _keyOverflow = true;
+      break;
+    case TGT_TAG:
+      if (_tagLen < TAG_MAX - 1) _tag[_tagLen++] = (char)b;
+      else _tagOverflow = true;
+      break;
+    case TGT_NAME:
+      // A candidate stays in the race while it matches byte for byte; the
+      // terminator check on a mismatch keeps reads inside each name.
+      for (uint8_t i = 0; i < _assetCount; ++i) {
+        if (_nameMismatch & (1u << i)) continue;
+        if ((uint8_t)_assetNames[i][_namePos] != b) _nameMismatch |= (uint8_t)(1u << i);
+      }
+      _namePos++;
+      break;
+    case TGT_URL:
+      if (_candLen < URL_MAX - 1) _cand[_candLen++] = (char)b;
+      else _candOverflow = true;
+      break;
+    case TGT_NONE:
+      break;
+  }
+}
+
+void ReleaseParser::emitCodepoint(uint32_t cp) {
+  // Lone/paired surrogates are not recombined; none of the values we
+  // extract (tags, file names, URLs) legitimately contain them.
+  if (cp >= 0xD800 && cp <= 0xDFFF) cp = 0xFFFD;
+  if (cp < 0x80) {
+    emit((uint8_t)cp);
+  } else if (cp < 0x800) {
+    emit((uint8_t)(0xC0 | (cp >> 6)));
+    emit((uint8_t)(0x80 | (cp & 0x3F)));
+  } else {
+    emit((uint8_t)(0xE0 | (cp >> 12)));
+    emit((uint8_t)(0x80 | ((cp >> 6) & 0x3F)));
+    emit((uint8_t)(0x80 | (cp & 0x3F)));
+  }
+}
+
+ReleaseParser::Key ReleaseParser::classifyKey() const {
+  if (_keyOverflow) return KEY_OTHER;
+  struct Entry { const char *name; uint8_t len; Key key; };
+  static const Entry kKeys[] = {
+    {"tag_name", 8, KEY_TAG_NAME},
+    {"assets", 6, KEY_ASSETS},
+    {"name", 4, KEY_NAME},
+    {"browser_download_url", 20, KEY_URL},
+  };
+  for (const Entry &e : kKeys) {
+    if (_keyLen == e.len && memcmp(_key, e.name, e.len) == 0) return e.key;
+  }
+  return KEY_OTHER;
+}
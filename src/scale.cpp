@@ -0,0 +1,216 @@
+// Hive scale implementation
+//
+// The HX711 pulls DOUT low when a conversion is ready. That edge runs an
+// interrupt handler which clocks the 24 bits out (about 55 us, interrupts
+// masked so SCK never stays high long enough to power the chip down) and
+// pushes the sample into a single-producer/single-consumer ring. The loop
+// task drains the ring every 100 ms through the WeightFilter chain.
+// Edges caused by our own clocking find DOUT high again and return at once.
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "scale.h"
+#include "weight_filter.h"
+#include "measurement.h"
+#include "trace.h"
+
+#define HS_LOG_PREFIX "SCALE"
+#include "debug.h"
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+// HX711 wiring (RATE pin high for 80 SPS)
+#ifndef SCALE_DOUT_PIN
+#define SCALE_DOUT_PIN 15
+#endif
+#ifndef SCALE_SCK_PIN
+#define SCALE_SCK_PIN 14
+#endif
+// Calibration: counts with the empty hive stand and counts per kg (0 =
+// uncalibrated, only w_v is published and BEEP applies its own)
+#ifndef SCALE_OFFSET
+#define SCALE_OFFSET 0
+#endif
+#ifndef SCALE_COUNTS_PER_KG
+#define SCALE_COUNTS_PER_KG 0
+#endif
+// Cell drift in counts per deg C around SCALE_TREF_C
+#ifndef SCALE_TEMPCO
+#define SCALE_TEMPCO 0
+#endif
+#ifndef SCALE_TREF_C
+#define SCALE_TREF_C 20
+#endif
+// Seconds between two settled weight reports
+#ifndef SCALE_PUBLISH_S
+#define SCALE_PUBLISH_S 300
+#endif
+
+namespace Scale {
+
+#if HS_SCALE
+
+static const uint32_t DETECT_MS = 200;     // a conversion takes 12.5 ms at 80 SPS
+static const uint8_t RING_SIZE = 64;       // power of two, 0.8 s of samples
+
+// The shared scale tuning with this build's temperature compensation
+static WeightFilter::Config filterConfig() {
+  WeightFilter::Config cfg = WeightFilter::SCALE_DEFAULTS;
+  cfg.tempco = SCALE_TEMPCO;
+  cfg.trefC100 = SCALE_TREF_C * 100;
+  return cfg;
+}
+
+// Interrupt handler -> loop task
+class SampleRing {
+public:
+  bool push(int32_t v) {
+    uint32_t h = _head.load(std::memory_order_relaxed);
+    if (h - _tail.load(std::memory_order_acquire) >= RING_SIZE) return false;
+    _slots[h & (RING_SIZE - 1)] = v;
+    _head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  bool pop(int32_t &v) {
+    uint32_t t = _tail.load(std::memory_order_relaxed);
+    if (t == _head.load(std::memory_order_acquire)) return false;
+    v = _slots[t & (RING_SIZE - 1)];
+    _tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  std::atomic<uint32_t> _head{0};
+  std::atomic<uint32_t> _tail{0};
+  int32_t _slots[RING_SIZE];
+};
+
+static SampleRing s_ring;
+static WeightFilter s_filter(filterConfig());
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t s_samples = 0;
+static volatile uint32_t s_overruns = 0;
+static uint32_t s_steps = 0;
+static uint32_t s_lastPublish = 0;
+static bool s_publishOnSettle = true; // first settle and after every step
+static bool s_found = false;
+
+static void IRAM_ATTR onDataReady() {
+  if (digitalRead(SCALE_DOUT_PIN)) return;
+  uint32_t v = 0;
+  portENTER_CRITICAL_ISR(&s_mux);
+  for (uint8_t i = 0; i < 24; ++i) {
+    digitalWrite(SCALE_SCK_PIN, HIGH);
+    delayMicroseconds(1);
+    v = (v << 1) | (uint32_t)digitalRead(SCALE_DOUT_PIN);
+    digitalWrite(SCALE_SCK_PIN, LOW);
+    delayMicroseconds(1);
+  }
+  // 25th pulse selects channel A, gain 128 for the next conversion
+  digitalWrite(SCALE_SCK_PIN, HIGH);
+  delayMicroseconds(1);
+  digitalWrite(SCALE_SCK_PIN, LOW);
+  portEXIT_CRITICAL_ISR(&s_mux);
+
+  s_samples = s_samples + 1;
+  if (!s_ring.push((int32_t)(v << 8) >> 8)) s_overruns = s_overruns + 1;
+}
+
+static void publish() {
+  int32_t counts = s_filter.value();
+  s_lastPublish = millis();
+  s_publishOnSettle = false;
+  Measurements::publish("w_v", (float)counts);
+#if SCALE_COUNTS_PER_KG != 0
+  float kg = (float)(counts - SCALE_OFFSET) / SCALE_COUNTS_PER_KG;
+  Measurements::publish("weight_kg", kg);
+  LOGF("Weight %.2f kg (%ld counts)\n", kg, (long)counts);
+#else
+  LOGF("Weight %ld counts (uncalibrated)\n", (long)counts);
+#endif
+}
+
+bool begin() {
+  pinMode(SCALE_SCK_PIN, OUTPUT);
+  digitalWrite(SCALE_SCK_PIN, LOW); // SCK high for > 60 us powers the HX711 down
+  pinMode(SCALE_DOUT_PIN, INPUT_PULLUP);
+  uint32_t start = millis();
+  while (digitalRead(SCALE_DOUT_PIN) && millis() - start < DETECT_MS) delay(1);
+  s_found = !digitalRead(SCALE_DOUT_PIN);
+  if (!s_found) {
+    LOGLN("HX711 not found");
+    return false;
+  }
+  attachInterrupt(digitalPinToInterrupt(SCALE_DOUT_PIN), onDataReady, FALLING);
+  LOGF("HX711 on DOUT=%d SCK=%d\n", SCALE_DOUT_PIN, SCALE_SCK_PIN);
+  return true;
+}
+
+void loop() {
+  if (!s_found) return;
+  TRACE_SPAN("scale.filter");
+  int32_t raw;
+  while (s_ring.pop(raw)) {
+    switch (s_filter.add(raw)) {
+      case WeightFilter::Event::Step:
+        s_steps++;
+        s_publishOnSettle = true;
+        LOGF("Load step %+ld counts\n", (long)s_filter.stepDelta());
+        break;
+      case WeightFilter::Event::Settled:
+        if (s_publishOnSettle) publish();
+        break;
+      case WeightFilter::Event::None:
+        break;
+    }
+  }
+  if (s_filter.settled() && millis() - s_lastPublish >= SCALE_PUBLISH_S * 1000UL) publish();
+}
+
+bool readSettled(uint32_t timeoutMs) {
+  if (!s_found) return false;
+  uint32_t start = millis();
+  int32_t raw;
+  while (millis() - start < timeoutMs) {
+    while (s_ring.pop(raw)) {
+      if (s_filter.add(raw) == WeightFilter::Event::Step) s_steps++;
+    }
+    if (s_filter.settled()) {
+      publish();
+      return true;
+    }
+    delay(10);
+  }
+  LOGF("No settled weight within %u ms\n", (unsigned)timeoutMs);
+  return false;
+}
+
+void setTemperature(float celsius) {
+  if (isfinite(celsius)) s_filter.setTemperature((int16_t)lrintf(celsius * 100.0f));
+}
+
+Stats stats() {
+  return Stats{s_samples, s_overruns, s_steps, s_filter.value(), s_filter.settled()};
+}
+
+#else
+
+bool begin() {
+  return false;
+}
+
+void loop() {}
+
+bool readSettled(uint32_t) {
+  return false;
+}
+
+void setTemperature(float) {}
+
+Stats stats() {
+  return Stats{0, 0, 0, 0, false};
+}
+
+#endif // HS_SCALE
+
+} // namespace Scale
@@ -0,0 +1,261 @@
+// Cooperative job scheduler implementation
+//
+// Jobs live in a static table and are hashed by deadline tick into a
+// 64-slot wheel (10 ms ticks, 640 ms per revolution); deadlines further
+// out carry a round counter. Advancing the wheel only touches the slots
+// whose ticks have passed, so the cost of a wakeup does not depend on how
+// many jobs are waiting. Between deadlines run() blocks on a task
+// notification instead of spinning on millis().
+
+#include <Arduino.h>
+
+#include "scheduler.h"
+
+#define HS_LOG_PREFIX "SCHED"
+#include "debug.h"
+
+namespace Scheduler {
+
+static const uint32_t TICK_MS = 10;
+static const uint8_t WHEEL_BITS = 6;
+static const uint16_t WHEEL_SLOTS = 1 << WHEEL_BITS;
+static const uint8_t MAX_JOBS = 16;
+static const uint32_t MAX_SLEEP_MS = 60000;
+static const uint8_t UNLINKED = 0xFF;
+
+struct Job {
+  const char *name;
+  JobFn fn;
+  uint32_t period;     // 0 = one-shot
+  uint32_t deadline;   // ms on the scheduler clock
+  uint32_t tick;       // wheel tick it was linked for
+  uint32_t rounds;     // wheel revolutions left before it is due
+  int8_t next;         // next job in the same slot, -1 = end
+  uint8_t slot;
+  bool active;
+  uint32_t runs;
+  uint32_t lateMax;    // worst lateness (ms) since the last report
+  uint32_t lateSum;
+};
+
+static Job s_jobs[MAX_JOBS];
+static int8_t s_slots[WHEEL_SLOTS];
+static bool s_initialized = false;
+static uint32_t s_tick = 0;        // last wheel tick processed
+static uint32_t (*s_clock)() = nullptr;
+static TaskHandle_t s_waiter = nullptr;
+static uint32_t s_wakeups = 0;
+static uint32_t s_statsSinceMs = 0;
+static volatile uint16_t s_triggered = 0;  // job bits set by triggerFromISR()
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t now() {
+  return s_clock ? s_clock() : millis();
+}
+
+static void init() {
+  if (s_initialized) return;
+  for (uint16_t i = 0; i < WHEEL_SLOTS; ++i) s_slots[i] = -1;
+  s_tick = now() / TICK_MS;
+  s_statsSinceMs = now();
+  s_initialized = true;
+}
+
+static void link(JobId id) {
+  Job &j = s_jobs[id];
+  uint32_t target = (j.deadline + TICK_MS - 1) / TICK_MS;
+  if ((int32_t)(target - s_tick) <= 0) target = s_tick + 1;
+  j.tick = target;
+  j.slot = target & (WHEEL_SLOTS - 1);
+  j.rounds = (target - s_tick - 1) >> WHEEL_BITS;
+  j.next = s_slots[j.slot];
+  s_slots[j.slot] = id;
+}
+
+static void unlink(JobId id) {
+  if (s_jobs[id].slot == UNLINKED) return;
+  int8_t *p = &s_slots[s_jobs[id].slot];
+  while (*p >= 0) {
+    if (*p == id) {
+      *p = s_jobs[id].next;
+      s_jobs[id].slot = UNLINKED;
+      return;
+    }
+    p = &s_jobs[*p].next;
+  }
+}
+
+static JobId add(const char *name, uint32_t delayMs, uint32_t periodMs, JobFn fn) {
+  init();
+  for (JobId id = 0; id < MAX_JOBS; ++id) {
+    Job &j = s_jobs[id];
+    if (j.active) continue;
+    j = Job();
+    j.name = name;
+    j.fn = fn;
+    j.period = periodMs;
+    j.deadline = now() + delayMs;
+    j.active = true;
+    link(id);
+    return id;
+  }
+  LOGF("No job slot for %s\n", name);
+  return -1;
+}
+
+JobId every(const char *name, uint32_t periodMs, JobFn fn, uint32_t firstDelayMs) {
+  return add(name, firstDelayMs, periodMs ? periodMs : TICK_MS, fn);
+}
+
+JobId after(const char *name, uint32_t delayMs, JobFn fn) {
+  return add(name, delayMs, 0, fn);
+}
+
+void reschedule(JobId id, uint32_t delayMs, uint32_t periodMs) {
+  if (id < 0 || id >= MAX_JOBS || !s_jobs[id].active) return;
+  unlink(id);
+  if (periodMs) s_jobs[id].period = periodMs;
+  s_jobs[id].deadline = now() + delayMs;
+  link(id);
+}
+
+void cancel(JobId id) {
+  if (id < 0 || id >= MAX_JOBS || !s_jobs[id].active) return;
+  unlink(id);
+  s_jobs[id].active = false;
+}
+
+// Run the jobs of one wheel slot whose rounds are used up. Due jobs are
+// collected first so callbacks can freely add, move or cancel jobs.
+static void processSlot(uint16_t slot) {
+  JobId due[MAX_JOBS];
+  uint8_t dueCount = 0;
+  int8_t id = s_slots[slot];
+  s_slots[slot] = -1;
+  while (id >= 0) {
+    Job &j = s_jobs[id];
+    int8_t next = j.next;
+    if (j.rounds > 0) {
+      j.rounds--;
+      j.next = s_slots[slot];
+      s_slots[slot] = id;
+    } else {
+      j.slot = UNLINKED;
+      due[dueCount++] = id;
+    }
+    id = next;
+  }
+
+  for (uint8_t i = 0; i < dueCount; ++i) {
+    Job &j = s_jobs[due[i]];
+    if (!j.active || j.slot != UNLINKED) continue; // cancelled or moved by an earlier job
+    uint32_t t = now();
+    uint32_t late = (int32_t)(t - j.deadline) > 0 ? t - j.deadline : 0;
+    if (late > j.lateMax) j.lateMax = late;
+    j.lateSum += late;
+    j.runs++;
+    // Re-arm before running so the job may reschedule or cancel itself
+    if (j.period) {
+      j.deadline += j.period;
+      if ((int32_t)(j.deadline - t) <= 0) j.deadline = t + j.period; // skip missed runs
+      link(due[i]);
+    } else {
+      j.active = false;
+    }
+    j.fn();
+  }
+}
+
+uint32_t runDue() {
+  init();
+  if (s_triggered) {
+    portENTER_CRITICAL(&s_mux);
+    uint16_t bits = s_triggered;
+    s_triggered = 0;
+    portEXIT_CRITICAL(&s_mux);
+    for (JobId id = 0; id < MAX_JOBS; ++id) {
+      if (bits & (1u << id)) reschedule(id, 0);
+    }
+  }
+  uint32_t target = now() / TICK_MS;
+  while ((int32_t)(target - s_tick) > 0) {
+    s_tick++;
+    processSlot(s_tick & (WHEEL_SLOTS - 1));
+  }
+
+  uint32_t t = now();
+  uint32_t wait = MAX_SLEEP_MS;
+  for (JobId id = 0; id < MAX_JOBS; ++id) {
+    const Job &j = s_jobs[id];
+    if (!j.active) continue;
+    // A job fires when the wheel reaches the tick it is linked in, which
+    // is never the current one; waiting for its raw deadline instead would
+    // spin until the next tick boundary
+    int32_t d = (int32_t)(j.tick * TICK_MS - t);
+    if (d <= 0) return 0;
+    if ((uint32_t)d < wait) wait = d;
+  }
+  return wait;
+}
+
+void run() {
+  uint32_t wait = runDue();
+  if (wait == 0) return;
+  s_waiter = xTaskGetCurrentTaskHandle();
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+  s_wakeups++;
+}
+
+void wake() {
+  if (s_waiter) xTaskNotifyGive(s_waiter);
+}
+
+void IRAM_ATTR wakeFromISR() {
+  if (!s_waiter) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(s_waiter, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+void IRAM_ATTR triggerFromISR(JobId id) {
+  if (id < 0 || id >= MAX_JOBS) return;
+  portENTER_CRITICAL_ISR(&s_mux);
+  s_triggered |= 1u << id;
+  portEXIT_CRITICAL_ISR(&s_mux);
+  wakeFromISR();
+}
+
+// Jobs keep the time they had left and are linked again on the new clock
+void setClock(uint32_t (*nowMs)()) {
+  uint32_t before = now();
+  s_clock = nowMs;
+  s_initialized = false;
+  init();
+  uint32_t t = now();
+  for (JobId id = 0; id < MAX_JOBS; ++id) {
+    Job &j = s_jobs[id];
+    if (!j.active) continue;
+    int32_t left = (int32_t)(j.deadline - before);
+    j.deadline = t + (left > 0 ? (uint32_t)left : 0);
+    link(id);
+  }
+}
+
+void logStats() {
+  uint32_t t = now();
+  uint32_t span = t - s_statsSinceMs;
+  if (span == 0) span = 1;
+  LOGF("Wakeups: %u in %u s (%u/h)\n", (unsigned)s_wakeups, (unsigned)(span / 1000),
+       (unsigned)((uint64_t)s_wakeups * 3600000ULL / span));
+  for (JobId id = 0; id < MAX_JOBS; ++id) {
+    Job &j = s_jobs[id];
+    if (!j.active || j.runs == 0) continue;
+    LOGF("  %-10s runs=%u late avg=%u max=%u ms\n", j.name, (unsigned)j.runs,
+         (unsigned)(j.lateSum / j.runs), (unsigned)j.lateMax);
+    j.runs = j.lateSum = j.lateMax = 0;
+  }
+  s_wakeups = 0;
+  s_statsSinceMs = t;
+}
+
+} // namespace Scheduler
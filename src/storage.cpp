@@ -0,0 +1,34 @@
+// LittleFS data partition implementation
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include "storage.h"
+
+#define HS_LOG_PREFIX "FS"
+#include "debug.h"
+
+namespace Storage {
+
+// Partition label from partitions/hivesync_ota_4mb_littlefs.csv
+static const char *PARTITION_LABEL = "littlefs";
+static bool s_mounted = false;
+static bool s_tried = false;
+
+bool begin() {
+  if (s_tried) return s_mounted;
+  s_tried = true;
+  s_mounted = LittleFS.begin(true, "/littlefs", 4, PARTITION_LABEL);
+  if (s_mounted) {
+    LOGF("Mounted: %u/%u bytes used\n", (unsigned)LittleFS.usedBytes(), (unsigned)LittleFS.totalBytes());
+  } else {
+    LOGLN("Mount failed");
+  }
+  return s_mounted;
+}
+
+bool mounted() {
+  return s_mounted;
+}
+
+} // namespace Storage
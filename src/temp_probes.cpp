@@ -0,0 +1,173 @@
+// Hive temperature probes implementation
+//
+// One round is a Skip ROM convert-all, which every probe starts at the same
+// time, and a one-shot scheduler job CONVERT_MS later that reads each
+// cached ROM's scratchpad. The loop task is only busy for the bus traffic
+// (about 10 ms per probe), never for the conversion itself, so a round
+// costs one conversion window however many probes hang on the chain.
+// ROM IDs are searched once and again only after a probe failed to answer.
+// Probes must be powered from 3V3; parasite power is not supported.
+
+#include <Arduino.h>
+
+#include "temp_probes.h"
+#include "ds18b20.h"
+#include "measurement.h"
+#include "scale.h"
+#include "scheduler.h"
+
+#define HS_LOG_PREFIX "TEMP"
+#include "debug.h"
+
+#if HS_TEMP_PROBES
+#include <driver/gpio.h>
+#endif
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+// 1-Wire data pin, with a 4.7 k pull-up to 3V3
+#ifndef TEMP_ONEWIRE_PIN
+#define TEMP_ONEWIRE_PIN 6
+#endif
+// Probe (t_N) whose reading feeds the scale's drift compensation
+#ifndef TEMP_SCALE_PROBE
+#define TEMP_SCALE_PROBE 0
+#endif
+
+namespace TempProbes {
+
+#if HS_TEMP_PROBES
+
+static const int16_t POWER_ON_CENTI_C = 8500; // scratchpad value before any conversion
+
+static portMUX_TYPE s_busMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Standard-speed 1-Wire slots, bit-banged on an open-drain pin. Each slot
+// runs with interrupts masked so a preempting task cannot stretch it.
+class GpioBus : public Ds18b20::Bus {
+public:
+  explicit GpioBus(gpio_num_t pin) : _pin(pin) {}
+
+  void begin() {
+    gpio_reset_pin(_pin);
+    gpio_set_direction(_pin, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_pull_mode(_pin, GPIO_PULLUP_ONLY);
+    gpio_set_level(_pin, 1);
+  }
+
+  bool reset() override {
+    gpio_set_level(_pin, 0);
+    delayMicroseconds(480); // a longer low is harmless
+    portENTER_CRITICAL(&s_busMux);
+    gpio_set_level(_pin, 1);
+    delayMicroseconds(70);
+    bool presence = gpio_get_level(_pin) == 0;
+    portEXIT_CRITICAL(&s_busMux);
+    delayMicroseconds(410);
+    return presence;
+  }
+
+  void writeBit(bool bit) override {
+    portENTER_CRITICAL(&s_busMux);
+    gpio_set_level(_pin, 0);
+    delayMicroseconds(bit ? 6 : 60);
+    gpio_set_level(_pin, 1);
+    portEXIT_CRITICAL(&s_busMux);
+    delayMicroseconds(bit ? 64 : 10);
+  }
+
+  bool readBit() override {
+    portENTER_CRITICAL(&s_busMux);
+    gpio_set_level(_pin, 0);
+    delayMicroseconds(6);
+    gpio_set_level(_pin, 1);
+    delayMicroseconds(9);
+    bool bit = gpio_get_level(_pin) != 0;
+    portEXIT_CRITICAL(&s_busMux);
+    delayMicroseconds(55);
+    return bit;
+  }
+
+private:
+  gpio_num_t _pin;
+};
+
+static GpioBus s_bus((gpio_num_t)TEMP_ONEWIRE_PIN);
+static uint8_t s_roms[MAX_PROBES][Ds18b20::ROM_LEN];
+static uint8_t s_count = 0;
+static bool s_rescan = false;
+static bool s_converting = false;
+static Stats s_stats = {0, 0, 0, 0};
+
+static void scan() {
+  s_count = Ds18b20::search(s_bus, s_roms, MAX_PROBES);
+  s_stats.probes = s_count;
+  s_rescan = false;
+  LOGF("%u probe(s) on GPIO %d\n", (unsigned)s_count, TEMP_ONEWIRE_PIN);
+}
+
+static void collect() {
+  s_converting = false;
+  s_stats.rounds++;
+  char key[4] = {'t', '_', '0', '\0'};
+  for (uint8_t i = 0; i < s_count; ++i) {
+    int16_t centiC;
+    // A probe that browned out during the conversion still holds 85.00
+    if (!Ds18b20::readCentiC(s_bus, s_roms[i], centiC) || centiC == POWER_ON_CENTI_C) {
+      s_stats.badReads++;
+      s_rescan = true;
+      LOGF("Probe t_%u did not answer\n", (unsigned)i);
+      continue;
+    }
+    float celsius = centiC / 100.0f;
+    key[2] = (char)('0' + i);
+    Measurements::publish(key, celsius);
+    if (i == TEMP_SCALE_PROBE) Scale::setTemperature(celsius);
+  }
+}
+
+bool begin() {
+  s_bus.begin();
+  scan();
+  return s_count > 0;
+}
+
+void sample() {
+  if (s_converting) return;
+  if (s_rescan) {
+    s_stats.rescans++;
+    scan();
+  }
+  if (!s_count || !Ds18b20::convertAll(s_bus)) {
+    s_rescan = true;
+    return;
+  }
+  s_converting = Scheduler::after("temp.read", Ds18b20::CONVERT_MS, collect) >= 0;
+}
+
+void sampleNow() {
+  if (!s_count || !Ds18b20::convertAll(s_bus)) return;
+  delay(Ds18b20::CONVERT_MS);
+  collect();
+}
+
+Stats stats() {
+  return s_stats;
+}
+
+#else
+
+bool begin() {
+  return false;
+}
+
+void sample() {}
+
+void sampleNow() {}
+
+Stats stats() {
+  return Stats{0, 0, 0, 0};
+}
+
+#endif // HS_TEMP_PROBES
+
+} // namespace TempProbes
@@ -0,0 +1,465 @@
+// Compressed time-series store implementation
+//
+// Each channel (BEEP key) fills a 256-byte block in RAM, encoded column-wise
+// in the style of Facebook's Gorilla: timestamps as delta-of-delta with
+// variable-length prefixes, values as the XOR against the previous value
+// with a reused leading/trailing-zero window. A slowly changing reading
+// costs 2-3 bits per sample instead of the ~30 bytes of a JSON line.
+// Full blocks are sealed under the lock and written by loop(), so sinks
+// never touch flash. Sealed blocks are appended once to 32 KB segment
+// files that are never rewritten; when the segment budget is exceeded the
+// oldest whole file is deleted, which keeps wear to one erase per block
+// lifetime and leaves wear levelling to LittleFS.
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <esp_rom_crc.h>
+
+#include "timeseries.h"
+#include "measurement.h"
+#include "storage.h"
+
+#define HS_LOG_PREFIX "TSDB"
+#include "debug.h"
+
+// Segment files kept on flash (32 KB each)
+#ifndef TS_MAX_SEGMENTS
+#define TS_MAX_SEGMENTS 16
+#endif
+// Keys recorded at once, ~300 bytes of RAM each. The built-in sensors
+// publish 24 (s_bin* and s_tot, bv, w_v, weight_kg, t_0..t_9); every BLE
+// tag adds up to four more (t_, h_, p_, bv_ plus its MAC suffix), so the
+// default leaves room for two tags; see timeseries.h.
+#ifndef TS_MAX_CHANNELS
+#define TS_MAX_CHANNELS 32
+#endif
+
+namespace TimeSeries {
+
+static const char *DIR_PATH = "/ts";
+static const uint32_t SEG_BYTES = 32 * 1024;
+static const uint16_t BLOCK_BYTES = 256;
+static const uint16_t BLOCK_BITS = BLOCK_BYTES * 8;
+static const uint8_t MAX_POINT_BITS = 4 + 32 + 2 + 5 + 5 + 32;  // worst-case encoded point
+static const uint32_t BLOCK_MAX_SPAN_S = 6 * 3600;  // seal older blocks to bound loss on reset
+static const uint8_t MAX_CHANNELS = TS_MAX_CHANNELS;
+static const uint8_t SEALED_CAP = 4;
+static const uint16_t BLOCK_MAGIC = 0x5354;  // "TS"
+static const uint8_t NO_WINDOW = 0xFF;
+
+struct BlockHeader {
+  uint16_t magic;
+  uint16_t count;     // points in the block
+  uint16_t bytes;     // payload length
+  uint16_t reserved;
+  uint32_t t0;        // first timestamp
+  uint32_t t1;        // last timestamp
+  uint32_t crc;       // CRC-32 of the payload
+  char key[16];
+};
+static_assert(sizeof(BlockHeader) == 36, "segment layout");
+
+struct Block {
+  BlockHeader hdr;
+  uint8_t data[BLOCK_BYTES];
+};
+
+// Open block plus encoder state of one channel
+struct Channel {
+  Block block;
+  uint16_t bitPos;
+  uint32_t prevTs;
+  uint32_t prevDelta;
+  uint32_t prevBits;
+  uint8_t prevLead;
+  uint8_t prevTrail;
+};
+
+static_assert(TS_MAX_CHANNELS > 0 && TS_MAX_CHANNELS < 256, "TS_MAX_CHANNELS out of range");
+
+static Channel s_channels[MAX_CHANNELS];
+static uint8_t s_channelCount = 0;
+static bool s_refusedLogged = false;
+static Block s_sealed[SEALED_CAP];
+static uint8_t s_sealedHead = 0;
+static uint8_t s_sealedCount = 0;
+static Block s_io;  // scratch for loop()/query()
+static SemaphoreHandle_t s_lock = nullptr;
+
+static uint32_t s_segFirst = 0;  // oldest segment id on flash
+static uint32_t s_segLast = 0;   // segment currently appended to
+static uint32_t s_segBytes = 0;
+static bool s_haveSegments = false;
+static Stats s_stats = {0, 0, 0, 0, 0};
+
+// ---- Bit packing (MSB first) ----
+
+static void putBits(Channel &c, uint32_t v, uint8_t n) {
+  while (n) {
+    uint8_t room = 8 - (c.bitPos & 7);
+    uint8_t take = n < room ? n : room;
+    uint8_t bits = (uint8_t)((v >> (n - take)) & ((1u << take) - 1));
+    c.block.data[c.bitPos >> 3] |= bits << (room - take);
+    c.bitPos += take;
+    n -= take;
+  }
+}
+
+class BitReader {
+public:
+  BitReader(const uint8_t *data, uint16_t bytes) : _data(data), _end((uint32_t)bytes * 8), _pos(0) {}
+  bool get(uint8_t n, uint32_t &out) {
+    if (_pos + n > _end) return false;
+    out = 0;
+    while (n) {
+      uint8_t room = 8 - (_pos & 7);
+      uint8_t take = n < room ? n : room;
+      uint8_t bits = (_data[_pos >> 3] >> (room - take)) & ((1u << take) - 1);
+      out = (out << take) | bits;
+      _pos += take;
+      n -= take;
+    }
+    return true;
+  }
+
+private:
+  const uint8_t *_data;
+  uint32_t _end;
+  uint32_t _pos;
+};
+
+// ---- Encoder ----
+
+static void startBlock(Channel &c) {
+  memset(c.block.data, 0, sizeof(c.block.data));
+  c.block.hdr.count = 0;
+  c.bitPos = 0;
+}
+
+// Move the open block of c to the write queue (lock held)
+static void seal(Channel &c) {
+  if (c.block.hdr.count == 0) return;
+  if (s_sealedCount == SEALED_CAP) {
+    // loop() fell behind; losing this block beats blocking the producer
+    s_stats.skipped += c.block.hdr.count;
+  } else {
+    Block &b = s_sealed[(s_sealedHead + s_sealedCount) % SEALED_CAP];
+    b = c.block;
+    b.hdr.magic = BLOCK_MAGIC;
+    b.hdr.bytes = (c.bitPos + 7) / 8;
+    b.hdr.reserved = 0;
+    b.hdr.crc = esp_rom_crc32_le(0, b.data, b.hdr.bytes);
+    s_sealedCount++;
+  }
+  startBlock(c);
+}
+
+static void append(Channel &c, uint32_t ts, float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  BlockHeader &h = c.block.hdr;
+  if (h.count && (ts < c.prevTs || ts - h.t0 > BLOCK_MAX_SPAN_S ||
+                  c.bitPos + MAX_POINT_BITS > BLOCK_BITS)) {
+    seal(c);
+  }
+
+  if (h.count == 0) {
+    putBits(c, ts, 32);
+    putBits(c, bits, 32);
+    h.t0 = ts;
+    c.prevDelta = 0;
+    c.prevLead = NO_WINDOW;
+    c.prevTrail = 0;
+  } else {
+    // Timestamp: delta-of-delta in the smallest bucket that holds it
+    uint32_t delta = ts - c.prevTs;
+    int32_t dod = (int32_t)(delta - c.prevDelta);
+    if (dod == 0) {
+      putBits(c, 0x0, 1);
+    } else if (dod >= -63 && dod <= 64) {
+      putBits(c, 0x2, 2);
+      putBits(c, (uint32_t)(dod + 63), 7);
+    } else if (dod >= -255 && dod <= 256) {
+      putBits(c, 0x6, 3);
+      putBits(c, (uint32_t)(dod + 255), 9);
+    } else if (dod >= -2047 && dod <= 2048) {
+      putBits(c, 0xE, 4);
+      putBits(c, (uint32_t)(dod + 2047), 12);
+    } else {
+      putBits(c, 0xF, 4);
+      putBits(c, (uint32_t)dod, 32);
+    }
+    c.prevDelta = delta;
+
+    // Value: XOR with the previous one, meaningful bits only
+    uint32_t x = bits ^ c.prevBits;
+    if (x == 0) {
+      putBits(c, 0x0, 1);
+    } else {
+      uint8_t lead = (uint8_t)__builtin_clz(x);
+      uint8_t trail = (uint8_t)__builtin_ctz(x);
+      if (c.prevLead != NO_WINDOW && lead >= c.prevLead && trail >= c.prevTrail) {
+        putBits(c, 0x2, 2);
+        putBits(c, x >> c.prevTrail, 32 - c.prevLead - c.prevTrail);
+      } else {
+        uint8_t len = 32 - lead - trail;
+        putBits(c, 0x3, 2);
+        putBits(c, lead, 5);
+        putBits(c, len - 1, 5);
+        putBits(c, x >> trail, len);
+        c.prevLead = lead;
+        c.prevTrail = trail;
+      }
+    }
+  }
+  c.prevTs = ts;
+  c.prevBits = bits;
+  h.t1 = ts;
+  h.count++;
+}
+
+// ---- Decoder ----
+
+// Visit the points of one block within [from, to]; false if it is corrupt
+static bool decodeBlock(const uint8_t *data, uint16_t bytes, uint16_t count,
+                        uint32_t from, uint32_t to, PointFn fn, void *ctx, uint32_t &visited) {
+  BitReader r(data, bytes);
+  uint32_t ts, bits, delta = 0;
+  uint8_t lead = 0, trail = 0;
+  if (!r.get(32, ts) || !r.get(32, bits)) return false;
+  for (uint16_t i = 0;; ++i) {
+    if (ts >= from && ts <= to) {
+      float v;
+      memcpy(&v, &bits, sizeof(v));
+      fn(ts, v, ctx);
+      visited++;
+    }
+    if (i + 1 >= count || ts > to) return true;
+
+    uint32_t b, v;
+    int32_t dod = 0;
+    if (!r.get(1, b)) return false;
+    if (b) {
+      uint8_t prefix = 1;  // count the leading ones of the bucket code
+      while (prefix < 4) {
+        if (!r.get(1, b)) return false;
+        if (!b) break;
+        prefix++;
+      }
+      static const uint8_t kWidth[] = {0, 7, 9, 12, 32};
+      static const int32_t kBias[] = {0, 63, 255, 2047, 0};
+      if (!r.get(kWidth[prefix], v)) return false;
+      dod = (int32_t)v - kBias[prefix];
+    }
+    delta += (uint32_t)dod;
+    ts += delta;
+
+    if (!r.get(1, b)) return false;
+    if (b) {
+      if (!r.get(1, b)) return false;
+      if (b) {
+        uint32_t l, len;
+        if (!r.get(5, l) || !r.get(5, len)) return false;
+        lead = (uint8_t)l;
+        trail = (uint8_t)(32 - lead - (len + 1));
+      }
+      if (!r.get(32 - lead - trail, v)) return false;
+      bits ^= v << trail;
+    }
+  }
+}
+
+// ---- Segments ----
+
+static void segmentPath(char *out, size_t len, uint32_t id) {
+  snprintf(out, len, "%s/%08u.seg", DIR_PATH, (unsigned)id);
+}
+
+static void scanSegments() {
+  File dir = LittleFS.open(DIR_PATH);
+  if (!dir || !dir.isDirectory()) {
+    LittleFS.mkdir(DIR_PATH);
+    return;
+  }
+  for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+    const char *name = strrchr(f.name(), '/');
+    name = name ? name + 1 : f.name();
+    char *end;
+    unsigned long id = strtoul(name, &end, 10);
+    if (end == name || strcmp(end, ".seg") != 0) continue;
+    if (!s_haveSegments || id < s_segFirst) s_segFirst = id;
+    if (!s_haveSegments || id >= s_segLast) {
+      s_segLast = id;
+      s_segBytes = f.size();
+    }
+    s_haveSegments = true;
+  }
+}
+
+static void writeBlock(const Block &b) {
+  uint32_t size = sizeof(BlockHeader) + b.hdr.bytes;
+  if (!s_haveSegments) {
+    s_haveSegments = true;
+    s_segFirst = s_segLast = 0;
+    s_segBytes = 0;
+  } else if (s_segBytes + size > SEG_BYTES) {
+    s_segLast++;
+    s_segBytes = 0;
+  }
+  char path[24];
+  while (s_segLast - s_segFirst + 1 > TS_MAX_SEGMENTS) {
+    segmentPath(path, sizeof(path), s_segFirst++);
+    LittleFS.remove(path);
+    LOGF("Rotated out %s\n", path);
+  }
+  segmentPath(path, sizeof(path), s_segLast);
+  File f = LittleFS.open(path, FILE_APPEND);
+  if (!f) {
+    LOGF("Cannot open %s\n", path);
+    return;
+  }
+  size_t n = f.write((const uint8_t *)&b, size);
+  f.close();
+  // A torn write ends the segment for readers; continue in a fresh one
+  s_segBytes += n;
+  if (n != size) s_segBytes = SEG_BYTES;
+  s_stats.blocks++;
+  s_stats.flashBytes += n;
+}
+
+// Write sealed blocks; called from loop() and query() (loop task only)
+static void writePending() {
+  for (;;) {
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    bool have = s_sealedCount > 0;
+    if (have) {
+      s_io = s_sealed[s_sealedHead];
+      s_sealedHead = (s_sealedHead + 1) % SEALED_CAP;
+      s_sealedCount--;
+    }
+    xSemaphoreGive(s_lock);
+    if (!have) return;
+    writeBlock(s_io);
+  }
+}
+
+static uint32_t querySegment(uint32_t id, const char *key, uint32_t from, uint32_t to, PointFn fn, void *ctx) {
+  char path[24];
+  segmentPath(path, sizeof(path), id);
+  File f = LittleFS.open(path, FILE_READ);
+  if (!f) return 0;
+  uint32_t visited = 0;
+  for (;;) {
+    BlockHeader &h = s_io.hdr;
+    if (f.read((uint8_t *)&h, sizeof(h)) != sizeof(h)) break;
+    if (h.magic != BLOCK_MAGIC || h.bytes > BLOCK_BYTES || h.count == 0) break;
+    if (h.t1 < from || h.t0 > to || strncmp(h.key, key, sizeof(h.key)) != 0) {
+      if (!f.seek(f.position() + h.bytes)) break;
+      continue;
+    }
+    if (f.read(s_io.data, h.bytes) != h.bytes) break;
+    if (esp_rom_crc32_le(0, s_io.data, h.bytes) != h.crc) {
+      LOGF("CRC mismatch in %s\n", path);
+      continue;
+    }
+    if (!decodeBlock(s_io.data, h.bytes, h.count, from, to, fn, ctx, visited)) {
+      LOGF("Corrupt block in %s\n", path);
+    }
+  }
+  f.close();
+  return visited;
+}
+
+// ---- Public API ----
+
+static void onMeasurement(const Measurement &m) {
+  if (m.time == 0 || xSemaphoreTake(s_lock, pdMS_TO_TICKS(10)) != pdTRUE) {
+    s_stats.skipped++;
+    return;
+  }
+  Channel *c = nullptr;
+  for (uint8_t i = 0; i < s_channelCount && !c; ++i) {
+    if (strncmp(s_channels[i].block.hdr.key, m.key, sizeof(m.key)) == 0) c = &s_channels[i];
+  }
+  if (!c && s_channelCount < MAX_CHANNELS) {
+    c = &s_channels[s_channelCount++];
+    memset(&c->block.hdr, 0, sizeof(c->block.hdr));
+    strlcpy(c->block.hdr.key, m.key, sizeof(c->block.hdr.key));
+    startBlock(*c);
+  }
+  if (c) {
+    append(*c, m.time, m.value);
+    s_stats.points++;
+  } else {
+    s_stats.skipped++;
+  }
+  bool logRefused = !c && !s_refusedLogged;
+  if (logRefused) s_refusedLogged = true;
+  xSemaphoreGive(s_lock);
+  if (logRefused) LOGF("All %u channels in use, not recording %s (raise TS_MAX_CHANNELS)\n", (unsigned)MAX_CHANNELS, m.key);
+}
+
+bool begin() {
+  if (s_lock) return true;
+  if (!Storage::begin()) {
+    LOGLN("No storage; time series disabled");
+    return false;
+  }
+  s_lock = xSemaphoreCreateMutex();
+  if (!s_lock) return false;
+  scanSegments();
+  LOGF("Segments %u..%u, current %u bytes\n", (unsigned)s_segFirst, (unsigned)s_segLast, (unsigned)s_segBytes);
+  return Measurements::subscribe(onMeasurement);
+}
+
+void loop() {
+  if (!s_lock || s_sealedCount == 0) return;
+  writePending();
+}
+
+// One channel at a time: sealing them all at once would overflow the
+// write queue as soon as more than SEALED_CAP channels have open blocks
+void flush() {
+  if (!s_lock) return;
+  for (uint8_t i = 0;; ++i) {
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    bool more = i < s_channelCount;
+    if (more) seal(s_channels[i]);
+    xSemaphoreGive(s_lock);
+    if (!more) return;
+    writePending();
+  }
+}
+
+uint32_t query(const char *key, uint32_t from, uint32_t to, PointFn fn, void *ctx) {
+  if (!s_lock) return 0;
+  writePending();
+  uint32_t visited = 0;
+  if (s_haveSegments) {
+    for (uint32_t id = s_segFirst; id <= s_segLast; ++id) visited += querySegment(id, key, from, to, fn, ctx);
+  }
+  // Points still in RAM are newer than anything on flash
+  bool found = false;
+  uint16_t bytes = 0;
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  for (uint8_t i = 0; i < s_channelCount; ++i) {
+    Channel &c = s_channels[i];
+    if (strncmp(c.block.hdr.key, key, sizeof(c.block.hdr.key)) == 0 && c.block.hdr.count) {
+      s_io = c.block;
+      bytes = (c.bitPos + 7) / 8;
+      found = true;
+      break;
+    }
+  }
+  xSemaphoreGive(s_lock);
+  if (found) decodeBlock(s_io.data, bytes, s_io.hdr.count, from, to, fn, ctx, visited);
+  return visited;
+}
+
+Stats stats() {
+  Stats st = s_stats;
+  st.segments = s_haveSegments ? (uint16_t)(s_segLast - s_segFirst + 1) : 0;
+  return st;
+}
+
+} // namespace TimeSeries
@@ -0,0 +1,204 @@
+// TLS client implementation
+//
+// The TCP side is the WiFiClient base; mbedTLS runs on top of it through
+// the bio callbacks below. After each handshake the negotiated session
+// (ID, master secret and the server's ticket, if it issued one) is copied
+// out with mbedtls_ssl_get_session() and offered on the next connection
+// with mbedtls_ssl_set_session(). A server that still knows the session
+// skips the certificate and key exchange: one round trip less and no
+// ECDHE/RSA work on the ESP32, which is most of a full handshake's cost.
+// The ssl context and its record buffers only exist while connected; the
+// session survives stop().
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/version.h>
+
+#include "tls_client.h"
+
+#define HS_LOG_PREFIX "TLS"
+#include "debug.h"
+
+// The resumption check below compares mbedtls_ssl_session::master, a
+// public field only up to mbedTLS 2.x; platformio.ini pins the platform
+#if MBEDTLS_VERSION_NUMBER >= 0x03000000
+#error "TlsClient needs mbedTLS 2.x (Arduino-ESP32 2.x); see platformio.ini"
+#endif
+
+static const uint32_t DEFAULT_TIMEOUT_MS = 15000;
+static const char PERS[] = "hivesync-tls";
+
+TlsClient::TlsClient() {
+  mbedtls_ssl_session_init(&_session);
+  mbedtls_entropy_init(&_entropy);
+  mbedtls_ctr_drbg_init(&_drbg);
+}
+
+TlsClient::~TlsClient() {
+  stop();
+  mbedtls_ssl_session_free(&_session);
+  mbedtls_ctr_drbg_free(&_drbg);
+  mbedtls_entropy_free(&_entropy);
+}
+
+int TlsClient::bioSend(void *ctx, const unsigned char *buf, size_t len) {
+  TlsClient *c = static_cast<TlsClient *>(ctx);
+  if (!c->WiFiClient::connected()) return MBEDTLS_ERR_NET_CONN_RESET;
+  size_t n = c->WiFiClient::write(buf, len);
+  return n ? (int)n : MBEDTLS_ERR_NET_SEND_FAILED;
+}
+
+// Returns 0 (EOF) once the socket is closed and drained
+int TlsClient::bioRecv(void *ctx, unsigned char *buf, size_t len) {
+  TlsClient *c = static_cast<TlsClient *>(ctx);
+  int avail = c->WiFiClient::available();
+  if (avail <= 0) return c->WiFiClient::connected() ? MBEDTLS_ERR_SSL_WANT_READ : 0;
+  int n = c->WiFiClient::read(buf, len < (size_t)avail ? len : (size_t)avail);
+  return n > 0 ? n : MBEDTLS_ERR_SSL_WANT_READ;
+}
+
+int TlsClient::connect(const char *host, uint16_t port, int32_t timeoutMs) {
+  stop();
+  _resumed = false;
+  _timeoutMs = timeoutMs > 0 ? (uint32_t)timeoutMs : DEFAULT_TIMEOUT_MS;
+  if (!_seeded) {
+    if (mbedtls_ctr_drbg_seed(&_drbg, mbedtls_entropy_func, &_entropy,
+                              (const unsigned char *)PERS, sizeof(PERS) - 1) != 0) {
+      return 0;
+    }
+    _seeded = true;
+  }
+  uint32_t t0 = millis();
+  if (!WiFiClient::connect(host, port, (int32_t)_timeoutMs)) return 0;
+
+  mbedtls_ssl_init(&_ssl);
+  mbedtls_ssl_config_init(&_conf);
+  _tls = true;
+  int ret = mbedtls_ssl_config_defaults(&_conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                        MBEDTLS_SSL_PRESET_DEFAULT);
+  if (ret == 0) {
+    // NOTE: certificates are not verified; consider pinning for production
+    mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_NONE);
+    mbedtls_ssl_conf_rng(&_conf, mbedtls_ctr_drbg_random, &_drbg);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedtls_ssl_conf_session_tickets(&_conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+    ret = mbedtls_ssl_setup(&_ssl, &_conf);
+  }
+  if (ret == 0) ret = mbedtls_ssl_set_hostname(&_ssl, host);
+  if (ret == 0) {
+    mbedtls_ssl_set_bio(&_ssl, this, bioSend, bioRecv, nullptr);
+    if (_haveSession) ret = mbedtls_ssl_set_session(&_ssl, &_session);
+  }
+  while (ret == 0 && (ret = mbedtls_ssl_handshake(&_ssl)) != 0) {
+    if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) break;
+    if (millis() - t0 > _timeoutMs) {
+      ret = MBEDTLS_ERR_SSL_TIMEOUT;
+      break;
+    }
+    ret = 0;
+    delay(1);
+  }
+  if (ret != 0) {
+    LOGF("Handshake with %s failed: -0x%04x\n", host, (unsigned)-ret);
+    // Some servers abort on a session they cannot resume; start afresh
+    forgetSession();
+    stop();
+    return 0;
+  }
+
+  mbedtls_ssl_session fresh;
+  mbedtls_ssl_session_init(&fresh);
+  if (mbedtls_ssl_get_session(&_ssl, &fresh) == 0) {
+    // A resumed handshake keeps the cached master secret; a full one
+    // derives a new one
+    _resumed = _haveSession && memcmp(fresh.master, _session.master, sizeof(fresh.master)) == 0;
+    mbedtls_ssl_session_free(&_session);
+    _session = fresh;  // takes over the copy's ticket and certificate
+    _haveSession = true;
+  } else {
+    mbedtls_ssl_session_free(&fresh);
+  }
+  return 1;
+}
+
+// Decrypted bytes ready to read, pulling in the next record when empty
+size_t TlsClient::pending() {
+  if (!_tls) return 0;
+  size_t n = mbedtls_ssl_get_bytes_avail(&_ssl);
+  if (n || _eof) return n;
+  int ret = mbedtls_ssl_read(&_ssl, nullptr, 0);
+  if (ret < 0 && ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) _eof = true;
+  return mbedtls_ssl_get_bytes_avail(&_ssl);
+}
+
+uint8_t TlsClient::connected() {
+  if (!_tls) return 0;
+  if (_peek >= 0 || mbedtls_ssl_get_bytes_avail(&_ssl)) return 1;
+  return !_eof && WiFiClient::connected();
+}
+
+int TlsClient::available() {
+  return (int)pending() + (_peek >= 0 ? 1 : 0);
+}
+
+int TlsClient::read(uint8_t *buf, size_t size) {
+  if (!size) return 0;
+  size_t got = 0;
+  if (_peek >= 0) {
+    buf[got++] = (uint8_t)_peek;
+    _peek = -1;
+  }
+  if (got < size && pending()) {
+    int ret = mbedtls_ssl_read(&_ssl, buf + got, size - got);
+    if (ret > 0) got += ret;
+  }
+  return got ? (int)got : -1;
+}
+
+int TlsClient::read() {
+  uint8_t b;
+  return read(&b, 1) == 1 ? b : -1;
+}
+
+int TlsClient::peek() {
+  uint8_t b;
+  if (_peek < 0 && pending() && mbedtls_ssl_read(&_ssl, &b, 1) == 1) _peek = b;
+  return _peek;
+}
+
+size_t TlsClient::write(const uint8_t *buf, size_t size) {
+  if (!_tls || _eof) return 0;
+  size_t sent = 0;
+  uint32_t t0 = millis();
+  while (sent < size) {
+    int ret = mbedtls_ssl_write(&_ssl, buf + sent, size - sent);
+    if (ret > 0) {
+      sent += ret;
+      continue;
+    }
+    if (ret != MBEDTLS_ERR_SSL_WANT_WRITE && ret != MBEDTLS_ERR_SSL_WANT_READ) break;
+    if (millis() - t0 > _timeoutMs) break;
+    delay(1);
+  }
+  return sent;
+}
+
+void TlsClient::stop() {
+  if (_tls) {
+    if (!_eof && WiFiClient::connected()) mbedtls_ssl_close_notify(&_ssl);
+    mbedtls_ssl_free(&_ssl);
+    mbedtls_ssl_config_free(&_conf);
+    _tls = false;
+  }
+  _eof = false;
+  _peek = -1;
+  WiFiClient::stop();
+}
+
+void TlsClient::forgetSession() {
+  mbedtls_ssl_session_free(&_session);
+  mbedtls_ssl_session_init(&_session);
+  _haveSession = false;
+}
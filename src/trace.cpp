@@ -0,0 +1,137 @@
+// Tracing implementation
+//
+// A span costs two cycle-counter reads plus one short critical section to
+// bump its site's bucket; sites live in static memory next to the code they
+// time and link themselves into a list the first time they record. Cycle
+// counts are per core, so spans must begin and end on the same core: only
+// place them in pinned tasks (loop, OTA reader/writer, UI, audio, and the
+// Wi-Fi event and Bluetooth host tasks). Spans longer than the counter's
+// wrap (~17 s at 240 MHz) are not meaningful.
+
+#include <string.h>
+#include <Print.h>
+
+#include "trace.h"
+
+#if defined(ESP_PLATFORM)
+#include <Arduino.h>
+#else
+#include <chrono>
+#include <mutex>
+#endif
+
+namespace Trace {
+
+static Site *s_sites = nullptr;
+
+#if defined(ESP_PLATFORM)
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+// record() may run in an ISR
+#define TRACE_LOCK() portENTER_CRITICAL_SAFE(&s_mux)
+#define TRACE_UNLOCK() portEXIT_CRITICAL_SAFE(&s_mux)
+
+uint32_t stamp() {
+  return ESP.getCycleCount();
+}
+
+static uint32_t ticksPerUs() {
+  static uint32_t mhz = 0;
+  if (mhz == 0) mhz = ESP.getCpuFreqMHz();
+  return mhz;
+}
+#else
+static std::mutex s_mux;
+#define TRACE_LOCK() s_mux.lock()
+#define TRACE_UNLOCK() s_mux.unlock()
+
+uint32_t stamp() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint32_t ticksPerUs() {
+  return 1000;
+}
+#endif
+
+// Bucket 0 is < 1 us, bucket b >= 1 holds [2^(b-1), 2^b) us
+static uint8_t bucketOf(uint32_t us) {
+  uint8_t b = us ? 32 - __builtin_clz(us) : 0;
+  return b < BUCKETS ? b : BUCKETS - 1;
+}
+
+static uint32_t bucketLimitUs(uint8_t b) {
+  return 1UL << b;
+}
+
+void record(Site &site, uint32_t start, uint32_t end) {
+  uint32_t us = (end - start) / ticksPerUs();
+  uint8_t b = bucketOf(us);
+  TRACE_LOCK();
+  if (!site.registered) {
+    site.registered = true;
+    site.next = s_sites;
+    s_sites = &site;
+  }
+  site.count++;
+  site.totalUs += us;
+  if (us > site.maxUs) site.maxUs = us;
+  site.buckets[b]++;
+  TRACE_UNLOCK();
+}
+
+uint32_t percentileUs(const Site &s, uint32_t permille) {
+  uint64_t want = ((uint64_t)s.count * permille + 999) / 1000;
+  uint64_t seen = 0;
+  for (uint8_t b = 0; b < BUCKETS; ++b) {
+    seen += s.buckets[b];
+    if (seen >= want) return b == BUCKETS - 1 ? s.maxUs : bucketLimitUs(b);
+  }
+  return s.maxUs;
+}
+
+void dump(Print &out) {
+  out.printf("%-18s %8s %8s %8s %8s %8s %8s\n", "span", "count", "avg_us", "p50<", "p90<", "p99<", "max_us");
+  for (Site *s = s_sites; s; s = s->next) {
+    // Copy under the lock so a concurrent record() cannot tear the numbers
+    Site snap(s->name);
+    TRACE_LOCK();
+    snap = *s;
+    TRACE_UNLOCK();
+    if (snap.count == 0) continue;
+    out.printf("%-18s %8u %8u %8u %8u %8u %8u\n", snap.name, (unsigned)snap.count,
+               (unsigned)(snap.totalUs / snap.count), (unsigned)percentileUs(snap, 500),
+               (unsigned)percentileUs(snap, 900), (unsigned)percentileUs(snap, 990), (unsigned)snap.maxUs);
+    out.print("   ");
+    for (uint8_t b = 0; b < BUCKETS; ++b) {
+      if (snap.buckets[b]) out.printf(" <%u:%u", (unsigned)bucketLimitUs(b), (unsigned)snap.buckets[b]);
+    }
+    out.println();
+  }
+}
+
+bool snapshot(const char *name, Site &out) {
+  bool found = false;
+  TRACE_LOCK();
+  for (Site *s = s_sites; s && !found; s = s->next) {
+    if (strcmp(s->name, name) == 0) {
+      out = *s;
+      found = true;
+    }
+  }
+  TRACE_UNLOCK();
+  return found;
+}
+
+void reset() {
+  TRACE_LOCK();
+  for (Site *s = s_sites; s; s = s->next) {
+    s->count = 0;
+    s->totalUs = 0;
+    s->maxUs = 0;
+    memset(s->buckets, 0, sizeof(s->buckets));
+  }
+  TRACE_UNLOCK();
+}
+
+} // namespace Trace
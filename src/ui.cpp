@@ -12,8 +12,16 @@
 #if __has_include("fa_wifi_icon.h")
 #include "fa_wifi_icon.h"
 #endif
+#if __has_include("ui_glyph_atlas.h")
+#include "ui_glyph_atlas.h"
+#endif
+#if __has_include("ui_icon_atlas.h")
+#include "ui_icon_atlas.h"
+#endif
 
 #include "ui.h"
+#include "ui_draw.h"
+#include "trace.h"
 
 #define HS_LOG_PREFIX "UI"
 #include "debug.h"
@@ -34,6 +42,14 @@
 #ifndef TFT_I2C_POWER
 #define TFT_I2C_POWER 7
 #endif
+// Upper bound on UI frames per second
+#ifndef UI_MAX_FPS
+#define UI_MAX_FPS 20
+#endif
+// Core of the UI task; pinned so its trace spans read one cycle counter
+#ifndef UI_TASK_CORE
+#define UI_TASK_CORE 1
+#endif
 
 namespace UI {
 
@@ -43,6 +59,8 @@ static Adafruit_ST7789 tft(TFT_CS, TFT_DC, TFT_RST);
 // Cached battery percent for status bar and Wi-Fi state
 static int s_battPercent = -1;
 static bool s_wifiConnected = false;
+static int8_t s_signalBars = -1; // 0..4, -1 = no RSSI reading
+static StatusIcon s_statusIcon = StatusIcon::None;
 
 // Fallback simple 16x12 monochrome bitmap (approximation) if FA icon not generated
 static const uint16_t WIFI_ICON_16x12[] PROGMEM = {
@@ -60,29 +78,233 @@ static const uint16_t WIFI_ICON_16x12[] PROGMEM = {
   0b0000000000000000,
 };
 
-// Generic 1bpp bitmap drawer (MSB-first per byte)
-static void drawMonoBitmap1BPP(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *data, uint16_t fg, uint16_t bg) {
-  int bytesPerRow = (w + 7) / 8;
-  for (int16_t row = 0; row < h; ++row) {
-    for (int16_t col = 0; col < w; ++col) {
-      int byteIndex = row * bytesPerRow + (col / 8);
-      uint8_t bits = pgm_read_byte(&data[byteIndex]);
-      bool on = bits & (0x80 >> (col % 8));
-      tft.drawPixel(x + col, y + row, on ? fg : bg);
+// Status band geometry: the right-hand part of the header holding the Wi-Fi
+// icon and battery SoC. It is composed off-screen in a canvas and only the
+// rectangle that differs from what the panel already shows gets flushed.
+static const int16_t SCREEN_W = 240;          // width after setRotation(3)
+static const int16_t BAND_RIGHT_MARGIN = 6;   // margin to right edge
+static const int16_t BAND_SPACING = 8;        // space between Wi-Fi icon and battery SoC
+static const int16_t BAND_TEXT_Y = 2;         // top margin similar to header text
+static const int16_t BAND_CHAR_W = 6 * TEXT_SIZE; // default 6x8 font width scaled
+static const int16_t BAND_MAX_CHARS = 4;      // up to "100%"
+#if defined(UI_ICON_ATLAS_AVAILABLE)
+// Status icon, Wi-Fi/signal and battery gauge slots, laid out right to left
+static const int16_t BAND_ICON_Y = 1;
+static const int16_t BAND_ICON_W = UI_ICON_MAX_W;
+static const int16_t BAND_ICON_H = UI_ICON_H;
+static const int16_t BAND_GAUGE_GAP = 4;      // battery glyph to SoC text
+static const int16_t BAND_ICONS_W = 3 * BAND_ICON_W + 2 * BAND_SPACING;
+#else
+static const int16_t BAND_ICON_Y = -2;        // align top with battery SoC text
+#if __has_include("fa_wifi_icon.h")
+static const int16_t BAND_ICON_W = FA_WIFI_ICON_WIDTH;
+static const int16_t BAND_ICON_H = FA_WIFI_ICON_HEIGHT;
+#else
+static const int16_t BAND_ICON_W = 16;
+static const int16_t BAND_ICON_H = 12;
+#endif
+static const int16_t BAND_ICONS_W = BAND_ICON_W;
+#endif
+static const int16_t BAND_W = BAND_ICONS_W + BAND_SPACING + BAND_MAX_CHARS * BAND_CHAR_W + BAND_RIGHT_MARGIN + 2;
+static const int16_t BAND_H = (BAND_ICON_Y + BAND_ICON_H > LINE_HEIGHT) ? (BAND_ICON_Y + BAND_ICON_H) : LINE_HEIGHT;
+static const int16_t BAND_X = SCREEN_W - BAND_W;
+
+// Off-screen composition target and a shadow of the pixels last pushed to the
+// panel for the same region. The shadow starts out as COLOR_BG (0) which
+// matches the panel right after printHeader() clears the screen.
+static GFXcanvas16 s_band(BAND_W, BAND_H);
+static uint16_t s_bandShadow[BAND_W * BAND_H];
+
+#ifdef UI_GLYPH_ATLAS_AVAILABLE
+// Default-style text is drawn from the pre-rendered glyph atlas (the GFX
+// built-in font at TEXT_SIZE, pixel for pixel) in fixed cells. Each line
+// remembers the characters and color it shows, so a new message only
+// redraws the cells that differ. The proportional RoundedSans/CleanSans
+// styles stay on the GFX path: clear the line, print it again.
+static const uint8_t TEXT_LINES = 8;
+static const int16_t TEXT_X = 2;
+static const uint8_t LINE_CELLS = (SCREEN_W - TEXT_X) / UI_GLYPH_W;
+static const uint8_t GLYPH_ROW_BYTES = (UI_GLYPH_W + 3) / 4;
+
+struct TextLine {
+  bool valid;             // false: unknown pixels, repaint the whole line
+  uint16_t color;
+  char cells[LINE_CELLS]; // ' ' pads past the end of the text
+};
+static TextLine s_lines[TEXT_LINES];
+
+static int16_t lineTop(int lineIndex1Based) {
+  return (lineIndex1Based - 1) * LINE_HEIGHT + 2;
+}
+#endif
+
+// Record that the panel was filled with COLOR_BG over a screen rectangle so
+// the shadow stays in sync with what is actually displayed.
+static void noteBackgroundFill(int16_t x, int16_t y, int16_t w, int16_t h) {
+#ifdef UI_GLYPH_ATLAS_AVAILABLE
+  // Text lines fully inside the fill are known blank, partly covered ones unknown
+  for (uint8_t i = 0; i < TEXT_LINES; ++i) {
+    int16_t top = lineTop(i + 1);
+    if (top >= y + h || top + LINE_HEIGHT <= y) continue;
+    TextLine &line = s_lines[i];
+    line.valid = x <= 0 && x + w >= SCREEN_W && y <= top && y + h >= top + LINE_HEIGHT;
+    memset(line.cells, ' ', LINE_CELLS);
+  }
+#endif
+  int16_t x0 = (x > BAND_X ? x : BAND_X) - BAND_X;
+  int16_t x1 = (x + w < BAND_X + BAND_W ? x + w : BAND_X + BAND_W) - BAND_X;
+  int16_t y0 = (y > 0) ? y : 0;
+  int16_t y1 = (y + h < BAND_H) ? y + h : BAND_H;
+  for (int16_t row = y0; row < y1; ++row) {
+    for (int16_t col = x0; col < x1; ++col) s_bandShadow[row * BAND_W + col] = COLOR_BG;
+  }
+}
+
+// Push the dirty rectangle of the status band (canvas vs shadow) to the panel
+// as one address window and one bulk pixel write per row.
+static void flushBand() {
+  const uint16_t *buf = s_band.getBuffer();
+  if (!buf) return;
+
+  int16_t dx0 = BAND_W, dy0 = BAND_H, dx1 = -1, dy1 = -1;
+  for (int16_t row = 0; row < BAND_H; ++row) {
+    const uint16_t *cur = buf + row * BAND_W;
+    const uint16_t *old = s_bandShadow + row * BAND_W;
+    int16_t first = 0;
+    while (first < BAND_W && cur[first] == old[first]) ++first;
+    if (first == BAND_W) continue; // row unchanged
+    int16_t last = BAND_W - 1;
+    while (cur[last] == old[last]) --last;
+    if (first < dx0) dx0 = first;
+    if (last > dx1) dx1 = last;
+    if (row < dy0) dy0 = row;
+    dy1 = row;
+  }
+  if (dy1 < 0) return; // nothing changed, no SPI traffic at all
+
+  const int16_t w = dx1 - dx0 + 1;
+  const int16_t h = dy1 - dy0 + 1;
+  tft.startWrite();
+  tft.setAddrWindow(BAND_X + dx0, dy0, w, h);
+  for (int16_t row = dy0; row <= dy1; ++row) {
+    tft.writePixels(const_cast<uint16_t *>(buf) + row * BAND_W + dx0, w);
+    memcpy(s_bandShadow + row * BAND_W + dx0, buf + row * BAND_W + dx0, w * sizeof(uint16_t));
+  }
+  tft.endWrite();
+}
+
+#if defined(UI_GLYPH_ATLAS_AVAILABLE) || defined(UI_ICON_ATLAS_AVAILABLE)
+// Mix two RGB565 colors; level 0..3 is the 2-bit glyph coverage
+static uint16_t blend565(uint16_t bg, uint16_t fg, uint8_t level) {
+  uint16_t r = (((bg >> 11) & 0x1F) * (3 - level) + ((fg >> 11) & 0x1F) * level) / 3;
+  uint16_t g = (((bg >> 5) & 0x3F) * (3 - level) + ((fg >> 5) & 0x3F) * level) / 3;
+  uint16_t b = ((bg & 0x1F) * (3 - level) + (fg & 0x1F) * level) / 3;
+  return (r << 11) | (g << 5) | b;
+}
+#endif
+
+#ifdef UI_ICON_ATLAS_AVAILABLE
+template <typename Sink>
+static void forEachSpan(uint8_t id, Sink sink) {
+  const UiIcon &icon = UI_ICONS[id];
+  forEachIconSpan(UI_ICON_RLE + pgm_read_word(&icon.offset), pgm_read_byte(&icon.w), pgm_read_byte(&icon.h), sink);
+}
+
+static int16_t iconWidth(uint8_t id) {
+  return pgm_read_byte(&UI_ICONS[id].w);
+}
+
+// Decode an icon into a canvas; uncovered pixels keep what is there
+static void drawIcon(GFXcanvas16 &dst, uint8_t id, int16_t x, int16_t y, uint16_t color) {
+  uint16_t *buf = dst.getBuffer();
+  if (!buf) return;
+  uint16_t pal[4];
+  for (uint8_t l = 0; l < 4; ++l) pal[l] = blend565(COLOR_BG, color, l);
+  const int16_t dw = dst.width(), dh = dst.height();
+  forEachSpan(id, [&](uint8_t sx, uint8_t sy, uint8_t n, uint8_t level) {
+    int16_t dy = y + sy;
+    if (dy < 0 || dy >= dh) return;
+    int16_t x0 = x + sx, x1 = x0 + n;
+    if (x0 < 0) x0 = 0;
+    if (x1 > dw) x1 = dw;
+    uint16_t *out = buf + dy * dw;
+    for (int16_t dx = x0; dx < x1; ++dx) out[dx] = pal[level];
+  });
+}
+
+// 0 (empty) .. 4 (full) to pick a battery glyph
+static uint8_t batteryLevel(int percent) {
+  return (uint8_t)((percent + 12) / 25);
+}
+#endif
+
+#ifdef UI_GLYPH_ATLAS_AVAILABLE
+
+// Blit n adjacent glyph cells through one address window, a row at a time
+static void blitRun(int16_t x, int16_t y, const char *text, uint8_t n, uint16_t color) {
+  uint16_t pal[4];
+  for (uint8_t l = 0; l < 4; ++l) pal[l] = blend565(COLOR_BG, color, l);
+  uint16_t row[LINE_CELLS * UI_GLYPH_W];
+  const int16_t w = n * UI_GLYPH_W;
+  tft.setAddrWindow(x, y, w, UI_GLYPH_H);
+  for (int16_t r = 0; r < UI_GLYPH_H; ++r) {
+    uint16_t *out = row;
+    for (uint8_t c = 0; c < n; ++c) {
+      const uint8_t *src = UI_GLYPH_ATLAS + (text[c] - UI_GLYPH_FIRST) * UI_GLYPH_BYTES + r * GLYPH_ROW_BYTES;
+      for (int16_t px = 0; px < UI_GLYPH_W; px += 4) {
+        uint8_t bits = pgm_read_byte(src++);
+        for (int16_t k = 0; k < 4 && px + k < UI_GLYPH_W; ++k) {
+          *out++ = pal[(bits >> (6 - 2 * k)) & 3];
+        }
+      }
     }
+    // Keep the status band's shadow in step where a line runs under it
+    int16_t sy = y + r;
+    if (sy < BAND_H && x + w > BAND_X) {
+      int16_t from = x > BAND_X ? x : BAND_X;
+      memcpy(s_bandShadow + sy * BAND_W + (from - BAND_X), row + (from - x), (x + w - from) * sizeof(uint16_t));
+    }
+    tft.writePixels(row, w);
   }
 }
 
-// Helper: draw 1-bit bitmap where each row is a 16-bit word (fallback 16x12)
-static void drawMonoBitmap16x12(int16_t x, int16_t y, const uint16_t *data, uint16_t color, uint16_t bg) {
-  for (int16_t row = 0; row < 12; ++row) {
-    uint16_t bits = pgm_read_word(&data[row]);
-    for (int16_t col = 0; col < 16; ++col) {
-      bool on = bits & (1 << (15 - col));
-      tft.drawPixel(x + col, y + row, on ? color : bg);
+// Draw msg on a text line, touching only the cells that changed
+static void printLineAtlas(int lineIndex1Based, const char *msg, uint16_t color) {
+  TextLine &line = s_lines[lineIndex1Based - 1];
+  int16_t yTop = lineTop(lineIndex1Based);
+  if (!line.valid) {
+    tft.fillRect(0, yTop, tft.width(), LINE_HEIGHT, COLOR_BG);
+    noteBackgroundFill(0, yTop, tft.width(), LINE_HEIGHT);
+  }
+
+  char next[LINE_CELLS];
+  uint8_t n = 0;
+  for (; n < LINE_CELLS && msg[n]; ++n) {
+    char c = msg[n];
+    next[n] = (c >= UI_GLYPH_FIRST && c <= UI_GLYPH_LAST) ? c : '?';
+  }
+  memset(next + n, ' ', LINE_CELLS - n);
+
+  const bool recolor = color != line.color;
+  tft.startWrite();
+  uint8_t i = 0;
+  while (i < LINE_CELLS) {
+    uint8_t j = i;
+    while (j < LINE_CELLS && (next[j] != line.cells[j] || (recolor && next[j] != ' '))) ++j;
+    if (j > i) {
+      blitRun(TEXT_X + i * UI_GLYPH_W, yTop, next + i, j - i, color);
+      i = j;
+    } else {
+      ++i;
     }
   }
+  tft.endWrite();
+
+  memcpy(line.cells, next, LINE_CELLS);
+  line.color = color;
+  line.valid = true;
 }
+#endif
 
 static inline const GFXfont* fontForStyle(FontStyle style) {
   switch (style) {
@@ -96,80 +318,101 @@ static inline const GFXfont* fontForStyle(FontStyle style) {
 // Forward declaration
 static void drawBatteryTextOnly(int16_t iconX, int16_t iconW);
 
-void drawWifiIcon(bool connected) {
+// --- Rendering (UI task, or init() before the task exists) ---
+
+static void renderStatusBand(bool connected) {
+  TRACE_SPAN("ui.wifi_icon");
   // Remember connection state so battery updates can reposition the icon
   s_wifiConnected = connected;
 
-  // Colors and measurements
   uint16_t iconColor = connected ? COLOR_SIGNAL_BLUE : COLOR_WHITE_SMOKE;
-  const int16_t scr_w = tft.width();
-  const int16_t rightMargin = 6;   // margin to right edge
-  const int16_t spacing = 8;       // space between Wi-Fi icon and battery SoC
-  const int16_t textY = 2;         // top margin similar to header text
-  const int16_t charW = 6 * TEXT_SIZE; // default 6x8 font width scaled
-
-  // Determine icon dimensions
-#if __has_include("fa_wifi_icon.h")
-  const int16_t iw = FA_WIFI_ICON_WIDTH;
-  const int16_t ih = FA_WIFI_ICON_HEIGHT;
-#else
-  const int16_t iw = 16, ih = 12;
-#endif
 
   // Compose battery text and compute width
-  String txt;
-  if (s_battPercent >= 0) txt = String(s_battPercent) + '%';
-  const int16_t txtW = txt.length() * charW;
+  char txt[5] = "";
+  if (s_battPercent >= 0) snprintf(txt, sizeof(txt), "%d%%", s_battPercent);
+  const int16_t txtW = strlen(txt) * BAND_CHAR_W;
 
-  // Clear a safe region on the right where icon + max text may appear
-  const int16_t maxChars = 4; // up to "100%"
-  const int16_t clearW = iw + spacing + maxChars * charW + rightMargin + 2;
-  const int16_t clearX = scr_w - clearW;
-  tft.fillRect(clearX, 0, clearW, LINE_HEIGHT, COLOR_BG);
+  // Compose the band off-screen (canvas coordinates are relative to BAND_X)
+  s_band.fillScreen(COLOR_BG);
 
   // Layout: Wi-Fi icon BEFORE battery text (left-to-right)
   // Text is right-aligned to the margin; icon sits to its left.
-  int16_t textX = scr_w - rightMargin - txtW;
-  int16_t iconX = textX - (txtW > 0 ? spacing : 0) - iw;
+  int16_t textX = BAND_W - BAND_RIGHT_MARGIN - txtW;
 
   // Draw icon
-  const int16_t iconY = -2; // align top with battery SoC text
+#if defined(UI_ICON_ATLAS_AVAILABLE)
+  // Battery gauge glyph left of the SoC, then Wi-Fi (signal bars once an
+  // RSSI is known) and the status icon furthest left
+  int16_t x = textX - (txtW > 0 ? BAND_GAUGE_GAP : 0);
+  if (s_battPercent >= 0) {
+    uint8_t id = UI_ICON_BATT_0 + batteryLevel(s_battPercent);
+    x -= iconWidth(id);
+    drawIcon(s_band, id, x, BAND_ICON_Y, COLOR_WHITE_SMOKE);
+    x -= BAND_SPACING;
+  }
+  uint8_t wifiId = (connected && s_signalBars >= 0) ? UI_ICON_SIGNAL_0 + s_signalBars : UI_ICON_WIFI;
+  x -= iconWidth(wifiId);
+  drawIcon(s_band, wifiId, x, BAND_ICON_Y, iconColor);
+  if (s_statusIcon != StatusIcon::None) {
+    uint8_t id = s_statusIcon == StatusIcon::Ble ? UI_ICON_BLE : s_statusIcon == StatusIcon::Ota ? UI_ICON_OTA : UI_ICON_ERROR;
+    uint16_t color = s_statusIcon == StatusIcon::Error ? (uint16_t)ST77XX_RED : COLOR_HIVE_YELLOW;
+    x -= BAND_SPACING + iconWidth(id);
+    drawIcon(s_band, id, x, BAND_ICON_Y, color);
+  }
+#else
+  int16_t iconX = textX - (txtW > 0 ? BAND_SPACING : 0) - BAND_ICON_W;
 #if __has_include("fa_wifi_icon.h")
-  drawMonoBitmap1BPP(iconX, iconY, iw, ih, FA_WIFI_ICON_BITMAP, iconColor, COLOR_BG);
+  drawMonoBitmap1BPP(s_band, iconX, BAND_ICON_Y, BAND_ICON_W, BAND_ICON_H, FA_WIFI_ICON_BITMAP, iconColor, COLOR_BG);
 #else
-  drawMonoBitmap16x12(iconX, iconY, WIFI_ICON_16x12, iconColor, COLOR_BG);
+  drawMonoBitmap16x12(s_band, iconX, BAND_ICON_Y, WIFI_ICON_16x12, iconColor, COLOR_BG);
+#endif
 #endif
 
   // Draw text (if available)
-  if (txt.length()) {
-    tft.setFont(nullptr);
-    tft.setTextSize(TEXT_SIZE);
-    tft.setTextColor(COLOR_WHITE_SMOKE);
-    tft.setCursor(textX, textY);
-    tft.print(txt);
+  if (txt[0]) {
+    s_band.setFont(nullptr);
+    s_band.setTextSize(TEXT_SIZE);
+    s_band.setTextColor(COLOR_WHITE_SMOKE);
+    s_band.setCursor(textX, BAND_TEXT_Y);
+    s_band.print(txt);
   }
+
+  flushBand();
 }
 
-void clearContentBelowHeader() {
+static void renderClear() {
   int16_t y0 = LINE_HEIGHT + 1;
   tft.fillRect(0, y0, tft.width(), tft.height() - y0, COLOR_BG);
+  noteBackgroundFill(0, y0, tft.width(), tft.height() - y0);
 }
 
-void printHeader() {
+static void renderHeader() {
   tft.fillScreen(COLOR_BG);
+  noteBackgroundFill(0, 0, tft.width(), tft.height());
   tft.setTextWrap(false);
   tft.setTextSize(TEXT_SIZE);
   tft.setTextColor(COLOR_HIVE_YELLOW);
   tft.setCursor(2, 2);
   tft.print("HiveSync");
+#ifdef UI_GLYPH_ATLAS_AVAILABLE
+  s_lines[0].valid = false;
+#endif
   LOGLN("Header drawn");
 }
 
-void printLine(int lineIndex1Based, const String &msg, uint16_t color, FontStyle style) {
+static void renderLine(int lineIndex1Based, const char *msg, uint16_t color, FontStyle style) {
+  TRACE_SPAN("ui.print_line");
   const GFXfont* chosen = fontForStyle(style);
+#ifdef UI_GLYPH_ATLAS_AVAILABLE
+  if (!chosen && lineIndex1Based >= 1 && lineIndex1Based <= TEXT_LINES) {
+    printLineAtlas(lineIndex1Based, msg, color);
+    return;
+  }
+#endif
 
   int16_t yTop = (lineIndex1Based - 1) * LINE_HEIGHT + 2;
   tft.fillRect(0, yTop, tft.width(), LINE_HEIGHT, COLOR_BG);
+  noteBackgroundFill(0, yTop, tft.width(), LINE_HEIGHT);
   tft.setTextColor(color);
 
   if (chosen) {
@@ -186,39 +429,224 @@ void printLine(int lineIndex1Based, const String &msg, uint16_t color, FontStyle
   }
 
   tft.print(msg);
+#ifdef UI_GLYPH_ATLAS_AVAILABLE
+  // Proportional text: the cell cache no longer describes this line
+  if (lineIndex1Based >= 1 && lineIndex1Based <= TEXT_LINES) s_lines[lineIndex1Based - 1].valid = false;
+#endif
 
   // Restore defaults
   tft.setFont(nullptr);
   tft.setTextSize(TEXT_SIZE);
 }
 
-void init() {
-  // Power up display / I2C rail and backlight
-  pinMode(TFT_I2C_POWER, OUTPUT);
-  digitalWrite(TFT_I2C_POWER, HIGH);
-  pinMode(TFT_BACKLITE, OUTPUT);
-  digitalWrite(TFT_BACKLITE, HIGH);
+// --- Command mailbox ---
+//
+// Public calls only record what should be on screen and notify the UI
+// task; they never touch SPI. Each kind of update has one slot, so a newer
+// value replaces an undrawn older one (counted as merged): the band keeps
+// the latest Wi-Fi state and battery percent, each text line its latest
+// message. A clear or header repaint discards the undrawn lines it would
+// wipe anyway. The task applies a snapshot of the slots at most
+// UI_MAX_FPS times per second.
+
+static const uint8_t MAIL_LINES = 8;
+static const uint8_t MAIL_TEXT = 40;
+
+struct LineSlot {
+  bool dirty;
+  uint16_t color;
+  FontStyle style;
+  char text[MAIL_TEXT];
+};
+
+struct Mailbox {
+  bool header;
+  bool clear;
+  bool band;
+  bool wifi;
+  int8_t battery;
+  int8_t bars;
+  StatusIcon status;
+  LineSlot lines[MAIL_LINES];
+};
+
+static Mailbox s_mail = {false, false, false, false, -1, -1, StatusIcon::None, {}};
+static portMUX_TYPE s_mailMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t s_task = nullptr;
+static volatile bool s_ready = false; // panel initialised, first frame drawn
+static Stats s_stats = {0, 0, 0, 0};
 
-  delay(10);
+static void post() {
+  if (s_task) xTaskNotifyGive(s_task);
+}
+
+static void uiTask(void *) {
+  // Panel reset and init sequence (~150 ms of controller delays), off the
+  // loop task so the rest of boot runs meanwhile
+  vTaskDelay(pdMS_TO_TICKS(10));
   tft.init(135, 240);      // ST7789 240x135
   tft.setRotation(3);      // landscape
-  printHeader();
-  drawWifiIcon(false);
+  s_band.setTextWrap(false);
+  renderHeader();
+  renderStatusBand(false);
+  s_ready = true;
   LOGLN("Display initialized (ST7789 240x135, rot=3)");
+  xTaskNotifyGive(xTaskGetCurrentTaskHandle()); // draw what was posted meanwhile
+
+  const TickType_t framePeriod = pdMS_TO_TICKS(1000 / UI_MAX_FPS);
+  TickType_t lastFrame = xTaskGetTickCount() - framePeriod;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    TickType_t since = xTaskGetTickCount() - lastFrame;
+    if (since < framePeriod) vTaskDelay(framePeriod - since); // more posts may merge meanwhile
+
+    Mailbox m;
+    portENTER_CRITICAL(&s_mailMux);
+    m = s_mail;
+    s_mail.header = s_mail.clear = s_mail.band = false;
+    for (uint8_t i = 0; i < MAIL_LINES; ++i) s_mail.lines[i].dirty = false;
+    portEXIT_CRITICAL(&s_mailMux);
+    lastFrame = xTaskGetTickCount();
+    s_stats.frames++;
+
+    if (m.header) renderHeader();
+    else if (m.clear) renderClear();
+    for (uint8_t i = 0; i < MAIL_LINES; ++i) {
+      if (m.lines[i].dirty) renderLine(i + 1, m.lines[i].text, m.lines[i].color, m.lines[i].style);
+    }
+    if (m.band || m.header) {
+      s_battPercent = m.battery;
+      s_signalBars = m.bars;
+      s_statusIcon = m.status;
+      renderStatusBand(m.wifi);
+    }
+  }
+}
+
+// Queue a status band repaint; caller holds s_mailMux
+static void markBand() {
+  s_stats.posted++;
+  if (s_mail.band) s_stats.merged++;
+  s_mail.band = true;
+}
+
+void drawWifiIcon(bool connected) {
+  portENTER_CRITICAL(&s_mailMux);
+  s_mail.wifi = connected;
+  markBand();
+  portEXIT_CRITICAL(&s_mailMux);
+  post();
+}
+
+void setSignal(int rssi) {
+  int8_t bars = -1;
+  if (rssi < 0) bars = rssi >= -55 ? 4 : rssi >= -65 ? 3 : rssi >= -75 ? 2 : rssi >= -85 ? 1 : 0;
+  portENTER_CRITICAL(&s_mailMux);
+  bool changed = bars != s_mail.bars;
+  if (changed) {
+    s_mail.bars = bars;
+    markBand();
+  }
+  portEXIT_CRITICAL(&s_mailMux);
+  if (changed) post();
+}
+
+void setStatusIcon(StatusIcon icon) {
+  portENTER_CRITICAL(&s_mailMux);
+  bool changed = icon != s_mail.status;
+  if (changed) {
+    s_mail.status = icon;
+    markBand();
+  }
+  portEXIT_CRITICAL(&s_mailMux);
+  if (changed) post();
 }
 
 void setBatteryPercent(int percent) {
   if (percent < 0) percent = -1;
   if (percent > 100) percent = 100;
-  if (percent == s_battPercent) return; // no change
-  s_battPercent = percent;
+  portENTER_CRITICAL(&s_mailMux);
+  bool changed = percent != s_mail.battery;
+  if (changed) {
+    s_mail.battery = (int8_t)percent;
+    markBand();
+  }
+  portEXIT_CRITICAL(&s_mailMux);
+  if (!changed) return;
   if (percent >= 0) LOGF("Battery shown: %d%%\n", percent); else LOGLN("Battery hidden");
-  // Re-draw the Wi-Fi icon and SoC together so spacing/order stay correct
-  drawWifiIcon(s_wifiConnected);
+  post();
+}
+
+// Undrawn lines from firstLine on would be wiped by the pending repaint
+static void dropLines(uint8_t firstLine) {
+  for (uint8_t i = firstLine - 1; i < MAIL_LINES; ++i) {
+    if (s_mail.lines[i].dirty) s_stats.merged++;
+    s_mail.lines[i].dirty = false;
+  }
+}
+
+void clearContentBelowHeader() {
+  portENTER_CRITICAL(&s_mailMux);
+  s_stats.posted++;
+  if (s_mail.clear || s_mail.header) s_stats.merged++;
+  s_mail.clear = true;
+  dropLines(2);
+  portEXIT_CRITICAL(&s_mailMux);
+  post();
+}
+
+void printHeader() {
+  portENTER_CRITICAL(&s_mailMux);
+  s_stats.posted++;
+  if (s_mail.clear || s_mail.header) s_stats.merged++;
+  s_mail.header = true;
+  dropLines(1);
+  portEXIT_CRITICAL(&s_mailMux);
+  post();
+}
+
+void printLine(int lineIndex1Based, const char *msg, uint16_t color, FontStyle style) {
+  if (lineIndex1Based < 1 || lineIndex1Based > MAIL_LINES) {
+    portENTER_CRITICAL(&s_mailMux);
+    s_stats.dropped++;
+    portEXIT_CRITICAL(&s_mailMux);
+    return;
+  }
+  portENTER_CRITICAL(&s_mailMux);
+  LineSlot &slot = s_mail.lines[lineIndex1Based - 1];
+  s_stats.posted++;
+  if (slot.dirty) s_stats.merged++;
+  slot.dirty = true;
+  slot.color = color;
+  slot.style = style;
+  strlcpy(slot.text, msg, sizeof(slot.text));
+  portEXIT_CRITICAL(&s_mailMux);
+  post();
+}
+
+Stats stats() {
+  portENTER_CRITICAL(&s_mailMux);
+  Stats st = s_stats;
+  portEXIT_CRITICAL(&s_mailMux);
+  return st;
+}
+
+void init() {
+  // Power up display / I2C rail and backlight; the gauge shares the rail
+  pinMode(TFT_I2C_POWER, OUTPUT);
+  digitalWrite(TFT_I2C_POWER, HIGH);
+  pinMode(TFT_BACKLITE, OUTPUT);
+  digitalWrite(TFT_BACKLITE, HIGH);
+  // The panel is brought up on the UI task, which then does all drawing
+  if (!s_task) xTaskCreatePinnedToCore(uiTask, "ui", 4096, nullptr, 1, &s_task, UI_TASK_CORE);
+}
+
+bool ready() {
+  return s_ready;
 }
 
 static void drawBatteryTextOnly(int16_t, int16_t) {
-  // Deprecated: retained for linkage but not used; drawing now handled in drawWifiIcon().
+  // Deprecated: retained for linkage but not used; drawing now handled in renderStatusBand().
 }
 
 } // namespace UI
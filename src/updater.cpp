@@ -2,14 +2,18 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WiFiClientSecure.h>
 #include <HTTPClient.h>
-#include <Update.h>
+#include <Preferences.h>
 #include <Adafruit_ST7789.h> // for ST77XX_* color constants
 
 #include "ui.h"
 #include "provisioning.h"
 #include "updater.h"
+#include "release_parser.h"
+#include "ota_engine.h"
+#include "https_client.h"
+#include "version.h"
+#include "trace.h"
 
 #define HS_LOG_PREFIX "OTA"
 #include "debug.h"
@@ -27,14 +31,76 @@
 #ifndef FIRMWARE_ASSET
 #define FIRMWARE_ASSET "firmware.bin"
 #endif
+#ifndef FIRMWARE_GZ_ASSET
+#define FIRMWARE_GZ_ASSET FIRMWARE_ASSET ".gz"
+#endif
+#ifndef FIRMWARE_DELTA_ASSET
+#define FIRMWARE_DELTA_ASSET "firmware-from-" FIRMWARE_VERSION ".hsd.gz"
+#endif
+// Seconds between release checks (jittered by +/-10%)
+#ifndef OTA_CHECK_INTERVAL_S
+#define OTA_CHECK_INTERVAL_S (6UL * 3600UL)
+#endif
+
+static_assert(Version::valid(FIRMWARE_VERSION), "FIRMWARE_VERSION must look like MAJOR.MINOR.PATCH");
 
 namespace Updater {
 
-static bool s_checkedThisBoot = false;
+// Check schedule: first check as soon as Wi-Fi is up, then periodically
+static const uint32_t RETRY_MIN_S = 300;   // first back-off step after a failed check
+static bool s_disabled = false;
+static uint32_t s_lastCheckMs = 0;
+static uint32_t s_checkDelayMs = 0;
+static uint8_t s_failures = 0;
+static constexpr Version::SemVer kCurrent = Version::parse(FIRMWARE_VERSION);
+static const char kApiUrl[] = "https://api.github.com/repos/" GITHUB_OWNER "/" GITHUB_REPO "/releases/latest";
+static const char kDownloadBase[] = "https://github.com/" GITHUB_OWNER "/" GITHUB_REPO "/releases/download/";
+
+// Last release check result, persisted in NVS so that an unchanged release
+// costs a conditional request answered with 304 Not Modified
+struct ReleaseCache {
+  char etag[80] = "";
+  char lastModified[40] = "";
+  char tag[ReleaseParser::TAG_MAX] = "";
+  char url[ReleaseParser::URL_MAX] = "";
+  int8_t assetIndex = -1;   // into kAssets, -1 = default download URL
+};
+
+// Response headers relevant to caching and rate limiting
+struct ResponseMeta {
+  char etag[80] = "";
+  char lastModified[40] = "";
+  long rateRemaining = -1;  // X-RateLimit-Remaining, -1 if absent
+  uint32_t rateReset = 0;   // X-RateLimit-Reset, epoch seconds
+  uint32_t retryAfter = 0;  // Retry-After, seconds
+  uint32_t date = 0;        // server Date, epoch seconds
+};
+
+// Release assets in order of preference (smallest download first). All of
+// them are produced by scripts/make_ota_artifacts.py in the release workflow.
+struct AssetCandidate {
+  const char *name;
+  OtaEngine::ImageFormat format;
+};
+static const AssetCandidate kAssets[] = {
+  {FIRMWARE_DELTA_ASSET, OtaEngine::ImageFormat::GzipDelta},
+  {FIRMWARE_GZ_ASSET,    OtaEngine::ImageFormat::Gzip},
+  {FIRMWARE_ASSET,       OtaEngine::ImageFormat::Raw},
+};
+static const uint8_t kAssetCount = sizeof(kAssets) / sizeof(kAssets[0]);
+
+// Full image to retry with when an encoded download fails this boot
+static char s_fallbackUrl[ReleaseParser::URL_MAX];
+// Format and release tag of the download in flight; after a failed raw
+// download the next check of the same release goes straight back to the
+// full image so it resumes from NVS
+static OtaEngine::ImageFormat s_otaFormat = OtaEngine::ImageFormat::Raw;
+static char s_otaTag[ReleaseParser::TAG_MAX] = "";
+static char s_resumeTag[ReleaseParser::TAG_MAX] = "";
 
 // Uses global HS_DEBUG flag and module prefix from debug.h
 
-static void logLine(int line, const String &msg, uint16_t color = UI::COLOR_WHITE_SMOKE) {
+static void logLine(int line, const char *msg, uint16_t color = UI::COLOR_WHITE_SMOKE) {
   UI::printLine(line, msg, color);
 }
 
@@ -42,239 +108,318 @@ const char* currentVersion() {
   return FIRMWARE_VERSION;
 }
 
-// Parse a tag/version string into [major, minor, patch].
-// Accepts optional leading 'v' and ignores any suffix after '-'.
-static void parseSemVer(const String &ver, int &maj, int &min, int &pat) {
-  maj = min = pat = 0;
-  int start = 0;
-  // Skip leading 'v' or 'V'
-  if (ver.length() > 0 && (ver[0] == 'v' || ver[0] == 'V')) start = 1;
-  // Stop at first '-' (pre-release/build suffix)
-  int end = ver.indexOf('-', start);
-  String core = (end == -1) ? ver.substring(start) : ver.substring(start, end);
-
-  // Split by '.'
-  int p1 = core.indexOf('.');
-  int p2 = (p1 == -1) ? -1 : core.indexOf('.', p1 + 1);
-  String sMaj = (p1 == -1) ? core : core.substring(0, p1);
-  String sMin = (p1 == -1) ? "0" : ((p2 == -1) ? core.substring(p1 + 1) : core.substring(p1 + 1, p2));
-  String sPat = (p2 == -1) ? "0" : core.substring(p2 + 1);
-
-  maj = sMaj.toInt();
-  min = sMin.toInt();
-  pat = sPat.toInt();
+// Strategy 2 for locating the firmware: construct the standard GitHub release
+// download URL from the tag when the asset list did not contain it.
+static void defaultAssetUrl(char *out, size_t len, const char *tag, const char *assetName) {
+  snprintf(out, len, "%s%s/%s", kDownloadBase, tag, assetName);
 }
 
-static int compareSemVer(const String &a, const String &b) {
-  int aM, aN, aP, bM, bN, bP;
-  parseSemVer(a, aM, aN, aP);
-  parseSemVer(b, bM, bN, bP);
-  if (aM != bM) return (aM < bM) ? -1 : 1;
-  if (aN != bN) return (aN < bN) ? -1 : 1;
-  if (aP != bP) return (aP < bP) ? -1 : 1;
-  return 0;
+// Stream adapter feeding the HTTP body straight into a ReleaseParser, so the
+// releases document is never held in RAM. Once the parser has everything it
+// reports a short write, which makes HTTPClient stop reading the remainder.
+class ReleaseParserSink : public Stream {
+public:
+  explicit ReleaseParserSink(ReleaseParser &parser) : _parser(parser), _bytes(0) {}
+
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t *buf, size_t size) override {
+    if (_parser.complete() || _parser.failed()) return 0;
+    _parser.feed(buf, size);
+    _bytes += size;
+    return size;
+  }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  void flush() {}
+
+  size_t bytes() const { return _bytes; }
+
+private:
+  ReleaseParser &_parser;
+  size_t _bytes;
+};
+
+static void loadCache(ReleaseCache &c) {
+  Preferences prefs;
+  if (!prefs.begin("ota", true)) return; // nothing stored yet
+  prefs.getString("etag", c.etag, sizeof(c.etag));
+  prefs.getString("lastmod", c.lastModified, sizeof(c.lastModified));
+  prefs.getString("tag", c.tag, sizeof(c.tag));
+  prefs.getString("url", c.url, sizeof(c.url));
+  c.assetIndex = prefs.getChar("asset", -1);
+  prefs.end();
 }
 
-// Very lightweight JSON scraping (avoid extra lib deps): find value for a key
-// Ex: key "tag_name" -> returns the unescaped string value without quotes.
-static String jsonFindString(const String &body, const String &key, int from = 0) {
-  String needle = String("\"") + key + "\":";
-  int k = body.indexOf(needle, from);
-  if (k == -1) return String();
-  int q1 = body.indexOf('"', k + needle.length());
-  if (q1 == -1) return String();
-  int q2 = body.indexOf('"', q1 + 1);
-  if (q2 == -1) return String();
-  return body.substring(q1 + 1, q2);
+static void saveCache(const ReleaseCache &c) {
+  Preferences prefs;
+  if (!prefs.begin("ota", false)) return;
+  prefs.putString("etag", c.etag);
+  prefs.putString("lastmod", c.lastModified);
+  prefs.putString("tag", c.tag);
+  prefs.putString("url", c.url);
+  prefs.putChar("asset", c.assetIndex);
+  prefs.end();
 }
 
-// Attempt to find a browser_download_url for the configured asset name.
-static String findAssetUrl(const String &json, const String &assetName) {
-  // Strategy 1: locate the asset by name, then get the nearest browser_download_url after it
-  String nameKey = String("\"name\":\"") + assetName + "\"";
-  int np = json.indexOf(nameKey);
-  if (np != -1) {
-    // search forward for browser_download_url
-    String key = "\"browser_download_url\":";
-    int bp = json.indexOf(key, np);
-    if (bp != -1) {
-      int q1 = json.indexOf('"', bp + key.length());
-      if (q1 != -1) {
-        int q2 = json.indexOf('"', q1 + 1);
-        if (q2 != -1) return json.substring(q1 + 1, q2);
-      }
-    }
-  }
-
-  // Strategy 2: construct the standard GitHub release download URL from tag
-  String tag = jsonFindString(json, String("tag_name"));
-  if (tag.length()) {
-    String url = String("https://github.com/") + GITHUB_OWNER + "/" + GITHUB_REPO + "/releases/download/" + tag + "/" + assetName;
-    return url;
-  }
-  return String();
+// Parse an IMF-fixdate ("Sun, 06 Nov 1994 08:49:37 GMT") into epoch seconds; 0 on failure
+static uint32_t parseHttpDate(const char *value) {
+  static const char kMonths[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+  const char *comma = strchr(value, ',');
+  if (!comma) return 0;
+  int day, year, hh, mm, ss;
+  char mon[4];
+  if (sscanf(comma + 1, " %d %3s %d %d:%d:%d", &day, mon, &year, &hh, &mm, &ss) != 6) return 0;
+  const char *m = strstr(kMonths, mon);
+  if (!m || (m - kMonths) % 3 != 0 || year < 1970) return 0;
+  int month = (int)(m - kMonths) / 3 + 1;
+  // Days since 1970-01-01 (civil calendar, years >= 1970)
+  int y = year - (month <= 2 ? 1 : 0);
+  int era = y / 400;
+  int yoe = y - era * 400;
+  int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  long days = (long)era * 146097L + doe - 719468L;
+  return (uint32_t)(days * 86400L + hh * 3600L + mm * 60L + ss);
 }
 
-static bool httpsGet(const String &url, String &outBody, int timeoutMs = 15000) {
-  outBody = String();
-  WiFiClientSecure client;
-  client.setInsecure(); // NOTE: for simplicity; consider pinning GitHub cert for production
-  HTTPClient http;
-  http.setTimeout(timeoutMs);
-  LOGF("GET %s\n", url.c_str());
-  if (!http.begin(client, url)) {
-    LOGLN("http.begin failed");
-    return false;
-  }
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  http.addHeader("User-Agent", "HiveSync-OTA");
-  http.addHeader("Accept", "application/vnd.github+json");
-  const char* hdrs[] = {"X-RateLimit-Remaining", "X-RateLimit-Used", "X-RateLimit-Reset"};
-  http.collectHeaders(hdrs, 3);
-  int code = http.GET();
-  LOGF("HTTP code: %d\n", code);
+// Conditional GET of url, streaming a 200 body into sink. Validators from
+// cache are sent as If-None-Match/If-Modified-Since. Returns the HTTP code
+// (negative on transport errors) and fills meta from the response headers.
+static int httpsGet(const char *url, Stream &sink, const ReleaseCache &cache, ResponseMeta &meta, uint16_t timeoutMs = 15000) {
+  TRACE_SPAN("ota.https_get");
+  Https::Header reqHdrs[4] = {
+    {"User-Agent", "HiveSync-OTA"},
+    {"Accept", "application/vnd.github+json"},
+  };
+  uint8_t reqCount = 2;
+  if (cache.etag[0]) reqHdrs[reqCount++] = {"If-None-Match", cache.etag};
+  if (cache.lastModified[0]) reqHdrs[reqCount++] = {"If-Modified-Since", cache.lastModified};
+  const char* hdrs[] = {"X-RateLimit-Remaining", "X-RateLimit-Used", "X-RateLimit-Reset",
+                        "ETag", "Last-Modified", "Retry-After", "Date"};
+  Https::Options opts;
+  opts.headers = reqHdrs;
+  opts.headerCount = reqCount;
+  opts.collect = hdrs;
+  opts.collectCount = sizeof(hdrs) / sizeof(hdrs[0]);
+  opts.timeoutMs = timeoutMs;
+
+  LOGF("GET %s\n", url);
+  Https::Response resp;
+  int code = Https::get(url, opts, resp);
+  LOGF("HTTP code: %d (handshake=%u ms x%u, reused=%u, ttfb=%u ms)\n", code,
+       (unsigned)resp.timing().handshakeMs, (unsigned)resp.timing().handshakes,
+       (unsigned)resp.timing().reused, (unsigned)resp.timing().ttfbMs);
+  if (code < 0) return code;
+  HTTPClient &http = resp.http();
   if (http.hasHeader("X-RateLimit-Remaining")) {
     LOGF("RateLimit remaining=%s used=%s reset=%s\n",
         http.header("X-RateLimit-Remaining").c_str(),
         http.header("X-RateLimit-Used").c_str(),
         http.header("X-RateLimit-Reset").c_str());
+    meta.rateRemaining = http.header("X-RateLimit-Remaining").toInt();
+    meta.rateReset = (uint32_t)http.header("X-RateLimit-Reset").toInt();
   }
-  if (code != HTTP_CODE_OK) {
-    LOGLN(String("Error: ") + http.errorToString(code));
+  if (http.hasHeader("Retry-After")) meta.retryAfter = (uint32_t)http.header("Retry-After").toInt();
+  if (http.hasHeader("Date")) meta.date = parseHttpDate(http.header("Date").c_str());
+  strlcpy(meta.etag, http.header("ETag").c_str(), sizeof(meta.etag));
+  strlcpy(meta.lastModified, http.header("Last-Modified").c_str(), sizeof(meta.lastModified));
+
+  bool drained = true;
+  if (code == HTTP_CODE_OK) {
+    int ret = http.writeToStream(&sink);
+    LOGF("Body streamed: ret=%d\n", ret);
+    // The parser stops reading once it has what it needs
+    drained = ret >= 0;
+  } else if (code != HTTP_CODE_NOT_MODIFIED) {
+    LOGF("Error: %s\n", http.errorToString(code).c_str());
     // Read body for diagnostics (often JSON with message)
     String errBody = http.getString();
-    if (errBody.length()) LOGF("Body: %s\n", errBody.substring(0, 200).c_str());
-    http.end();
-    return false;
+    if (errBody.length()) LOGF("Body: %.200s\n", errBody.c_str());
   }
-  outBody = http.getString();
-  LOGF("Body size: %d\n", outBody.length());
-  http.end();
-  return true;
+  resp.end(drained);
+  return code;
 }
 
-static bool performOta(const String &url) {
-  WiFiClientSecure client;
-  client.setInsecure();
-  HTTPClient http;
-  http.setTimeout(30000);
-  http.addHeader("User-Agent", "HiveSync-OTA");
-
-  if (!http.begin(client, url)) {
-    logLine(4, F("OTA: begin failed"), ST77XX_RED);
-    LOGLN("OTA begin failed");
-    return false;
-  }
-
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  int httpCode = http.GET();
-  LOGF("OTA GET code: %d\n", httpCode);
-  if (httpCode != HTTP_CODE_OK) {
-    logLine(4, String(F("HTTP ")) + httpCode, ST77XX_RED);
-    LOGLN(String("OTA HTTP error: ") + http.errorToString(httpCode));
-    http.end();
-    return false;
-  }
-
-  int contentLen = http.getSize();
-  if (contentLen <= 0) {
-    logLine(4, F("No Content-Length"), ST77XX_RED);
-    LOGLN("Missing or invalid Content-Length");
-    http.end();
-    return false;
-  }
-
-  // Setup progress callback to update display
-  Update.onProgress([](size_t done, size_t total) {
-    if (total == 0) return;
-    int pct = (int)((done * 100) / total);
-    UI::printLine(4, String(F("Updating: ")) + pct + "%", UI::COLOR_DEEP_TEAL);
-  });
-
-  LOGF("Starting Update: size=%d bytes\n", contentLen);
-  if (!Update.begin(contentLen)) {
-    logLine(4, F("Update.begin failed"), ST77XX_RED);
-    LOGLN(String("Update.begin error: ") + Update.errorString());
-    http.end();
+// Hand the download to the background engine; progress arrives via events
+static bool performOta(const char *url, OtaEngine::ImageFormat fmt) {
+  s_otaFormat = fmt;
+  if (!OtaEngine::start(url, fmt)) {
+    logLine(4, "OTA: start failed", ST77XX_RED);
+    UI::setStatusIcon(UI::StatusIcon::Error);
+    LOGLN("OTA engine start failed");
     return false;
   }
+  logLine(4, "Updating: 0%", UI::COLOR_DEEP_TEAL);
+  UI::setStatusIcon(UI::StatusIcon::Ota);
+  return true;
+}
 
-  WiFiClient * stream = http.getStreamPtr();
-  size_t written = Update.writeStream(*stream);
-  LOGF("Update.writeStream wrote=%u bytes\n", (unsigned)written);
-  bool ok = true;
-  if (written != (size_t)contentLen) {
-    logLine(4, F("Write incomplete"), ST77XX_RED);
-    LOGF("Expected %d but wrote %u\n", contentLen, (unsigned)written);
-    ok = false;
-  }
-  if (!Update.end()) {
-    logLine(4, String(F("End err: ")) + Update.errorString(), ST77XX_RED);
-    LOGLN(String("Update.end error: ") + Update.errorString());
-    ok = false;
-  }
-  http.end();
-
-  if (ok && Update.isFinished()) {
-    logLine(5, F("Update OK, rebooting"), ST77XX_GREEN);
-    delay(500);
-    ESP.restart();
-  } else if (ok) {
-    logLine(5, F("Update not finished"), ST77XX_RED);
+// Reflect OTA engine events on the display; reboot once the image is in place
+static void pumpOtaEvents() {
+  OtaEngine::Event ev;
+  while (OtaEngine::pollEvent(ev)) {
+    switch (ev.type) {
+      case OtaEngine::EventType::Started:
+        LOGF("OTA started: size=%u bytes, resuming at %u\n", (unsigned)ev.total, (unsigned)ev.resumedFrom);
+        s_resumeTag[0] = '\0'; // set again if this attempt fails too
+        break;
+      case OtaEngine::EventType::Progress: {
+        if (ev.total == 0) break;
+        char text[20];
+        snprintf(text, sizeof(text), "Updating: %d%%", (int)(((uint64_t)ev.done * 100) / ev.total));
+        logLine(4, text, UI::COLOR_DEEP_TEAL);
+        break;
+      }
+      case OtaEngine::EventType::Failed:
+        logLine(4, ev.message, ST77XX_RED);
+        UI::setStatusIcon(UI::StatusIcon::Error);
+        LOGF("OTA failed: %s\n", ev.message);
+        if (s_fallbackUrl[0]) {
+          LOGF("Retrying with full image: %s\n", s_fallbackUrl);
+          char url[sizeof(s_fallbackUrl)];
+          strlcpy(url, s_fallbackUrl, sizeof(url));
+          s_fallbackUrl[0] = '\0';
+          performOta(url, OtaEngine::ImageFormat::Raw);
+        } else {
+          // Check again soon; a raw download picks up where this one stopped
+          if (s_otaFormat == OtaEngine::ImageFormat::Raw) strlcpy(s_resumeTag, s_otaTag, sizeof(s_resumeTag));
+          s_lastCheckMs = millis();
+          s_checkDelayMs = RETRY_MIN_S * 1000UL;
+        }
+        break;
+      case OtaEngine::EventType::Finished:
+        LOGF("OTA finished: %u bytes in %u ms (peak queued=%u)\n",
+             (unsigned)ev.done, (unsigned)ev.elapsedMs, (unsigned)ev.peakFilled);
+        logLine(5, "Update OK, rebooting", ST77XX_GREEN);
+        delay(500);
+        ESP.restart();
+        break;
+    }
   }
-  return ok;
 }
 
-static void checkAndUpdateOnce() {
-  if (s_checkedThisBoot) return;
-  s_checkedThisBoot = true;
+// Spread the fleet's checks over +/-10% of our own intervals; waits the
+// API asks for (rate limit) are taken as they are
+static uint32_t withJitter(uint32_t seconds) {
+  uint32_t span = seconds / 5; // +/-10%
+  if (span == 0) return seconds;
+  return seconds - span / 2 + esp_random() % span;
+}
 
-  // Ensure configuration present
-  if (String(GITHUB_OWNER).length() == 0 || String(GITHUB_REPO).length() == 0) {
-    // Not configured; nothing to do
-    LOGLN("GITHUB_OWNER/REPO not configured; skipping");
-    return;
+// Seconds to wait before talking to the API again given its rate-limit state
+static uint32_t rateLimitWait(const ResponseMeta &meta) {
+  if (meta.retryAfter) return meta.retryAfter;
+  if (meta.rateRemaining == 0 && meta.rateReset && meta.date && meta.rateReset > meta.date) {
+    return meta.rateReset - meta.date + 30; // small margin past the reset
   }
+  return 0;
+}
 
+// Query the latest release (conditionally) and start an OTA if it is newer.
+// Returns the number of seconds until the next check should run.
+static uint32_t checkForUpdate() {
+  TRACE_SPAN("ota.check");
   LOGF("Current version: %s\n", FIRMWARE_VERSION);
   LOGF("WiFi status=%d IP=%s RSSI=%d\n", (int)WiFi.status(), WiFi.localIP().toString().c_str(), (int)WiFi.RSSI());
 
-  String latestJson;
-  String apiUrl = String("https://api.github.com/repos/") + GITHUB_OWNER + "/" + GITHUB_REPO + "/releases/latest";
-  LOGF("API URL: %s\n", apiUrl.c_str());
-  if (!httpsGet(apiUrl, latestJson)) {
-    LOGLN("Latest check failed");
-    return;
+  ReleaseCache cache;
+  loadCache(cache);
+  // Validators are only useful if the parsed result they vouch for is present
+  if (cache.tag[0] == '\0') cache.etag[0] = cache.lastModified[0] = '\0';
+
+  const char *names[kAssetCount];
+  for (uint8_t i = 0; i < kAssetCount; ++i) names[i] = kAssets[i].name;
+  ReleaseParser parser(names, kAssetCount);
+  ReleaseParserSink sink(parser);
+  ResponseMeta meta;
+  int code = httpsGet(kApiUrl, sink, cache, meta);
+
+  uint32_t next = withJitter(OTA_CHECK_INTERVAL_S);
+  uint32_t limited = rateLimitWait(meta);
+  if (code == HTTP_CODE_NOT_MODIFIED) {
+    LOGF("Release unchanged (304), cached tag=%s\n", cache.tag);
+  } else if (code == HTTP_CODE_OK) {
+    LOGF("Release JSON scanned: %u bytes\n", (unsigned)sink.bytes());
+    if (strlen(parser.tagName()) == 0) {
+      LOGF("JSON missing tag_name (parser %s)\n", parser.failed() ? "failed" : "ok");
+      code = -1;
+    } else {
+      strlcpy(cache.etag, meta.etag, sizeof(cache.etag));
+      strlcpy(cache.lastModified, meta.lastModified, sizeof(cache.lastModified));
+      strlcpy(cache.tag, parser.tagName(), sizeof(cache.tag));
+      strlcpy(cache.url, parser.assetUrl(), sizeof(cache.url));
+      cache.assetIndex = parser.assetIndex();
+      saveCache(cache);
+    }
   }
 
-  String latestTag = jsonFindString(latestJson, String("tag_name"));
-  if (latestTag.length() == 0) {
-    LOGLN("JSON missing tag_name; body preview:");
-    LOGF("%s\n", latestJson.substring(0, 200).c_str());
-    return;
+  if (code != HTTP_CODE_OK && code != HTTP_CODE_NOT_MODIFIED) {
+    LOGLN("Latest check failed");
+    // Exponential back-off, capped at the regular interval
+    uint32_t backoff = RETRY_MIN_S << (s_failures < 6 ? s_failures : 6);
+    if (s_failures < 255) s_failures++;
+    next = withJitter(backoff < OTA_CHECK_INTERVAL_S ? backoff : OTA_CHECK_INTERVAL_S);
+    return limited > next ? limited : next;
   }
+  s_failures = 0;
+  if (limited > next) next = limited;
 
-  String current = FIRMWARE_VERSION;
-  int cmp = compareSemVer(current, latestTag);
-  LOGF("Compare: current=%s latest=%s -> %d\n", current.c_str(), latestTag.c_str(), cmp);
+  int cmp = Version::compare(kCurrent, Version::parse(cache.tag));
+  LOGF("Compare: current=%s latest=%s -> %d\n", FIRMWARE_VERSION, cache.tag, cmp);
   if (cmp >= 0) {
-    return;
+    return next;
   }
 
-  String assetUrl = findAssetUrl(latestJson, FIRMWARE_ASSET);
-  if (assetUrl.length() == 0) {
-    LOGLN("Could not determine asset URL from JSON");
-    return;
+  const char *assetUrl = cache.url;
+  char defaultUrl[ReleaseParser::URL_MAX];
+  OtaEngine::ImageFormat fmt = OtaEngine::ImageFormat::Raw;
+  if (s_resumeTag[0] && strcmp(s_resumeTag, cache.tag) != 0) {
+    LOGF("Release changed from %s; not resuming\n", s_resumeTag);
+    s_resumeTag[0] = '\0';
+  }
+  if (s_resumeTag[0]) {
+    LOGLN("Resuming the interrupted full image download");
+    defaultAssetUrl(defaultUrl, sizeof(defaultUrl), cache.tag, FIRMWARE_ASSET);
+    assetUrl = defaultUrl;
+  } else if (cache.url[0] == '\0' || cache.assetIndex < 0 || cache.assetIndex >= kAssetCount) {
+    LOGLN("Asset not listed; using default download URL");
+    defaultAssetUrl(defaultUrl, sizeof(defaultUrl), cache.tag, FIRMWARE_ASSET);
+    assetUrl = defaultUrl;
+  } else {
+    fmt = kAssets[cache.assetIndex].format;
+    if (fmt != OtaEngine::ImageFormat::Raw) defaultAssetUrl(s_fallbackUrl, sizeof(s_fallbackUrl), cache.tag, FIRMWARE_ASSET);
   }
 
-  LOGF("Asset URL: %s\n", assetUrl.c_str());
-  performOta(assetUrl);
+  LOGF("Asset URL: %s (format %u)\n", assetUrl, (unsigned)fmt);
+  strlcpy(s_otaTag, cache.tag, sizeof(s_otaTag));
+  performOta(assetUrl, fmt);
+  return next;
 }
 
 void loop() {
-  // Only proceed if WiFi is connected
-  if (!Provisioning::isConnected()) return;
-  checkAndUpdateOnce();
+  pumpOtaEvents();
+  // Only proceed if WiFi is connected and no update is in flight
+  if (s_disabled || !Provisioning::isConnected() || OtaEngine::busy()) return;
+  if (millis() - s_lastCheckMs < s_checkDelayMs) return;
+
+  // Ensure configuration present
+  if (GITHUB_OWNER[0] == '\0' || GITHUB_REPO[0] == '\0') {
+    // Not configured; nothing to do
+    LOGLN("GITHUB_OWNER/REPO not configured; skipping");
+    s_disabled = true;
+    return;
+  }
+
+  // Fragmentation report: an OTA needs large contiguous TLS/inflate buffers
+  uint32_t freeBefore = ESP.getFreeHeap();
+  uint32_t largestBefore = ESP.getMaxAllocHeap();
+  uint32_t next = checkForUpdate();
+  LOGF("Heap free %u -> %u, largest block %u -> %u\n", (unsigned)freeBefore, (unsigned)ESP.getFreeHeap(),
+       (unsigned)largestBefore, (unsigned)ESP.getMaxAllocHeap());
+  s_lastCheckMs = millis();
+  s_checkDelayMs = next * 1000UL;
+  LOGF("Next release check in %u s\n", (unsigned)next);
 }
 
 } // namespace Updater
@@ -0,0 +1,391 @@
+// BEEP sensor-data uploader implementation
+//
+// Readings arrive through Measurements::publish into a small RAM staging
+// area (any task, never touches flash). loop() appends staged readings to
+// an append-only queue file on LittleFS in one write and, when online,
+// reads batches back from the queue head and POSTs them to the BEEP sensor
+// API (doc/Beep-Sensor-data-API-v0.5.pdf). The API takes one timestamp per
+// request, so readings sharing a timestamp go out as one form body and
+// consecutive requests reuse the pooled keep-alive connection. The head
+// offset is kept in NVS so a reboot resumes where the last batch stopped.
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <Preferences.h>
+#include <HTTPClient.h>
+
+#include "uploader.h"
+#include "measurement.h"
+#include "storage.h"
+#include "https_client.h"
+#include "provisioning.h"
+#include "ota_engine.h"
+
+#define HS_LOG_PREFIX "UPL"
+#include "debug.h"
+
+// Build-time configuration (can be overridden via platformio.ini build_flags)
+#ifndef BEEP_API_URL
+#define BEEP_API_URL "https://api.beep.nl/api/sensors"
+#endif
+#ifndef BEEP_SENSOR_KEY
+#define BEEP_SENSOR_KEY ""
+#endif
+// A reading waits at most this long before it is sent
+#ifndef UPLOAD_MAX_DELAY_S
+#define UPLOAD_MAX_DELAY_S 300
+#endif
+// ...or until this many readings are pending
+#ifndef UPLOAD_BATCH_MIN
+#define UPLOAD_BATCH_MIN 16
+#endif
+
+namespace Uploader {
+
+static const char *QUEUE_PATH = "/upq.bin";
+static const char *QUEUE_TMP_PATH = "/upq.tmp";
+static const uint32_t QUEUE_MAX_BYTES = 128 * 1024;
+static const uint32_t REC_SIZE = sizeof(Measurement);
+static const uint8_t STAGE_CAP = 32;
+static const uint8_t STAGE_FLUSH = 16;           // staged readings that trigger a flash append
+static const uint32_t STAGE_MAX_AGE_MS = 60000;  // ...or the age of the oldest staged one
+static const uint8_t BATCH_MAX = 32;             // readings read from flash per send round
+static const size_t BODY_MAX = 512;
+static const uint32_t BACKOFF_MIN_S = 30;
+static const uint32_t BACKOFF_MAX_S = 3600;
+
+static_assert(sizeof(Measurement) == 24, "queue file layout");
+
+static bool s_enabled = false;
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static Measurement s_stage[STAGE_CAP];
+static uint8_t s_staged = 0;
+static uint32_t s_stageSinceMs = 0;
+
+static uint32_t s_head = 0;         // byte offset of the first unsent record
+static uint32_t s_tail = 0;         // queue file size
+static uint32_t s_fileOldestMs = 0; // when the oldest record on flash was staged
+static uint32_t s_retryAtMs = 0;
+static uint32_t s_backoffS = 0;
+static bool s_draining = false;
+static bool s_sntpStarted = false;
+static Measurement s_batch[BATCH_MAX];
+static Stats s_stats = {0, 0, 0, 0, 0, 0, 0};
+
+// Measurements sink: RAM only, callable from any task
+static void enqueue(const Measurement &m) {
+  portENTER_CRITICAL(&s_mux);
+  if (s_staged < STAGE_CAP) {
+    if (s_staged == 0) s_stageSinceMs = millis();
+    s_stage[s_staged++] = m;
+    s_stats.queued++;
+  } else {
+    s_stats.dropped++;
+  }
+  portEXIT_CRITICAL(&s_mux);
+}
+
+static void saveHead() {
+  Preferences prefs;
+  if (!prefs.begin("upq", false)) return;
+  prefs.putUInt("head", s_head);
+  prefs.end();
+}
+
+static void resetQueue() {
+  LittleFS.remove(QUEUE_PATH);
+  s_head = s_tail = 0;
+  saveHead();
+}
+
+// Rewrite the queue file as exactly [head, tail): drops already-sent records
+// from the front and any partial record after tail
+static bool compact() {
+  File in = LittleFS.open(QUEUE_PATH, FILE_READ);
+  File out = LittleFS.open(QUEUE_TMP_PATH, FILE_WRITE);
+  if (!in || !out) return false;
+  in.seek(s_head);
+  uint8_t buf[256];
+  uint32_t copied = 0;
+  while (copied < s_tail - s_head) {
+    uint32_t want = s_tail - s_head - copied;
+    size_t n = in.read(buf, want < sizeof(buf) ? want : sizeof(buf));
+    if (n == 0) break;
+    if (out.write(buf, n) != n) break;
+    copied += n;
+  }
+  in.close();
+  out.close();
+  if (copied != s_tail - s_head) {
+    LittleFS.remove(QUEUE_TMP_PATH);
+    return false;
+  }
+  LittleFS.remove(QUEUE_PATH);
+  LittleFS.rename(QUEUE_TMP_PATH, QUEUE_PATH);
+  LOGF("Compacted queue: %u -> %u bytes\n", (unsigned)s_tail, (unsigned)copied);
+  s_tail = copied;
+  s_head = 0;
+  saveHead();
+  return true;
+}
+
+// Append staged readings to the queue file in a single write
+static void flushStage() {
+  Measurement local[STAGE_CAP];
+  uint8_t n;
+  uint32_t since;
+  portENTER_CRITICAL(&s_mux);
+  n = s_staged;
+  since = s_stageSinceMs;
+  memcpy(local, s_stage, n * sizeof(Measurement));
+  s_staged = 0;
+  portEXIT_CRITICAL(&s_mux);
+  if (n == 0) return;
+
+  uint32_t bytes = n * REC_SIZE;
+  if (s_tail + bytes > QUEUE_MAX_BYTES && s_head) compact();
+  if (s_tail + bytes > QUEUE_MAX_BYTES) {
+    LOGF("Queue full, dropping %u readings\n", (unsigned)n);
+    s_stats.dropped += n;
+    return;
+  }
+  File f = LittleFS.open(QUEUE_PATH, FILE_APPEND);
+  // Bytes past tail are a torn record from an append that ran out of
+  // space; a record written behind them would be misaligned
+  if (f && f.size() != s_tail) {
+    f.close();
+    f = compact() ? LittleFS.open(QUEUE_PATH, FILE_APPEND) : File();
+  }
+  size_t written = f ? f.write((const uint8_t *)local, bytes) : 0;
+  if (f) f.close();
+  // Whole records that made it stay queued
+  uint8_t whole = (uint8_t)(written / REC_SIZE);
+  if (whole < n) {
+    LOGF("Queue append failed, dropping %u readings\n", (unsigned)(n - whole));
+    s_stats.dropped += n - whole;
+  }
+  if (whole == 0) return;
+  if (s_tail == s_head) s_fileOldestMs = since;
+  s_tail += whole * REC_SIZE;
+  s_stats.flashWrites++;
+}
+
+// Shortest decimal form of a reading, e.g. "40.12" rather than "40.120000"
+static void formatValue(char *out, size_t len, float v) {
+  snprintf(out, len, "%.6g", (double)v);
+}
+
+// Readings [i, j) that can share one request: same timestamp, no key twice
+static uint8_t groupEnd(uint8_t i, uint8_t n) {
+  uint8_t j = i + 1;
+  for (; j < n && s_batch[j].time == s_batch[i].time; ++j) {
+    for (uint8_t k = i; k < j; ++k) {
+      if (strcmp(s_batch[k].key, s_batch[j].key) == 0) return j;
+    }
+  }
+  return j;
+}
+
+// Build "key=<sensor>&time=<t>&k1=v1&k2=v2..." for readings from i;
+// returns how many readings fit, 0 if none
+static uint8_t buildBody(char *body, size_t cap, size_t &len, uint8_t i, uint8_t end) {
+  int n = s_batch[i].time
+              ? snprintf(body, cap, "key=%s&time=%u", BEEP_SENSOR_KEY, (unsigned)s_batch[i].time)
+              : snprintf(body, cap, "key=%s", BEEP_SENSOR_KEY);
+  if (n <= 0 || (size_t)n >= cap) return 0;
+  len = n;
+  uint8_t used = 0;
+  for (uint8_t k = i; k < end; ++k) {
+    char value[16];
+    formatValue(value, sizeof(value), s_batch[k].value);
+    n = snprintf(body + len, cap - len, "&%s=%s", s_batch[k].key, value);
+    if (n <= 0 || (size_t)n >= cap - len) break;
+    len += n;
+    used++;
+  }
+  body[len] = '\0';
+  return used;
+}
+
+// Send one batch from the queue head. Returns false on a transport or
+// server error that should be retried later.
+static bool sendBatch() {
+  File f = LittleFS.open(QUEUE_PATH, FILE_READ);
+  if (!f) {
+    resetQueue();
+    return true;
+  }
+  f.seek(s_head);
+  size_t got = f.read((uint8_t *)s_batch, sizeof(s_batch));
+  f.close();
+  uint8_t n = (uint8_t)(got / REC_SIZE);
+  if (n > (s_tail - s_head) / REC_SIZE) n = (uint8_t)((s_tail - s_head) / REC_SIZE);
+  if (n == 0) {
+    resetQueue();
+    return true;
+  }
+
+  static const Https::Header kHeaders[] = {
+    {"User-Agent", "HiveSync"},
+    {"Content-Type", "application/x-www-form-urlencoded"},
+  };
+  Https::Options opts;
+  opts.headers = kHeaders;
+  opts.headerCount = sizeof(kHeaders) / sizeof(kHeaders[0]);
+  opts.timeoutMs = 10000;
+
+  uint8_t consumed = 0;
+  bool ok = true;
+  char body[BODY_MAX];
+  while (consumed < n) {
+    size_t len = 0;
+    uint8_t used = buildBody(body, sizeof(body), len, consumed, groupEnd(consumed, n));
+    if (used == 0) {
+      LOGF("Unsendable reading '%s' dropped\n", s_batch[consumed].key);
+      s_stats.dropped++;
+      consumed++;
+      continue;
+    }
+    Https::Response resp;
+    int code = Https::request("POST", BEEP_API_URL, (const uint8_t *)body, len, opts, resp);
+    s_stats.posts++;
+    if (code > 0) {
+      resp.http().getString(); // short JSON acknowledgement; read it to keep the connection
+      resp.end();
+    }
+    if (code >= 200 && code < 300) {
+      s_stats.sent += used;
+      s_stats.bodyBytes += len;
+    } else if (code == 400 || code == 422) {
+      // Malformed for the server; resending would fail forever
+      LOGF("Server rejected %u readings (HTTP %d)\n", (unsigned)used, code);
+      s_stats.dropped += used;
+    } else {
+      LOGF("POST failed: %d\n", code);
+      ok = false;
+      break;
+    }
+    consumed += used;
+  }
+
+  if (consumed) {
+    s_head += consumed * REC_SIZE;
+    if (s_head >= s_tail) {
+      resetQueue();
+    } else {
+      saveHead();
+    }
+  }
+  LOGF("Batch: %u/%u readings sent, %u bytes still queued\n", (unsigned)consumed, (unsigned)n,
+       (unsigned)(s_tail - s_head));
+  return ok;
+}
+
+// Readings taken once the clock is set carry real timestamps; the clock
+// keeps running through deep sleep
+static void startSntp() {
+  if (s_sntpStarted) return;
+  configTime(0, 0, "pool.ntp.org", "time.google.com");
+  s_sntpStarted = true;
+}
+
+// Exponential back-off with +/-25% jitter after a failed batch
+static void backOff() {
+  s_backoffS = s_backoffS ? s_backoffS * 2 : BACKOFF_MIN_S;
+  if (s_backoffS > BACKOFF_MAX_S) s_backoffS = BACKOFF_MAX_S;
+  uint32_t wait = s_backoffS - s_backoffS / 4 + esp_random() % (s_backoffS / 2 + 1);
+  s_retryAtMs = millis() + wait * 1000UL;
+  s_draining = false;
+  LOGF("Retry in %u s\n", (unsigned)wait);
+}
+
+void begin() {
+  if (strlen(BEEP_SENSOR_KEY) == 0) {
+    LOGLN("BEEP_SENSOR_KEY not configured; uploads disabled");
+    return;
+  }
+  if (!Storage::begin()) {
+    LOGLN("No storage; uploads disabled");
+    return;
+  }
+  File f = LittleFS.open(QUEUE_PATH, FILE_READ);
+  s_tail = f ? (uint32_t)f.size() : 0;
+  if (f) f.close();
+  s_tail -= s_tail % REC_SIZE;
+  Preferences prefs;
+  if (prefs.begin("upq", true)) {
+    s_head = prefs.getUInt("head", 0);
+    prefs.end();
+  }
+  s_head -= s_head % REC_SIZE;
+  if (s_head >= s_tail) {
+    if (s_tail || s_head) resetQueue();
+  } else {
+    // Left over from before the reboot: due right away
+    s_fileOldestMs = millis() - UPLOAD_MAX_DELAY_S * 1000UL;
+    LOGF("Restored %u queued readings\n", (unsigned)((s_tail - s_head) / REC_SIZE));
+  }
+  s_enabled = Measurements::subscribe(enqueue);
+}
+
+void loop() {
+  if (!s_enabled) return;
+  uint32_t now = millis();
+
+  uint8_t staged;
+  uint32_t stageSince;
+  portENTER_CRITICAL(&s_mux);
+  staged = s_staged;
+  stageSince = s_stageSinceMs;
+  portEXIT_CRITICAL(&s_mux);
+  if (staged >= STAGE_FLUSH || (staged && now - stageSince >= STAGE_MAX_AGE_MS)) {
+    flushStage();
+    staged = 0;
+  }
+
+  if (!Provisioning::isConnected() || OtaEngine::busy()) return;
+  startSntp();
+  if ((int32_t)(now - s_retryAtMs) < 0) return;
+
+  uint32_t pending = (s_tail - s_head) / REC_SIZE + staged;
+  if (pending == 0) return;
+  uint32_t oldest = (s_tail > s_head) ? s_fileOldestMs : stageSince;
+  bool due = s_draining || pending >= UPLOAD_BATCH_MIN || now - oldest >= UPLOAD_MAX_DELAY_S * 1000UL;
+  if (!due) return;
+
+  flushStage();
+  if (s_tail == s_head) return;
+  if (sendBatch()) {
+    s_backoffS = 0;
+    s_draining = s_tail > s_head;
+  } else {
+    backOff();
+  }
+}
+
+bool flush(uint32_t timeoutMs) {
+  if (!s_enabled) return true;
+  flushStage();
+  if (!Provisioning::isConnected()) return s_tail == s_head;
+  startSntp();
+  uint32_t start = millis();
+  while (s_tail > s_head && millis() - start < timeoutMs) {
+    if (!sendBatch()) {
+      backOff();
+      break;
+    }
+    s_backoffS = 0;
+  }
+  return s_tail == s_head;
+}
+
+Stats stats() {
+  Stats st = s_stats;
+  portENTER_CRITICAL(&s_mux);
+  st.pending = s_staged;
+  portEXIT_CRITICAL(&s_mux);
+  st.pending += (s_tail - s_head) / REC_SIZE;
+  return st;
+}
+
+} // namespace Uploader
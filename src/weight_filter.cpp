@@ -0,0 +1,81 @@
+// Load-cell filter implementation
+//
+// The median stage removes single-sample spikes (a bee landing next to the
+// cell, SPI glitches); the Kalman stage averages out wind and traffic
+// noise with a gain that shrinks to about sqrt(Q/R) once converged. A
+// step, such as a super being added or the lid lifted, shows up as many
+// samples in a row on the same side of the estimate; the filter jumps to
+// the new level and waits to settle again, so no slow ramp is reported.
+
+#include "weight_filter.h"
+
+const WeightFilter::Config WeightFilter::SCALE_DEFAULTS = {10000, 4, 2000, 40, 160, 0, 2000};
+
+void WeightFilter::reset() {
+  _filled = 0;
+  _next = 0;
+  _x = 0;
+  _p = 0;
+  _started = false;
+  _outliers = 0;
+  _outlierSign = 0;
+  _quiet = 0;
+  _stepDelta = 0;
+  _tempC100 = _cfg.trefC100;
+}
+
+int32_t WeightFilter::median(int32_t raw) {
+  _window[_next] = raw;
+  _next = (_next + 1) % MEDIAN_N;
+  if (_filled < MEDIAN_N) _filled++;
+  int32_t sorted[MEDIAN_N];
+  for (uint8_t i = 0; i < _filled; ++i) {
+    int32_t v = _window[i];
+    uint8_t j = i;
+    for (; j > 0 && sorted[j - 1] > v; --j) sorted[j] = sorted[j - 1];
+    sorted[j] = v;
+  }
+  return sorted[_filled / 2];
+}
+
+WeightFilter::Event WeightFilter::add(int32_t raw) {
+  int32_t z = median(raw);
+  if (_filled < MEDIAN_N) return Event::None; // the first medians are not robust yet
+  z -= (int32_t)(((int64_t)_cfg.tempco * (_tempC100 - _cfg.trefC100)) / 100);
+
+  if (!_started) {
+    _x = (int64_t)z << FRAC_BITS;
+    _p = _cfg.noiseVar;
+    _started = true;
+    return Event::None;
+  }
+
+  int32_t innovation = z - value();
+  int8_t sign = innovation > 0 ? 1 : -1;
+  if (innovation > _cfg.stepCounts || innovation < -_cfg.stepCounts) {
+    _outliers = (sign == _outlierSign) ? _outliers + 1 : 1;
+    _outlierSign = sign;
+    if (_outliers >= _cfg.stepConfirm) {
+      // Restart at the median, which already sits at the new level
+      _stepDelta = z - value();
+      _x = (int64_t)z << FRAC_BITS;
+      _p = _cfg.noiseVar;
+      _outliers = 0;
+      _quiet = 0;
+      return Event::Step;
+    }
+    _quiet = 0;
+    return Event::None; // hold the estimate while a possible step builds up
+  }
+  _outliers = 0;
+
+  uint32_t prior = _p + _cfg.driftVar;
+  uint32_t gain = (uint32_t)(((uint64_t)prior << GAIN_BITS) / ((uint64_t)prior + _cfg.noiseVar));
+  _x += ((int64_t)innovation * gain) >> (GAIN_BITS - FRAC_BITS);
+  _p = (uint32_t)(((uint64_t)((1UL << GAIN_BITS) - gain) * prior) >> GAIN_BITS);
+
+  if (_quiet < _cfg.settleSamples) {
+    if (++_quiet == _cfg.settleSamples) return Event::Settled;
+  }
+  return Event::None;
+}
@@ -0,0 +1,247 @@
+// Wi-Fi fast reconnect implementation
+//
+// A plain WiFi.begin() scans every channel and then runs DHCP, which is
+// most of the energy of a duty-cycle wake. After each successful connect
+// the AP's BSSID and channel and the DHCP lease are kept in NVS (and in
+// RTC memory, so timer wakes skip even the NVS read). The next connect
+// passes channel + BSSID to WiFi.begin() and, while the lease is recent,
+// configures the old address statically. A disconnect before an IP
+// arrives drops back to a scan for the stored SSID, then joins the
+// strongest AP it found with DHCP. One failure may just be a busy AP, so
+// the cached AP is only forgotten after WIFI_DIRECT_RETRIES of them
+// without a successful connect in between; the cached lease is dropped
+// after the first.
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_wifi.h>
+#include <Preferences.h>
+
+#include "wifi_fast.h"
+#include "measurement.h"
+
+#define HS_LOG_PREFIX "WIFI"
+#include "debug.h"
+
+// Reuse a DHCP lease without asking again for this long (seconds)
+#ifndef WIFI_LEASE_REUSE_S
+#define WIFI_LEASE_REUSE_S 3600
+#endif
+// Forget the cached AP after this many failed direct connects in a row
+#ifndef WIFI_DIRECT_RETRIES
+#define WIFI_DIRECT_RETRIES 3
+#endif
+
+namespace WifiFast {
+
+static const uint32_t CACHE_MAGIC = 0x57464331;  // "WFC1"
+static const uint32_t SCAN_MS_PER_CHANNEL = 120;
+
+struct Cache {
+  uint32_t magic;
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t failures;   // direct connects that failed since the last success
+  uint32_t ip, gateway, mask, dns;
+  uint32_t leaseAt;   // unix time of the last real DHCP lease, 0 = unknown
+};
+
+static RTC_DATA_ATTR Cache s_rtcCache;
+static Cache s_cache;
+static bool s_haveCache = false;
+
+enum class Attempt : uint8_t { Idle, Direct, Scan, Join };
+static volatile Attempt s_attempt = Attempt::Idle;
+static char s_ssid[33];
+static char s_pass[65];
+static uint32_t s_scanAtMs = 0;
+static uint32_t s_beginMs = 0;
+static uint32_t s_assocAtMs = 0;
+static Timings s_timings = {0, 0, 0, false, false, 0};
+
+static void loadCache() {
+  if (s_rtcCache.magic == CACHE_MAGIC) {
+    s_cache = s_rtcCache;
+  } else {
+    Preferences prefs;
+    if (prefs.begin("wifi", true)) {
+      if (prefs.getBytes("cache", &s_cache, sizeof(s_cache)) != sizeof(s_cache)) s_cache.magic = 0;
+      prefs.end();
+    }
+  }
+  s_haveCache = s_cache.magic == CACHE_MAGIC && s_cache.channel != 0;
+}
+
+// NVS is only written when something actually changed
+static void saveCache(const Cache &c) {
+  s_rtcCache = c;
+  if (s_haveCache && memcmp(&c, &s_cache, sizeof(c)) == 0) return;
+  s_cache = c;
+  s_haveCache = true;
+  Preferences prefs;
+  if (!prefs.begin("wifi", false)) return;
+  prefs.putBytes("cache", &c, sizeof(c));
+  prefs.end();
+}
+
+static void forgetCache() {
+  s_rtcCache.magic = 0;
+  s_cache.magic = 0;
+  s_haveCache = false;
+  Preferences prefs;
+  if (!prefs.begin("wifi", false)) return;
+  prefs.remove("cache");
+  prefs.end();
+}
+
+// A failed direct connect keeps the AP for the next try, without the lease
+static void noteDirectFailure() {
+  Cache c = s_cache;
+  c.failures++;
+  c.leaseAt = 0;
+  if (c.failures >= WIFI_DIRECT_RETRIES) {
+    LOGF("%u direct connects failed; forgetting the cached AP\n", (unsigned)c.failures);
+    forgetCache();
+    return;
+  }
+  saveCache(c);
+}
+
+static bool leaseFresh() {
+  uint32_t now = Measurements::now();
+  return s_cache.ip != 0 && s_cache.leaseAt != 0 && now >= s_cache.leaseAt &&
+         now - s_cache.leaseAt < WIFI_LEASE_REUSE_S;
+}
+
+// Join with DHCP: the AP a scan picked, or (bssid null) whichever the
+// driver's own scan finds
+static void join(const uint8_t *bssid, int32_t channel) {
+  s_attempt = Attempt::Join;
+  s_beginMs = millis();
+  if (bssid) WiFi.begin(s_ssid, s_pass[0] ? s_pass : nullptr, channel, bssid);
+  else WiFi.begin();
+}
+
+static void beginScan() {
+  if (s_timings.staticIp) {
+    // Back to DHCP after a direct attempt with the cached address
+    WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+  }
+  s_timings.direct = false;
+  s_timings.staticIp = false;
+  if (!s_ssid[0]) {
+    join(nullptr, 0);
+    return;
+  }
+  // Only the stored SSID; ARDUINO_EVENT_WIFI_SCAN_DONE picks the AP
+  s_attempt = Attempt::Scan;
+  s_scanAtMs = millis();
+  if (WiFi.scanNetworks(true, false, false, SCAN_MS_PER_CHANNEL, 0, s_ssid) == WIFI_SCAN_FAILED) join(nullptr, 0);
+}
+
+static void onScanDone() {
+  s_timings.scanMs = millis() - s_scanAtMs;
+  int16_t n = WiFi.scanComplete();
+  int16_t best = -1;
+  for (int16_t i = 0; i < n; ++i) {
+    if (WiFi.SSID(i) != s_ssid) continue;
+    if (best < 0 || WiFi.RSSI(i) > WiFi.RSSI(best)) best = i;
+  }
+  if (best >= 0) {
+    LOGF("Scan: %d APs, joining ch %d at %d dBm\n", (int)n, (int)WiFi.channel(best), (int)WiFi.RSSI(best));
+    join(WiFi.BSSID(best), WiFi.channel(best));
+  } else {
+    // Hidden SSID, or the AP is not up yet: leave it to the driver
+    LOGLN("Scan: stored SSID not seen");
+    join(nullptr, 0);
+  }
+  WiFi.scanDelete();
+}
+
+void begin() {
+  static bool registered = false;
+  if (!registered) {
+    WiFi.onEvent(onEvent);
+    registered = true;
+  }
+  loadCache();
+  s_timings = Timings{0, 0, 0, false, false, 0};
+
+  wifi_config_t conf;
+  s_ssid[0] = s_pass[0] = '\0';
+  if (esp_wifi_get_config(WIFI_IF_STA, &conf) == ESP_OK) {
+    memcpy(s_ssid, conf.sta.ssid, 32);
+    s_ssid[32] = '\0';
+    memcpy(s_pass, conf.sta.password, 64);
+    s_pass[64] = '\0';
+  }
+  if (!s_haveCache || !s_ssid[0]) {
+    beginScan();
+    return;
+  }
+
+  s_timings.staticIp = leaseFresh();
+  if (s_timings.staticIp) {
+    WiFi.config(IPAddress(s_cache.ip), IPAddress(s_cache.gateway), IPAddress(s_cache.mask), IPAddress(s_cache.dns));
+  }
+  s_attempt = Attempt::Direct;
+  s_timings.direct = true;
+  LOGF("Direct connect: ch %u, %s\n", (unsigned)s_cache.channel, s_timings.staticIp ? "cached lease" : "DHCP");
+  s_beginMs = millis();
+  WiFi.begin(s_ssid, s_pass[0] ? s_pass : nullptr, s_cache.channel, s_cache.bssid);
+}
+
+void onEvent(arduino_event_t *e) {
+  switch (e->event_id) {
+    case ARDUINO_EVENT_WIFI_SCAN_DONE:
+      if (s_attempt == Attempt::Scan) onScanDone();
+      break;
+
+    case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+      s_assocAtMs = millis();
+      s_timings.assocMs = s_assocAtMs - s_beginMs;
+      break;
+
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP: {
+      if (s_attempt == Attempt::Idle) break; // reconnect after a later drop
+      s_timings.dhcpMs = millis() - s_assocAtMs;
+      LOGF("Connect phases: scan %u ms, assoc %u ms, ip %u ms (%s%s)\n", (unsigned)s_timings.scanMs,
+           (unsigned)s_timings.assocMs, (unsigned)s_timings.dhcpMs, s_timings.direct ? "direct" : "scan",
+           s_timings.staticIp ? ", cached lease" : "");
+      Cache c;
+      memset(&c, 0, sizeof(c));
+      c.magic = CACHE_MAGIC;
+      const uint8_t *bssid = WiFi.BSSID();
+      if (bssid) memcpy(c.bssid, bssid, sizeof(c.bssid));
+      c.channel = (uint8_t)WiFi.channel();
+      c.ip = e->event_info.got_ip.ip_info.ip.addr;
+      c.gateway = e->event_info.got_ip.ip_info.gw.addr;
+      c.mask = e->event_info.got_ip.ip_info.netmask.addr;
+      c.dns = (uint32_t)WiFi.dnsIP();
+      // A reused lease does not renew it; keep the time of the real one
+      c.leaseAt = s_timings.staticIp ? s_cache.leaseAt : Measurements::now();
+      saveCache(c);
+      s_attempt = Attempt::Idle;
+      break;
+    }
+
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+      if (s_attempt == Attempt::Direct) {
+        // AP moved channel, BSSID changed or the old address was refused
+        LOGF("Direct connect failed (reason %u), scanning\n", (unsigned)e->event_info.wifi_sta_disconnected.reason);
+        s_timings.fallbacks++;
+        noteDirectFailure();
+        beginScan();
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+Timings timings() {
+  return s_timings;
+}
+
+} // namespace WifiFast
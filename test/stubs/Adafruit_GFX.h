@@ -0,0 +1,66 @@
+// Host stand-in for Adafruit GFX: same drawing API and pixel cost, but text
+// is drawn from a deterministic per-character pattern instead of the real
+// fonts.
+#pragma once
+
+#include <Arduino.h>
+
+struct GFXglyph {
+  uint16_t bitmapOffset;
+  uint8_t width, height, xAdvance;
+  int8_t xOffset, yOffset;
+};
+
+struct GFXfont {
+  uint8_t *bitmap;
+  GFXglyph *glyph;
+  uint16_t first, last;
+  uint8_t yAdvance;
+};
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+  virtual void setRotation(uint8_t r);
+
+  void setCursor(int16_t x, int16_t y) { _cursorX = x; _cursorY = y; }
+  void setTextColor(uint16_t c) { _textColor = _textBg = c; }
+  void setTextColor(uint16_t c, uint16_t bg) { _textColor = c; _textBg = bg; }
+  void setTextSize(uint8_t s) { _textSize = s ? s : 1; }
+  void setTextWrap(bool w) { _wrap = w; }
+  void setFont(const GFXfont *f) { _font = f; }
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+  int16_t getCursorX() const { return _cursorX; }
+  int16_t getCursorY() const { return _cursorY; }
+  uint8_t getRotation() const { return _rotation; }
+
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+protected:
+  int16_t WIDTH, HEIGHT;  // unrotated size
+  int16_t _width, _height;
+  int16_t _cursorX = 0, _cursorY = 0;
+  uint16_t _textColor = 0xFFFF, _textBg = 0xFFFF;
+  uint8_t _textSize = 1;
+  uint8_t _rotation = 0;
+  bool _wrap = true;
+  const GFXfont *_font = nullptr;
+};
+
+class GFXcanvas16 : public Adafruit_GFX {
+public:
+  GFXcanvas16(uint16_t w, uint16_t h);
+  ~GFXcanvas16();
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+  uint16_t *getBuffer() const { return _buffer; }
+
+private:
+  uint16_t *_buffer;
+};
@@ -0,0 +1,33 @@
+// Host stand-in for the Adafruit MAX1704X library: the same register
+// accessors over the Wire stand-in, so a simulated gauge behind
+// Host::attachI2c() answers both the library and raw register reads
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define MAX17048_I2CADDR_DEFAULT 0x36
+
+#define MAX1704X_ALERTFLAG_SOC_CHANGE 0x20
+#define MAX1704X_ALERTFLAG_SOC_LOW 0x10
+#define MAX1704X_ALERTFLAG_VOLTAGE_RESET 0x08
+#define MAX1704X_ALERTFLAG_VOLTAGE_LOW 0x04
+#define MAX1704X_ALERTFLAG_VOLTAGE_HIGH 0x02
+#define MAX1704X_ALERTFLAG_RESET_INDICATOR 0x01
+
+class Adafruit_MAX17048 {
+public:
+  // Finds the chip by its VERSION register (0x001x)
+  bool begin(TwoWire *wire = &Wire);
+  uint16_t getICversion();
+  float cellVoltage();
+  float cellPercent();
+  float chargeRate();
+  void setAlertVoltages(float minv, float maxv);
+  void getAlertVoltages(float &minv, float &maxv);
+
+private:
+  bool readReg(uint8_t reg, uint16_t &value);
+  bool writeReg(uint8_t reg, uint16_t value);
+  TwoWire *_wire = nullptr;
+};
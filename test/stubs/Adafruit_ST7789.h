@@ -0,0 +1,41 @@
+// Host stand-in for the ST7789 panel: a framebuffer behind the SPI-style
+// address window API, counting what would go over the bus (host.h)
+#pragma once
+
+#include <Adafruit_GFX.h>
+
+#define ST77XX_BLACK 0x0000
+#define ST77XX_WHITE 0xFFFF
+#define ST77XX_RED 0xF800
+#define ST77XX_GREEN 0x07E0
+#define ST77XX_BLUE 0x001F
+#define ST77XX_CYAN 0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW 0xFFE0
+#define ST77XX_ORANGE 0xFC00
+
+class Adafruit_ST7789 : public Adafruit_GFX {
+public:
+  Adafruit_ST7789(int8_t cs, int8_t dc, int8_t rst);
+  ~Adafruit_ST7789();
+  void init(uint16_t width, uint16_t height, uint8_t spiMode = 0);
+  void setRotation(uint8_t r) override;
+
+  void startWrite() {}
+  void endWrite() {}
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+  void writePixels(uint16_t *colors, uint32_t len, bool block = true, bool bigEndian = false);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+
+  // Panel contents in the current rotation (host only)
+  uint16_t pixel(int16_t x, int16_t y) const;
+
+private:
+  void push(uint16_t color);
+
+  uint16_t *_fb = nullptr;
+  int16_t _winX = 0, _winY = 0, _winW = 0, _winH = 0;
+  uint32_t _winPos = 0;
+};
@@ -0,0 +1,74 @@
+// Host stand-in for the Arduino-ESP32 core: just enough of the API for the
+// modules built by the native environment. Time is the host's steady
+// clock, pins are simulated (see host.h), Serial goes to stdout.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "pgmspace.h"
+#include "WString.h"
+#include "IPAddress.h"
+#include "Print.h"
+#include "Stream.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+// glibc only has strlcpy from 2.38 on
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+extern "C" size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
+
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define digitalPinToInterrupt(p) (p)
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+uint32_t esp_random();
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char *server1, const char *server2 = nullptr,
+                const char *server3 = nullptr);
+
+class EspClass {
+public:
+  uint32_t getFreeHeap() { return 256 * 1024; }
+  uint32_t getCpuFreqMHz() { return 240; }
+};
+extern EspClass ESP;
+
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buf, size_t n) override;
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
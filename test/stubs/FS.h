@@ -0,0 +1,65 @@
+// Host stand-in for the Arduino-ESP32 FS/File API: files live in a host
+// directory (see Host::fsRoot()), so data survives "reboots" within a test
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+struct HostFile;
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File : public Stream {
+public:
+  File() {}
+  explicit File(std::shared_ptr<HostFile> f) : _f(f) {}
+
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t *buf, size_t n) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  size_t read(uint8_t *buf, size_t n);
+  int peek() override;
+  void flush() override;
+  bool seek(uint32_t pos, SeekMode mode);
+  bool seek(uint32_t pos) { return seek(pos, SeekSet); }
+  size_t position() const;
+  size_t size() const;
+  void close();
+  operator bool() const;
+  const char *path() const;
+  const char *name() const;  // last path component, as in Arduino-ESP32 2.x
+  bool isDirectory() const;
+  File openNextFile(const char *mode = FILE_READ);
+
+private:
+  std::shared_ptr<HostFile> _f;
+};
+
+class FS {
+public:
+  File open(const char *path, const char *mode = FILE_READ, bool create = false);
+  File open(const String &path, const char *mode = FILE_READ, bool create = false) {
+    return open(path.c_str(), mode, create);
+  }
+  bool exists(const char *path);
+  bool exists(const String &path) { return exists(path.c_str()); }
+  bool remove(const char *path);
+  bool remove(const String &path) { return remove(path.c_str()); }
+  bool rename(const char *from, const char *to);
+  bool rename(const String &from, const String &to) { return rename(from.c_str(), to.c_str()); }
+  bool mkdir(const char *path);
+  bool rmdir(const char *path);
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
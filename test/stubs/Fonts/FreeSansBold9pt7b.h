@@ -0,0 +1,6 @@
+// Host stand-in: metrics only, glyphs come from the GFX stand-in's pattern
+#pragma once
+
+#include <Adafruit_GFX.h>
+
+static const GFXfont FreeSansBold9pt7b = {nullptr, nullptr, 0x20, 0x7E, 22};
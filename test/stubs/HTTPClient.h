@@ -0,0 +1,79 @@
+// Host stand-in for the Arduino-ESP32 HTTPClient. Requests are handed to
+// the in-process server of host.h as a whole; the response body is then
+// read back through the WiFiClient like from a socket, so keep-alive,
+// partial reads and dropped connections behave as on the device.
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_PARTIAL_CONTENT 206
+#define HTTP_CODE_MOVED_PERMANENTLY 301
+#define HTTP_CODE_FOUND 302
+#define HTTP_CODE_NOT_MODIFIED 304
+#define HTTP_CODE_FORBIDDEN 403
+#define HTTP_CODE_NOT_FOUND 404
+#define HTTP_CODE_RANGE_NOT_SATISFIABLE 416
+#define HTTP_CODE_TOO_MANY_REQUESTS 429
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+typedef enum {
+  HTTPC_DISABLE_FOLLOW_REDIRECTS,
+  HTTPC_STRICT_FOLLOW_REDIRECTS,
+  HTTPC_FORCE_FOLLOW_REDIRECTS
+} followRedirects_t;
+
+class HTTPClient {
+public:
+  bool begin(WiFiClient &client, const String &url);
+  void end();
+  void setReuse(bool reuse) { _reuse = reuse; }
+  void setTimeout(uint16_t ms) { _timeoutMs = ms; }
+  void setConnectTimeout(int32_t) {}
+  void setFollowRedirects(followRedirects_t) {}
+  void addHeader(const String &name, const String &value, bool first = false, bool replace = true);
+  void collectHeaders(const char *keys[], const size_t count);
+
+  int sendRequest(const char *method, uint8_t *payload = nullptr, size_t size = 0);
+  int GET() { return sendRequest("GET"); }
+  int POST(uint8_t *payload, size_t size) { return sendRequest("POST", payload, size); }
+
+  String header(const char *name);
+  bool hasHeader(const char *name);
+  int getSize() { return _size; }
+  String getLocation() { return _location; }
+  String getString();
+  WiFiClient *getStreamPtr() { return _client; }
+  WiFiClient &getStream() { return *_client; }
+  int writeToStream(Stream *stream);
+  static String errorToString(int error);
+
+private:
+  WiFiClient *_client = nullptr;
+  std::string _url;
+  std::string _host;
+  uint16_t _port = 0;
+  bool _reuse = true;
+  bool _canReuse = false;
+  uint16_t _timeoutMs = 5000;
+  std::vector<std::pair<std::string, std::string>> _reqHeaders;
+  std::vector<std::string> _collect;
+  std::vector<std::pair<std::string, std::string>> _respHeaders;
+  int _size = -1;
+  String _location;
+};
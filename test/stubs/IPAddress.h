@@ -0,0 +1,26 @@
+// Host stand-in for the Arduino IPAddress: an IPv4 address in the lwIP
+// byte order (first octet in the low byte)
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "WString.h"
+
+class IPAddress {
+public:
+  IPAddress() : _addr(0) {}
+  IPAddress(uint32_t addr) : _addr(addr) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+      : _addr((uint32_t)a | (uint32_t)b << 8 | (uint32_t)c << 16 | (uint32_t)d << 24) {}
+  operator uint32_t() const { return _addr; }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (unsigned)(_addr & 0xff), (unsigned)(_addr >> 8 & 0xff),
+             (unsigned)(_addr >> 16 & 0xff), (unsigned)(_addr >> 24));
+    return String(buf);
+  }
+
+private:
+  uint32_t _addr;
+};
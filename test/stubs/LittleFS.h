@@ -0,0 +1,21 @@
+// Host stand-in for the LittleFS partition (0xF0000 bytes, as in
+// partitions/hivesync_ota_4mb_littlefs.csv)
+#pragma once
+
+#include <FS.h>
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+  bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+             const char *partitionLabel = "spiffs");
+  bool format();
+  size_t totalBytes();
+  size_t usedBytes();
+  void end() {}
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,37 @@
+// Host stand-in for the Arduino-ESP32 NVS wrapper: namespaces of typed
+// keys kept in memory for the life of the process (Host::clearNvs())
+#pragma once
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+  // Read-only opening of a namespace that was never written fails, as on NVS
+  bool begin(const char *name, bool readOnly = false);
+  void end();
+
+  bool clear();
+  bool remove(const char *key);
+  bool isKey(const char *key);
+
+  size_t putChar(const char *key, int8_t value);
+  size_t putUInt(const char *key, uint32_t value);
+  size_t putString(const char *key, const char *value);
+  size_t putString(const char *key, const String &value) { return putString(key, value.c_str()); }
+  size_t putBytes(const char *key, const void *value, size_t len);
+
+  int8_t getChar(const char *key, int8_t defaultValue = 0);
+  uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+  size_t getString(const char *key, char *value, size_t maxLen);
+  String getString(const char *key, const String &defaultValue = String());
+  size_t getBytesLength(const char *key);
+  size_t getBytes(const char *key, void *buf, size_t maxLen);
+
+private:
+  bool put(const char *key, char type, const void *data, size_t len);
+  const std::string *get(const char *key, char type);
+
+  std::string _ns;
+  bool _open = false;
+  bool _readOnly = false;
+};
@@ -0,0 +1,32 @@
+// Host stand-in for the Arduino Print interface
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "WString.h"
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t n);
+  size_t write(const char *s);
+  virtual void flush() {}
+
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+  size_t print(const char *s) { return write(s); }
+  size_t print(const String &s) { return write(s.c_str()); }
+  size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = 10) { return print((long)v, base); }
+  size_t print(unsigned v, int base = 10) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = 10);
+  size_t print(unsigned long v, int base = 10);
+  size_t print(double v, int digits = 2);
+  size_t println() { return write("\r\n"); }
+  template <typename T>
+  size_t println(const T &v) { return print(v) + println(); }
+  size_t println(int v, int base) { return print(v, base) + println(); }
+  size_t println(double v, int digits) { return print(v, digits) + println(); }
+};
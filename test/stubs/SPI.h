@@ -0,0 +1,2 @@
+// Host stand-in: the panel stand-in needs no bus
+#pragma once
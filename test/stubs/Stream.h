@@ -0,0 +1,25 @@
+// Host stand-in for the Arduino Stream and Client interfaces
+#pragma once
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  void setTimeout(unsigned long ms) { _timeout = ms; }
+  size_t readBytes(uint8_t *buf, size_t n);
+
+protected:
+  unsigned long _timeout = 1000;
+};
+
+class Client : public Stream {
+public:
+  virtual int connect(const char *host, uint16_t port) = 0;
+  virtual int read(uint8_t *buf, size_t n) = 0;
+  using Stream::read;
+  virtual void stop() = 0;
+  virtual uint8_t connected() = 0;
+};
@@ -0,0 +1,30 @@
+// Host stand-in for the Arduino-ESP32 Update class on top of the
+// file-backed OTA slots of esp_partition.h
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+
+class UpdateClass {
+public:
+  bool begin(size_t size = UPDATE_SIZE_UNKNOWN);
+  size_t write(uint8_t *data, size_t len);
+  bool end(bool evenIfRemaining = false);
+  void abort();
+  bool isFinished() const { return _finished; }
+  bool hasError() const { return _error != nullptr; }
+  const char *errorString() const { return _error ? _error : "No Error"; }
+  size_t progress() const { return _written; }
+
+private:
+  const esp_partition_t *_part = nullptr;
+  size_t _size = 0;
+  size_t _written = 0;
+  size_t _erased = 0;
+  bool _finished = false;
+  const char *_error = nullptr;
+};
+
+extern UpdateClass Update;
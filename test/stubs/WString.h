@@ -0,0 +1,61 @@
+// Host stand-in for the Arduino String, backed by std::string
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+class __FlashStringHelper;
+
+class String {
+public:
+  String(const char *s = "") : _s(s ? s : "") {}
+  String(const __FlashStringHelper *s) : String(reinterpret_cast<const char *>(s)) {}
+  String(const std::string &s) : _s(s) {}
+  explicit String(char c) : _s(1, c) {}
+  explicit String(int v, unsigned char base = 10) : _s(number((long)v, base)) {}
+  explicit String(unsigned v, unsigned char base = 10) : _s(number((unsigned long)v, base)) {}
+  explicit String(long v, unsigned char base = 10) : _s(number(v, base)) {}
+  explicit String(unsigned long v, unsigned char base = 10) : _s(number(v, base)) {}
+  explicit String(double v, unsigned int decimals = 2);
+
+  unsigned length() const { return (unsigned)_s.size(); }
+  const char *c_str() const { return _s.c_str(); }
+  bool isEmpty() const { return _s.empty(); }
+  bool reserve(unsigned n) { _s.reserve(n); return true; }
+  char operator[](unsigned i) const { return i < _s.size() ? _s[i] : 0; }
+  char charAt(unsigned i) const { return (*this)[i]; }
+
+  String &operator+=(const String &o) { _s += o._s; return *this; }
+  String &operator+=(const char *s) { _s += s; return *this; }
+  String &operator+=(char c) { _s += c; return *this; }
+  String &operator+=(int v) { _s += number((long)v, 10); return *this; }
+  bool concat(const char *s) { _s += s; return true; }
+
+  bool operator==(const String &o) const { return _s == o._s; }
+  bool operator==(const char *s) const { return _s == s; }
+  bool operator!=(const String &o) const { return _s != o._s; }
+  bool operator!=(const char *s) const { return _s != s; }
+  bool equals(const String &o) const { return _s == o._s; }
+  bool equalsIgnoreCase(const String &o) const;
+  bool startsWith(const String &p) const { return _s.compare(0, p._s.size(), p._s) == 0; }
+  bool endsWith(const String &p) const;
+
+  int indexOf(char c, unsigned from = 0) const;
+  int indexOf(const String &s, unsigned from = 0) const;
+  String substring(unsigned from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+  String substring(unsigned from, unsigned to) const;
+  long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(_s.c_str(), nullptr); }
+  void trim();
+  void toCharArray(char *buf, unsigned size) const;
+
+private:
+  static std::string number(long v, unsigned char base);
+  static std::string number(unsigned long v, unsigned char base);
+  std::string _s;
+};
+
+String operator+(const String &a, const String &b);
+String operator+(const String &a, const char *b);
+String operator+(const char *a, const String &b);
+String operator+(const String &a, char b);
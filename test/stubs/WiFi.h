@@ -0,0 +1,99 @@
+// Host stand-in for the Arduino-ESP32 WiFi object and client: a simulated
+// station (see host.h) and a connection to the in-process HTTP server
+// instead of a socket
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+
+struct HostConnection;
+
+// Only the events WifiFast handles; nothing posts them, a test calls the
+// handler itself
+typedef enum {
+  ARDUINO_EVENT_WIFI_SCAN_DONE = 1,
+  ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+  ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+  ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+} arduino_event_id_t;
+
+struct esp_ip4_addr_t {
+  uint32_t addr;
+};
+
+typedef union {
+  struct {
+    struct {
+      esp_ip4_addr_t ip, netmask, gw;
+    } ip_info;
+  } got_ip;
+  struct {
+    uint8_t reason;
+  } wifi_sta_disconnected;
+} arduino_event_info_t;
+
+struct arduino_event_t {
+  arduino_event_id_t event_id;
+  arduino_event_info_t event_info;
+};
+
+typedef void (*WiFiEventSysCb)(arduino_event_t *event);
+
+typedef enum { WIFI_OFF = 0, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+typedef enum { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 } wl_status_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+// Radio control does nothing: the link is up or down as
+// Host::setWifiConnected() sets it. Scans report the APs of
+// Host::setWifiAps() at once; begin() and config() are recorded in
+// Host::wifiStats().
+class WiFiClass {
+public:
+  bool disconnect(bool wifiOff = false, bool eraseAp = false);
+  bool mode(wifi_mode_t m);
+  int onEvent(WiFiEventSysCb cb);
+
+  wl_status_t begin(const char *ssid, const char *passphrase = nullptr, int32_t channel = 0,
+                    const uint8_t *bssid = nullptr, bool connect = true);
+  wl_status_t begin();
+  bool config(IPAddress localIp, IPAddress gateway, IPAddress subnet, IPAddress dns1 = (uint32_t)0,
+              IPAddress dns2 = (uint32_t)0);
+  uint8_t *BSSID();
+  int32_t channel();
+  IPAddress localIP();
+  IPAddress dnsIP(uint8_t n = 0);
+
+  int16_t scanNetworks(bool async = false, bool showHidden = false, bool passive = false, uint32_t maxMsPerChannel = 300,
+                       uint8_t channel = 0, const char *ssid = nullptr, const uint8_t *bssid = nullptr);
+  int16_t scanComplete();
+  void scanDelete();
+  String SSID(uint8_t i);
+  int32_t RSSI(uint8_t i);
+  uint8_t *BSSID(uint8_t i);
+  int32_t channel(uint8_t i);
+};
+extern WiFiClass WiFi;
+
+class WiFiClient : public Client {
+public:
+  int connect(const char *host, uint16_t port) override { return connect(host, port, 0); }
+  int connect(const char *host, uint16_t port, int32_t timeoutMs);
+  uint8_t connected() override;
+  int available() override;
+  int read() override;
+  int read(uint8_t *buf, size_t n) override;
+  int peek() override;
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t *, size_t n) override { return n; }
+  using Print::write;
+  void stop() override;
+  operator bool() { return connected(); }
+
+  // Host side of the connection (HTTPClient stand-in)
+  HostConnection *hostConnection() const { return _conn.get(); }
+
+private:
+  std::shared_ptr<HostConnection> _conn;
+};
@@ -0,0 +1,11 @@
+// Host stand-in: TLS is not simulated, the handshake is the connect()
+#pragma once
+
+#include <WiFi.h>
+
+class WiFiClientSecure : public WiFiClient {
+public:
+  void setInsecure() {}
+  void setCACert(const char *) {}
+  void setHandshakeTimeout(unsigned long) {}
+};
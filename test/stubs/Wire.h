@@ -0,0 +1,27 @@
+// Host stand-in for the Arduino I2C master: transactions go to simulated
+// devices attached with Host::attachI2c()
+#pragma once
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  bool begin() { return true; }
+  void beginTransmission(uint8_t addr);
+  size_t write(uint8_t b);
+  // 0 = ACK, 2 = address NACK (no device), like the real core
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(uint8_t addr, uint8_t count);
+  int available() { return _rxLen - _rxPos; }
+  int read() { return _rxPos < _rxLen ? _rx[_rxPos++] : -1; }
+
+private:
+  uint8_t _addr = 0;
+  uint8_t _tx[32];
+  uint8_t _txLen = 0;
+  uint8_t _rx[32];
+  uint8_t _rxLen = 0;
+  uint8_t _rxPos = 0;
+};
+
+extern TwoWire Wire;
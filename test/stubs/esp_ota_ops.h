@@ -0,0 +1,10 @@
+// Host stand-in for the ESP-IDF OTA slot selection. Image verification is
+// reduced to the app image magic byte (0xE9) at the start of the slot.
+#pragma once
+
+#include "esp_partition.h"
+
+const esp_partition_t *esp_ota_get_running_partition();
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *start);
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *part);
+const esp_partition_t *esp_ota_get_boot_partition();
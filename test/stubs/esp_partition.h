@@ -0,0 +1,35 @@
+// Host stand-in for the ESP-IDF partition API. The two OTA app slots of
+// partitions/hivesync_ota_4mb_littlefs.csv are backed by temporary files
+// that behave like NOR flash: erase sets 4 KB sectors to 0xFF, a write can
+// only clear bits. See host.h for loading and inspecting them.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+typedef enum {
+  ESP_PARTITION_TYPE_APP = 0x00,
+  ESP_PARTITION_TYPE_DATA = 0x01
+} esp_partition_type_t;
+
+typedef enum {
+  ESP_PARTITION_SUBTYPE_APP_OTA_0 = 0x10,
+  ESP_PARTITION_SUBTYPE_APP_OTA_1 = 0x11
+} esp_partition_subtype_t;
+
+struct esp_partition_t {
+  esp_partition_type_t type;
+  esp_partition_subtype_t subtype;
+  uint32_t address;
+  uint32_t size;
+  char label[17];
+  bool encrypted;
+};
+
+#define SPI_FLASH_SEC_SIZE 4096
+
+esp_err_t esp_partition_read(const esp_partition_t *part, size_t offset, void *dst, size_t size);
+esp_err_t esp_partition_write(const esp_partition_t *part, size_t offset, const void *src, size_t size);
+esp_err_t esp_partition_erase_range(const esp_partition_t *part, size_t offset, size_t size);
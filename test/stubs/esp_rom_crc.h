@@ -0,0 +1,10 @@
+// Host stand-in for the ROM CRC routines (zlib's CRC-32 is the same
+// polynomial and chaining as esp_rom_crc32_le)
+#pragma once
+
+#include <stdint.h>
+#include <zlib.h>
+
+static inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+  return (uint32_t)crc32(crc, buf, len);
+}
@@ -0,0 +1,18 @@
+// Host stand-in for the ESP-IDF Wi-Fi driver's stored station config: the
+// credentials come from Host::setWifiCredentials()
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+typedef enum { WIFI_IF_STA = 0, WIFI_IF_AP } wifi_interface_t;
+
+typedef union {
+  struct {
+    uint8_t ssid[32];
+    uint8_t password[64];
+  } sta;
+} wifi_config_t;
+
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t *conf);
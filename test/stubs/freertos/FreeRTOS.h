@@ -0,0 +1,37 @@
+// Host stand-in for FreeRTOS on std::thread. Tasks are detached threads, a
+// 1 kHz tick, and critical sections are recursive mutexes: on the host a
+// "masked interrupt" is just another thread that has to wait.
+#pragma once
+
+#include <stdint.h>
+#include <mutex>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define configTICK_RATE_HZ 1000
+
+struct portMUX_TYPE {
+  std::recursive_mutex m;
+};
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) (mux)->m.lock()
+#define portEXIT_CRITICAL(mux) (mux)->m.unlock()
+#define portENTER_CRITICAL_ISR(mux) (mux)->m.lock()
+#define portEXIT_CRITICAL_ISR(mux) (mux)->m.unlock()
+#define portENTER_CRITICAL_SAFE(mux) (mux)->m.lock()
+#define portEXIT_CRITICAL_SAFE(mux) (mux)->m.unlock()
+#define portYIELD_FROM_ISR(woken) ((void)(woken))
+
+// Every host thread runs on "core" 0
+inline BaseType_t xPortGetCoreID() {
+  return 0;
+}
@@ -0,0 +1,11 @@
+// Host stand-in for FreeRTOS mutexes
+#pragma once
+
+#include "FreeRTOS.h"
+
+struct HostSemaphore;
+typedef HostSemaphore *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s);
@@ -0,0 +1,22 @@
+// Host stand-in for FreeRTOS tasks and direct-to-task notifications
+#pragma once
+
+#include "FreeRTOS.h"
+
+struct HostTask;
+typedef HostTask *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stackDepth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *created, BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stackDepth, void *arg, UBaseType_t priority,
+                       TaskHandle_t *created);
+// The thread ends when its function returns; deleting another task is not supported
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t wait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higherPriorityTaskWoken);
@@ -0,0 +1,199 @@
+// Hooks for host tests and benches into the stand-ins: the clock, simulated
+// pins and I2C devices, the panel's bus counters and pixels, flash, NVS and
+// LittleFS, the TLS session cache, the Wi-Fi station and the in-process
+// HTTP server
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Host {
+
+// ---- Clock ----
+
+// Move millis() and micros() forward without waiting
+void advanceClock(uint32_t ms);
+// Frozen: millis() and micros() only move with advanceClock(), and delay()
+// advances them instead of sleeping
+void freezeClock(bool frozen);
+// Back to 0, as after a reset or a deep-sleep wake
+void restartClock();
+
+// ---- Sleep ----
+
+// Thrown by esp_deep_sleep_start(): the simulated boot ends there. The
+// clock restarts and the next esp_sleep_get_wakeup_cause() reports the
+// timer, if one was armed.
+struct DeepSleep {
+  uint64_t wakeAfterUs;  // 0 = no timer wake-up
+};
+
+// ---- GPIO ----
+
+// Drive an input pin; an edge runs the handler registered with
+// attachInterrupt() on the calling thread, as the ISR would
+void setPin(uint8_t pin, int level);
+// Last level written with digitalWrite() or set with setPin()
+int pinLevel(uint8_t pin);
+
+// ---- I2C ----
+
+class I2cDevice {
+public:
+  virtual ~I2cDevice() {}
+  // One write transaction (register pointer, optionally followed by data)
+  virtual void write(const uint8_t *data, size_t len) = 0;
+  // One read transaction; returns the bytes supplied
+  virtual size_t read(uint8_t *data, size_t len) = 0;
+};
+
+// Answer transactions to addr (nullptr removes the device)
+void attachI2c(uint8_t addr, I2cDevice *dev);
+
+// ---- Panel ----
+
+struct PanelStats {
+  uint32_t windows;  // setAddrWindow() calls
+  uint32_t pixels;   // pixels sent to the panel
+};
+PanelStats panelStats();
+void resetPanelStats();
+
+// Called on the drawing thread for every setAddrWindow() (nullptr: none)
+typedef std::function<void(int16_t x, int16_t y, int16_t w, int16_t h)> PanelWindowHandler;
+void setPanelWindowHandler(PanelWindowHandler handler);
+// Pixel of the panel last init()ed, in its current rotation
+uint16_t panelPixel(int16_t x, int16_t y);
+
+// ---- Flash ----
+
+// Erase both OTA slots and boot from slot 0 again
+void resetFlash();
+// Put an image into a slot (e.g. the running one, as base of a delta)
+void loadSlot(uint8_t slot, const std::string &image);
+std::string readSlot(uint8_t slot, size_t offset, size_t len);
+uint8_t runningSlot();
+// Slot chosen by esp_ota_set_boot_partition(); the running one until then
+uint8_t bootSlot();
+
+struct FlashStats {
+  uint32_t sectorErases;
+  uint32_t writes;        // esp_partition_write() calls
+  uint64_t bytesWritten;
+};
+FlashStats flashStats();
+
+// ---- NVS ----
+
+// Forget every Preferences namespace
+void clearNvs();
+
+struct NvsStats {
+  uint32_t writes;  // put*/remove/clear calls, each an NVS entry write
+};
+NvsStats nvsStats();
+void resetNvsStats();
+
+// ---- LittleFS ----
+
+// Host directory holding the partition's files (removed at exit)
+const char *fsRoot();
+// Delete every file, as a freshly formatted partition
+void resetFs();
+// Partition size; writes past it come back short, as on a full LittleFS
+void setFsCapacity(size_t bytes);
+
+struct FsStats {
+  uint32_t opens;
+  uint32_t writes;        // File::write() calls
+  uint64_t bytesWritten;
+};
+FsStats fsStats();
+void resetFsStats();
+
+// ---- TLS ----
+
+struct TlsStats {
+  uint32_t fullHandshakes;
+  uint32_t resumedHandshakes;
+};
+TlsStats tlsStats();
+void resetTlsStats();
+// Servers forget every session they issued (restart, cache expiry)
+void expireTlsSessions();
+
+// ---- Wi-Fi ----
+
+// Link state reported by Provisioning::isConnected() (down at start)
+void setWifiConnected(bool up);
+// Clock time Provisioning::connectStored() takes to bring the link up; a
+// link that is down costs the whole timeout
+void setWifiConnectMs(uint32_t ms);
+
+// Credentials esp_wifi_get_config() reports as stored ("" = none)
+void setWifiCredentials(const char *ssid, const char *pass);
+
+struct WifiAp {
+  std::string ssid;
+  uint8_t bssid[6];
+  int32_t channel;
+  int32_t rssi;
+};
+// Networks in range: the results of WiFi.scanNetworks(), and the AP a
+// WiFi.begin() without a BSSID ends up on (the strongest one)
+void setWifiAps(const std::vector<WifiAp> &aps);
+
+struct WifiStats {
+  uint32_t scans;       // WiFi.scanNetworks() calls
+  uint32_t joins;       // WiFi.begin() calls
+  int32_t joinChannel;  // of the last join, 0 = any
+  uint8_t joinBssid[6]; // of the last join, all zero = any
+  uint32_t staticIp;    // last WiFi.config() address, 0 = DHCP
+};
+WifiStats wifiStats();
+void resetWifiStats();
+
+// ---- HTTP ----
+
+typedef std::vector<std::pair<std::string, std::string>> Headers;
+
+// Case-insensitive header lookup; nullptr when absent
+const char *findHeader(const Headers &headers, const char *name);
+
+struct HttpRequest {
+  std::string method;
+  std::string url;
+  std::string host;
+  std::string path;
+  Headers headers;
+  std::string body;
+  uint32_t connection;  // id of the connection it arrived on
+};
+
+struct HttpReply {
+  int code = 200;
+  Headers headers;
+  std::string body;
+  size_t dropAfter = std::string::npos;  // body bytes delivered before the connection dies
+  size_t segment = 0;                    // max bytes available() reports at once, 0 = all
+  bool close = false;                    // "Connection: close"
+};
+
+typedef std::function<HttpReply(const HttpRequest &)> HttpHandler;
+
+// Serve every request through handler (nullptr: refuse connections)
+void setHttpHandler(HttpHandler handler);
+
+struct HttpStats {
+  uint32_t connects;   // new connections (TCP + TLS handshakes)
+  uint32_t requests;
+  uint64_t bodyBytes;  // response body bytes read by the client
+};
+HttpStats httpStats();
+void resetHttpStats();
+
+} // namespace Host
@@ -0,0 +1,286 @@
+// Host stand-in for the Arduino core: clock, pins, Serial, Print and String
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <strings.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "host.h"
+
+static int64_t steadyUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static std::atomic<int64_t> s_bootUs(steadyUs());
+static std::atomic<int64_t> s_frozenUs(-1);  // real time at freezeClock(), -1 = running
+static std::atomic<uint64_t> s_skippedUs(0);
+
+static uint64_t nowUs() {
+  int64_t frozen = s_frozenUs;
+  return (uint64_t)((frozen >= 0 ? frozen : steadyUs()) - s_bootUs) + s_skippedUs;
+}
+
+namespace Host {
+
+void advanceClock(uint32_t ms) {
+  s_skippedUs += (uint64_t)ms * 1000;
+}
+
+void freezeClock(bool frozen) {
+  s_frozenUs = frozen ? steadyUs() : -1;
+}
+
+void restartClock() {
+  int64_t frozen = s_frozenUs;
+  s_bootUs = frozen >= 0 ? frozen : steadyUs();
+  s_skippedUs = 0;
+}
+
+} // namespace Host
+
+uint32_t millis() {
+  return (uint32_t)(nowUs() / 1000);
+}
+
+uint32_t micros() {
+  return (uint32_t)nowUs();
+}
+
+void delay(uint32_t ms) {
+  if (s_frozenUs >= 0) s_skippedUs += (uint64_t)ms * 1000;
+  else std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+  if (s_frozenUs >= 0) s_skippedUs += us;
+  else std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+extern "C" size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+#endif
+
+// Fixed seed: runs are reproducible
+static uint32_t s_random = 0x2545F491;
+
+uint32_t esp_random() {
+  s_random ^= s_random << 13;
+  s_random ^= s_random >> 17;
+  s_random ^= s_random << 5;
+  return s_random;
+}
+
+void configTime(long, int, const char *, const char *, const char *) {}
+
+EspClass ESP;
+
+// ---- Pins ----
+
+static const uint8_t PIN_COUNT = 64;
+static uint8_t s_levels[PIN_COUNT];
+static void (*s_isr[PIN_COUNT])();
+static int s_isrMode[PIN_COUNT];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < PIN_COUNT && mode == INPUT_PULLUP) s_levels[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin < PIN_COUNT) s_levels[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < PIN_COUNT ? s_levels[pin] : LOW;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+  if (pin >= PIN_COUNT) return;
+  s_isr[pin] = isr;
+  s_isrMode[pin] = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (pin < PIN_COUNT) s_isr[pin] = nullptr;
+}
+
+namespace Host {
+
+void setPin(uint8_t pin, int level) {
+  if (pin >= PIN_COUNT) return;
+  uint8_t old = s_levels[pin];
+  s_levels[pin] = level ? HIGH : LOW;
+  if (!s_isr[pin] || old == s_levels[pin]) return;
+  bool rising = s_levels[pin] == HIGH;
+  int mode = s_isrMode[pin];
+  if (mode == CHANGE || (mode == RISING && rising) || (mode == FALLING && !rising)) s_isr[pin]();
+}
+
+int pinLevel(uint8_t pin) {
+  return digitalRead(pin);
+}
+
+} // namespace Host
+
+// ---- Serial ----
+
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(uint8_t c) {
+  return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t n) {
+  return fwrite(buf, 1, n, stdout);
+}
+
+// ---- Print / Stream ----
+
+size_t Print::write(const uint8_t *buf, size_t n) {
+  size_t done = 0;
+  while (done < n && write(buf[done])) done++;
+  return done;
+}
+
+size_t Print::write(const char *s) {
+  return s ? write((const uint8_t *)s, strlen(s)) : 0;
+}
+
+size_t Print::printf(const char *fmt, ...) {
+  char small[128];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(small, sizeof(small), fmt, ap);
+  va_end(ap);
+  if (n < 0) return 0;
+  if ((size_t)n < sizeof(small)) return write((const uint8_t *)small, n);
+  std::string big(n + 1, '\0');
+  va_start(ap, fmt);
+  vsnprintf(&big[0], big.size(), fmt, ap);
+  va_end(ap);
+  return write((const uint8_t *)big.data(), n);
+}
+
+size_t Print::print(long v, int base) {
+  return print(String(v, (unsigned char)base));
+}
+
+size_t Print::print(unsigned long v, int base) {
+  return print(String(v, (unsigned char)base));
+}
+
+size_t Print::print(double v, int digits) {
+  return print(String(v, digits));
+}
+
+size_t Stream::readBytes(uint8_t *buf, size_t n) {
+  size_t got = 0;
+  uint32_t start = millis();
+  while (got < n && millis() - start < _timeout) {
+    int c = read();
+    if (c < 0) {
+      delay(1);
+      continue;
+    }
+    buf[got++] = (uint8_t)c;
+  }
+  return got;
+}
+
+// ---- String ----
+
+String::String(double v, unsigned int decimals) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+  _s = buf;
+}
+
+std::string String::number(long v, unsigned char base) {
+  if (v < 0 && base == 10) return "-" + number((unsigned long)-v, base);
+  return number((unsigned long)v, base);
+}
+
+std::string String::number(unsigned long v, unsigned char base) {
+  if (base < 2 || base > 36) base = 10;
+  std::string out;
+  do {
+    uint8_t d = v % base;
+    out += (char)(d < 10 ? '0' + d : 'a' + d - 10);
+    v /= base;
+  } while (v);
+  std::reverse(out.begin(), out.end());
+  return out;
+}
+
+bool String::equalsIgnoreCase(const String &o) const {
+  return strcasecmp(_s.c_str(), o._s.c_str()) == 0;
+}
+
+bool String::endsWith(const String &p) const {
+  return _s.size() >= p._s.size() && _s.compare(_s.size() - p._s.size(), p._s.size(), p._s) == 0;
+}
+
+int String::indexOf(char c, unsigned from) const {
+  size_t at = _s.find(c, from);
+  return at == std::string::npos ? -1 : (int)at;
+}
+
+int String::indexOf(const String &s, unsigned from) const {
+  size_t at = _s.find(s._s, from);
+  return at == std::string::npos ? -1 : (int)at;
+}
+
+String String::substring(unsigned from, unsigned to) const {
+  if (from > to) std::swap(from, to);
+  if (from >= _s.size()) return String();
+  return String(_s.substr(from, to - from));
+}
+
+void String::trim() {
+  size_t a = _s.find_first_not_of(" \t\r\n");
+  if (a == std::string::npos) {
+    _s.clear();
+    return;
+  }
+  size_t b = _s.find_last_not_of(" \t\r\n");
+  _s = _s.substr(a, b - a + 1);
+}
+
+void String::toCharArray(char *buf, unsigned size) const {
+  if (size) strlcpy(buf, _s.c_str(), size);
+}
+
+String operator+(const String &a, const String &b) {
+  String r(a);
+  r += b;
+  return r;
+}
+
+String operator+(const String &a, const char *b) {
+  String r(a);
+  r += b;
+  return r;
+}
+
+String operator+(const char *a, const String &b) {
+  String r(a);
+  r += b;
+  return r;
+}
+
+String operator+(const String &a, char b) {
+  String r(a);
+  r += b;
+  return r;
+}
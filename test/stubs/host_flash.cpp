@@ -0,0 +1,210 @@
+// Host stand-in for the OTA app slots, esp_ota_* and Update
+
+#include <Update.h>
+#include <esp_ota_ops.h>
+#include <mutex>
+
+#include "host.h"
+
+static const uint32_t SECTOR = SPI_FLASH_SEC_SIZE;
+
+// app0/app1 of partitions/hivesync_ota_4mb_littlefs.csv
+static const esp_partition_t s_slots[2] = {
+  {ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, 0x10000, 0x180000, "app0", false},
+  {ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_1, 0x190000, 0x180000, "app1", false},
+};
+
+static std::recursive_mutex s_mutex;
+static FILE *s_files[2] = {nullptr, nullptr};
+static uint8_t s_running = 0;
+static uint8_t s_boot = 0;
+static Host::FlashStats s_stats = {0, 0, 0};
+
+static int slotOf(const esp_partition_t *part) {
+  if (part == &s_slots[0]) return 0;
+  if (part == &s_slots[1]) return 1;
+  return -1;
+}
+
+static void fill(FILE *f, size_t offset, size_t len, uint8_t value) {
+  uint8_t buf[SECTOR];
+  memset(buf, value, sizeof(buf));
+  fseek(f, (long)offset, SEEK_SET);
+  while (len) {
+    size_t n = len < sizeof(buf) ? len : sizeof(buf);
+    fwrite(buf, 1, n, f);
+    len -= n;
+  }
+}
+
+// Slot files are created erased on first use
+static FILE *slotFile(int slot) {
+  if (!s_files[slot]) {
+    s_files[slot] = tmpfile();
+    fill(s_files[slot], 0, s_slots[slot].size, 0xFF);
+  }
+  return s_files[slot];
+}
+
+namespace Host {
+
+void resetFlash() {
+  std::lock_guard<std::recursive_mutex> lock(s_mutex);
+  for (int i = 0; i < 2; ++i) fill(slotFile(i), 0, s_slots[i].size, 0xFF);
+  s_running = s_boot = 0;
+  s_stats = FlashStats{0, 0, 0};
+}
+
+void loadSlot(uint8_t slot, const std::string &image) {
+  std::lock_guard<std::recursive_mutex> lock(s_mutex);
+  FILE *f = slotFile(slot);
+  fill(f, 0, s_slots[slot].size, 0xFF);
+  fseek(f, 0, SEEK_SET);
+  fwrite(image.data(), 1, image.size(), f);
+}
+
+std::string readSlot(uint8_t slot, size_t offset, size_t len) {
+  std::lock_guard<std::recursive_mutex> lock(s_mutex);
+  std::string out(len, '\0');
+  FILE *f = slotFile(slot);
+  fseek(f, (long)offset, SEEK_SET);
+  out.resize(fread(&out[0], 1, len, f));
+  return out;
+}
+
+uint8_t runningSlot() {
+  return s_running;
+}
+
+uint8_t bootSlot() {
+  return s_boot;
+}
+
+FlashStats flashStats() {
+  std::lock_guard<std::recursive_mutex> lock(s_mutex);
+  return s_stats;
+}
+
+} // namespace Host
+
+// ---- esp_partition ----
+
+esp_err_t esp_partition_read(const esp_partition_t *part, size_t offset, void *dst, size_t size) {
+  int slot = slotOf(part);
+  if (slot < 0 || offset + size > part->size) return ESP_ERR_INVALID_ARG;
+  std::lock_guard<std::recursive_mutex> lock(s_mutex);
+  FILE *f = slotFile(slot);
+  fseek(f, (long)offset, SEEK_SET);
+  return fread(dst, 1, size, f) == size ? ESP_OK : ESP_FAIL;
+}
+
+// NOR flash: programming can only turn 1 bits into 0
+esp_err_t esp_partition_write(const esp_partition_t *part, size_t offset, const void *src, size_t size) {
+  int slot = slotOf(part);
+  if (slot < 0 || offset + size > part->size) return ESP_ERR_INVALID_ARG;
+  std::lock_guard<std::recursive_mutex> lock(s_mutex);
+  std::string cur(size, '\0');
+  FILE *f = slotFile(slot);
+  fseek(f, (long)offset, SEEK_SET);
+  if (fread(&cur[0], 1, size, f) != size) return ESP_FAIL;
+  const uint8_t *in = (const uint8_t *)src;
+  for (size_t i = 0; i < size; ++i) cur[i] = (char)(cur[i] & in[i]);
+  fseek(f, (long)offset, SEEK_SET);
+  fwrite(cur.data(), 1, size, f);
+  s_stats.writes++;
+  s_stats.bytesWritten += size;
+  return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *part, size_t offset, size_t size) {
+  int slot = slotOf(part);
+  if (slot < 0 || offset % SECTOR || size % SECTOR || offset + size > part->size) return ESP_ERR_INVALID_ARG;
+  std::lock_guard<std::recursive_mutex> lock(s_mutex);
+  fill(slotFile(slot), offset, size, 0xFF);
+  s_stats.sectorErases += size / SECTOR;
+  return ESP_OK;
+}
+
+// ---- esp_ota ----
+
+const esp_partition_t *esp_ota_get_running_partition() {
+  return &s_slots[s_running];
+}
+
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *) {
+  return &s_slots[s_running ^ 1];
+}
+
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *part) {
+  int slot = slotOf(part);
+  if (slot < 0) return ESP_ERR_INVALID_ARG;
+  uint8_t magic = 0;
+  if (esp_partition_read(part, 0, &magic, 1) != ESP_OK || magic != 0xE9) return ESP_ERR_OTA_VALIDATE_FAILED;
+  s_boot = (uint8_t)slot;
+  return ESP_OK;
+}
+
+const esp_partition_t *esp_ota_get_boot_partition() {
+  return &s_slots[s_boot];
+}
+
+// ---- Update ----
+
+UpdateClass Update;
+
+bool UpdateClass::begin(size_t size) {
+  _part = esp_ota_get_next_update_partition(nullptr);
+  _size = size;
+  _written = _erased = 0;
+  _finished = false;
+  _error = nullptr;
+  if (size != UPDATE_SIZE_UNKNOWN && size > _part->size) {
+    _error = "Not Enough Space";
+    return false;
+  }
+  return true;
+}
+
+size_t UpdateClass::write(uint8_t *data, size_t len) {
+  if (_error || !_part) return 0;
+  if (_written == 0 && len && data[0] != 0xE9) {
+    _error = "Wrong Magic Byte";
+    return 0;
+  }
+  if (_written + len > _part->size || (_size != UPDATE_SIZE_UNKNOWN && _written + len > _size)) {
+    _error = "Not Enough Space";
+    return 0;
+  }
+  while (_erased < _written + len) {
+    if (esp_partition_erase_range(_part, _erased, SECTOR) != ESP_OK) {
+      _error = "Flash Erase Failed";
+      return 0;
+    }
+    _erased += SECTOR;
+  }
+  if (esp_partition_write(_part, _written, data, len) != ESP_OK) {
+    _error = "Flash Write Failed";
+    return 0;
+  }
+  _written += len;
+  return len;
+}
+
+bool UpdateClass::end(bool evenIfRemaining) {
+  if (_error || !_part) return false;
+  if (_written == 0 || (!evenIfRemaining && _size != UPDATE_SIZE_UNKNOWN && _written != _size)) {
+    _error = "Premature End";
+    return false;
+  }
+  if (esp_ota_set_boot_partition(_part) != ESP_OK) {
+    _error = "Could Not Activate The Firmware";
+    return false;
+  }
+  _finished = true;
+  return true;
+}
+
+void UpdateClass::abort() {
+  if (!_error) _error = "Aborted";
+  _part = nullptr;
+}
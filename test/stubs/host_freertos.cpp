@@ -0,0 +1,142 @@
+// Host stand-in for FreeRTOS tasks, notifications, queues and mutexes
+
+#include <Arduino.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+struct HostTask {
+  std::mutex m;
+  std::condition_variable cv;
+  uint32_t notified = 0;
+};
+
+struct HostQueue {
+  std::mutex m;
+  std::condition_variable cv;
+  std::deque<std::vector<uint8_t>> items;
+  size_t length;
+  size_t itemSize;
+};
+
+struct HostSemaphore {
+  std::recursive_timed_mutex m;
+};
+
+// Task objects are never freed: a late notification to a finished task
+// must not touch released memory
+static thread_local HostTask *t_self = nullptr;
+
+// Wait on cv until pred holds or wait ticks pass (portMAX_DELAY: forever)
+template <typename Pred>
+static bool waitFor(std::condition_variable &cv, std::unique_lock<std::mutex> &lock, TickType_t wait, Pred pred) {
+  if (wait == portMAX_DELAY) {
+    cv.wait(lock, pred);
+    return true;
+  }
+  return cv.wait_for(lock, std::chrono::milliseconds(wait), pred);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *, uint32_t, void *arg, UBaseType_t,
+                                   TaskHandle_t *created, BaseType_t) {
+  HostTask *task = new HostTask();
+  if (created) *created = task;
+  std::thread([fn, arg, task]() {
+    t_self = task;
+    fn(arg);
+  }).detach();
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stackDepth, void *arg, UBaseType_t priority,
+                       TaskHandle_t *created) {
+  return xTaskCreatePinnedToCore(fn, name, stackDepth, arg, priority, created, 0);
+}
+
+void vTaskDelete(TaskHandle_t) {}
+
+void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks ? ticks : 1));
+}
+
+TickType_t xTaskGetTickCount() {
+  return millis();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  if (!t_self) t_self = new HostTask();
+  return t_self;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t wait) {
+  HostTask *self = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lock(self->m);
+  waitFor(self->cv, lock, wait, [self] { return self->notified > 0; });
+  uint32_t value = self->notified;
+  if (value) self->notified = clearOnExit ? 0 : value - 1;
+  return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  if (!task) return pdFAIL;
+  {
+    std::lock_guard<std::mutex> lock(task->m);
+    task->notified++;
+  }
+  task->cv.notify_all();
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken) {
+  xTaskNotifyGive(task);
+  if (woken) *woken = pdTRUE;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  HostQueue *q = new HostQueue();
+  q->length = length;
+  q->itemSize = itemSize;
+  return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait) {
+  std::unique_lock<std::mutex> lock(q->m);
+  if (!waitFor(q->cv, lock, wait, [q] { return q->items.size() < q->length; })) return pdFAIL;
+  const uint8_t *p = (const uint8_t *)item;
+  q->items.emplace_back(p, p + q->itemSize);
+  q->cv.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait) {
+  std::unique_lock<std::mutex> lock(q->m);
+  if (!waitFor(q->cv, lock, wait, [q] { return !q->items.empty(); })) return pdFAIL;
+  memcpy(item, q->items.front().data(), q->itemSize);
+  q->items.pop_front();
+  q->cv.notify_all();
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+  std::lock_guard<std::mutex> lock(q->m);
+  return (UBaseType_t)q->items.size();
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return new HostSemaphore();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t wait) {
+  if (wait == portMAX_DELAY) {
+    s->m.lock();
+    return pdTRUE;
+  }
+  return s->m.try_lock_for(std::chrono::milliseconds(wait)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  s->m.unlock();
+  return pdTRUE;
+}
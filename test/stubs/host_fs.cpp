@@ -0,0 +1,271 @@
+// Host stand-in for LittleFS: one host directory per process
+
+#include <FS.h>
+#include <LittleFS.h>
+#include <dirent.h>
+#include <errno.h>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "host.h"
+
+fs::LittleFSFS LittleFS;
+
+struct HostFile {
+  std::string path;  // as seen by the firmware, e.g. "/ts/00000001.seg"
+  FILE *fp = nullptr;
+  bool dir = false;
+  std::vector<std::string> entries;  // directory listing
+  size_t next = 0;
+
+  ~HostFile() {
+    if (fp) fclose(fp);
+  }
+};
+
+static std::mutex s_mutex;
+static std::string s_root;
+static size_t s_capacity = 0x0F0000;
+static Host::FsStats s_stats = {0, 0, 0};
+
+static void removeTree(const std::string &dir, bool self) {
+  DIR *d = opendir(dir.c_str());
+  if (d) {
+    while (struct dirent *e = readdir(d)) {
+      std::string name = e->d_name;
+      if (name == "." || name == "..") continue;
+      std::string p = dir + "/" + name;
+      struct stat st;
+      if (stat(p.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) removeTree(p, true);
+      else ::remove(p.c_str());
+    }
+    closedir(d);
+  }
+  if (self) ::rmdir(dir.c_str());
+}
+
+static void removeRoot() {
+  if (!s_root.empty()) removeTree(s_root, true);
+}
+
+static const std::string &root() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if (s_root.empty()) {
+    char tmpl[] = "/tmp/hivesync-fs-XXXXXX";
+    if (mkdtemp(tmpl)) s_root = tmpl;
+    atexit(removeRoot);
+  }
+  return s_root;
+}
+
+static std::string hostPath(const char *path) {
+  std::string p = path ? path : "";
+  if (p.empty() || p[0] != '/') p = "/" + p;
+  return root() + p;
+}
+
+static uint64_t treeBytes(const std::string &dir) {
+  uint64_t total = 0;
+  DIR *d = opendir(dir.c_str());
+  if (!d) return 0;
+  while (struct dirent *e = readdir(d)) {
+    std::string name = e->d_name;
+    if (name == "." || name == "..") continue;
+    std::string p = dir + "/" + name;
+    struct stat st;
+    if (stat(p.c_str(), &st) != 0) continue;
+    total += S_ISDIR(st.st_mode) ? treeBytes(p) : (uint64_t)st.st_size;
+  }
+  closedir(d);
+  return total;
+}
+
+namespace Host {
+
+const char *fsRoot() {
+  return root().c_str();
+}
+
+void resetFs() {
+  removeTree(root(), false);
+}
+
+void setFsCapacity(size_t bytes) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_capacity = bytes;
+}
+
+FsStats fsStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return s_stats;
+}
+
+void resetFsStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_stats = FsStats{0, 0, 0};
+}
+
+} // namespace Host
+
+// ---- File ----
+
+namespace fs {
+
+size_t File::write(const uint8_t *buf, size_t n) {
+  if (!_f || !_f->fp) return 0;
+  uint64_t used = treeBytes(root());
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if (used + n > s_capacity) n = used < s_capacity ? (size_t)(s_capacity - used) : 0;
+  size_t w = n ? fwrite(buf, 1, n, _f->fp) : 0;
+  fflush(_f->fp);
+  s_stats.writes++;
+  s_stats.bytesWritten += w;
+  return w;
+}
+
+int File::available() {
+  if (!_f || !_f->fp) return 0;
+  return (int)(size() - position());
+}
+
+int File::read() {
+  uint8_t b;
+  return read(&b, 1) == 1 ? b : -1;
+}
+
+size_t File::read(uint8_t *buf, size_t n) {
+  if (!_f || !_f->fp) return 0;
+  return fread(buf, 1, n, _f->fp);
+}
+
+int File::peek() {
+  if (!_f || !_f->fp) return -1;
+  int c = fgetc(_f->fp);
+  if (c != EOF) ungetc(c, _f->fp);
+  return c == EOF ? -1 : c;
+}
+
+void File::flush() {
+  if (_f && _f->fp) fflush(_f->fp);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!_f || !_f->fp) return false;
+  int whence = mode == SeekCur ? SEEK_CUR : mode == SeekEnd ? SEEK_END : SEEK_SET;
+  return fseek(_f->fp, (long)pos, whence) == 0;
+}
+
+size_t File::position() const {
+  if (!_f || !_f->fp) return 0;
+  long p = ftell(_f->fp);
+  return p < 0 ? 0 : (size_t)p;
+}
+
+size_t File::size() const {
+  if (!_f || !_f->fp) return 0;
+  fflush(_f->fp);
+  struct stat st;
+  return fstat(fileno(_f->fp), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close() {
+  _f.reset();
+}
+
+File::operator bool() const {
+  return _f && (_f->fp || _f->dir);
+}
+
+const char *File::path() const {
+  return _f ? _f->path.c_str() : "";
+}
+
+const char *File::name() const {
+  if (!_f) return "";
+  const char *slash = strrchr(_f->path.c_str(), '/');
+  return slash ? slash + 1 : _f->path.c_str();
+}
+
+bool File::isDirectory() const {
+  return _f && _f->dir;
+}
+
+File File::openNextFile(const char *mode) {
+  if (!_f || !_f->dir || _f->next >= _f->entries.size()) return File();
+  std::string p = _f->path;
+  if (p.empty() || p.back() != '/') p += '/';
+  return LittleFS.open((p + _f->entries[_f->next++]).c_str(), mode);
+}
+
+// ---- FS ----
+
+File FS::open(const char *path, const char *mode, bool) {
+  std::string hp = hostPath(path);
+  auto f = std::make_shared<HostFile>();
+  f->path = path;
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_stats.opens++;
+  }
+  struct stat st;
+  if (stat(hp.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+    if (strcmp(mode, FILE_READ) != 0) return File();
+    f->dir = true;
+    if (DIR *d = opendir(hp.c_str())) {
+      while (struct dirent *e = readdir(d)) {
+        if (strcmp(e->d_name, ".") && strcmp(e->d_name, "..")) f->entries.push_back(e->d_name);
+      }
+      closedir(d);
+    }
+    return File(f);
+  }
+  const char *m = strcmp(mode, FILE_WRITE) == 0 ? "wb" : strcmp(mode, FILE_APPEND) == 0 ? "ab" : "rb";
+  f->fp = fopen(hp.c_str(), m);
+  return f->fp ? File(f) : File();
+}
+
+bool FS::exists(const char *path) {
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char *path) {
+  return ::remove(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char *from, const char *to) {
+  return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool FS::mkdir(const char *path) {
+  return ::mkdir(hostPath(path).c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+bool FS::rmdir(const char *path) {
+  return ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+// ---- LittleFSFS ----
+
+bool LittleFSFS::begin(bool, const char *, uint8_t, const char *) {
+  return !root().empty();
+}
+
+bool LittleFSFS::format() {
+  Host::resetFs();
+  return true;
+}
+
+size_t LittleFSFS::totalBytes() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return s_capacity;
+}
+
+size_t LittleFSFS::usedBytes() {
+  return (size_t)treeBytes(root());
+}
+
+} // namespace fs
@@ -0,0 +1,159 @@
+// Host stand-in for Adafruit GFX, the RGB565 canvas and the ST7789 panel
+
+#include <Adafruit_GFX.h>
+#include <Adafruit_ST7789.h>
+
+#include "host.h"
+
+static Host::PanelStats s_panel = {0, 0};
+static Host::PanelWindowHandler s_windowHandler;
+static const Adafruit_ST7789 *s_lastPanel = nullptr;
+
+namespace Host {
+
+PanelStats panelStats() {
+  return s_panel;
+}
+
+void resetPanelStats() {
+  s_panel = PanelStats{0, 0};
+}
+
+void setPanelWindowHandler(PanelWindowHandler handler) {
+  s_windowHandler = handler;
+}
+
+uint16_t panelPixel(int16_t x, int16_t y) {
+  return s_lastPanel ? s_lastPanel->pixel(x, y) : 0;
+}
+
+} // namespace Host
+
+// ---- Adafruit_GFX ----
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  for (int16_t row = y; row < y + h; ++row) {
+    for (int16_t col = x; col < x + w; ++col) drawPixel(col, row, color);
+  }
+}
+
+void Adafruit_GFX::setRotation(uint8_t r) {
+  _rotation = r & 3;
+  bool swap = _rotation & 1;
+  _width = swap ? HEIGHT : WIDTH;
+  _height = swap ? WIDTH : HEIGHT;
+}
+
+// Built-in font: 6x8 cells of 5x7 glyphs. Proportional fonts: a 9x13 box
+// advancing 10 px. The "glyph" is a fixed pattern derived from the code.
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (c == '\n') {
+    _cursorX = 0;
+    _cursorY += _font ? _font->yAdvance : 8 * _textSize;
+    return 1;
+  }
+  if (c == '\r') return 1;
+  const int16_t gw = _font ? 9 : 5, gh = _font ? 13 : 7, adv = _font ? 10 : 6 * _textSize;
+  const int16_t top = _font ? _cursorY - gh : _cursorY;
+  const uint8_t s = _font ? 1 : _textSize;
+  if (_wrap && _cursorX + adv > _width) {
+    _cursorX = 0;
+    _cursorY += _font ? _font->yAdvance : 8 * _textSize;
+  }
+  for (int16_t gy = 0; gy < gh; ++gy) {
+    for (int16_t gx = 0; gx < gw; ++gx) {
+      bool on = (c >> ((gx + gy) & 7)) & 1;
+      if (!on && _textBg == _textColor) continue;
+      uint16_t color = on ? _textColor : _textBg;
+      if (s == 1) drawPixel(_cursorX + gx, top + gy, color);
+      else fillRect(_cursorX + gx * s, top + gy * s, s, s, color);
+    }
+  }
+  _cursorX += adv;
+  return 1;
+}
+
+// ---- GFXcanvas16 ----
+
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+  _buffer = (uint16_t *)calloc((size_t)w * h, sizeof(uint16_t));
+}
+
+GFXcanvas16::~GFXcanvas16() {
+  free(_buffer);
+}
+
+void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+  _buffer[y * _width + x] = color;
+}
+
+void GFXcanvas16::fillScreen(uint16_t color) {
+  for (int32_t i = 0; i < (int32_t)WIDTH * HEIGHT; ++i) _buffer[i] = color;
+}
+
+// ---- Adafruit_ST7789 ----
+
+Adafruit_ST7789::Adafruit_ST7789(int8_t, int8_t, int8_t) : Adafruit_GFX(240, 320) {}
+
+Adafruit_ST7789::~Adafruit_ST7789() {
+  if (s_lastPanel == this) s_lastPanel = nullptr;
+  free(_fb);
+}
+
+void Adafruit_ST7789::init(uint16_t width, uint16_t height, uint8_t) {
+  WIDTH = width;
+  HEIGHT = height;
+  free(_fb);
+  _fb = (uint16_t *)calloc((size_t)width * height, sizeof(uint16_t));
+  setRotation(0);
+  s_lastPanel = this;
+}
+
+void Adafruit_ST7789::setRotation(uint8_t r) {
+  Adafruit_GFX::setRotation(r);
+}
+
+void Adafruit_ST7789::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+  _winX = x;
+  _winY = y;
+  _winW = w;
+  _winH = h;
+  _winPos = 0;
+  s_panel.windows++;
+  if (s_windowHandler) s_windowHandler(x, y, w, h);
+}
+
+void Adafruit_ST7789::push(uint16_t color) {
+  if (_winW <= 0 || _winH <= 0) return;
+  int16_t x = _winX + _winPos % _winW;
+  int16_t y = _winY + (_winPos / _winW) % _winH;
+  _winPos++;
+  s_panel.pixels++;
+  if (_fb && x >= 0 && y >= 0 && x < _width && y < _height) _fb[y * _width + x] = color;
+}
+
+void Adafruit_ST7789::writePixels(uint16_t *colors, uint32_t len, bool, bool) {
+  for (uint32_t i = 0; i < len; ++i) push(colors[i]);
+}
+
+void Adafruit_ST7789::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+  setAddrWindow(x, y, 1, 1);
+  push(color);
+}
+
+void Adafruit_ST7789::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > _width) w = _width - x;
+  if (y + h > _height) h = _height - y;
+  if (w <= 0 || h <= 0) return;
+  setAddrWindow(x, y, w, h);
+  for (int32_t i = 0; i < (int32_t)w * h; ++i) push(color);
+}
+
+uint16_t Adafruit_ST7789::pixel(int16_t x, int16_t y) const {
+  if (!_fb || x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+  return _fb[y * _width + x];
+}
@@ -0,0 +1,256 @@
+// Host stand-in for WiFiClient / HTTPClient and the in-process HTTP server
+
+#include <HTTPClient.h>
+#include <strings.h>
+
+#include "host.h"
+
+struct HostConnection {
+  uint32_t id;
+  bool open;
+  std::string host;
+  uint16_t port;
+  std::string rx;       // response body still to be read
+  size_t rxPos;
+  size_t dropAt;        // rx offset at which the server goes away
+  size_t segment;
+  bool closeAfter;      // server closes once the body is read
+};
+
+static std::mutex s_mutex;
+static Host::HttpHandler s_handler;
+static Host::HttpStats s_stats = {0, 0, 0};
+static uint32_t s_nextId = 1;
+
+namespace Host {
+
+const char *findHeader(const Headers &headers, const char *name) {
+  for (const auto &h : headers) {
+    if (strcasecmp(h.first.c_str(), name) == 0) return h.second.c_str();
+  }
+  return nullptr;
+}
+
+void setHttpHandler(HttpHandler handler) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_handler = handler;
+}
+
+HttpStats httpStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return s_stats;
+}
+
+void resetHttpStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_stats = HttpStats{0, 0, 0};
+}
+
+} // namespace Host
+
+// ---- WiFiClient ----
+
+int WiFiClient::connect(const char *host, uint16_t port, int32_t) {
+  stop();
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if (!s_handler) return 0;
+  _conn = std::make_shared<HostConnection>();
+  _conn->id = s_nextId++;
+  _conn->open = true;
+  _conn->host = host;
+  _conn->port = port;
+  _conn->rxPos = 0;
+  _conn->dropAt = std::string::npos;
+  _conn->segment = 0;
+  _conn->closeAfter = false;
+  s_stats.connects++;
+  return 1;
+}
+
+// Past the drop point the connection is gone, like a reset socket
+static bool alive(HostConnection *c) {
+  if (!c || !c->open) return false;
+  if (c->rxPos >= c->dropAt) {
+    c->open = false;
+    return false;
+  }
+  return true;
+}
+
+uint8_t WiFiClient::connected() {
+  HostConnection *c = _conn.get();
+  if (!alive(c)) return 0;
+  if (c->closeAfter && c->rxPos >= c->rx.size()) c->open = false;
+  return c->open || c->rxPos < c->rx.size();
+}
+
+int WiFiClient::available() {
+  HostConnection *c = _conn.get();
+  if (!alive(c)) return 0;
+  size_t end = c->dropAt < c->rx.size() ? c->dropAt : c->rx.size();
+  size_t n = end - c->rxPos;
+  if (c->segment && n > c->segment) n = c->segment;
+  return (int)n;
+}
+
+int WiFiClient::read(uint8_t *buf, size_t n) {
+  int avail = WiFiClient::available();
+  if (avail <= 0) return -1;
+  if (n > (size_t)avail) n = avail;
+  HostConnection *c = _conn.get();
+  memcpy(buf, c->rx.data() + c->rxPos, n);
+  c->rxPos += n;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_stats.bodyBytes += n;
+  return (int)n;
+}
+
+int WiFiClient::read() {
+  uint8_t b;
+  return WiFiClient::read(&b, 1) == 1 ? b : -1;
+}
+
+int WiFiClient::peek() {
+  return WiFiClient::available() > 0 ? (uint8_t)_conn->rx[_conn->rxPos] : -1;
+}
+
+void WiFiClient::stop() {
+  if (_conn) _conn->open = false;
+  _conn.reset();
+}
+
+// ---- HTTPClient ----
+
+bool HTTPClient::begin(WiFiClient &client, const String &url) {
+  _client = &client;
+  _url = url.c_str();
+  _reqHeaders.clear();
+  _respHeaders.clear();
+  _size = -1;
+  _location = String();
+  size_t scheme = _url.find("://");
+  if (scheme == std::string::npos) return false;
+  size_t hostStart = scheme + 3;
+  size_t hostEnd = _url.find_first_of(":/?#", hostStart);
+  _host = _url.substr(hostStart, hostEnd == std::string::npos ? std::string::npos : hostEnd - hostStart);
+  _port = _url.compare(0, scheme, "https") == 0 ? 443 : 80;
+  if (hostEnd != std::string::npos && _url[hostEnd] == ':') _port = (uint16_t)atoi(_url.c_str() + hostEnd + 1);
+  return !_host.empty();
+}
+
+void HTTPClient::end() {
+  if (_client && !(_reuse && _canReuse)) _client->stop();
+  _reqHeaders.clear();
+}
+
+void HTTPClient::addHeader(const String &name, const String &value, bool, bool) {
+  _reqHeaders.emplace_back(name.c_str(), value.c_str());
+}
+
+void HTTPClient::collectHeaders(const char *keys[], const size_t count) {
+  _collect.assign(keys, keys + count);
+}
+
+int HTTPClient::sendRequest(const char *method, uint8_t *payload, size_t size) {
+  if (!_client) return HTTPC_ERROR_NOT_CONNECTED;
+  if (!_client->connected() && !_client->connect(_host.c_str(), _port)) return HTTPC_ERROR_CONNECTION_REFUSED;
+  HostConnection *c = _client->hostConnection();
+  // Unread bytes of the previous response are thrown away, as HTTPClient does
+  c->rx.clear();
+  c->rxPos = 0;
+  c->dropAt = std::string::npos;
+
+  Host::HttpRequest req;
+  req.method = method;
+  req.url = _url;
+  req.host = _host;
+  size_t pathStart = _url.find('/', _url.find("://") + 3);
+  req.path = pathStart == std::string::npos ? "/" : _url.substr(pathStart);
+  req.headers = _reqHeaders;
+  if (payload && size) req.body.assign((const char *)payload, size);
+  req.connection = c->id;
+
+  Host::HttpHandler handler;
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    handler = s_handler;
+    s_stats.requests++;
+  }
+  if (!handler) {
+    _client->stop();
+    return HTTPC_ERROR_CONNECTION_LOST;
+  }
+  Host::HttpReply reply = handler(req);
+  if (reply.code < 0) {
+    _client->stop();
+    return reply.code;
+  }
+
+  _respHeaders.clear();
+  for (const auto &h : reply.headers) {
+    for (const auto &k : _collect) {
+      if (strcasecmp(k.c_str(), h.first.c_str()) == 0) _respHeaders.push_back(h);
+    }
+  }
+  const char *len = Host::findHeader(reply.headers, "Content-Length");
+  _size = len ? atoi(len) : (int)reply.body.size();
+  const char *loc = Host::findHeader(reply.headers, "Location");
+  _location = loc ? String(loc) : String();
+  _canReuse = !reply.close;
+
+  c->rx = reply.body;
+  c->dropAt = reply.dropAfter;
+  c->segment = reply.segment;
+  c->closeAfter = reply.close;
+  return reply.code;
+}
+
+String HTTPClient::header(const char *name) {
+  const char *v = Host::findHeader(_respHeaders, name);
+  return v ? String(v) : String();
+}
+
+bool HTTPClient::hasHeader(const char *name) {
+  return Host::findHeader(_respHeaders, name) != nullptr;
+}
+
+String HTTPClient::getString() {
+  std::string body;
+  uint8_t buf[512];
+  while (_client && _client->available() > 0) {
+    int n = _client->read(buf, sizeof(buf));
+    if (n <= 0) break;
+    body.append((const char *)buf, n);
+  }
+  return String(body);
+}
+
+int HTTPClient::writeToStream(Stream *stream) {
+  if (!_client || !stream) return HTTPC_ERROR_NO_STREAM;
+  int total = 0;
+  uint8_t buf[512];
+  while (_size < 0 || total < _size) {
+    int avail = _client->available();
+    if (avail <= 0) {
+      if (!_client->connected()) break;
+      continue;
+    }
+    int n = _client->read(buf, sizeof(buf));
+    if (n <= 0) break;
+    if (stream->write(buf, n) != (size_t)n) return HTTPC_ERROR_STREAM_WRITE;
+    total += n;
+  }
+  if (_size >= 0 && total < _size) return HTTPC_ERROR_CONNECTION_LOST;
+  return total;
+}
+
+String HTTPClient::errorToString(int error) {
+  switch (error) {
+    case HTTPC_ERROR_CONNECTION_REFUSED: return String("connection refused");
+    case HTTPC_ERROR_CONNECTION_LOST: return String("connection lost");
+    case HTTPC_ERROR_NOT_CONNECTED: return String("not connected");
+    case HTTPC_ERROR_STREAM_WRITE: return String("Stream write error");
+    case HTTPC_ERROR_READ_TIMEOUT: return String("read Timeout");
+    default: return String();
+  }
+}
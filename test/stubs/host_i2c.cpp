@@ -0,0 +1,113 @@
+// Host stand-in for the I2C master and the MAX17048 library on top of it
+
+#include <Wire.h>
+#include <Adafruit_MAX1704X.h>
+
+#include "host.h"
+
+TwoWire Wire;
+
+static Host::I2cDevice *s_devices[128];
+
+namespace Host {
+
+void attachI2c(uint8_t addr, I2cDevice *dev) {
+  if (addr < 128) s_devices[addr] = dev;
+}
+
+} // namespace Host
+
+void TwoWire::beginTransmission(uint8_t addr) {
+  _addr = addr;
+  _txLen = 0;
+}
+
+size_t TwoWire::write(uint8_t b) {
+  if (_txLen >= sizeof(_tx)) return 0;
+  _tx[_txLen++] = b;
+  return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  Host::I2cDevice *dev = _addr < 128 ? s_devices[_addr] : nullptr;
+  if (!dev) return 2;
+  dev->write(_tx, _txLen);
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t addr, uint8_t count) {
+  Host::I2cDevice *dev = addr < 128 ? s_devices[addr] : nullptr;
+  _rxPos = 0;
+  _rxLen = 0;
+  if (!dev) return 0;
+  if (count > sizeof(_rx)) count = sizeof(_rx);
+  _rxLen = (uint8_t)dev->read(_rx, count);
+  return _rxLen;
+}
+
+// ---- Adafruit_MAX17048 ----
+
+static const uint8_t REG_VCELL = 0x02;
+static const uint8_t REG_SOC = 0x04;
+static const uint8_t REG_VERSION = 0x08;
+static const uint8_t REG_VALRT = 0x14;
+static const uint8_t REG_CRATE = 0x16;
+
+bool Adafruit_MAX17048::readReg(uint8_t reg, uint16_t &value) {
+  _wire->beginTransmission(MAX17048_I2CADDR_DEFAULT);
+  _wire->write(reg);
+  if (_wire->endTransmission(false) != 0) return false;
+  if (_wire->requestFrom(MAX17048_I2CADDR_DEFAULT, 2) != 2) return false;
+  value = (uint16_t)(_wire->read() << 8);
+  value |= (uint8_t)_wire->read();
+  return true;
+}
+
+bool Adafruit_MAX17048::writeReg(uint8_t reg, uint16_t value) {
+  _wire->beginTransmission(MAX17048_I2CADDR_DEFAULT);
+  _wire->write(reg);
+  _wire->write((uint8_t)(value >> 8));
+  _wire->write((uint8_t)value);
+  return _wire->endTransmission() == 0;
+}
+
+bool Adafruit_MAX17048::begin(TwoWire *wire) {
+  _wire = wire;
+  return (getICversion() & 0xFFF0) == 0x0010;
+}
+
+uint16_t Adafruit_MAX17048::getICversion() {
+  uint16_t v = 0;
+  return readReg(REG_VERSION, v) ? v : 0;
+}
+
+float Adafruit_MAX17048::cellVoltage() {
+  uint16_t v;
+  if (!readReg(REG_VCELL, v)) return NAN;
+  return v * 78.125f / 1000000.0f;
+}
+
+float Adafruit_MAX17048::cellPercent() {
+  uint16_t v;
+  if (!readReg(REG_SOC, v)) return NAN;
+  return v / 256.0f;
+}
+
+float Adafruit_MAX17048::chargeRate() {
+  uint16_t v;
+  if (!readReg(REG_CRATE, v)) return NAN;
+  return (int16_t)v * 0.208f;
+}
+
+void Adafruit_MAX17048::setAlertVoltages(float minv, float maxv) {
+  uint8_t lo = (uint8_t)fminf(255.0f, fmaxf(0.0f, minv / 0.02f));
+  uint8_t hi = (uint8_t)fminf(255.0f, fmaxf(0.0f, maxv / 0.02f));
+  writeReg(REG_VALRT, (uint16_t)(lo << 8 | hi));
+}
+
+void Adafruit_MAX17048::getAlertVoltages(float &minv, float &maxv) {
+  uint16_t v = 0;
+  readReg(REG_VALRT, v);
+  minv = (v >> 8) * 0.02f;
+  maxv = (v & 0xFF) * 0.02f;
+}
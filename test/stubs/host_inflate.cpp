@@ -0,0 +1,48 @@
+// Host stand-in for the ROM inflater (see rom/miniz.h)
+
+#include <rom/miniz.h>
+#include <string.h>
+
+static voidpf arenaAlloc(voidpf opaque, uInt items, uInt size) {
+  tinfl_decompressor *r = (tinfl_decompressor *)opaque;
+  size_t n = ((size_t)items * size + 15) & ~(size_t)15;
+  if (r->used + n > sizeof(r->arena)) return Z_NULL;
+  void *p = r->arena + r->used;
+  r->used += n;
+  return p;
+}
+
+static void arenaFree(voidpf, voidpf) {}
+
+void tinfl_init(tinfl_decompressor *r) {
+  memset(&r->z, 0, sizeof(r->z));
+  r->used = 0;
+  r->done = false;
+  r->z.zalloc = arenaAlloc;
+  r->z.zfree = arenaFree;
+  r->z.opaque = r;
+  inflateInit2(&r->z, -15);
+}
+
+tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *in, size_t *inSize, uint8_t *,
+                              uint8_t *outNext, size_t *outSize, uint32_t flags) {
+  if (r->done) {
+    *inSize = *outSize = 0;
+    return TINFL_STATUS_DONE;
+  }
+  r->z.next_in = const_cast<Bytef *>(in);
+  r->z.avail_in = (uInt)*inSize;
+  r->z.next_out = outNext;
+  r->z.avail_out = (uInt)*outSize;
+  int rc = inflate(&r->z, Z_NO_FLUSH);
+  *inSize -= r->z.avail_in;
+  *outSize -= r->z.avail_out;
+  if (rc == Z_STREAM_END) {
+    r->done = true;
+    return TINFL_STATUS_DONE;
+  }
+  if (rc != Z_OK && rc != Z_BUF_ERROR) return TINFL_STATUS_FAILED;
+  if (r->z.avail_out == 0) return TINFL_STATUS_HAS_MORE_OUTPUT;
+  if (!(flags & TINFL_FLAG_HAS_MORE_INPUT)) return TINFL_STATUS_FAILED;
+  return TINFL_STATUS_NEEDS_MORE_INPUT;
+}
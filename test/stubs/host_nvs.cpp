@@ -0,0 +1,146 @@
+// Host stand-in for NVS behind Preferences
+
+#include <Preferences.h>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "host.h"
+
+// Value = type tag + raw bytes, so a getter of the wrong type misses
+typedef std::map<std::string, std::string> Namespace;
+
+static std::mutex s_mutex;
+static std::map<std::string, Namespace> s_nvs;
+static Host::NvsStats s_stats = {0};
+
+namespace Host {
+
+void clearNvs() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_nvs.clear();
+}
+
+NvsStats nvsStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return s_stats;
+}
+
+void resetNvsStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_stats = NvsStats{0};
+}
+
+} // namespace Host
+
+bool Preferences::begin(const char *name, bool readOnly) {
+  if (_open || !name || !name[0] || strlen(name) > 15) return false;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if (readOnly && !s_nvs.count(name)) return false;
+  if (!readOnly) s_nvs[name];
+  _ns = name;
+  _readOnly = readOnly;
+  _open = true;
+  return true;
+}
+
+void Preferences::end() {
+  _open = false;
+}
+
+bool Preferences::clear() {
+  if (!_open || _readOnly) return false;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_nvs[_ns].clear();
+  s_stats.writes++;
+  return true;
+}
+
+bool Preferences::remove(const char *key) {
+  if (!_open || _readOnly) return false;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_stats.writes++;
+  return s_nvs[_ns].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+  if (!_open) return false;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return s_nvs[_ns].count(key) > 0;
+}
+
+bool Preferences::put(const char *key, char type, const void *data, size_t len) {
+  if (!_open || _readOnly || !key || strlen(key) > 15) return false;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  std::string value(1, type);
+  value.append((const char *)data, len);
+  s_nvs[_ns][key] = value;
+  s_stats.writes++;
+  return true;
+}
+
+// Caller copies the value out before the next put (single-threaded use)
+const std::string *Preferences::get(const char *key, char type) {
+  if (!_open || !key) return nullptr;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  Namespace &ns = s_nvs[_ns];
+  auto it = ns.find(key);
+  if (it == ns.end() || it->second[0] != type) return nullptr;
+  return &it->second;
+}
+
+size_t Preferences::putChar(const char *key, int8_t value) {
+  return put(key, 'c', &value, 1) ? 1 : 0;
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value) {
+  return put(key, 'u', &value, 4) ? 4 : 0;
+}
+
+size_t Preferences::putString(const char *key, const char *value) {
+  size_t len = strlen(value);
+  return put(key, 's', value, len) ? len : 0;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) {
+  return put(key, 'b', value, len) ? len : 0;
+}
+
+int8_t Preferences::getChar(const char *key, int8_t defaultValue) {
+  const std::string *v = get(key, 'c');
+  return v ? (int8_t)(*v)[1] : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue) {
+  const std::string *v = get(key, 'u');
+  if (!v) return defaultValue;
+  uint32_t out;
+  memcpy(&out, v->data() + 1, 4);
+  return out;
+}
+
+size_t Preferences::getString(const char *key, char *value, size_t maxLen) {
+  const std::string *v = get(key, 's');
+  // NVS refuses a buffer that cannot hold the string and its terminator
+  if (!v || !value || v->size() > maxLen) return 0;
+  memcpy(value, v->data() + 1, v->size() - 1);
+  value[v->size() - 1] = '\0';
+  return v->size();
+}
+
+String Preferences::getString(const char *key, const String &defaultValue) {
+  const std::string *v = get(key, 's');
+  return v ? String(v->substr(1)) : defaultValue;
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+  const std::string *v = get(key, 'b');
+  return v ? v->size() - 1 : 0;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+  const std::string *v = get(key, 'b');
+  if (!v || v->size() - 1 > maxLen) return 0;
+  memcpy(buf, v->data() + 1, v->size() - 1);
+  return v->size() - 1;
+}
@@ -0,0 +1,41 @@
+// Host stand-in for Provisioning: no radio, the link is up or down as a
+// test sets it
+
+#include <WiFi.h>
+#include <atomic>
+
+#include "host.h"
+#include "provisioning.h"
+
+static std::atomic<bool> s_connected(false);
+static std::atomic<uint32_t> s_connectMs(0);
+
+namespace Host {
+
+void setWifiConnected(bool up) {
+  s_connected = up;
+}
+
+void setWifiConnectMs(uint32_t ms) {
+  s_connectMs = ms;
+}
+
+} // namespace Host
+
+namespace Provisioning {
+
+bool isConnected() {
+  return s_connected;
+}
+
+bool provisioningActive() {
+  return false;
+}
+
+bool connectStored(uint32_t timeoutMs) {
+  bool up = s_connected;
+  Host::advanceClock(up ? s_connectMs.load() : timeoutMs);
+  return up;
+}
+
+} // namespace Provisioning
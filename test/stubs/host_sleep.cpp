@@ -0,0 +1,27 @@
+// Host stand-in for the ESP-IDF sleep API: deep sleep throws
+// Host::DeepSleep and the next "boot" wakes from the timer
+
+#include <Arduino.h>
+#include <esp_sleep.h>
+
+#include "host.h"
+
+static esp_sleep_wakeup_cause_t s_cause = ESP_SLEEP_WAKEUP_UNDEFINED;
+static uint64_t s_timerUs = 0;
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+  return s_cause;
+}
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t timeUs) {
+  s_timerUs = timeUs;
+  return ESP_OK;
+}
+
+void esp_deep_sleep_start() {
+  Host::DeepSleep sleep = {s_timerUs};
+  s_cause = s_timerUs ? ESP_SLEEP_WAKEUP_TIMER : ESP_SLEEP_WAKEUP_UNDEFINED;
+  s_timerUs = 0;
+  Host::restartClock();
+  throw sleep;
+}
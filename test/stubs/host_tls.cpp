@@ -0,0 +1,198 @@
+// Host stand-in for mbedTLS: pass-through records and a server side that
+// remembers the sessions it handed out, per host
+
+#include <Arduino.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/ssl.h>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "host.h"
+
+static const size_t RECORD_MAX = 16384;
+
+static std::mutex s_mutex;
+static std::set<std::string> s_sessions;  // host + master secret
+static Host::TlsStats s_stats = {0, 0};
+
+static std::string sessionKey(const mbedtls_ssl_context *ssl) {
+  return std::string(ssl->hostname) + '\0' +
+         std::string((const char *)ssl->session.master, sizeof(ssl->session.master));
+}
+
+namespace Host {
+
+TlsStats tlsStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return s_stats;
+}
+
+void resetTlsStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_stats = TlsStats{0, 0};
+}
+
+void expireTlsSessions() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_sessions.clear();
+}
+
+} // namespace Host
+
+// ---- ssl context ----
+
+void mbedtls_ssl_init(mbedtls_ssl_context *ssl) {
+  memset(ssl, 0, sizeof(*ssl));
+}
+
+void mbedtls_ssl_free(mbedtls_ssl_context *ssl) {
+  free(ssl->in);
+  memset(ssl, 0, sizeof(*ssl));
+}
+
+int mbedtls_ssl_setup(mbedtls_ssl_context *ssl, const mbedtls_ssl_config *conf) {
+  ssl->conf = conf;
+  ssl->in = (unsigned char *)malloc(RECORD_MAX);
+  return ssl->in ? 0 : MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+}
+
+int mbedtls_ssl_set_hostname(mbedtls_ssl_context *ssl, const char *hostname) {
+  if (!hostname || strlen(hostname) >= sizeof(ssl->hostname)) return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+  strcpy(ssl->hostname, hostname);
+  return 0;
+}
+
+void mbedtls_ssl_set_bio(mbedtls_ssl_context *ssl, void *p_bio, mbedtls_ssl_send_t *f_send,
+                         mbedtls_ssl_recv_t *f_recv, mbedtls_ssl_recv_timeout_t *) {
+  ssl->p_bio = p_bio;
+  ssl->f_send = f_send;
+  ssl->f_recv = f_recv;
+}
+
+int mbedtls_ssl_set_session(mbedtls_ssl_context *ssl, const mbedtls_ssl_session *session) {
+  ssl->session = *session;
+  ssl->offered = true;
+  return 0;
+}
+
+int mbedtls_ssl_get_session(const mbedtls_ssl_context *ssl, mbedtls_ssl_session *session) {
+  if (!ssl->handshakeOver) return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+  *session = ssl->session;
+  return 0;
+}
+
+// The server resumes an offered session it still knows, else runs a full
+// handshake and remembers the new one
+int mbedtls_ssl_handshake(mbedtls_ssl_context *ssl) {
+  if (!ssl->conf || !ssl->f_recv || !ssl->f_send) return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if (ssl->offered && s_sessions.count(sessionKey(ssl))) {
+    s_stats.resumedHandshakes++;
+  } else {
+    ssl->conf->f_rng(ssl->conf->p_rng, ssl->session.id, sizeof(ssl->session.id));
+    ssl->session.id_len = sizeof(ssl->session.id);
+    ssl->conf->f_rng(ssl->conf->p_rng, ssl->session.master, sizeof(ssl->session.master));
+    s_sessions.insert(sessionKey(ssl));
+    s_stats.fullHandshakes++;
+  }
+  ssl->handshakeOver = true;
+  return 0;
+}
+
+int mbedtls_ssl_read(mbedtls_ssl_context *ssl, unsigned char *buf, size_t len) {
+  if (!ssl->handshakeOver) return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+  if (ssl->inPos == ssl->inLen) {
+    int n = ssl->f_recv(ssl->p_bio, ssl->in, RECORD_MAX);
+    if (n == 0) return MBEDTLS_ERR_SSL_CONN_EOF;
+    if (n < 0) return n;
+    ssl->inLen = (size_t)n;
+    ssl->inPos = 0;
+  }
+  if (!buf || !len) return 0;
+  size_t n = ssl->inLen - ssl->inPos;
+  if (n > len) n = len;
+  memcpy(buf, ssl->in + ssl->inPos, n);
+  ssl->inPos += n;
+  return (int)n;
+}
+
+int mbedtls_ssl_write(mbedtls_ssl_context *ssl, const unsigned char *buf, size_t len) {
+  if (!ssl->handshakeOver) return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+  return ssl->f_send(ssl->p_bio, buf, len);
+}
+
+size_t mbedtls_ssl_get_bytes_avail(const mbedtls_ssl_context *ssl) {
+  return ssl->inLen - ssl->inPos;
+}
+
+int mbedtls_ssl_close_notify(mbedtls_ssl_context *) {
+  return 0;
+}
+
+// ---- config and session ----
+
+void mbedtls_ssl_config_init(mbedtls_ssl_config *conf) {
+  memset(conf, 0, sizeof(*conf));
+}
+
+void mbedtls_ssl_config_free(mbedtls_ssl_config *conf) {
+  memset(conf, 0, sizeof(*conf));
+}
+
+int mbedtls_ssl_config_defaults(mbedtls_ssl_config *, int, int, int) {
+  return 0;
+}
+
+void mbedtls_ssl_conf_authmode(mbedtls_ssl_config *, int) {}
+
+void mbedtls_ssl_conf_rng(mbedtls_ssl_config *conf, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng) {
+  conf->f_rng = f_rng;
+  conf->p_rng = p_rng;
+}
+
+void mbedtls_ssl_conf_session_tickets(mbedtls_ssl_config *conf, int use_tickets) {
+  conf->tickets = use_tickets;
+}
+
+void mbedtls_ssl_session_init(mbedtls_ssl_session *session) {
+  memset(session, 0, sizeof(*session));
+}
+
+void mbedtls_ssl_session_free(mbedtls_ssl_session *session) {
+  memset(session, 0, sizeof(*session));
+}
+
+// ---- randomness ----
+
+void mbedtls_entropy_init(mbedtls_entropy_context *ctx) {
+  ctx->initialised = 1;
+}
+
+void mbedtls_entropy_free(mbedtls_entropy_context *ctx) {
+  ctx->initialised = 0;
+}
+
+int mbedtls_entropy_func(void *, unsigned char *output, size_t len) {
+  for (size_t i = 0; i < len; ++i) output[i] = (unsigned char)esp_random();
+  return 0;
+}
+
+void mbedtls_ctr_drbg_init(mbedtls_ctr_drbg_context *ctx) {
+  ctx->seeded = 0;
+}
+
+void mbedtls_ctr_drbg_free(mbedtls_ctr_drbg_context *ctx) {
+  ctx->seeded = 0;
+}
+
+int mbedtls_ctr_drbg_seed(mbedtls_ctr_drbg_context *ctx, int (*)(void *, unsigned char *, size_t), void *,
+                          const unsigned char *, size_t) {
+  ctx->seeded = 1;
+  return 0;
+}
+
+int mbedtls_ctr_drbg_random(void *, unsigned char *output, size_t output_len) {
+  return mbedtls_entropy_func(nullptr, output, output_len);
+}
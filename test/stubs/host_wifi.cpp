@@ -0,0 +1,147 @@
+// Host stand-in for the WiFi object and the driver's stored station config:
+// the APs in range are a list a test sets, scans finish at once and joins
+// are only recorded; link state stays with host_provisioning.cpp
+
+#include <WiFi.h>
+#include <esp_wifi.h>
+
+#include "host.h"
+
+WiFiClass WiFi;
+
+static std::string s_ssid;
+static std::string s_pass;
+static std::vector<Host::WifiAp> s_aps;
+static std::vector<Host::WifiAp> s_results;
+static bool s_scanDone = false;
+static Host::WifiStats s_stats;
+static uint8_t s_bssid[6];
+static int32_t s_channel = 0;
+static uint32_t s_dns = 0;
+
+namespace Host {
+
+void setWifiCredentials(const char *ssid, const char *pass) {
+  s_ssid = ssid;
+  s_pass = pass;
+}
+
+void setWifiAps(const std::vector<WifiAp> &aps) {
+  s_aps = aps;
+}
+
+WifiStats wifiStats() {
+  return s_stats;
+}
+
+void resetWifiStats() {
+  s_stats = WifiStats();
+}
+
+} // namespace Host
+
+esp_err_t esp_wifi_get_config(wifi_interface_t, wifi_config_t *conf) {
+  memset(conf, 0, sizeof(*conf));
+  strncpy((char *)conf->sta.ssid, s_ssid.c_str(), sizeof(conf->sta.ssid));
+  strncpy((char *)conf->sta.password, s_pass.c_str(), sizeof(conf->sta.password));
+  return ESP_OK;
+}
+
+bool WiFiClass::disconnect(bool, bool) {
+  return true;
+}
+
+bool WiFiClass::mode(wifi_mode_t) {
+  return true;
+}
+
+int WiFiClass::onEvent(WiFiEventSysCb) {
+  return 0;
+}
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *, int32_t channel, const uint8_t *bssid, bool) {
+  s_stats.joins++;
+  s_stats.joinChannel = channel;
+  memset(s_stats.joinBssid, 0, sizeof(s_stats.joinBssid));
+  if (bssid) memcpy(s_stats.joinBssid, bssid, sizeof(s_stats.joinBssid));
+  // Where the station ends up if the test reports it connected
+  memset(s_bssid, 0, sizeof(s_bssid));
+  s_channel = 0;
+  const Host::WifiAp *best = nullptr;
+  for (const Host::WifiAp &ap : s_aps) {
+    if (ap.ssid != ssid) continue;
+    if (bssid && memcmp(ap.bssid, bssid, 6) != 0) continue;
+    if (channel && ap.channel != channel) continue;
+    if (!best || ap.rssi > best->rssi) best = &ap;
+  }
+  if (best) {
+    memcpy(s_bssid, best->bssid, sizeof(s_bssid));
+    s_channel = best->channel;
+  }
+  return WL_DISCONNECTED;
+}
+
+wl_status_t WiFiClass::begin() {
+  return begin(s_ssid.c_str());
+}
+
+bool WiFiClass::config(IPAddress localIp, IPAddress, IPAddress, IPAddress dns1, IPAddress) {
+  s_stats.staticIp = localIp;
+  s_dns = dns1;
+  return true;
+}
+
+uint8_t *WiFiClass::BSSID() {
+  return s_channel ? s_bssid : nullptr;
+}
+
+int32_t WiFiClass::channel() {
+  return s_channel;
+}
+
+IPAddress WiFiClass::localIP() {
+  return IPAddress();
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t) {
+  return IPAddress(s_dns);
+}
+
+int16_t WiFiClass::scanNetworks(bool async, bool, bool, uint32_t, uint8_t channel, const char *ssid,
+                                const uint8_t *bssid) {
+  s_stats.scans++;
+  s_results.clear();
+  for (const Host::WifiAp &ap : s_aps) {
+    if (ssid && ap.ssid != ssid) continue;
+    if (bssid && memcmp(ap.bssid, bssid, 6) != 0) continue;
+    if (channel && ap.channel != channel) continue;
+    s_results.push_back(ap);
+  }
+  s_scanDone = true;
+  return async ? WIFI_SCAN_RUNNING : (int16_t)s_results.size();
+}
+
+int16_t WiFiClass::scanComplete() {
+  return s_scanDone ? (int16_t)s_results.size() : WIFI_SCAN_FAILED;
+}
+
+void WiFiClass::scanDelete() {
+  s_results.clear();
+  s_scanDone = false;
+}
+
+String WiFiClass::SSID(uint8_t i) {
+  return i < s_results.size() ? String(s_results[i].ssid.c_str()) : String();
+}
+
+int32_t WiFiClass::RSSI(uint8_t i) {
+  return i < s_results.size() ? s_results[i].rssi : 0;
+}
+
+uint8_t *WiFiClass::BSSID(uint8_t i) {
+  return i < s_results.size() ? s_results[i].bssid : nullptr;
+}
+
+int32_t WiFiClass::channel(uint8_t i) {
+  return i < s_results.size() ? s_results[i].channel : 0;
+}
@@ -0,0 +1,12 @@
+// Host stand-in for the mbedTLS entropy source
+#pragma once
+
+#include <stddef.h>
+
+struct mbedtls_entropy_context {
+  int initialised;
+};
+
+void mbedtls_entropy_init(mbedtls_entropy_context *ctx);
+void mbedtls_entropy_free(mbedtls_entropy_context *ctx);
+int mbedtls_entropy_func(void *data, unsigned char *output, size_t len);
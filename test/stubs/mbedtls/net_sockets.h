@@ -0,0 +1,5 @@
+// Host stand-in for the mbedTLS socket error codes
+#pragma once
+
+#define MBEDTLS_ERR_NET_SEND_FAILED -0x004E
+#define MBEDTLS_ERR_NET_CONN_RESET -0x0050
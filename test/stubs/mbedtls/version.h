@@ -0,0 +1,4 @@
+// Host stand-in for the mbedTLS version macros (Arduino-ESP32 2.0.17)
+#pragma once
+
+#define MBEDTLS_VERSION_NUMBER 0x021C0800
@@ -0,0 +1,13 @@
+// Host stand-in: flash and RAM share one address space
+#pragma once
+
+#include <stdint.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
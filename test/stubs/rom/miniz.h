@@ -0,0 +1,36 @@
+// Host stand-in for the ROM's miniz inflater: the tinfl_decompress() calls
+// used by the OTA decoder, implemented on zlib's raw inflate. Output may
+// go into a wrapping 32 KB buffer as with the real one, because zlib keeps
+// its own window. zlib's allocations come from an arena inside the
+// decompressor, so free() of the struct releases everything, as on the
+// device.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zlib.h>
+
+#define TINFL_LZ_DICT_SIZE 32768
+#define TINFL_FLAG_HAS_MORE_INPUT 2
+#define TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF 4
+
+typedef enum {
+  TINFL_STATUS_BAD_PARAM = -3,
+  TINFL_STATUS_ADLER32_MISMATCH = -2,
+  TINFL_STATUS_FAILED = -1,
+  TINFL_STATUS_DONE = 0,
+  TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+  TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+struct tinfl_decompressor {
+  z_stream z;
+  bool done;
+  size_t used;
+  uint8_t arena[48 * 1024];  // inflate state + 32 KB window
+};
+
+void tinfl_init(tinfl_decompressor *r);
+
+tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *in, size_t *inSize, uint8_t *outStart,
+                              uint8_t *outNext, size_t *outSize, uint32_t flags);
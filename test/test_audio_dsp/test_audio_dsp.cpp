@@ -0,0 +1,176 @@
+// AudioDsp band levels on WAV fixtures (scripts/make_audio_fixtures.py):
+// silence, a bin-centred tone, two tones 20 dB apart, white noise and a
+// synthetic worker buzz, captured at the firmware's 12.5 kHz
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+#include "audio_dsp.h"
+
+struct Wav {
+  uint32_t rate = 0;
+  std::vector<int16_t> samples;
+};
+
+static std::string fixture(const char *name) {
+  std::string dir(__FILE__);
+  return dir.substr(0, dir.find_last_of("/\\") + 1) + "fixtures/" + name;
+}
+
+static uint32_t le32(const uint8_t *p) {
+  return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+// 16-bit mono PCM only, like the I2S capture
+static Wav loadWav(const char *name) {
+  Wav wav;
+  FILE *f = fopen(fixture(name).c_str(), "rb");
+  TEST_ASSERT_NOT_NULL(f);
+  std::vector<uint8_t> bytes;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) bytes.insert(bytes.end(), buf, buf + n);
+  fclose(f);
+  TEST_ASSERT_TRUE(bytes.size() >= 12 && memcmp(bytes.data(), "RIFF", 4) == 0 && memcmp(&bytes[8], "WAVE", 4) == 0);
+  for (size_t pos = 12; pos + 8 <= bytes.size();) {
+    const uint8_t *chunk = &bytes[pos];
+    uint32_t size = le32(chunk + 4);
+    TEST_ASSERT_TRUE(pos + 8 + size <= bytes.size());
+    if (memcmp(chunk, "fmt ", 4) == 0) {
+      TEST_ASSERT_EQUAL_UINT16(1, chunk[8] | chunk[9] << 8);   // PCM
+      TEST_ASSERT_EQUAL_UINT16(1, chunk[10] | chunk[11] << 8); // mono
+      TEST_ASSERT_EQUAL_UINT16(16, chunk[22] | chunk[23] << 8);
+      wav.rate = le32(chunk + 12);
+    } else if (memcmp(chunk, "data", 4) == 0) {
+      wav.samples.resize(size / 2);
+      memcpy(wav.samples.data(), chunk + 8, size & ~1u);
+    }
+    pos += 8 + size + (size & 1);
+  }
+  TEST_ASSERT_EQUAL_UINT32(AudioDsp::SAMPLE_RATE, wav.rate);
+  TEST_ASSERT_TRUE(wav.samples.size() >= AudioDsp::FFT_N);
+  return wav;
+}
+
+static uint16_t s_bands[AudioDsp::BANDS];
+static uint16_t s_total;
+
+// Every whole frame of the fixture, as Audio::capture() feeds them
+static uint32_t analyse(const char *name) {
+  Wav wav = loadWav(name);
+  static int16_t work[2 * AudioDsp::FFT_N];
+  AudioDsp::BandEnergy energy;
+  energy.reset();
+  for (size_t off = 0; off + AudioDsp::FFT_N <= wav.samples.size(); off += AudioDsp::FFT_N) {
+    memcpy(work, &wav.samples[off], AudioDsp::FFT_N * sizeof(int16_t));
+    energy.addFrame(work, work);
+  }
+  energy.result(s_bands, s_total);
+  return energy.frames();
+}
+
+static uint8_t loudest() {
+  uint8_t best = 0;
+  for (uint8_t b = 1; b < AudioDsp::BANDS; ++b) {
+    if (s_bands[b] > s_bands[best]) best = b;
+  }
+  return best;
+}
+
+void setUp() {
+  AudioDsp::begin();
+}
+
+void tearDown() {}
+
+void test_silence_reads_zero() {
+  TEST_ASSERT_EQUAL_UINT32(4, analyse("silence.wav"));
+  for (uint8_t b = 0; b < AudioDsp::BANDS; ++b) TEST_ASSERT_EQUAL_UINT16(0, s_bands[b]);
+  TEST_ASSERT_EQUAL_UINT16(0, s_total);
+}
+
+void test_fft_peak_of_a_bin_centred_tone() {
+  // Unwindowed: a -6 dBFS sine peaks at A/2 of full scale in its bin and
+  // the mirror bin, and leaves the others near zero
+  Wav wav = loadWav("tone_bin22_-6dbfs.wav");
+  static int16_t data[2 * AudioDsp::FFT_N];
+  for (uint16_t i = 0; i < AudioDsp::FFT_N; ++i) {
+    data[2 * i] = wav.samples[i];
+    data[2 * i + 1] = 0;
+  }
+  AudioDsp::fft(data);
+  auto mag = [&](uint16_t bin) { return hypotf(data[2 * bin], data[2 * bin + 1]); };
+  TEST_ASSERT_FLOAT_WITHIN(8192 * 0.02f, 8192.0f, mag(22));
+  TEST_ASSERT_FLOAT_WITHIN(8192 * 0.02f, 8192.0f, mag(AudioDsp::FFT_N - 22));
+  TEST_ASSERT_TRUE(mag(21) < 16 && mag(23) < 16 && mag(100) < 16);
+}
+
+void test_tone_lands_in_its_band() {
+  analyse("tone_bin22_-6dbfs.wav");
+  // -6 dBFS, +1.8 dB for the Hann main lobe's three bins
+  TEST_ASSERT_EQUAL_STRING("s_bin244_293Hz", AudioDsp::bandKey(3));
+  TEST_ASSERT_EQUAL_UINT8(3, loudest());
+  TEST_ASSERT_INT_WITHIN(1, 96, s_bands[3]);
+  TEST_ASSERT_INT_WITHIN(1, 96, s_total);
+  for (uint8_t b = 0; b < AudioDsp::BANDS; ++b) {
+    if (b != 3) TEST_ASSERT_TRUE(s_bands[b] + 40 < s_bands[3]);
+  }
+}
+
+void test_two_tones_keep_their_level_difference() {
+  analyse("two_tone.wav");
+  TEST_ASSERT_EQUAL_UINT8(1, loudest());
+  TEST_ASSERT_INT_WITHIN(1, 96, s_bands[1]);
+  TEST_ASSERT_INT_WITHIN(1, 20, s_bands[1] - s_bands[7]);
+}
+
+void test_white_noise_is_flat() {
+  analyse("white_noise.wav");
+  uint16_t lo = 0xFFFF, hi = 0;
+  float sum = 0;
+  for (uint8_t b = 0; b < AudioDsp::BANDS; ++b) {
+    lo = s_bands[b] < lo ? s_bands[b] : lo;
+    hi = s_bands[b] > hi ? s_bands[b] : hi;
+    sum += powf(10.0f, s_bands[b] / 10.0f);
+  }
+  TEST_ASSERT_TRUE(lo > 30);
+  TEST_ASSERT_TRUE_MESSAGE(hi - lo <= 4, "noise bands differ by more than 4 dB");
+  // s_tot is the power sum of the bands, ten equal bands: +10 dB
+  TEST_ASSERT_INT_WITHIN(1, (int)lrintf(10.0f * log10f(sum)), s_total);
+}
+
+void test_worker_buzz() {
+  analyse("hive_buzz.wav");
+  // 250 Hz fundamental, 500 Hz harmonic; 750 Hz is above the BEEP bands
+  TEST_ASSERT_EQUAL_UINT8(3, loudest());
+  TEST_ASSERT_EQUAL_STRING("s_bin488_537Hz", AudioDsp::bandKey(8));
+  TEST_ASSERT_INT_WITHIN(2, 6, s_bands[3] - s_bands[8]);
+  for (uint8_t b = 0; b < AudioDsp::BANDS; ++b) {
+    if (b != 3 && b != 8) TEST_ASSERT_TRUE(s_bands[b] < s_bands[8]);
+  }
+}
+
+void test_result_without_frames() {
+  AudioDsp::BandEnergy energy;
+  energy.reset();
+  energy.result(s_bands, s_total);
+  TEST_ASSERT_EQUAL_UINT32(0, energy.frames());
+  for (uint8_t b = 0; b < AudioDsp::BANDS; ++b) TEST_ASSERT_EQUAL_UINT16(0, s_bands[b]);
+  TEST_ASSERT_EQUAL_STRING("", AudioDsp::bandKey(AudioDsp::BANDS));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_silence_reads_zero);
+  RUN_TEST(test_fft_peak_of_a_bin_centred_tone);
+  RUN_TEST(test_tone_lands_in_its_band);
+  RUN_TEST(test_two_tones_keep_their_level_difference);
+  RUN_TEST(test_white_noise_is_flat);
+  RUN_TEST(test_worker_buzz);
+  RUN_TEST(test_result_without_frames);
+  return UNITY_END();
+}
@@ -0,0 +1,238 @@
+// Battery module against a simulated MAX17048 on the I2C stand-in: alert
+// servicing, SoC rounding, the charge-trend hysteresis and the low-voltage
+// alert re-arm
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_MAX1704X.h>
+#include <unity.h>
+#include <vector>
+
+#include "battery.h"
+#include "measurement.h"
+#include "host.h"
+
+static const uint8_t REG_VCELL = 0x02;
+static const uint8_t REG_SOC = 0x04;
+static const uint8_t REG_VERSION = 0x08;
+static const uint8_t REG_CONFIG = 0x0C;
+static const uint8_t REG_VALRT = 0x14;
+static const uint8_t REG_CRATE = 0x16;
+static const uint8_t REG_STATUS = 0x1A;
+static const uint16_t CONFIG_ALSC = 0x0040;
+static const uint16_t CONFIG_ALRT = 0x0020;
+static const uint16_t STATUS_FLAGS = 0x3F00;
+static const uint32_t RATE_MS = 60000;
+
+// Register file with a pointer, like the chip: a write of one byte sets
+// the pointer, a longer write stores a big-endian word
+class Gauge : public Host::I2cDevice {
+public:
+  uint16_t regs[256];
+  uint32_t reads[256];
+
+  Gauge() { reset(); }
+
+  void reset() {
+    memset(regs, 0, sizeof(regs));
+    memset(reads, 0, sizeof(reads));
+    regs[REG_VERSION] = 0x0012;
+    regs[REG_CONFIG] = 0x971C;
+    regs[REG_VALRT] = 0x00FF;
+    regs[REG_STATUS] = 0x0100; // reset indicator after power-on
+    setVolts(3.90f);
+    setPercent256(0x3280); // 50.5 %
+  }
+
+  void setVolts(float v) { regs[REG_VCELL] = (uint16_t)(v * 1000000.0f / 78.125f); }
+  void setPercent256(uint16_t raw) { regs[REG_SOC] = raw; }
+  void setCrate(int16_t raw) { regs[REG_CRATE] = (uint16_t)raw; }
+
+  // Raise ALRT with the given STATUS flags, as the chip does
+  void alert(uint8_t flags) {
+    regs[REG_STATUS] |= (uint16_t)flags << 8;
+    regs[REG_CONFIG] |= CONFIG_ALRT;
+  }
+
+  void write(const uint8_t *data, size_t len) override {
+    if (!len) return;
+    _ptr = data[0];
+    if (len >= 3) regs[_ptr] = (uint16_t)(data[1] << 8 | data[2]);
+  }
+
+  size_t read(uint8_t *data, size_t len) override {
+    reads[_ptr]++;
+    if (len > 0) data[0] = (uint8_t)(regs[_ptr] >> 8);
+    if (len > 1) data[1] = (uint8_t)regs[_ptr];
+    return len < 2 ? len : 2;
+  }
+
+private:
+  uint8_t _ptr = 0;
+};
+
+static Gauge s_gauge;
+static std::vector<Measurement> s_published;
+
+static void capture(const Measurement &m) {
+  s_published.push_back(m);
+}
+
+static size_t countKey(const char *key) {
+  size_t n = 0;
+  for (const auto &m : s_published) n += strcmp(m.key, key) == 0;
+  return n;
+}
+
+// One CRATE sample per RATE_MS
+static void feedRate(int16_t raw, uint8_t samples) {
+  s_gauge.setCrate(raw);
+  for (uint8_t i = 0; i < samples; ++i) {
+    Host::advanceClock(RATE_MS);
+    Battery::update();
+  }
+}
+
+void setUp() {
+  static bool subscribed = false;
+  if (!subscribed) subscribed = Measurements::subscribe(capture);
+  s_gauge.reset();
+  Host::attachI2c(MAX17048_I2CADDR_DEFAULT, &s_gauge);
+  TEST_ASSERT_TRUE(Battery::begin());
+  // A voltage reset drops the smoothed rate left by the previous test
+  s_gauge.alert(MAX1704X_ALERTFLAG_VOLTAGE_RESET);
+  Battery::update();
+  s_published.clear();
+  memset(s_gauge.reads, 0, sizeof(s_gauge.reads));
+}
+
+void tearDown() {
+  Host::attachI2c(MAX17048_I2CADDR_DEFAULT, nullptr);
+}
+
+void test_begin_configures_the_alerts() {
+  TEST_ASSERT_EQUAL_HEX16(CONFIG_ALSC, s_gauge.regs[REG_CONFIG] & (CONFIG_ALSC | CONFIG_ALRT));
+  TEST_ASSERT_EQUAL_HEX16(0, s_gauge.regs[REG_STATUS] & STATUS_FLAGS);
+  // 3450 mV in 20 mV steps, upper threshold out of reach
+  TEST_ASSERT_EQUAL_HEX16(172 << 8 | 255, s_gauge.regs[REG_VALRT]);
+  // 50.5 % rounds up
+  TEST_ASSERT_EQUAL_INT(51, Battery::percent());
+  TEST_ASSERT_EQUAL(Battery::Trend::Idle, Battery::trend());
+}
+
+void test_soc_is_only_read_after_an_alert() {
+  for (int i = 0; i < 10; ++i) Battery::update();
+  TEST_ASSERT_EQUAL_UINT32(0, s_gauge.reads[REG_SOC]);
+  TEST_ASSERT_EQUAL_UINT32(10, s_gauge.reads[REG_CONFIG]);
+  TEST_ASSERT_EQUAL_size_t(0, s_published.size());
+
+  s_gauge.setPercent256(0x3100); // 49 %
+  s_gauge.setVolts(3.80f);
+  s_gauge.alert(MAX1704X_ALERTFLAG_SOC_CHANGE);
+  Battery::update();
+  TEST_ASSERT_EQUAL_UINT32(1, s_gauge.reads[REG_SOC]);
+  TEST_ASSERT_EQUAL_INT(49, Battery::percent());
+  TEST_ASSERT_EQUAL_size_t(1, countKey("bv"));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.80f, s_published.back().value);
+  // Acknowledged: flags and ALRT cleared, ALSC still set
+  TEST_ASSERT_EQUAL_HEX16(0, s_gauge.regs[REG_STATUS] & STATUS_FLAGS);
+  TEST_ASSERT_EQUAL_HEX16(CONFIG_ALSC, s_gauge.regs[REG_CONFIG] & (CONFIG_ALSC | CONFIG_ALRT));
+
+  // An alert without a whole-percent change publishes nothing
+  s_gauge.setPercent256(0x3140);
+  s_gauge.alert(MAX1704X_ALERTFLAG_SOC_CHANGE);
+  Battery::update();
+  TEST_ASSERT_EQUAL_INT(49, Battery::percent());
+  TEST_ASSERT_EQUAL_size_t(1, countKey("bv"));
+}
+
+void test_trend_enters_and_leaves_with_hysteresis() {
+  TEST_ASSERT_EQUAL(Battery::Trend::Idle, Battery::trend());
+  TEST_ASSERT_EQUAL_INT32(-1, Battery::minutesToFull());
+  TEST_ASSERT_EQUAL_INT32(-1, Battery::minutesToEmpty());
+
+  // CRATE is 0.208 %/h per bit
+  feedRate(5, 1);
+  TEST_ASSERT_EQUAL(Battery::Trend::Charging, Battery::trend());
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.04f, Battery::chargeRate());
+  TEST_ASSERT_INT32_WITHIN(1, (int32_t)(49 * 60 / 1.04f), Battery::minutesToFull());
+
+  // 0.208 %/h: above the leave threshold, below the enter one
+  feedRate(1, 20);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.208f, Battery::chargeRate());
+  TEST_ASSERT_EQUAL(Battery::Trend::Charging, Battery::trend());
+  feedRate(0, 1);
+  TEST_ASSERT_EQUAL(Battery::Trend::Idle, Battery::trend());
+  feedRate(1, 20);
+  TEST_ASSERT_EQUAL(Battery::Trend::Idle, Battery::trend());
+
+  // The EMA needs a few samples before a new direction counts
+  feedRate(-5, 1);
+  TEST_ASSERT_EQUAL(Battery::Trend::Idle, Battery::trend());
+  feedRate(-5, 20);
+  TEST_ASSERT_EQUAL(Battery::Trend::Discharging, Battery::trend());
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, -1.04f, Battery::chargeRate());
+  TEST_ASSERT_INT32_WITHIN(1, (int32_t)(51 * 60 / -Battery::chargeRate()), Battery::minutesToEmpty());
+  TEST_ASSERT_EQUAL_INT32(-1, Battery::minutesToFull());
+
+  // No CRATE sample before RATE_MS has passed
+  s_gauge.setCrate(5);
+  uint32_t before = s_gauge.reads[REG_CRATE];
+  Battery::update();
+  TEST_ASSERT_EQUAL_UINT32(before, s_gauge.reads[REG_CRATE]);
+}
+
+void test_voltage_reset_forgets_the_trend() {
+  feedRate(-10, 3);
+  TEST_ASSERT_EQUAL(Battery::Trend::Discharging, Battery::trend());
+  s_gauge.alert(MAX1704X_ALERTFLAG_VOLTAGE_RESET);
+  Battery::update();
+  TEST_ASSERT_EQUAL(Battery::Trend::Idle, Battery::trend());
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, Battery::chargeRate());
+}
+
+void test_low_voltage_alert_disarms_until_the_cell_recovers() {
+  s_gauge.setVolts(3.40f);
+  s_gauge.alert(MAX1704X_ALERTFLAG_VOLTAGE_LOW);
+  Battery::update();
+  TEST_ASSERT_EQUAL_size_t(1, countKey("bv"));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.40f, s_published[0].value);
+  TEST_ASSERT_EQUAL_HEX16(0 << 8 | 255, s_gauge.regs[REG_VALRT]);
+
+  // Still below the hysteresis band: stays disarmed
+  s_gauge.setVolts(3.50f);
+  feedRate(0, 1);
+  TEST_ASSERT_EQUAL_HEX16(0 << 8 | 255, s_gauge.regs[REG_VALRT]);
+  s_gauge.setVolts(3.60f);
+  feedRate(0, 1);
+  TEST_ASSERT_EQUAL_HEX16(172 << 8 | 255, s_gauge.regs[REG_VALRT]);
+}
+
+void test_gauge_reset_reconfigures() {
+  s_gauge.regs[REG_CONFIG] = 0x971C | CONFIG_ALRT; // power-on defaults, ALSC off
+  s_gauge.regs[REG_VALRT] = 0x00FF;
+  s_gauge.alert(MAX1704X_ALERTFLAG_RESET_INDICATOR);
+  Battery::update();
+  TEST_ASSERT_EQUAL_HEX16(CONFIG_ALSC, s_gauge.regs[REG_CONFIG] & (CONFIG_ALSC | CONFIG_ALRT));
+  TEST_ASSERT_EQUAL_HEX16(172 << 8 | 255, s_gauge.regs[REG_VALRT]);
+  TEST_ASSERT_EQUAL_HEX16(0, s_gauge.regs[REG_STATUS] & STATUS_FLAGS);
+}
+
+void test_missing_gauge() {
+  Host::attachI2c(MAX17048_I2CADDR_DEFAULT, nullptr);
+  TEST_ASSERT_FALSE(Battery::begin());
+  TEST_ASSERT_TRUE(isnan(Battery::voltage()));
+  Battery::update(); // must not touch the bus
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_begin_configures_the_alerts);
+  RUN_TEST(test_soc_is_only_read_after_an_alert);
+  RUN_TEST(test_trend_enters_and_leaves_with_hysteresis);
+  RUN_TEST(test_voltage_reset_forgets_the_trend);
+  RUN_TEST(test_low_voltage_alert_disarms_until_the_cell_recovers);
+  RUN_TEST(test_gauge_reset_reconfigures);
+  RUN_TEST(test_missing_gauge);
+  return UNITY_END();
+}
@@ -0,0 +1,160 @@
+// BleAdv::decode on captured advertisements: the Ruuvi RAWv2 test vectors
+// from the format spec, BTHome v2 objects as documented on bthome.io, both
+// pvvx/ATC layouts, and malformed, encrypted and truncated payloads
+
+#include <unity.h>
+#include <string.h>
+#include <vector>
+
+#include "ble_adv.h"
+
+// Advertising data as a hex dump, the way a sniffer shows it
+static std::vector<uint8_t> hex(const char *s) {
+  std::vector<uint8_t> out;
+  for (; s[0] && s[1]; s += 2) {
+    auto nibble = [](char c) { return (uint8_t)(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10); };
+    out.push_back((uint8_t)(nibble(s[0]) << 4 | nibble(s[1])));
+  }
+  return out;
+}
+
+static BleAdv::Reading s_out[BleAdv::MAX_READINGS];
+
+static uint8_t decode(const char *adv, uint8_t max = BleAdv::MAX_READINGS) {
+  std::vector<uint8_t> data = hex(adv);
+  memset(s_out, 0, sizeof(s_out));
+  return BleAdv::decode(data.data(), (uint8_t)data.size(), s_out, max);
+}
+
+static void expectReading(uint8_t i, BleAdv::Kind kind, float value) {
+  TEST_ASSERT_EQUAL_INT((int)kind, (int)s_out[i].kind);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, value, s_out[i].value);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_ruuvi_valid_vector() {
+  TEST_ASSERT_EQUAL_UINT8(4, decode("0201061BFF99040512FC5394C37C0004FFFC040CAC364200CDCBB8334C884F"));
+  expectReading(0, BleAdv::Kind::Temperature, 24.3f);
+  expectReading(1, BleAdv::Kind::Humidity, 53.49f);
+  expectReading(2, BleAdv::Kind::Pressure, 1000.44f);
+  expectReading(3, BleAdv::Kind::BatteryVolts, 2.977f);
+}
+
+void test_ruuvi_limits() {
+  TEST_ASSERT_EQUAL_UINT8(4, decode("0201061BFF9904057FFFFFFEFFFE7FFF7FFF7FFFFFDEFEFFFECBB8334C884F"));
+  expectReading(0, BleAdv::Kind::Temperature, 163.835f);
+  expectReading(1, BleAdv::Kind::Humidity, 163.835f);
+  expectReading(2, BleAdv::Kind::Pressure, 1155.34f);
+  expectReading(3, BleAdv::Kind::BatteryVolts, 3.646f);
+
+  TEST_ASSERT_EQUAL_UINT8(4, decode("0201061BFF990405800100000000800180018001000000000000CBB8334C884F"));
+  expectReading(0, BleAdv::Kind::Temperature, -163.835f);
+  expectReading(1, BleAdv::Kind::Humidity, 0.0f);
+  expectReading(2, BleAdv::Kind::Pressure, 500.0f);
+  expectReading(3, BleAdv::Kind::BatteryVolts, 1.6f);
+}
+
+void test_ruuvi_not_available_fields_are_skipped() {
+  TEST_ASSERT_EQUAL_UINT8(0, decode("0201061BFF9904058000FFFFFFFF800080008000FFFFFFFFFFFFFFFFFFFFFF"));
+}
+
+void test_bthome_objects() {
+  TEST_ASSERT_EQUAL_UINT8(4, decode("0201061116D2FC4002CA0903BF1304138A010C020C"));
+  expectReading(0, BleAdv::Kind::Temperature, 25.06f);
+  expectReading(1, BleAdv::Kind::Humidity, 50.55f);
+  expectReading(2, BleAdv::Kind::Pressure, 1008.83f);
+  expectReading(3, BleAdv::Kind::BatteryVolts, 3.074f);
+
+  // Mass in kg and in lb, whole-percent humidity
+  TEST_ASSERT_EQUAL_UINT8(3, decode("0201060C16D2FC40065E1F073E1D2E23"));
+  expectReading(0, BleAdv::Kind::WeightKg, 80.30f);
+  expectReading(1, BleAdv::Kind::WeightKg, 74.86f * 0.45359237f);
+  expectReading(2, BleAdv::Kind::Humidity, 35.0f);
+
+  // Objects the decoder does not forward are stepped over
+  TEST_ASSERT_EQUAL_UINT8(1, decode("0201060A16D2FC400164020A0903"));
+  expectReading(0, BleAdv::Kind::Temperature, 23.14f);
+}
+
+void test_bthome_encrypted_and_unknown_objects() {
+  TEST_ASSERT_EQUAL_UINT8(0, decode("0201060E16D2FC41A47E7F50A0B1C2D3E4F5"));
+  // Version 1 device info
+  TEST_ASSERT_EQUAL_UINT8(0, decode("0201060716D2FC2002CA09"));
+  // An unknown object ID ends the parse; what came before is kept
+  TEST_ASSERT_EQUAL_UINT8(1, decode("0201060D16D2FC4002CA0930000003BF13"));
+  expectReading(0, BleAdv::Kind::Temperature, 25.06f);
+}
+
+void test_pvvx_and_atc_layouts() {
+  // pvvx custom: little-endian, 0.01 deg C / 0.01 %RH / mV
+  TEST_ASSERT_EQUAL_UINT8(3, decode("12161A18B96C0A38C1A41009EC138A0B5A0704"));
+  expectReading(0, BleAdv::Kind::Temperature, 23.2f);
+  expectReading(1, BleAdv::Kind::Humidity, 51.0f);
+  expectReading(2, BleAdv::Kind::BatteryVolts, 2.954f);
+
+  // ATC1441: big-endian, 0.1 deg C / whole %RH / mV
+  TEST_ASSERT_EQUAL_UINT8(3, decode("10161A18A4C1380A6CB9FF9C335A0B8A07"));
+  expectReading(0, BleAdv::Kind::Temperature, -10.0f);
+  expectReading(1, BleAdv::Kind::Humidity, 51.0f);
+  expectReading(2, BleAdv::Kind::BatteryVolts, 2.954f);
+}
+
+void test_malformed_payloads() {
+  // Truncated mid-structure
+  TEST_ASSERT_EQUAL_UINT8(0, decode("0201061BFF99040512FC5394C37C0004FFFC040CAC364200CDCB"));
+  // Other company, other service UUID
+  TEST_ASSERT_EQUAL_UINT8(0, decode("0201061BFF4C000512FC5394C37C0004FFFC040CAC364200CDCBB8334C884F"));
+  TEST_ASSERT_EQUAL_UINT8(0, decode("0201060616AAFE02CA09"));
+  // Ruuvi format 3
+  TEST_ASSERT_EQUAL_UINT8(0, decode("0201061BFF99040312FC5394C37C0004FFFC040CAC364200CDCBB8334C884F"));
+  // A BTHome object running past the structure
+  TEST_ASSERT_EQUAL_UINT8(0, decode("0201060616D2FC4002CA"));
+  TEST_ASSERT_EQUAL_UINT8(0, decode(""));
+  TEST_ASSERT_EQUAL_UINT8(0, decode("00"));
+}
+
+void test_scan_response_and_padding() {
+  // Advertising data and scan response back to back; zero padding ends it
+  TEST_ASSERT_EQUAL_UINT8(2, decode("0201060709487665546167" "0716D2FC4002CA09" "0616D2FC402E23" "0000"
+                                    "0716D2FC4002CA09"));
+  expectReading(0, BleAdv::Kind::Temperature, 25.06f);
+  expectReading(1, BleAdv::Kind::Humidity, 35.0f);
+}
+
+void test_max_readings_caps_the_output() {
+  TEST_ASSERT_EQUAL_UINT8(2, decode("0201061BFF99040512FC5394C37C0004FFFC040CAC364200CDCBB8334C884F", 2));
+  expectReading(1, BleAdv::Kind::Humidity, 53.49f);
+  TEST_ASSERT_EQUAL_INT(0, (int)s_out[2].kind);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, s_out[2].value);
+}
+
+void test_keys_and_hash() {
+  TEST_ASSERT_EQUAL_STRING("t", BleAdv::beepKey(BleAdv::Kind::Temperature));
+  TEST_ASSERT_EQUAL_STRING("weight_kg", BleAdv::beepKey(BleAdv::Kind::WeightKg));
+  TEST_ASSERT_EQUAL_STRING("bv", BleAdv::beepKey(BleAdv::Kind::BatteryVolts));
+  // FNV-1a reference values
+  TEST_ASSERT_EQUAL_HEX32(0x811C9DC5, BleAdv::hash(nullptr, 0));
+  TEST_ASSERT_EQUAL_HEX32(0xE40C292C, BleAdv::hash((const uint8_t *)"a", 1));
+  std::vector<uint8_t> a = hex("0201061BFF99040512FC5394C37C0004FFFC040CAC364200CDCBB8334C884F");
+  std::vector<uint8_t> b = a;
+  b[20] ^= 1; // measurement sequence number
+  TEST_ASSERT_TRUE(BleAdv::hash(a.data(), a.size()) != BleAdv::hash(b.data(), b.size()));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_ruuvi_valid_vector);
+  RUN_TEST(test_ruuvi_limits);
+  RUN_TEST(test_ruuvi_not_available_fields_are_skipped);
+  RUN_TEST(test_bthome_objects);
+  RUN_TEST(test_bthome_encrypted_and_unknown_objects);
+  RUN_TEST(test_pvvx_and_atc_layouts);
+  RUN_TEST(test_malformed_payloads);
+  RUN_TEST(test_scan_response_and_padding);
+  RUN_TEST(test_max_readings_caps_the_output);
+  RUN_TEST(test_keys_and_hash);
+  return UNITY_END();
+}
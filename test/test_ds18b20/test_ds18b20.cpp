@@ -0,0 +1,372 @@
+// Ds18b20 against a simulated multi-drop 1-Wire bus: every device answers
+// the bit slots like the chip (wired-AND, search triplets, match ROM,
+// scratchpad read), with a foreign family, a ROM with a bad CRC, a
+// glitched search pass, a corrupted scratchpad, an unplugged probe and a
+// line stuck low
+
+#include <string.h>
+#include <unity.h>
+#include <vector>
+
+#include "ds18b20.h"
+
+static const uint8_t CMD_SEARCH_ROM = 0xF0;
+static const uint8_t CMD_MATCH_ROM = 0x55;
+static const uint8_t CMD_SKIP_ROM = 0xCC;
+static const uint8_t CMD_CONVERT_T = 0x44;
+static const uint8_t CMD_READ_SCRATCHPAD = 0xBE;
+
+// One device on the line. Bits are counted from the LSB of byte 0, the
+// order they travel on the wire.
+class Device {
+public:
+  uint8_t rom[Ds18b20::ROM_LEN];
+  uint8_t pad[Ds18b20::SCRATCHPAD_LEN];
+  int16_t sensed = 0;  // raw 1/16 deg C, latched by Convert T
+  bool present = true;
+  bool corruptPad = false;
+
+  Device(uint8_t family, uint32_t serial, int16_t raw, uint8_t config = 0x7F) {
+    rom[0] = family;
+    for (uint8_t b = 0; b < 6; ++b) rom[1 + b] = b < 4 ? (uint8_t)(serial >> (8 * b)) : 0;
+    rom[7] = Ds18b20::crc8(rom, 7);
+    sensed = raw;
+    // Power-on scratchpad: +85 deg C until the first conversion
+    const uint8_t init[8] = {0x50, 0x05, 0x4B, 0x46, config, 0xFF, 0x0C, 0x10};
+    memcpy(pad, init, sizeof(init));
+    pad[8] = Ds18b20::crc8(pad, 8);
+  }
+
+  void onReset() {
+    _phase = present ? RomCmd : Idle;
+    _bits = 0;
+    _byte = 0;
+  }
+
+  void onWrite(bool bit) {
+    switch (_phase) {
+      case RomCmd:
+      case FnCmd:
+        _byte |= (uint8_t)bit << _bits;
+        if (++_bits < 8) return;
+        command(_byte);
+        _bits = 0;
+        _byte = 0;
+        return;
+      case SearchDir:
+        if (bit != romBit(_bits)) _phase = Idle;
+        else _phase = ++_bits < 64 ? SearchBit : Idle;
+        return;
+      case Match:
+        if (bit != romBit(_bits)) _phase = Idle;
+        else if (++_bits == 64) {
+          _phase = FnCmd;
+          _bits = 0;
+        }
+        return;
+      default:
+        _phase = Idle; // out of step with the master
+        return;
+    }
+  }
+
+  // What this device drives in a read slot; true releases the line
+  bool onRead() {
+    switch (_phase) {
+      case SearchBit:
+        _phase = SearchCmp;
+        return romBit(_bits);
+      case SearchCmp:
+        _phase = SearchDir;
+        return !romBit(_bits);
+      case ReadPad: {
+        if (_bits >= 8 * Ds18b20::SCRATCHPAD_LEN) return true;
+        uint8_t byte = pad[_bits / 8];
+        if (corruptPad && _bits / 8 == 0) byte ^= 0x04;
+        return byte >> (_bits++ % 8) & 1;
+      }
+      default:
+        return true;
+    }
+  }
+
+private:
+  enum Phase { Idle, RomCmd, SearchBit, SearchCmp, SearchDir, Match, FnCmd, ReadPad };
+  Phase _phase = Idle;
+  uint8_t _bits = 0;
+  uint8_t _byte = 0;
+
+  bool romBit(uint8_t i) const { return rom[i / 8] >> (i % 8) & 1; }
+
+  void command(uint8_t cmd) {
+    if (_phase == RomCmd) {
+      if (cmd == CMD_SEARCH_ROM) _phase = SearchBit;
+      else if (cmd == CMD_MATCH_ROM) _phase = Match;
+      else if (cmd == CMD_SKIP_ROM) _phase = FnCmd;
+      else _phase = Idle;
+      return;
+    }
+    if (cmd == CMD_CONVERT_T && rom[0] == Ds18b20::FAMILY) {
+      pad[0] = (uint8_t)sensed;
+      pad[1] = (uint8_t)(sensed >> 8);
+      pad[8] = Ds18b20::crc8(pad, 8);
+      _phase = Idle;
+    } else if (cmd == CMD_READ_SCRATCHPAD && rom[0] == Ds18b20::FAMILY) {
+      _phase = ReadPad;
+    } else {
+      _phase = Idle;
+    }
+  }
+};
+
+// Wired-AND line with a pull-up: a read is 0 when any device pulls low
+class SimBus : public Ds18b20::Bus {
+public:
+  std::vector<Device *> devices;
+  bool stuckLow = false;
+  int32_t unplugAfterReads = -1;  // every device leaves after this many reads
+  int32_t glitchPass = -1;        // in this pass (counted from 0)...
+  uint8_t glitchBit = 63;         // ...the master mis-reads this ROM bit
+  uint32_t resets = 0;
+  uint32_t reads = 0;
+
+  bool reset() override {
+    _passReads = 0;
+    resets++;
+    bool presence = stuckLow;
+    for (Device *d : devices) {
+      d->onReset();
+      presence |= d->present;
+    }
+    return presence;
+  }
+
+  void writeBit(bool bit) override {
+    for (Device *d : devices) d->onWrite(bit);
+  }
+
+  bool readBit() override {
+    if (reads++ == (uint32_t)unplugAfterReads) {
+      for (Device *d : devices) d->present = false;
+    }
+    bool level = !stuckLow;
+    for (Device *d : devices) {
+      bool driven = d->onRead();
+      if (d->present) level &= driven;
+    }
+    // Search reads come in pairs (bit, complement), one pair per ROM bit
+    if ((int32_t)resets - 1 == glitchPass && _passReads++ / 2 == glitchBit) level = !level;
+    return level;
+  }
+
+private:
+  uint32_t _passReads = 0;
+};
+
+// Four probes with temperatures a hive sees, plus two that search skips
+static Device s_brood(Ds18b20::FAMILY, 0x00A1B2C3, 0x0238);   // +35.5
+static Device s_frame(Ds18b20::FAMILY, 0x00A1B2C2, 0x01F4);   // +31.25
+static Device s_roof(Ds18b20::FAMILY, 0x10000001, 0x0191);    // +25.0625
+static Device s_outside(Ds18b20::FAMILY, 0x7F0000FE, 0xFF5E); // -10.125
+static Device s_serial(0x01, 0x00123456, 0);                  // DS2401 silicon serial
+static Device s_badRom(Ds18b20::FAMILY, 0x00BADBAD, 0);
+static SimBus s_bus;
+
+static Device *const PROBES[] = {&s_brood, &s_frame, &s_roof, &s_outside};
+
+// The order search visits: lowest ROM first, comparing from bit 0 upward
+static bool romBefore(const Device *a, const Device *b) {
+  for (uint8_t i = 0; i < 64; ++i) {
+    bool x = a->rom[i / 8] >> (i % 8) & 1, y = b->rom[i / 8] >> (i % 8) & 1;
+    if (x != y) return y;
+  }
+  return false;
+}
+
+static std::vector<Device *> searchOrder() {
+  std::vector<Device *> out(PROBES, PROBES + 4);
+  for (size_t i = 1; i < out.size(); ++i) {
+    for (size_t j = i; j > 0 && romBefore(out[j], out[j - 1]); --j) std::swap(out[j], out[j - 1]);
+  }
+  return out;
+}
+
+void setUp() {
+  for (Device *d : PROBES) {
+    d->present = true;
+    d->corruptPad = false;
+  }
+  s_badRom.rom[7] ^= 0x01;
+  s_bus = SimBus();
+  s_bus.devices = {&s_serial, &s_outside, &s_brood, &s_badRom, &s_roof, &s_frame};
+}
+
+void tearDown() {
+  s_badRom.rom[7] ^= 0x01;
+}
+
+void test_crc8_matches_the_application_note() {
+  // Maxim AN27 example ROM: family 02, serial 0000000001B81C, CRC A2
+  const uint8_t rom[8] = {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2};
+  TEST_ASSERT_EQUAL_HEX8(0xA2, Ds18b20::crc8(rom, 7));
+  TEST_ASSERT_EQUAL_HEX8(0x00, Ds18b20::crc8(rom, 8));
+  TEST_ASSERT_EQUAL_HEX8(0x00, Ds18b20::crc8(rom, 0));
+}
+
+void test_search_finds_every_probe_in_rom_order() {
+  uint8_t roms[8][Ds18b20::ROM_LEN];
+  TEST_ASSERT_EQUAL_UINT8(4, Ds18b20::search(s_bus, roms, 8));
+  std::vector<Device *> order = searchOrder();
+  for (uint8_t i = 0; i < 4; ++i) TEST_ASSERT_EQUAL_HEX8_ARRAY(order[i]->rom, roms[i], Ds18b20::ROM_LEN);
+  // One pass per leaf of the ROM tree: four probes and the foreign
+  // device, plus a retry of the ROM that fails its CRC
+  TEST_ASSERT_EQUAL_UINT32(7, s_bus.resets);
+}
+
+void test_search_order_does_not_depend_on_wiring() {
+  uint8_t first[8][Ds18b20::ROM_LEN], second[8][Ds18b20::ROM_LEN];
+  TEST_ASSERT_EQUAL_UINT8(4, Ds18b20::search(s_bus, first, 8));
+  s_bus.devices = {&s_frame, &s_roof, &s_badRom, &s_brood, &s_outside, &s_serial};
+  TEST_ASSERT_EQUAL_UINT8(4, Ds18b20::search(s_bus, second, 8));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(first, second, 4 * Ds18b20::ROM_LEN);
+}
+
+void test_search_retries_a_glitched_pass() {
+  // Every pass in turn gets a flipped last ROM bit: the branch it was on
+  // is walked again and no probe goes missing
+  std::vector<Device *> order = searchOrder();
+  for (int32_t pass = 0; pass < 7; ++pass) {
+    uint8_t roms[8][Ds18b20::ROM_LEN];
+    s_bus = SimBus();
+    s_bus.devices = {&s_serial, &s_outside, &s_brood, &s_badRom, &s_roof, &s_frame};
+    s_bus.glitchPass = pass;
+    TEST_ASSERT_EQUAL_UINT8(4, Ds18b20::search(s_bus, roms, 8));
+    for (uint8_t i = 0; i < 4; ++i) TEST_ASSERT_EQUAL_HEX8_ARRAY(order[i]->rom, roms[i], Ds18b20::ROM_LEN);
+  }
+}
+
+void test_search_stops_at_max() {
+  uint8_t roms[2][Ds18b20::ROM_LEN];
+  TEST_ASSERT_EQUAL_UINT8(2, Ds18b20::search(s_bus, roms, 2));
+  std::vector<Device *> order = searchOrder();
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(order[0]->rom, roms[0], Ds18b20::ROM_LEN);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(order[1]->rom, roms[1], Ds18b20::ROM_LEN);
+}
+
+void test_search_without_probes() {
+  uint8_t roms[4][Ds18b20::ROM_LEN];
+  s_bus.devices.clear();
+  TEST_ASSERT_EQUAL_UINT8(0, Ds18b20::search(s_bus, roms, 4));
+  TEST_ASSERT_FALSE(Ds18b20::convertAll(s_bus));
+  // Only a foreign device answering
+  s_bus.devices = {&s_serial};
+  TEST_ASSERT_EQUAL_UINT8(0, Ds18b20::search(s_bus, roms, 4));
+}
+
+void test_search_when_probes_are_unplugged_midway() {
+  // Everyone leaves during the second pass: the first ROM is kept and the
+  // search gives up instead of recording a ROM of all ones
+  uint8_t roms[8][Ds18b20::ROM_LEN];
+  s_bus.unplugAfterReads = 2 * 64 + 20;
+  uint8_t found = Ds18b20::search(s_bus, roms, 8);
+  TEST_ASSERT_EQUAL_UINT8(1, found);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(searchOrder()[0]->rom, roms[0], Ds18b20::ROM_LEN);
+  TEST_ASSERT_EQUAL_UINT32(2, s_bus.resets);
+}
+
+void test_read_after_convert() {
+  uint8_t roms[8][Ds18b20::ROM_LEN];
+  TEST_ASSERT_EQUAL_UINT8(4, Ds18b20::search(s_bus, roms, 8));
+  int16_t c = 0;
+  // Before the first conversion every probe reports its power-on +85
+  TEST_ASSERT_TRUE(Ds18b20::readCentiC(s_bus, roms[0], c));
+  TEST_ASSERT_EQUAL_INT16(8500, c);
+
+  TEST_ASSERT_TRUE(Ds18b20::convertAll(s_bus));
+  const int16_t expect[] = {3550, 3125, 2506, -1012};
+  for (uint8_t p = 0; p < 4; ++p) {
+    int16_t got = 0;
+    TEST_ASSERT_TRUE(Ds18b20::readCentiC(s_bus, PROBES[p]->rom, got));
+    TEST_ASSERT_EQUAL_INT16(expect[p], got);
+  }
+}
+
+void test_datasheet_temperatures() {
+  // Table 1 of the DS18B20 datasheet, through one probe alone on the line
+  struct Row {
+    int16_t raw, centiC;
+  };
+  const Row rows[] = {{0x07D0, 12500}, {0x0550, 8500}, {0x0191, 2506}, {0x00A2, 1012}, {0x0008, 50},
+                      {0x0000, 0},     {(int16_t)0xFFF8, -50},  {(int16_t)0xFF5E, -1012},
+                      {(int16_t)0xFE6F, -2506}, {(int16_t)0xFC90, -5500}};
+  s_bus.devices = {&s_roof};
+  for (const Row &row : rows) {
+    s_roof.sensed = row.raw;
+    TEST_ASSERT_TRUE(Ds18b20::convertAll(s_bus));
+    int16_t got = 1;
+    TEST_ASSERT_TRUE(Ds18b20::readCentiC(s_bus, s_roof.rom, got));
+    TEST_ASSERT_EQUAL_INT16(row.centiC, got);
+  }
+  s_roof.sensed = 0x0191;
+}
+
+void test_lower_resolution_masks_undefined_bits() {
+  // 9-bit configuration: bits 0-2 are undefined and must not show
+  Device probe(Ds18b20::FAMILY, 0x00C0FFEE, 0x0197, 0x1F);
+  s_bus.devices = {&probe};
+  TEST_ASSERT_TRUE(Ds18b20::convertAll(s_bus));
+  int16_t got = 0;
+  TEST_ASSERT_TRUE(Ds18b20::readCentiC(s_bus, probe.rom, got));
+  TEST_ASSERT_EQUAL_INT16(2500, got);
+}
+
+void test_corrupted_scratchpad_is_rejected() {
+  TEST_ASSERT_TRUE(Ds18b20::convertAll(s_bus));
+  s_frame.corruptPad = true;
+  int16_t got = 1234;
+  TEST_ASSERT_FALSE(Ds18b20::readCentiC(s_bus, s_frame.rom, got));
+  TEST_ASSERT_EQUAL_INT16(1234, got);
+  // The others on the line still read
+  TEST_ASSERT_TRUE(Ds18b20::readCentiC(s_bus, s_brood.rom, got));
+  TEST_ASSERT_EQUAL_INT16(3550, got);
+}
+
+void test_missing_probe_is_rejected() {
+  uint8_t roms[8][Ds18b20::ROM_LEN];
+  TEST_ASSERT_EQUAL_UINT8(4, Ds18b20::search(s_bus, roms, 8));
+  s_roof.present = false;
+  TEST_ASSERT_EQUAL_UINT8(3, Ds18b20::search(s_bus, roms, 8));
+  TEST_ASSERT_TRUE(Ds18b20::convertAll(s_bus));
+  int16_t got = 0;
+  // Nobody matches: the scratchpad reads all ones
+  TEST_ASSERT_FALSE(Ds18b20::readCentiC(s_bus, s_roof.rom, got));
+  TEST_ASSERT_TRUE(Ds18b20::readCentiC(s_bus, s_outside.rom, got));
+  TEST_ASSERT_EQUAL_INT16(-1012, got);
+}
+
+void test_line_stuck_low() {
+  uint8_t roms[4][Ds18b20::ROM_LEN];
+  s_bus.stuckLow = true;
+  int16_t got = 0;
+  // Presence, but every slot reads 0: an all-zero scratchpad passes the CRC
+  TEST_ASSERT_FALSE(Ds18b20::readCentiC(s_bus, s_brood.rom, got));
+  TEST_ASSERT_EQUAL_UINT8(0, Ds18b20::search(s_bus, roms, 4));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_crc8_matches_the_application_note);
+  RUN_TEST(test_search_finds_every_probe_in_rom_order);
+  RUN_TEST(test_search_order_does_not_depend_on_wiring);
+  RUN_TEST(test_search_retries_a_glitched_pass);
+  RUN_TEST(test_search_stops_at_max);
+  RUN_TEST(test_search_without_probes);
+  RUN_TEST(test_search_when_probes_are_unplugged_midway);
+  RUN_TEST(test_read_after_convert);
+  RUN_TEST(test_datasheet_temperatures);
+  RUN_TEST(test_lower_resolution_masks_undefined_bits);
+  RUN_TEST(test_corrupted_scratchpad_is_rejected);
+  RUN_TEST(test_missing_probe_is_rejected);
+  RUN_TEST(test_line_stuck_low);
+  return UNITY_END();
+}
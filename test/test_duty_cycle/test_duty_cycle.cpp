@@ -0,0 +1,165 @@
+// DutyCycle on a frozen clock: a full boot, then timer wakes that sample the
+// gauge into RTC memory and every DUTY_UPLOAD_EVERY-th one that uploads, each
+// ending in deep sleep, with the awake/radio split and the average current
+// estimated from the DUTY_I_* defaults (40 mA awake, 110 mA with Wi-Fi,
+// 80 uA asleep, a 900 s period)
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "duty_cycle.h"
+#include "esp_sleep.h"
+#include "host.h"
+#include "scheduler.h"
+#include "uploader.h"
+
+static const uint32_t PERIOD_MS = 900000;
+static const uint32_t AWAKE_WINDOW_MS = 600000;
+static const uint32_t CONNECT_MS = 1500;
+static const uint32_t POST_MS = 500;
+
+static const uint8_t REG_VCELL = 0x02;
+static const uint8_t REG_VERSION = 0x08;
+
+// Just enough MAX17048 for Battery::voltage()
+class Gauge : public Host::I2cDevice {
+public:
+  Gauge() {
+    memset(regs, 0, sizeof(regs));
+    regs[REG_VERSION] = 0x0012;
+    regs[REG_VCELL] = (uint16_t)(3.9f * 1000000.0f / 78.125f);
+  }
+
+  void write(const uint8_t *data, size_t len) override {
+    if (!len) return;
+    _ptr = data[0];
+    if (len >= 3) regs[_ptr] = (uint16_t)(data[1] << 8 | data[2]);
+  }
+
+  size_t read(uint8_t *data, size_t len) override {
+    if (len > 0) data[0] = (uint8_t)(regs[_ptr] >> 8);
+    if (len > 1) data[1] = (uint8_t)regs[_ptr];
+    return len < 2 ? len : 2;
+  }
+
+private:
+  uint16_t regs[256];
+  uint8_t _ptr = 0;
+};
+
+static Gauge s_gauge;
+
+static Host::HttpReply handle(const Host::HttpRequest &) {
+  Host::advanceClock(POST_MS);
+  Host::HttpReply r;
+  r.body = "{\"result\":\"ok\"}";
+  return r;
+}
+
+// Run one boot until it goes to deep sleep; returns the timer wake-up in ms
+static uint32_t untilSleep(void (*boot)()) {
+  try {
+    boot();
+  } catch (const Host::DeepSleep &s) {
+    return (uint32_t)(s.wakeAfterUs / 1000);
+  }
+  TEST_FAIL_MESSAGE("boot returned instead of sleeping");
+  return 0;
+}
+
+static void timerWake() {
+  TEST_ASSERT_EQUAL_INT(ESP_SLEEP_WAKEUP_TIMER, esp_sleep_get_wakeup_cause());
+  DutyCycle::fastBootIfTimerWake();
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_full_boot_sleeps_after_the_awake_window() {
+  Host::freezeClock(true);
+  Host::restartClock();
+  Host::resetFs();
+  Host::clearNvs();
+  Host::attachI2c(0x36, &s_gauge);
+  Host::setHttpHandler(handle);
+
+  uint32_t wakeMs = untilSleep([] {
+    // Power-on: no fast path
+    DutyCycle::fastBootIfTimerWake();
+    DutyCycle::begin();
+    Host::advanceClock(AWAKE_WINDOW_MS);
+    Scheduler::runDue();
+  });
+  DutyCycle::Stats st = DutyCycle::stats();
+  TEST_ASSERT_EQUAL_UINT32(0, st.cycle);
+  TEST_ASSERT_EQUAL_UINT32(AWAKE_WINDOW_MS, st.awakeMs);
+  TEST_ASSERT_EQUAL_UINT32(AWAKE_WINDOW_MS, st.wifiMs);  // radio up all along
+  TEST_ASSERT_EQUAL_UINT32(PERIOD_MS - AWAKE_WINDOW_MS, st.sleepMs);
+  TEST_ASSERT_EQUAL_UINT32(PERIOD_MS - AWAKE_WINDOW_MS, wakeMs);
+  // (600 s * 110 mA + 300 s * 80 uA) / 900 s
+  TEST_ASSERT_EQUAL_UINT32(73360, st.microAmps);
+}
+
+void test_timer_wakes_buffer_readings_in_rtc_memory() {
+  for (uint8_t cycle = 1; cycle < 4; ++cycle) {
+    uint32_t wakeMs = untilSleep(timerWake);
+    DutyCycle::Stats st = DutyCycle::stats();
+    TEST_ASSERT_EQUAL_UINT32(cycle, st.cycle);
+    TEST_ASSERT_EQUAL_UINT8(cycle, st.buffered);  // one "bv" per wake
+    TEST_ASSERT_EQUAL_UINT32(0, st.awakeMs);
+    TEST_ASSERT_EQUAL_UINT32(0, st.wifiMs);
+    TEST_ASSERT_EQUAL_UINT32(PERIOD_MS, wakeMs);
+    // Asleep the whole period: the sleep current alone
+    TEST_ASSERT_EQUAL_UINT32(80, st.microAmps);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, Uploader::stats().posts);
+}
+
+void test_upload_wake_sends_the_buffer() {
+  Host::setWifiConnected(true);
+  Host::setWifiConnectMs(CONNECT_MS);
+  uint32_t wakeMs = untilSleep(timerWake);
+  DutyCycle::Stats st = DutyCycle::stats();
+  TEST_ASSERT_EQUAL_UINT32(4, st.cycle);
+  TEST_ASSERT_EQUAL_UINT8(0, st.buffered);
+  TEST_ASSERT_EQUAL_UINT32(4, Uploader::stats().sent);
+  TEST_ASSERT_EQUAL_UINT32(0, Uploader::stats().pending);
+  // Readings with the same key go in separate requests
+  TEST_ASSERT_EQUAL_UINT32(4, Uploader::stats().posts);
+  const uint32_t awake = CONNECT_MS + 4 * POST_MS;
+  TEST_ASSERT_EQUAL_UINT32(awake, st.awakeMs);
+  TEST_ASSERT_EQUAL_UINT32(awake, st.wifiMs);
+  TEST_ASSERT_EQUAL_UINT32(PERIOD_MS - awake, wakeMs);
+  // (3.5 s * 110 mA + 896.5 s * 80 uA) / 900 s
+  TEST_ASSERT_EQUAL_UINT32(507, st.microAmps);
+}
+
+void test_upload_wake_without_wifi_keeps_the_readings() {
+  Host::setWifiConnected(false);
+  for (uint8_t cycle = 5; cycle < 8; ++cycle) untilSleep(timerWake);
+  uint32_t wakeMs = untilSleep(timerWake);
+  DutyCycle::Stats st = DutyCycle::stats();
+  TEST_ASSERT_EQUAL_UINT32(8, st.cycle);
+  // Handed to the flash-backed queue before the connection attempt. (The
+  // host keeps one process across boots, so the uploader has also seen the
+  // sample-only wakes' readings directly; on the device it is not running.)
+  TEST_ASSERT_EQUAL_UINT8(0, st.buffered);
+  TEST_ASSERT_EQUAL_UINT32(4, Uploader::stats().sent);
+  TEST_ASSERT_GREATER_OR_EQUAL(4, Uploader::stats().pending);
+  // The whole 10 s connect timeout with the radio up
+  TEST_ASSERT_EQUAL_UINT32(10000, st.awakeMs);
+  TEST_ASSERT_EQUAL_UINT32(10000, st.wifiMs);
+  TEST_ASSERT_EQUAL_UINT32(PERIOD_MS - 10000, wakeMs);
+  // (10 s * 110 mA + 890 s * 80 uA) / 900 s
+  TEST_ASSERT_EQUAL_UINT32(1301, st.microAmps);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_full_boot_sleeps_after_the_awake_window);
+  RUN_TEST(test_timer_wakes_buffer_readings_in_rtc_memory);
+  RUN_TEST(test_upload_wake_sends_the_buffer);
+  RUN_TEST(test_upload_wake_without_wifi_keeps_the_readings);
+  return UNITY_END();
+}
@@ -0,0 +1,145 @@
+// Https pool against the HTTP stand-in: keep-alive reuse, TLS session
+// resumption after the server closes, redirects across hosts and the
+// cumulative counters under concurrent callers
+
+#include <Arduino.h>
+#include <string>
+#include <thread>
+#include <unity.h>
+#include <vector>
+
+#include "host.h"
+#include "https_client.h"
+
+static Host::HttpReply handle(const Host::HttpRequest &req) {
+  Host::HttpReply r;
+  delay(2);  // server time, so slots' last-use times differ
+  if (req.path == "/redirect") {
+    r.code = 302;
+    r.headers = {{"Location", "https://objects.example.com/asset"}};
+    return r;
+  }
+  r.body = "hello from " + req.host;
+  r.close = req.path == "/close";
+  return r;
+}
+
+// GET url and read the whole body; returns the status code
+static int fetch(const char *url, Https::Timing *timing = nullptr, std::string *body = nullptr) {
+  Https::Options opts;
+  Https::Response resp;
+  int code = Https::get(url, opts, resp);
+  if (code > 0) {
+    String s = resp.http().getString();
+    if (body) *body = s.c_str();
+  }
+  if (timing) *timing = resp.timing();
+  resp.end();
+  return code;
+}
+
+void setUp() {
+  Host::setHttpHandler(handle);
+  Host::resetHttpStats();
+  Host::resetTlsStats();
+}
+
+void tearDown() {}
+
+void test_keep_alive_reuses_the_connection() {
+  Https::Timing t;
+  std::string body;
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://a.example.com/x", &t, &body));
+  TEST_ASSERT_EQUAL_STRING("hello from a.example.com", body.c_str());
+  TEST_ASSERT_EQUAL_UINT8(1, t.handshakes);
+  TEST_ASSERT_EQUAL_UINT8(0, t.reused);
+
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://a.example.com/y", &t));
+  TEST_ASSERT_EQUAL_UINT8(0, t.handshakes);
+  TEST_ASSERT_EQUAL_UINT8(1, t.reused);
+  TEST_ASSERT_EQUAL_UINT32(1, Host::httpStats().connects);
+  TEST_ASSERT_EQUAL_UINT32(1, Host::tlsStats().fullHandshakes);
+}
+
+void test_reconnect_resumes_the_tls_session() {
+  Https::Timing t;
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://b.example.com/close", &t));
+  TEST_ASSERT_EQUAL_UINT8(1, t.handshakes);
+  TEST_ASSERT_EQUAL_UINT8(0, t.resumed);
+
+  // The server closed the socket; the next request reconnects and offers
+  // the cached session
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://b.example.com/close", &t));
+  TEST_ASSERT_EQUAL_UINT8(1, t.handshakes);
+  TEST_ASSERT_EQUAL_UINT8(1, t.resumed);
+  TEST_ASSERT_EQUAL_UINT32(1, Host::tlsStats().fullHandshakes);
+  TEST_ASSERT_EQUAL_UINT32(1, Host::tlsStats().resumedHandshakes);
+}
+
+void test_forgotten_session_falls_back_to_full_handshake() {
+  Https::Timing t;
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://c.example.com/close", &t));
+  Host::expireTlsSessions();
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://c.example.com/close", &t));
+  TEST_ASSERT_EQUAL_UINT8(1, t.handshakes);
+  TEST_ASSERT_EQUAL_UINT8(0, t.resumed);
+
+  // The new session is cached in turn
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://c.example.com/close", &t));
+  TEST_ASSERT_EQUAL_UINT8(1, t.resumed);
+  TEST_ASSERT_EQUAL_UINT32(2, Host::tlsStats().fullHandshakes);
+}
+
+void test_session_is_not_offered_to_another_host() {
+  Https::Timing t;
+  // Two slots: d and e take them, f evicts the least recently used (d)
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://d.example.com/close"));
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://e.example.com/close"));
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://f.example.com/close", &t));
+  TEST_ASSERT_EQUAL_UINT8(0, t.resumed);
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://e.example.com/close", &t));
+  TEST_ASSERT_EQUAL_UINT8(1, t.resumed);
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://d.example.com/close", &t));
+  TEST_ASSERT_EQUAL_UINT8(0, t.resumed);
+}
+
+void test_redirect_hops_get_their_own_connections() {
+  Https::Timing t;
+  std::string body;
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://api.example.com/redirect", &t, &body));
+  TEST_ASSERT_EQUAL_STRING("hello from objects.example.com", body.c_str());
+  TEST_ASSERT_EQUAL_UINT8(1, t.redirects);
+  TEST_ASSERT_EQUAL_UINT8(2, t.handshakes);
+
+  TEST_ASSERT_EQUAL_INT(200, fetch("https://api.example.com/redirect", &t));
+  TEST_ASSERT_EQUAL_UINT8(0, t.handshakes);
+  TEST_ASSERT_EQUAL_UINT8(2, t.reused);
+}
+
+void test_stats_add_up_across_tasks() {
+  const Https::Stats before = Https::stats();
+  const int threads = 2, perThread = 200;
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i) {
+    workers.emplace_back([i] {
+      const char *url = i ? "https://g.example.com/x" : "https://h.example.com/x";
+      for (int n = 0; n < perThread; ++n) fetch(url);
+    });
+  }
+  for (auto &w : workers) w.join();
+  const Https::Stats after = Https::stats();
+  TEST_ASSERT_EQUAL_UINT32(threads * perThread, after.requests - before.requests);
+  TEST_ASSERT_EQUAL_UINT32(threads * perThread,
+                           (after.handshakes - before.handshakes) + (after.reuses - before.reuses));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_keep_alive_reuses_the_connection);
+  RUN_TEST(test_reconnect_resumes_the_tls_session);
+  RUN_TEST(test_forgotten_session_falls_back_to_full_handshake);
+  RUN_TEST(test_session_is_not_offered_to_another_host);
+  RUN_TEST(test_redirect_hops_get_their_own_connections);
+  RUN_TEST(test_stats_add_up_across_tasks);
+  return UNITY_END();
+}
@@ -0,0 +1,299 @@
+// OtaDecode round trips: gzip and HSD1 delta images must rebuild the
+// target bit for bit however the download is split, and damaged input
+// must be refused
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <unity.h>
+#include <zlib.h>
+
+#include "host.h"
+#include "ota_decode.h"
+
+class CollectSink : public OtaDecode::ByteSink {
+public:
+  bool write(const uint8_t *data, size_t len) override {
+    out.append((const char *)data, len);
+    return true;
+  }
+  bool finish() override {
+    finished = true;
+    return true;
+  }
+  std::string out;
+  bool finished = false;
+};
+
+static std::string makeImage(size_t size, uint32_t seed) {
+  std::string img(size, '\0');
+  uint32_t x = seed;
+  for (size_t i = 0; i < size; ++i) {
+    x = x * 1103515245u + 12345u;
+    img[i] = (char)("HiveSync firmware "[(x >> 16) % 18] ^ ((i / 4096) & 3));
+  }
+  img[0] = (char)0xE9;
+  return img;
+}
+
+static std::string deflateRaw(const std::string &data) {
+  z_stream z = {};
+  deflateInit2(&z, 9, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  std::string out(deflateBound(&z, data.size()), '\0');
+  z.next_in = (Bytef *)data.data();
+  z.avail_in = (uInt)data.size();
+  z.next_out = (Bytef *)&out[0];
+  z.avail_out = (uInt)out.size();
+  deflate(&z, Z_FINISH);
+  out.resize(z.total_out);
+  deflateEnd(&z);
+  return out;
+}
+
+static void putLE32(std::string &out, uint32_t v) {
+  for (int i = 0; i < 4; ++i) out += (char)(v >> (8 * i));
+}
+
+static uint32_t crcOf(const std::string &data) {
+  return (uint32_t)crc32(0, (const Bytef *)data.data(), (uInt)data.size());
+}
+
+// gzip member; flags adds the optional header fields of RFC 1952
+static std::string gzip(const std::string &data, uint8_t flags = 0) {
+  std::string out = std::string("\x1f\x8b\x08", 3) + (char)flags + std::string(6, '\0');
+  if (flags & 0x04) out += std::string("\x06\x00" "HS\x02\x00" "ab", 8);
+  if (flags & 0x08) out += std::string("firmware.bin\0", 13);
+  if (flags & 0x10) out += std::string("built by CI\0", 12);
+  if (flags & 0x02) out += std::string("\x12\x34", 2);
+  out += deflateRaw(data);
+  putLE32(out, crcOf(data));
+  putLE32(out, (uint32_t)data.size());
+  return out;
+}
+
+// Greedy block-matching diff, same algorithm and output as make_delta() in
+// scripts/make_ota_artifacts.py
+static std::string makeDelta(const std::string &source, const std::string &target) {
+  const size_t BLOCK = 32, STRIDE = 16, MIN_COPY = 24;
+  std::map<std::string, size_t> index;
+  for (size_t pos = 0; pos + BLOCK <= source.size(); pos += STRIDE) index.insert({source.substr(pos, BLOCK), pos});
+
+  std::string ops;
+  size_t literalStart = 0, i = 0, n = target.size();
+  auto flushLiteral = [&](size_t end) {
+    if (end <= literalStart) return;
+    ops += (char)0x02;
+    putLE32(ops, (uint32_t)(end - literalStart));
+    ops += target.substr(literalStart, end - literalStart);
+  };
+  while (i + BLOCK <= n) {
+    auto it = index.find(target.substr(i, BLOCK));
+    if (it == index.end()) {
+      ++i;
+      continue;
+    }
+    size_t src = it->second, back = 0;
+    while (back < i - literalStart && src - back > 0 && source[src - back - 1] == target[i - back - 1]) ++back;
+    size_t length = BLOCK;
+    while (i + length < n && src + length < source.size() && source[src + length] == target[i + length]) ++length;
+    size_t start = i - back, srcStart = src - back;
+    length += back;
+    if (length < MIN_COPY) {
+      ++i;
+      continue;
+    }
+    flushLiteral(start);
+    ops += (char)0x01;
+    putLE32(ops, (uint32_t)srcStart);
+    putLE32(ops, (uint32_t)length);
+    i = start + length;
+    literalStart = i;
+  }
+  flushLiteral(n);
+  ops += (char)0x00;
+
+  std::string patch = "HSD1";
+  putLE32(patch, (uint32_t)source.size());
+  putLE32(patch, crcOf(source));
+  putLE32(patch, (uint32_t)target.size());
+  putLE32(patch, crcOf(target));
+  return patch + ops;
+}
+
+// The next release: some bytes changed, a block inserted, one removed
+static std::string nextRelease(const std::string &base) {
+  std::string t = base;
+  for (size_t i = 1000; i < t.size(); i += 7919) t[i] = (char)(t[i] + 1);
+  t.insert(base.size() / 3, makeImage(3000, 99).substr(1));
+  t.erase(base.size() * 2 / 3, 2500);
+  return t;
+}
+
+static bool feed(OtaDecode::ByteSink &dec, const std::string &data, size_t chunk) {
+  for (size_t off = 0; off < data.size(); off += chunk) {
+    size_t n = data.size() - off < chunk ? data.size() - off : chunk;
+    if (!dec.write((const uint8_t *)data.data() + off, n)) return false;
+  }
+  return dec.finish();
+}
+
+void setUp() {
+  Host::resetFlash();
+}
+
+void tearDown() {}
+
+void test_gzip_round_trip_any_split() {
+  const std::string image = makeImage(200 * 1024, 1);  // several dictionary wraps
+  const std::string gz = gzip(image);
+  const size_t chunks[] = {7, 1436, 4096, gz.size()};
+  for (size_t chunk : chunks) {
+    CollectSink sink;
+    OtaDecode::GzipDecoder dec;
+    TEST_ASSERT_TRUE(dec.begin(&sink));
+    TEST_ASSERT_TRUE_MESSAGE(feed(dec, gz, chunk), dec.error());
+    dec.end();
+    TEST_ASSERT_TRUE(sink.finished);
+    TEST_ASSERT_TRUE(sink.out == image);
+  }
+}
+
+void test_gzip_byte_by_byte() {
+  const std::string image = makeImage(40 * 1024, 2);
+  CollectSink sink;
+  OtaDecode::GzipDecoder dec;
+  TEST_ASSERT_TRUE(dec.begin(&sink));
+  TEST_ASSERT_TRUE_MESSAGE(feed(dec, gzip(image), 1), dec.error());
+  dec.end();
+  TEST_ASSERT_TRUE(sink.out == image);
+}
+
+void test_gzip_optional_header_fields() {
+  const std::string image = makeImage(10000, 3);
+  const uint8_t flags[] = {0x04, 0x08, 0x10, 0x02, 0x1E};
+  for (uint8_t f : flags) {
+    CollectSink sink;
+    OtaDecode::GzipDecoder dec;
+    TEST_ASSERT_TRUE(dec.begin(&sink));
+    TEST_ASSERT_TRUE_MESSAGE(feed(dec, gzip(image, f), 5), dec.error());
+    dec.end();
+    TEST_ASSERT_TRUE(sink.out == image);
+  }
+}
+
+static const char *gzipError(const std::string &gz) {
+  static std::string err;
+  CollectSink sink;
+  OtaDecode::GzipDecoder dec;
+  dec.begin(&sink);
+  bool ok = feed(dec, gz, 512);
+  err = ok ? "" : dec.error();
+  dec.end();
+  return err.c_str();
+}
+
+void test_gzip_damage_refused() {
+  const std::string image = makeImage(30000, 4);
+  const std::string gz = gzip(image);
+  TEST_ASSERT_EQUAL_STRING("Not a gzip image", gzipError("PK\x03\x04" + gz));
+  TEST_ASSERT_EQUAL_STRING("Inflate: truncated image", gzipError(gz.substr(0, gz.size() - 3)));
+  std::string badCrc = gz;
+  badCrc[gz.size() - 8] ^= 1;
+  TEST_ASSERT_EQUAL_STRING("Inflate: CRC mismatch", gzipError(badCrc));
+  std::string badSize = gz;
+  badSize[gz.size() - 1] ^= 1;
+  TEST_ASSERT_EQUAL_STRING("Inflate: size mismatch", gzipError(badSize));
+  TEST_ASSERT_EQUAL_STRING("Inflate: trailing data", gzipError(gz + "x"));
+  std::string corrupt = gz;
+  for (size_t i = 20; i < 60; ++i) corrupt[i] = (char)0xFF;
+  TEST_ASSERT_TRUE(strlen(gzipError(corrupt)) > 0);
+}
+
+void test_delta_round_trip_any_split() {
+  const std::string base = makeImage(160 * 1024, 5);
+  const std::string target = nextRelease(base);
+  const std::string patch = makeDelta(base, target);
+  TEST_ASSERT_LESS_THAN(target.size() / 4, patch.size());
+  Host::loadSlot(Host::runningSlot(), base);
+
+  const size_t chunks[] = {1, 3, 21, 1436, patch.size()};
+  for (size_t chunk : chunks) {
+    CollectSink sink;
+    OtaDecode::DeltaDecoder dec;
+    TEST_ASSERT_TRUE(dec.begin(&sink));
+    TEST_ASSERT_TRUE_MESSAGE(feed(dec, patch, chunk), dec.error());
+    dec.end();
+    TEST_ASSERT_TRUE(sink.finished);
+    TEST_ASSERT_TRUE(sink.out == target);
+  }
+}
+
+void test_gzip_delta_chain() {
+  const std::string base = makeImage(100 * 1024, 6);
+  const std::string target = nextRelease(base);
+  const std::string artifact = gzip(makeDelta(base, target));
+  Host::loadSlot(Host::runningSlot(), base);
+
+  CollectSink sink;
+  OtaDecode::DeltaDecoder delta;
+  OtaDecode::GzipDecoder gz;
+  TEST_ASSERT_TRUE(delta.begin(&sink));
+  TEST_ASSERT_TRUE(gz.begin(&delta));
+  TEST_ASSERT_TRUE_MESSAGE(feed(gz, artifact, 4096), gz.error());
+  gz.end();
+  delta.end();
+  TEST_ASSERT_TRUE(sink.finished);
+  TEST_ASSERT_TRUE(sink.out == target);
+}
+
+static const char *deltaError(const std::string &patch) {
+  static std::string err;
+  CollectSink sink;
+  OtaDecode::DeltaDecoder dec;
+  dec.begin(&sink);
+  bool ok = feed(dec, patch, 100);
+  err = ok ? "" : dec.error();
+  return err.c_str();
+}
+
+void test_delta_damage_refused() {
+  const std::string base = makeImage(50 * 1024, 7);
+  const std::string target = nextRelease(base);
+  const std::string patch = makeDelta(base, target);
+
+  // Patch made against another image than the running one
+  Host::loadSlot(Host::runningSlot(), makeImage(50 * 1024, 8));
+  TEST_ASSERT_EQUAL_STRING("Delta: base mismatch", deltaError(patch));
+
+  Host::loadSlot(Host::runningSlot(), base);
+  TEST_ASSERT_EQUAL_STRING("Not a delta image", deltaError("HSD2" + patch.substr(4)));
+  TEST_ASSERT_EQUAL_STRING("Delta: truncated patch", deltaError(patch.substr(0, patch.size() - 1)));
+  TEST_ASSERT_EQUAL_STRING("Delta: trailing data", deltaError(patch + '\0'));
+
+  std::string header = patch.substr(0, 20);
+  TEST_ASSERT_EQUAL_STRING("Delta: bad opcode", deltaError(header + '\x07'));
+  std::string copy = header + '\x01';
+  putLE32(copy, (uint32_t)base.size() - 10);
+  putLE32(copy, 11);
+  TEST_ASSERT_EQUAL_STRING("Delta: copy out of range", deltaError(copy));
+
+  // Target size in the header smaller than what the ops produce
+  std::string shortTarget = patch;
+  shortTarget[12] = (char)(shortTarget[12] - 1);
+  TEST_ASSERT_EQUAL_STRING("Delta: output overrun", deltaError(shortTarget));
+  std::string badCrc = patch;
+  badCrc[16] ^= 1;
+  TEST_ASSERT_EQUAL_STRING("Delta: CRC mismatch", deltaError(badCrc));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_gzip_round_trip_any_split);
+  RUN_TEST(test_gzip_byte_by_byte);
+  RUN_TEST(test_gzip_optional_header_fields);
+  RUN_TEST(test_gzip_damage_refused);
+  RUN_TEST(test_delta_round_trip_any_split);
+  RUN_TEST(test_gzip_delta_chain);
+  RUN_TEST(test_delta_damage_refused);
+  return UNITY_END();
+}
@@ -0,0 +1,378 @@
+// OtaEngine end to end: HTTP stand-in -> reader/writer tasks -> decoders ->
+// file-backed OTA slot, for raw and gzip images, the ways a download can
+// fail and the Range request that resumes a raw one
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <unity.h>
+#include <vector>
+#include <zlib.h>
+
+#include "host.h"
+#include "ota_engine.h"
+
+static const char *const URL = "https://github.com/dodichri/HiveSync-32/releases/download/v0.4.0/firmware.bin";
+
+// App image stand-in: magic byte, then text-like data that compresses
+static std::string makeImage(size_t size, uint32_t seed) {
+  std::string img(size, '\0');
+  uint32_t x = seed;
+  for (size_t i = 0; i < size; ++i) {
+    x = x * 1103515245u + 12345u;
+    img[i] = (char)("HiveSync firmware "[(x >> 16) % 18] ^ ((i / 4096) & 3));
+  }
+  img[0] = (char)0xE9;
+  return img;
+}
+
+static std::string gzip(const std::string &data) {
+  z_stream z = {};
+  deflateInit2(&z, 9, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  std::string out(deflateBound(&z, data.size()), '\0');
+  z.next_in = (Bytef *)data.data();
+  z.avail_in = (uInt)data.size();
+  z.next_out = (Bytef *)&out[0];
+  z.avail_out = (uInt)out.size();
+  deflate(&z, Z_FINISH);
+  out.resize(z.total_out);
+  deflateEnd(&z);
+  return out;
+}
+
+static Host::HttpReply ok(const std::string &body, const std::string &etag = "\"v040\"") {
+  Host::HttpReply r;
+  r.headers = {{"Content-Length", std::to_string(body.size())}, {"ETag", etag}};
+  r.body = body;
+  r.segment = 1436;
+  return r;
+}
+
+// Release CDN stand-in: a Range request whose If-Range still names the
+// current ETag gets the rest of the image as 206 with Content-Range, any
+// other request the whole image. Range headers seen are kept in ranges.
+struct Cdn {
+  std::string image;
+  std::string etag = "\"v040\"";
+  size_t dropAfter = std::string::npos;
+  std::vector<std::string> ranges;
+  std::vector<std::string> ifRanges;
+
+  Host::HttpReply serve(const Host::HttpRequest &req) {
+    const char *range = Host::findHeader(req.headers, "Range");
+    const char *ifRange = Host::findHeader(req.headers, "If-Range");
+    ranges.push_back(range ? range : "");
+    ifRanges.push_back(ifRange ? ifRange : "");
+    Host::HttpReply r = ok(image, etag);
+    unsigned long first;
+    if (range && ifRange && etag == ifRange && sscanf(range, "bytes=%lu-", &first) == 1) {
+      if (first >= image.size()) {
+        r.code = 416;
+        r.headers = {{"Content-Range", "bytes */" + std::to_string(image.size())}};
+        r.body.clear();
+        return r;
+      }
+      r = ok(image.substr(first), etag);
+      r.code = 206;
+      r.headers.push_back({"Content-Range", "bytes " + std::to_string(first) + "-" +
+                                                std::to_string(image.size() - 1) + "/" +
+                                                std::to_string(image.size())});
+    }
+    r.dropAfter = dropAfter;
+    return r;
+  }
+};
+
+static Cdn s_cdn;
+
+static void serveCdn() {
+  Host::setHttpHandler([](const Host::HttpRequest &req) { return s_cdn.serve(req); });
+}
+
+// Byte offset asked for by a "bytes=N-" Range header
+static uint32_t rangeStart(const std::string &range) {
+  unsigned long first = 0;
+  TEST_ASSERT_EQUAL_INT(1, sscanf(range.c_str(), "bytes=%lu-", &first));
+  return (uint32_t)first;
+}
+
+struct Result {
+  bool started;
+  bool finished;
+  uint32_t progressEvents;
+  bool progressMonotonic;
+  OtaEngine::Event last;
+};
+
+// Start an update and collect its events until it ends
+static Result run(OtaEngine::ImageFormat fmt) {
+  Result res = {false, false, 0, true, {}};
+  TEST_ASSERT_TRUE(OtaEngine::start(URL, fmt));
+  uint32_t lastDone = 0;
+  uint32_t t0 = millis();
+  for (;;) {
+    OtaEngine::Event ev;
+    if (!OtaEngine::pollEvent(ev)) {
+      TEST_ASSERT_LESS_THAN(20000u, millis() - t0);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    if (ev.type == OtaEngine::EventType::Started) res.started = true;
+    if (ev.type == OtaEngine::EventType::Progress) {
+      res.progressEvents++;
+      if (ev.done < lastDone) res.progressMonotonic = false;
+      lastDone = ev.done;
+    }
+    if (ev.type == OtaEngine::EventType::Finished || ev.type == OtaEngine::EventType::Failed) {
+      res.finished = ev.type == OtaEngine::EventType::Finished;
+      res.last = ev;
+      break;
+    }
+  }
+  while (OtaEngine::busy()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return res;
+}
+
+void setUp() {
+  s_cdn = Cdn();
+  Host::resetFlash();
+  Host::clearNvs();
+  Host::resetHttpStats();
+}
+
+void tearDown() {
+  Host::setHttpHandler(nullptr);
+}
+
+void test_raw_image_through_redirect() {
+  const std::string image = makeImage(300 * 1024 + 123, 1);
+  Host::setHttpHandler([&](const Host::HttpRequest &req) {
+    if (req.host == "github.com") {
+      Host::HttpReply r;
+      r.code = 302;
+      r.headers = {{"Location", "https://objects.githubusercontent.com/asset/firmware.bin"}};
+      return r;
+    }
+    return ok(image);
+  });
+  Result res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_TRUE(res.started);
+  TEST_ASSERT_TRUE_MESSAGE(res.finished, res.last.message);
+  TEST_ASSERT_EQUAL_UINT32(image.size(), res.last.total);
+  TEST_ASSERT_EQUAL_UINT32(image.size(), res.last.done);
+  TEST_ASSERT_EQUAL_UINT32(0, res.last.resumedFrom);
+  TEST_ASSERT_TRUE(res.progressMonotonic);
+  TEST_ASSERT_GREATER_THAN(10u, res.progressEvents);
+  TEST_ASSERT_TRUE(res.last.peakFilled >= 1 && res.last.peakFilled <= 8);
+  TEST_ASSERT_EQUAL_UINT8(1, Host::bootSlot());
+  TEST_ASSERT_TRUE(Host::readSlot(1, 0, image.size()) == image);
+  // Every sector erased exactly once
+  TEST_ASSERT_EQUAL_UINT32((image.size() + 4095) / 4096, Host::flashStats().sectorErases);
+}
+
+void test_gzip_image() {
+  const std::string image = makeImage(256 * 1024, 2);
+  const std::string gz = gzip(image);
+  TEST_ASSERT_LESS_THAN(image.size(), gz.size());
+  Host::setHttpHandler([&](const Host::HttpRequest &) { return ok(gz); });
+  Result res = run(OtaEngine::ImageFormat::Gzip);
+  TEST_ASSERT_TRUE_MESSAGE(res.finished, res.last.message);
+  // Progress counts downloaded (compressed) bytes
+  TEST_ASSERT_EQUAL_UINT32(gz.size(), res.last.done);
+  TEST_ASSERT_EQUAL_UINT8(1, Host::bootSlot());
+  TEST_ASSERT_TRUE(Host::readSlot(1, 0, image.size()) == image);
+}
+
+void test_http_error() {
+  Host::setHttpHandler([](const Host::HttpRequest &) {
+    Host::HttpReply r;
+    r.code = 404;
+    r.body = "Not Found";
+    return r;
+  });
+  Result res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_FALSE(res.started);
+  TEST_ASSERT_FALSE(res.finished);
+  TEST_ASSERT_EQUAL_STRING("HTTP 404", res.last.message);
+  TEST_ASSERT_EQUAL_UINT8(0, Host::bootSlot());
+}
+
+void test_connection_lost() {
+  const std::string image = makeImage(200 * 1024, 3);
+  Host::setHttpHandler([&](const Host::HttpRequest &) {
+    Host::HttpReply r = ok(image);
+    r.dropAfter = 70000;
+    return r;
+  });
+  Result res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_TRUE(res.started);
+  TEST_ASSERT_FALSE(res.finished);
+  TEST_ASSERT_EQUAL_STRING("Download interrupted", res.last.message);
+  TEST_ASSERT_LESS_OR_EQUAL(70000u, res.last.done);
+  TEST_ASSERT_EQUAL_UINT8(0, Host::bootSlot());
+}
+
+void test_corrupt_gzip() {
+  const std::string image = makeImage(128 * 1024, 4);
+  std::string gz = gzip(image);
+  gz[gz.size() - 6] ^= 0x55;  // CRC32 in the trailer
+  Host::setHttpHandler([&](const Host::HttpRequest &) { return ok(gz); });
+  Result res = run(OtaEngine::ImageFormat::Gzip);
+  TEST_ASSERT_FALSE(res.finished);
+  TEST_ASSERT_EQUAL_STRING("Inflate: CRC mismatch", res.last.message);
+  TEST_ASSERT_EQUAL_UINT8(0, Host::bootSlot());
+}
+
+void test_raw_image_failing_verification() {
+  std::string image = makeImage(64 * 1024, 5);
+  image[0] = 0;
+  Host::setHttpHandler([&](const Host::HttpRequest &) { return ok(image); });
+  Result res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_FALSE(res.finished);
+  TEST_ASSERT_EQUAL_STRING("Image verification failed", res.last.message);
+  TEST_ASSERT_EQUAL_UINT8(0, Host::bootSlot());
+}
+
+void test_busy_rejects_second_start() {
+  const std::string image = makeImage(512 * 1024, 6);
+  Host::setHttpHandler([&](const Host::HttpRequest &) {
+    Host::HttpReply r = ok(image);
+    r.segment = 256;  // slow enough to still be running below
+    return r;
+  });
+  TEST_ASSERT_TRUE(OtaEngine::start(URL, OtaEngine::ImageFormat::Raw));
+  TEST_ASSERT_TRUE(OtaEngine::busy());
+  TEST_ASSERT_FALSE(OtaEngine::start(URL, OtaEngine::ImageFormat::Raw));
+  OtaEngine::Event ev;
+  do {
+    while (!OtaEngine::pollEvent(ev)) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  } while (ev.type != OtaEngine::EventType::Finished && ev.type != OtaEngine::EventType::Failed);
+  TEST_ASSERT_TRUE_MESSAGE(ev.type == OtaEngine::EventType::Finished, ev.message);
+  while (OtaEngine::busy()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void test_resume_after_connection_lost() {
+  s_cdn.image = makeImage(300 * 1024 + 123, 7);
+  s_cdn.dropAfter = 150000;
+  serveCdn();
+  Result res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_FALSE(res.finished);
+  TEST_ASSERT_EQUAL_STRING("Download interrupted", res.last.message);
+  TEST_ASSERT_EQUAL_STRING("", s_cdn.ranges[0].c_str());
+
+  s_cdn.dropAfter = std::string::npos;
+  Host::resetHttpStats();
+  uint32_t erasesBefore = Host::flashStats().sectorErases;
+  res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_TRUE_MESSAGE(res.finished, res.last.message);
+  TEST_ASSERT_EQUAL_size_t(2, s_cdn.ranges.size());
+  // Resumed at the last sector committed before the drop
+  uint32_t from = rangeStart(s_cdn.ranges[1]);
+  TEST_ASSERT_EQUAL_UINT32(0, from % 4096);
+  TEST_ASSERT_TRUE(from >= 65536 && from <= 150000);
+  TEST_ASSERT_EQUAL_STRING("\"v040\"", s_cdn.ifRanges[1].c_str());
+  TEST_ASSERT_EQUAL_UINT32(from, res.last.resumedFrom);
+  TEST_ASSERT_EQUAL_UINT32(s_cdn.image.size(), res.last.done);
+  TEST_ASSERT_EQUAL_UINT32(s_cdn.image.size(), res.last.total);
+  // Only the rest is downloaded and erased again
+  TEST_ASSERT_EQUAL_UINT64(s_cdn.image.size() - from, Host::httpStats().bodyBytes);
+  TEST_ASSERT_EQUAL_UINT32((s_cdn.image.size() + 4095) / 4096 - from / 4096,
+                           Host::flashStats().sectorErases - erasesBefore);
+  TEST_ASSERT_EQUAL_UINT8(1, Host::bootSlot());
+  TEST_ASSERT_TRUE(Host::readSlot(1, 0, s_cdn.image.size()) == s_cdn.image);
+
+  // Finished: nothing left to resume
+  s_cdn.ranges.clear();
+  Host::resetFlash();
+  res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_TRUE_MESSAGE(res.finished, res.last.message);
+  TEST_ASSERT_EQUAL_STRING("", s_cdn.ranges[0].c_str());
+}
+
+void test_changed_asset_starts_over() {
+  s_cdn.image = makeImage(200 * 1024, 8);
+  s_cdn.dropAfter = 120000;
+  serveCdn();
+  Result res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_FALSE(res.finished);
+
+  // Re-uploaded under the same name: If-Range no longer matches
+  s_cdn.image = makeImage(210 * 1024, 9);
+  s_cdn.etag = "\"v040-rebuilt\"";
+  s_cdn.dropAfter = std::string::npos;
+  res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_TRUE_MESSAGE(res.finished, res.last.message);
+  TEST_ASSERT_TRUE(rangeStart(s_cdn.ranges[1]) > 0);
+  TEST_ASSERT_EQUAL_STRING("\"v040\"", s_cdn.ifRanges[1].c_str());
+  TEST_ASSERT_EQUAL_UINT32(0, res.last.resumedFrom);
+  TEST_ASSERT_EQUAL_UINT32(s_cdn.image.size(), res.last.done);
+  TEST_ASSERT_TRUE(Host::readSlot(1, 0, s_cdn.image.size()) == s_cdn.image);
+}
+
+void test_bad_content_range_clears_checkpoint() {
+  const std::string image = makeImage(200 * 1024, 10);
+  uint32_t requests = 0;
+  Host::setHttpHandler([&](const Host::HttpRequest &req) {
+    requests++;
+    Host::HttpReply r = ok(image);
+    if (requests == 1) r.dropAfter = 100000;
+    if (requests == 2) {
+      TEST_ASSERT_NOT_NULL(Host::findHeader(req.headers, "Range"));
+      // A range other than the one asked for
+      r.code = 206;
+      r.headers.push_back({"Content-Range", "bytes 0-" + std::to_string(image.size() - 1) + "/" +
+                                                std::to_string(image.size())});
+    }
+    if (requests == 3) TEST_ASSERT_NULL(Host::findHeader(req.headers, "Range"));
+    return r;
+  });
+  TEST_ASSERT_FALSE(run(OtaEngine::ImageFormat::Raw).finished);
+  Result res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_FALSE(res.finished);
+  TEST_ASSERT_EQUAL_STRING("Bad Content-Range", res.last.message);
+  res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_TRUE_MESSAGE(res.finished, res.last.message);
+  TEST_ASSERT_EQUAL_UINT32(3, requests);
+  TEST_ASSERT_TRUE(Host::readSlot(1, 0, image.size()) == image);
+}
+
+void test_compressed_download_voids_raw_checkpoint() {
+  // A raw attempt leaves a checkpoint for slot 1; a gzip attempt of the
+  // same URL then rewrites the slot through Update and is cut off too
+  s_cdn.image = makeImage(256 * 1024, 11);
+  s_cdn.dropAfter = 150000;
+  serveCdn();
+  TEST_ASSERT_FALSE(run(OtaEngine::ImageFormat::Raw).finished);
+  const std::string raw = s_cdn.image;
+  s_cdn.image = gzip(makeImage(256 * 1024, 12));
+  s_cdn.dropAfter = s_cdn.image.size() / 2;
+  Result res = run(OtaEngine::ImageFormat::Gzip);
+  TEST_ASSERT_FALSE(res.finished);
+  TEST_ASSERT_EQUAL_UINT32(0, res.last.resumedFrom);
+
+  // The raw retry must not resume on top of what the gzip attempt flashed
+  s_cdn.image = raw;
+  s_cdn.dropAfter = std::string::npos;
+  res = run(OtaEngine::ImageFormat::Raw);
+  TEST_ASSERT_TRUE_MESSAGE(res.finished, res.last.message);
+  TEST_ASSERT_EQUAL_STRING("", s_cdn.ranges[2].c_str());
+  TEST_ASSERT_EQUAL_UINT32(0, res.last.resumedFrom);
+  TEST_ASSERT_TRUE(Host::readSlot(1, 0, raw.size()) == raw);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_raw_image_through_redirect);
+  RUN_TEST(test_gzip_image);
+  RUN_TEST(test_http_error);
+  RUN_TEST(test_connection_lost);
+  RUN_TEST(test_corrupt_gzip);
+  RUN_TEST(test_raw_image_failing_verification);
+  RUN_TEST(test_busy_rejects_second_start);
+  RUN_TEST(test_resume_after_connection_lost);
+  RUN_TEST(test_changed_asset_starts_over);
+  RUN_TEST(test_bad_content_range_clears_checkpoint);
+  RUN_TEST(test_compressed_download_voids_raw_checkpoint);
+  return UNITY_END();
+}
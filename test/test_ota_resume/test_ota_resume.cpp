@@ -0,0 +1,115 @@
+// OtaResume: when a stored checkpoint may be resumed, Content-Range
+// parsing, and the sector-aligned commit point
+
+#include <string.h>
+#include <unity.h>
+
+#include "ota_resume.h"
+
+static const char *const URL = "https://github.com/dodichri/HiveSync-32/releases/download/v0.4.0/firmware.bin";
+static const uint32_t SLOT = 0x110000;
+
+static OtaResume::Checkpoint s_cp;
+
+void setUp() {
+  memset(&s_cp, 0, sizeof(s_cp));
+  strcpy(s_cp.url, URL);
+  strcpy(s_cp.etag, "\"0x8DC4A1F2B7E3C10\"");
+  s_cp.slot = SLOT;
+  s_cp.size = 1234567;
+  s_cp.offset = 65536;
+}
+
+void tearDown() {}
+
+void test_resume_matching_checkpoint() {
+  TEST_ASSERT_EQUAL_UINT32(65536, OtaResume::resumeFrom(s_cp, URL, SLOT));
+  s_cp.offset = s_cp.size - 1;
+  TEST_ASSERT_EQUAL_UINT32(s_cp.size - 1, OtaResume::resumeFrom(s_cp, URL, SLOT));
+}
+
+void test_start_over_without_validator() {
+  // Without an ETag If-Range cannot guard the range
+  s_cp.etag[0] = '\0';
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::resumeFrom(s_cp, URL, SLOT));
+}
+
+void test_start_over_for_another_asset_or_slot() {
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::resumeFrom(s_cp, "https://github.com/dodichri/HiveSync-32/releases/download/v0.4.1/firmware.bin", SLOT));
+  // A prefix of the stored URL is another URL
+  char shorter[OtaResume::URL_MAX];
+  strcpy(shorter, URL);
+  shorter[strlen(shorter) - 1] = '\0';
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::resumeFrom(s_cp, shorter, SLOT));
+  // The other slot booted in between: the prefix is in the wrong place
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::resumeFrom(s_cp, URL, 0x10000));
+}
+
+void test_start_over_outside_the_image() {
+  s_cp.offset = 0;
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::resumeFrom(s_cp, URL, SLOT));
+  // Complete, or beyond a shrunk size: nothing left to ask for
+  s_cp.offset = s_cp.size;
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::resumeFrom(s_cp, URL, SLOT));
+  s_cp.offset = s_cp.size + 4096;
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::resumeFrom(s_cp, URL, SLOT));
+  // Empty NVS reads back as all zeros
+  memset(&s_cp, 0, sizeof(s_cp));
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::resumeFrom(s_cp, "", 0));
+}
+
+void test_parse_content_range() {
+  uint32_t first = 1, last = 1, total = 1;
+  TEST_ASSERT_TRUE(OtaResume::parseContentRange("bytes 65536-1234566/1234567", first, last, total));
+  TEST_ASSERT_EQUAL_UINT32(65536, first);
+  TEST_ASSERT_EQUAL_UINT32(1234566, last);
+  TEST_ASSERT_EQUAL_UINT32(1234567, total);
+  TEST_ASSERT_TRUE(OtaResume::parseContentRange("bytes  0-0/1", first, last, total));
+  TEST_ASSERT_EQUAL_UINT32(0, first);
+  TEST_ASSERT_EQUAL_UINT32(0, last);
+  TEST_ASSERT_EQUAL_UINT32(1, total);
+  TEST_ASSERT_TRUE(OtaResume::parseContentRange("bytes 4294967293-4294967294/4294967295", first, last, total));
+  TEST_ASSERT_EQUAL_UINT32(4294967295u, total);
+}
+
+void test_reject_malformed_content_range() {
+  uint32_t first, last, total;
+  const char *const bad[] = {
+    "",
+    "bytes",
+    "bytes=0-1/2",            // request syntax, not the response's
+    "Bytes 0-1/2",
+    "bytes 0-1/*",            // total unknown
+    "bytes */1234567",        // unsatisfied-range form of a 416
+    "bytes 0-1",
+    "bytes -1/2",
+    "bytes 0-/2",
+    "bytes 5-4/10",           // first after last
+    "bytes 0-10/10",          // last outside the image
+    "bytes 0-1/2 ",
+    "bytes 0-1/2x",
+    "bytes 0-1/4294967296",   // overflow
+    "bytes 0 - 1/2",
+  };
+  for (const char *value : bad) TEST_ASSERT_FALSE_MESSAGE(OtaResume::parseContentRange(value, first, last, total), value);
+  TEST_ASSERT_FALSE(OtaResume::parseContentRange(nullptr, first, last, total));
+}
+
+void test_committable_rounds_down_to_a_sector() {
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::committable(0, 4096));
+  TEST_ASSERT_EQUAL_UINT32(0, OtaResume::committable(4095, 4096));
+  TEST_ASSERT_EQUAL_UINT32(4096, OtaResume::committable(4096, 4096));
+  TEST_ASSERT_EQUAL_UINT32(65536, OtaResume::committable(65536 + 1436, 4096));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_resume_matching_checkpoint);
+  RUN_TEST(test_start_over_without_validator);
+  RUN_TEST(test_start_over_for_another_asset_or_slot);
+  RUN_TEST(test_start_over_outside_the_image);
+  RUN_TEST(test_parse_content_range);
+  RUN_TEST(test_reject_malformed_content_range);
+  RUN_TEST(test_committable_rounds_down_to_a_sector);
+  return UNITY_END();
+}
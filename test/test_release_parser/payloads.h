@@ -0,0 +1,84 @@
+// GitHub "latest release" responses, trimmed to the fields that matter
+// for parsing (nesting, key order, escapes) but otherwise as the API
+// returns them
+#pragma once
+
+// Full release: uploader objects carry their own "name"-like keys, assets
+// come in upload order with the raw image last, body after the assets
+static const char RELEASE_FULL[] = R"({
+  "url": "https://api.github.com/repos/dodichri/HiveSync-32/releases/154000000",
+  "assets_url": "https://api.github.com/repos/dodichri/HiveSync-32/releases/154000000/assets",
+  "html_url": "https://github.com/dodichri/HiveSync-32/releases/tag/v0.4.0",
+  "id": 154000000,
+  "author": {
+    "login": "dodichri",
+    "id": 1234567,
+    "type": "User",
+    "site_admin": false
+  },
+  "node_id": "RE_kwDOLabcde4JLx1A",
+  "tag_name": "v0.4.0",
+  "target_commitish": "main",
+  "name": "HiveSync 0.4.0",
+  "draft": false,
+  "prerelease": false,
+  "created_at": "2024-05-01T09:58:00Z",
+  "published_at": "2024-05-01T10:01:00Z",
+  "assets": [
+    {
+      "url": "https://api.github.com/repos/dodichri/HiveSync-32/releases/assets/170000000",
+      "id": 170000000,
+      "name": "firmware.elf",
+      "label": null,
+      "uploader": {
+        "login": "github-actions[bot]",
+        "name": "firmware.bin",
+        "type": "Bot"
+      },
+      "content_type": "application/octet-stream",
+      "state": "uploaded",
+      "size": 4512336,
+      "download_count": 3,
+      "browser_download_url": "https://github.com/dodichri/HiveSync-32/releases/download/v0.4.0/firmware.elf"
+    },
+    {
+      "url": "https://api.github.com/repos/dodichri/HiveSync-32/releases/assets/170000001",
+      "id": 170000001,
+      "browser_download_url": "https://github.com/dodichri/HiveSync-32/releases/download/v0.4.0/firmware.bin.gz",
+      "name": "firmware.bin.gz",
+      "label": "",
+      "size": 611204,
+      "download_count": 41
+    },
+    {
+      "url": "https://api.github.com/repos/dodichri/HiveSync-32/releases/assets/170000002",
+      "id": 170000002,
+      "name": "firmware.bin",
+      "label": "",
+      "size": 1004816,
+      "download_count": 17,
+      "browser_download_url": "https://github.com/dodichri/HiveSync-32/releases/download/v0.4.0/firmware.bin"
+    }
+  ],
+  "tarball_url": "https://api.github.com/repos/dodichri/HiveSync-32/tarball/v0.4.0",
+  "zipball_url": "https://api.github.com/repos/dodichri/HiveSync-32/zipball/v0.4.0",
+  "body": "## Changes\r\n* Scale: \"tare\" survives reboots {see #12}\r\n* [assets] list – unchanged\r\n"
+})";
+
+// Escaped slashes and \u escapes in names and URLs (GitHub may emit either
+// form), and an asset whose name only starts like the wanted one
+static const char RELEASE_ESCAPED[] = R"({"tag_name":"v1.2.3-rc.1","prerelease":true,"assets":[)"
+    R"({"name":"firmware.bin.sha256","browser_download_url":"https:\/\/github.com\/x\/firmware.bin.sha256"},)"
+    R"({"name":"firmware.bin","browser_download_url":"https:\/\/github.com\/x\/v1.2.3-rc.1\/firmware.bin"}]})";
+
+// Release without uploaded assets
+static const char RELEASE_NO_ASSETS[] = R"({"tag_name":"v0.5.0","name":"Tag only","assets":[],"body":""})";
+
+// Error bodies (404 for a repo without releases, 403 when rate limited)
+static const char RELEASE_NOT_FOUND[] = R"({
+  "message": "Not Found",
+  "documentation_url": "https://docs.github.com/rest/releases/releases#get-the-latest-release",
+  "status": "404"
+})";
+
+static const char RELEASE_RATE_LIMITED[] = R"json({"message":"API rate limit exceeded for 203.0.113.7. (But here's the good news: Authenticated requests get a higher rate limit.)","documentation_url":"https://docs.github.com/rest/overview/resources-in-the-rest-api#rate-limiting"})json";
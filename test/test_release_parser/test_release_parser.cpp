@@ -0,0 +1,173 @@
+// ReleaseParser against GitHub release payloads fed in every split the
+// network might produce
+
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+#include "release_parser.h"
+#include "payloads.h"
+
+static const char *const PREFERRED[] = {"firmware-from-0.3.0.hsd.gz", "firmware.bin.gz", "firmware.bin"};
+
+static void feedIn(ReleaseParser &p, const char *doc, size_t chunk) {
+  size_t len = strlen(doc);
+  for (size_t off = 0; off < len; off += chunk) {
+    size_t n = len - off < chunk ? len - off : chunk;
+    p.feed((const uint8_t *)doc + off, n);
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_full_release_any_split() {
+  const size_t chunks[] = {1, 2, 3, 7, 64, 1436, 100000};
+  for (size_t chunk : chunks) {
+    ReleaseParser p("firmware.bin");
+    feedIn(p, RELEASE_FULL, chunk);
+    TEST_ASSERT_FALSE(p.failed());
+    TEST_ASSERT_EQUAL_STRING("v0.4.0", p.tagName());
+    TEST_ASSERT_EQUAL_STRING("https://github.com/dodichri/HiveSync-32/releases/download/v0.4.0/firmware.bin",
+                             p.assetUrl());
+    TEST_ASSERT_EQUAL_INT(0, p.assetIndex());
+    TEST_ASSERT_TRUE(p.complete());
+  }
+}
+
+void test_uploader_name_is_not_an_asset_name() {
+  // The first asset's uploader has "name":"firmware.bin"; only the third
+  // asset may match
+  ReleaseParser p("firmware.bin");
+  feedIn(p, RELEASE_FULL, 5);
+  TEST_ASSERT_TRUE(strstr(p.assetUrl(), "/firmware.bin") != nullptr);
+  TEST_ASSERT_TRUE(strstr(p.assetUrl(), ".elf") == nullptr);
+}
+
+void test_url_before_name_in_asset() {
+  ReleaseParser p("firmware.bin.gz");
+  feedIn(p, RELEASE_FULL, 11);
+  TEST_ASSERT_EQUAL_STRING("https://github.com/dodichri/HiveSync-32/releases/download/v0.4.0/firmware.bin.gz",
+                           p.assetUrl());
+}
+
+void test_preference_order() {
+  ReleaseParser p(PREFERRED, 3);
+  feedIn(p, RELEASE_FULL, 13);
+  // No delta asset: gzip beats raw although raw comes later
+  TEST_ASSERT_EQUAL_INT(1, p.assetIndex());
+  TEST_ASSERT_TRUE(strstr(p.assetUrl(), "firmware.bin.gz") != nullptr);
+  // A better candidate could still follow until the asset list ends
+  TEST_ASSERT_TRUE(p.complete());
+}
+
+void test_complete_stops_early_on_first_choice() {
+  ReleaseParser p(PREFERRED + 2, 1);
+  size_t len = strlen(RELEASE_FULL), consumed = 0;
+  while (consumed < len && !p.complete()) p.feed(RELEASE_FULL[consumed++]);
+  TEST_ASSERT_TRUE(p.complete());
+  // Everything after the raw asset's last field is skipped
+  TEST_ASSERT_LESS_THAN(len, consumed);
+  TEST_ASSERT_TRUE(consumed > (size_t)(strstr(RELEASE_FULL, "download/v0.4.0/firmware.bin\"") - RELEASE_FULL));
+}
+
+void test_not_complete_before_assets_end() {
+  ReleaseParser p(PREFERRED, 3);
+  std::string doc(RELEASE_FULL);
+  size_t cut = doc.find("\"id\": 170000002");
+  feedIn(p, doc.substr(0, cut).c_str(), 9);
+  // gz seen, but the delta could still come
+  TEST_ASSERT_EQUAL_INT(1, p.assetIndex());
+  TEST_ASSERT_FALSE(p.complete());
+}
+
+void test_escapes_decoded() {
+  const size_t chunks[] = {1, 4, 1000};
+  for (size_t chunk : chunks) {
+    ReleaseParser p("firmware.bin");
+    feedIn(p, RELEASE_ESCAPED, chunk);
+    TEST_ASSERT_FALSE(p.failed());
+    TEST_ASSERT_EQUAL_STRING("v1.2.3-rc.1", p.tagName());
+    TEST_ASSERT_EQUAL_STRING("https://github.com/x/v1.2.3-rc.1/firmware.bin", p.assetUrl());
+  }
+}
+
+void test_no_assets() {
+  ReleaseParser p(PREFERRED, 3);
+  feedIn(p, RELEASE_NO_ASSETS, 3);
+  TEST_ASSERT_EQUAL_STRING("v0.5.0", p.tagName());
+  TEST_ASSERT_EQUAL_STRING("", p.assetUrl());
+  TEST_ASSERT_EQUAL_INT(-1, p.assetIndex());
+  TEST_ASSERT_TRUE(p.complete());
+}
+
+void test_error_bodies() {
+  const char *const docs[] = {RELEASE_NOT_FOUND, RELEASE_RATE_LIMITED};
+  for (const char *doc : docs) {
+    ReleaseParser p("firmware.bin");
+    feedIn(p, doc, 17);
+    TEST_ASSERT_FALSE(p.failed());
+    TEST_ASSERT_EQUAL_STRING("", p.tagName());
+    TEST_ASSERT_EQUAL_STRING("", p.assetUrl());
+    TEST_ASSERT_FALSE(p.complete());
+  }
+}
+
+void test_truncated_body() {
+  ReleaseParser p("firmware.bin");
+  std::string doc(RELEASE_FULL);
+  feedIn(p, doc.substr(0, doc.find("\"assets\"")).c_str(), 100);
+  TEST_ASSERT_EQUAL_STRING("v0.4.0", p.tagName());
+  TEST_ASSERT_EQUAL_STRING("", p.assetUrl());
+  TEST_ASSERT_FALSE(p.complete());
+}
+
+void test_overlong_values_are_dropped() {
+  std::string tag(ReleaseParser::TAG_MAX + 4, '9');
+  std::string url(ReleaseParser::URL_MAX + 4, 'u');
+  std::string doc = "{\"tag_name\":\"v" + tag + "\",\"assets\":[{\"name\":\"firmware.bin\",\"browser_download_url\":\"" +
+                    url + "\"}]}";
+  ReleaseParser p("firmware.bin");
+  feedIn(p, doc.c_str(), 7);
+  TEST_ASSERT_FALSE(p.failed());
+  TEST_ASSERT_EQUAL_STRING("", p.tagName());
+  TEST_ASSERT_EQUAL_STRING("", p.assetUrl());
+}
+
+void test_malformed_and_too_deep() {
+  ReleaseParser p("firmware.bin");
+  feedIn(p, "{\"tag_name\":\"v1\"]", 1);
+  TEST_ASSERT_TRUE(p.failed());
+
+  std::string deep(ReleaseParser::MAX_DEPTH + 1, '[');
+  ReleaseParser q("firmware.bin");
+  feedIn(q, ("{\"x\":" + deep).c_str(), 8);
+  TEST_ASSERT_TRUE(q.failed());
+}
+
+void test_reset_keeps_names() {
+  ReleaseParser p(PREFERRED, 3);
+  feedIn(p, RELEASE_NO_ASSETS, 50);
+  p.reset();
+  TEST_ASSERT_EQUAL_STRING("", p.tagName());
+  feedIn(p, RELEASE_FULL, 50);
+  TEST_ASSERT_EQUAL_INT(1, p.assetIndex());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_full_release_any_split);
+  RUN_TEST(test_uploader_name_is_not_an_asset_name);
+  RUN_TEST(test_url_before_name_in_asset);
+  RUN_TEST(test_preference_order);
+  RUN_TEST(test_complete_stops_early_on_first_choice);
+  RUN_TEST(test_not_complete_before_assets_end);
+  RUN_TEST(test_escapes_decoded);
+  RUN_TEST(test_no_assets);
+  RUN_TEST(test_error_bodies);
+  RUN_TEST(test_truncated_body);
+  RUN_TEST(test_overlong_values_are_dropped);
+  RUN_TEST(test_malformed_and_too_deep);
+  RUN_TEST(test_reset_keeps_names);
+  return UNITY_END();
+}
@@ -0,0 +1,159 @@
+// Scheduler on a virtual clock (setClock()): periods, waits reported by
+// runDue(), jobs many wheel revolutions out, triggers and clock changes
+
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+
+#include "scheduler.h"
+
+static uint32_t s_now = 0;
+static uint32_t s_other = 0;
+static std::vector<uint32_t> s_runs;
+static Scheduler::JobId s_job = -1;
+
+static uint32_t virtualClock() {
+  return s_now;
+}
+
+static uint32_t otherClock() {
+  return s_other;
+}
+
+static void record() {
+  s_runs.push_back(s_now);
+}
+
+static void cancelSelf() {
+  record();
+  Scheduler::cancel(s_job);
+}
+
+// Advance the clock by the waits runDue() reports until `until`; returns
+// how many times runDue() was called
+static uint32_t runUntil(uint32_t until) {
+  uint32_t calls = 0;
+  while ((int32_t)(until - s_now) > 0) {
+    uint32_t wait = Scheduler::runDue();
+    calls++;
+    TEST_ASSERT_TRUE_MESSAGE(calls < 100000, "runDue() keeps returning 0");
+    uint32_t step = wait < until - s_now ? wait : until - s_now;
+    s_now += step;
+  }
+  Scheduler::runDue();
+  return calls;
+}
+
+void setUp() {
+  s_runs.clear();
+}
+
+void tearDown() {
+  Scheduler::cancel(s_job);
+  s_job = -1;
+}
+
+void test_periodic_job_runs_on_its_period() {
+  s_now = 1000;
+  s_job = Scheduler::every("tick", 100, record, 100);
+  runUntil(2000);
+  TEST_ASSERT_EQUAL_size_t(10, s_runs.size());
+  for (size_t i = 0; i < s_runs.size(); ++i) TEST_ASSERT_EQUAL_UINT32(1100 + 100 * i, s_runs[i]);
+}
+
+void test_wait_reaches_the_next_deadline() {
+  s_now = 3000;
+  s_job = Scheduler::after("once", 25, record);
+  // Deadlines fire on 10 ms tick boundaries
+  TEST_ASSERT_EQUAL_UINT32(30, Scheduler::runDue());
+  s_now += 29;
+  Scheduler::runDue();
+  TEST_ASSERT_EQUAL_size_t(0, s_runs.size());
+  s_now += 1;
+  Scheduler::runDue();
+  TEST_ASSERT_EQUAL_size_t(1, s_runs.size());
+}
+
+void test_deadline_in_the_current_tick_does_not_spin() {
+  // On a tick boundary and in the middle of one: the job is linked for the
+  // next tick, and runDue() must report the wait to it, not 0
+  const uint32_t starts[] = {5000, 6004};
+  for (uint32_t start : starts) {
+    s_runs.clear();
+    s_now = start;
+    Scheduler::runDue();
+    s_job = Scheduler::after("now", 0, record);
+    uint32_t wait = Scheduler::runDue();
+    TEST_ASSERT_TRUE(wait > 0 && wait <= 10);
+    TEST_ASSERT_TRUE(runUntil(start + 20) <= 3);
+    TEST_ASSERT_EQUAL_size_t(1, s_runs.size());
+    TEST_ASSERT_EQUAL_UINT32((start / 10 + 1) * 10, s_runs[0]);
+  }
+}
+
+void test_job_many_revolutions_out() {
+  // 640 ms per wheel revolution
+  s_now = 7000;
+  s_job = Scheduler::after("later", 5000, record);
+  runUntil(11990);
+  TEST_ASSERT_EQUAL_size_t(0, s_runs.size());
+  runUntil(12100);
+  TEST_ASSERT_EQUAL_size_t(1, s_runs.size());
+  TEST_ASSERT_EQUAL_UINT32(12000, s_runs[0]);
+}
+
+void test_job_may_cancel_itself() {
+  s_now = 20000;
+  s_job = Scheduler::every("selfcancel", 50, cancelSelf, 50);
+  runUntil(20500);
+  TEST_ASSERT_EQUAL_size_t(1, s_runs.size());
+}
+
+void test_trigger_runs_at_the_next_tick() {
+  s_now = 30000;
+  s_job = Scheduler::every("slow", 60000, record, 60000);
+  Scheduler::runDue();
+  s_now = 30003;
+  Scheduler::triggerFromISR(s_job);
+  uint32_t wait = Scheduler::runDue();
+  TEST_ASSERT_EQUAL_size_t(0, s_runs.size());
+  TEST_ASSERT_EQUAL_UINT32(7, wait);
+  s_now += wait;
+  Scheduler::runDue();
+  TEST_ASSERT_EQUAL_size_t(1, s_runs.size());
+  // The period restarts from the trigger
+  TEST_ASSERT_EQUAL_UINT32(60000, Scheduler::runDue());
+}
+
+void test_set_clock_keeps_pending_jobs() {
+  s_now = 40000;
+  s_job = Scheduler::every("kept", 500, record, 500);
+  s_now = 40200;
+  Scheduler::runDue();
+
+  // Switch to a clock with another epoch: the job keeps its 300 ms left
+  s_other = 900000;
+  Scheduler::setClock(otherClock);
+  uint32_t wait = Scheduler::runDue();
+  TEST_ASSERT_EQUAL_UINT32(300, wait);
+  s_other += 300;
+  Scheduler::runDue();
+  TEST_ASSERT_EQUAL_size_t(1, s_runs.size());
+  s_other += 500;
+  Scheduler::runDue();
+  TEST_ASSERT_EQUAL_size_t(2, s_runs.size());
+  Scheduler::setClock(virtualClock);
+}
+
+int main() {
+  Scheduler::setClock(virtualClock);
+  UNITY_BEGIN();
+  RUN_TEST(test_periodic_job_runs_on_its_period);
+  RUN_TEST(test_wait_reaches_the_next_deadline);
+  RUN_TEST(test_deadline_in_the_current_tick_does_not_spin);
+  RUN_TEST(test_job_many_revolutions_out);
+  RUN_TEST(test_job_may_cancel_itself);
+  RUN_TEST(test_trigger_runs_at_the_next_tick);
+  RUN_TEST(test_set_clock_keeps_pending_jobs);
+  return UNITY_END();
+}
@@ -0,0 +1,224 @@
+// TimeSeries encode/decode through the LittleFS stand-in: bit-exact round
+// trips across every timestamp bucket, range queries, points still in RAM,
+// corrupt blocks, segment rotation and the size of the channel table
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <math.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+#include "host.h"
+#include "measurement.h"
+#include "timeseries.h"
+
+static const uint32_t T0 = 1700000000;
+
+struct Point {
+  uint32_t time;
+  float value;
+};
+
+static void collect(uint32_t time, float value, void *ctx) {
+  static_cast<std::vector<Point> *>(ctx)->push_back(Point{time, value});
+}
+
+static std::vector<Point> queryAll(const char *key, uint32_t from = 0, uint32_t to = 0xFFFFFFFF) {
+  std::vector<Point> out;
+  uint32_t n = TimeSeries::query(key, from, to, collect, &out);
+  TEST_ASSERT_EQUAL_UINT32(out.size(), n);
+  return out;
+}
+
+static void record(const char *key, const std::vector<Point> &points) {
+  for (const Point &p : points) {
+    Measurement m;
+    m.time = p.time;
+    m.value = p.value;
+    strlcpy(m.key, key, sizeof(m.key));
+    Measurements::publish(m);
+    TimeSeries::loop();
+  }
+}
+
+// Values compare by bit pattern: the XOR coding must be lossless
+static void assertSame(const std::vector<Point> &want, const std::vector<Point> &got) {
+  TEST_ASSERT_EQUAL_size_t(want.size(), got.size());
+  for (size_t i = 0; i < want.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT32(want[i].time, got[i].time);
+    uint32_t a, b;
+    memcpy(&a, &want[i].value, 4);
+    memcpy(&b, &got[i].value, 4);
+    TEST_ASSERT_EQUAL_HEX32(a, b);
+  }
+}
+
+static uint32_t s_rng = 12345;
+static uint32_t rnd() {
+  s_rng ^= s_rng << 13;
+  s_rng ^= s_rng >> 17;
+  s_rng ^= s_rng << 5;
+  return s_rng;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_regular_cadence_round_trips_compactly() {
+  std::vector<Point> pts;
+  float w = 42.0f;
+  for (uint32_t i = 0; i < 2000; ++i) {
+    if (i % 7 == 0) w += 0.01f;  // slow drift, as a hive gaining weight
+    pts.push_back(Point{T0 + i * 300, w});
+  }
+  const TimeSeries::Stats before = TimeSeries::stats();
+  record("weight_kg", pts);
+  TimeSeries::flush();
+  assertSame(pts, queryAll("weight_kg"));
+
+  const TimeSeries::Stats st = TimeSeries::stats();
+  TEST_ASSERT_EQUAL_UINT32(2000, st.points - before.points);
+  // A JSON line per reading is ~30 bytes; blocks with headers stay far below
+  float bytesPerPoint = (float)(st.flashBytes - before.flashBytes) / 2000;
+  TEST_ASSERT_TRUE(bytesPerPoint < 2.0f);
+}
+
+void test_every_timestamp_bucket_and_value_pattern() {
+  // Deltas whose delta-of-delta lands in each bucket, both signs and the
+  // edges; values of every XOR shape including sign flips and NaN/inf
+  const int32_t deltas[] = {60, 60, 60, 124, 61, 316, 61, 2109, 62, 40000, 60, 1, 1, 65, 2, 258, 3, 2050, 5};
+  const float values[] = {0.0f, -0.0f, 1.0f, -1.0f, 1e-30f, 3.4e38f, INFINITY, -INFINITY, NAN, 21.5f};
+  std::vector<Point> pts;
+  uint32_t t = T0;
+  for (uint32_t i = 0; i < 400; ++i) {
+    t += deltas[i % (sizeof(deltas) / sizeof(deltas[0]))];
+    float v = (i % 3 == 0) ? values[i % 10] : (float)(int32_t)rnd() / 1024.0f;
+    pts.push_back(Point{t, v});
+  }
+  record("irregular", pts);
+  assertSame(pts, queryAll("irregular"));  // part on flash, part in RAM
+  TimeSeries::flush();
+  assertSame(pts, queryAll("irregular"));
+}
+
+void test_range_query_returns_only_the_window() {
+  std::vector<Point> pts;
+  for (uint32_t i = 0; i < 500; ++i) pts.push_back(Point{T0 + i * 600, 20.0f + (i % 40) * 0.125f});
+  record("t_0", pts);
+  const uint32_t from = T0 + 100 * 600, to = T0 + 250 * 600;
+  std::vector<Point> want(pts.begin() + 100, pts.begin() + 251);
+  assertSame(want, queryAll("t_0", from, to));
+  TEST_ASSERT_EQUAL_size_t(0, queryAll("t_0", T0 + 500 * 600).size());
+  TEST_ASSERT_EQUAL_size_t(0, queryAll("no_such_key").size());
+}
+
+void test_interleaved_channels_stay_apart() {
+  std::vector<Point> a, b;
+  for (uint32_t i = 0; i < 300; ++i) {
+    a.push_back(Point{T0 + i * 60, (float)i});
+    b.push_back(Point{T0 + i * 60, -(float)i * 0.5f});
+  }
+  for (uint32_t i = 0; i < 300; ++i) {
+    record("h", {a[i]});
+    record("bv", {b[i]});
+  }
+  assertSame(a, queryAll("h"));
+  assertSame(b, queryAll("bv"));
+}
+
+void test_backwards_time_and_untimed_readings() {
+  const uint32_t skipped = TimeSeries::stats().skipped;
+  record("clock", {{T0 + 100, 1.0f}, {T0 + 200, 2.0f}, {T0 + 50, 3.0f}, {0, 4.0f}, {T0 + 60, 5.0f}});
+  TEST_ASSERT_EQUAL_UINT32(skipped + 1, TimeSeries::stats().skipped);
+  // A step back seals the block; both stay readable in recording order
+  assertSame({{T0 + 100, 1.0f}, {T0 + 200, 2.0f}, {T0 + 50, 3.0f}, {T0 + 60, 5.0f}}, queryAll("clock"));
+}
+
+void test_corrupt_block_is_skipped() {
+  std::vector<Point> pts;
+  for (uint32_t i = 0; i < 200; ++i) pts.push_back(Point{T0 + i * 60, (float)(rnd() % 1000)});
+  record("crc", pts);
+  TimeSeries::flush();
+  std::vector<Point> before = queryAll("crc");
+  assertSame(pts, before);
+
+  // Flip a payload byte of the first "crc" block in the segment files
+  const TimeSeries::Stats st = TimeSeries::stats();
+  bool flipped = false;
+  for (uint16_t id = 0; id < 64 && !flipped; ++id) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s/ts/%08u.seg", Host::fsRoot(), (unsigned)id);
+    FILE *f = fopen(path, "r+b");
+    if (!f) continue;
+    std::string data;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.append(buf, n);
+    size_t at = data.find(std::string("crc\0", 4));
+    if (at != std::string::npos) {
+      size_t payload = at + 16;  // the key ends the 36-byte header
+      fseek(f, (long)payload + 5, SEEK_SET);
+      fputc(data[payload + 5] ^ 0x10, f);
+      flipped = true;
+    }
+    fclose(f);
+  }
+  TEST_ASSERT_TRUE(flipped);
+  TEST_ASSERT_TRUE(st.segments > 0);
+
+  std::vector<Point> after = queryAll("crc");
+  TEST_ASSERT_TRUE(after.size() > 0 && after.size() < pts.size());
+  // What is left are the later blocks, unchanged
+  std::vector<Point> tail(pts.end() - after.size(), pts.end());
+  assertSame(tail, after);
+}
+
+void test_oldest_segment_rotates_out() {
+  // Noisy values take ~6 bytes a point: 16 x 32 KB hold ~90000
+  std::vector<Point> pts;
+  for (uint32_t i = 0; i < 120000; ++i) pts.push_back(Point{T0 + i * 60, (float)(int32_t)rnd()});
+  record("noise", pts);
+  TimeSeries::flush();
+  const TimeSeries::Stats st = TimeSeries::stats();
+  TEST_ASSERT_EQUAL_UINT16(16, st.segments);
+  TEST_ASSERT_FALSE(LittleFS.exists("/ts/00000000.seg"));
+
+  std::vector<Point> got = queryAll("noise");
+  TEST_ASSERT_TRUE(got.size() > 60000 && got.size() < pts.size());
+  std::vector<Point> tail(pts.end() - got.size(), pts.end());
+  assertSame(tail, got);
+}
+
+void test_published_key_set_fits() {
+  // What the firmware publishes with every sensor fitted, plus a BLE
+  // thermometer; with the five keys earlier tests used the table is full
+  std::vector<std::string> keys = {"s_tot", "bv", "w_v", "weight_kg", "t_a4c1", "h_a4c1", "bv_a4c1"};
+  for (int b = 0; b < 10; ++b) keys.push_back("s_bin" + std::to_string(98 + b * 49));
+  for (int t = 0; t < 10; ++t) keys.push_back("t_" + std::to_string(t));
+  const uint32_t t = T0 + 10000000;
+  const TimeSeries::Stats before = TimeSeries::stats();
+  for (const std::string &k : keys) record(k.c_str(), {Point{t, 1.5f}});
+  TEST_ASSERT_EQUAL_UINT32(before.skipped, TimeSeries::stats().skipped);
+  for (const std::string &k : keys) TEST_ASSERT_EQUAL_size_t(1, queryAll(k.c_str(), t, t).size());
+
+  // Past the table, readings are counted as skipped rather than recorded
+  for (int i = 0; i < 64; ++i) record(("x_" + std::to_string(i)).c_str(), {Point{t, 2.5f}});
+  TEST_ASSERT_TRUE(TimeSeries::stats().skipped > before.skipped);
+  TEST_ASSERT_EQUAL_size_t(0, queryAll("x_63").size());
+}
+
+int main() {
+  Host::resetFs();
+  TimeSeries::begin();
+  UNITY_BEGIN();
+  RUN_TEST(test_regular_cadence_round_trips_compactly);
+  RUN_TEST(test_every_timestamp_bucket_and_value_pattern);
+  RUN_TEST(test_range_query_returns_only_the_window);
+  RUN_TEST(test_interleaved_channels_stay_apart);
+  RUN_TEST(test_backwards_time_and_untimed_readings);
+  RUN_TEST(test_corrupt_block_is_skipped);
+  RUN_TEST(test_oldest_segment_rotates_out);
+  RUN_TEST(test_published_key_set_fits);
+  return UNITY_END();
+}
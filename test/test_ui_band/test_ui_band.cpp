@@ -0,0 +1,337 @@
+// Status band: Wi-Fi, battery and header updates through the UI task. Each
+// repaint must flush one address window around exactly the pixels that
+// differ from what the panel showed, and the flushed rectangles must match
+// golden images (with the 1bpp Wi-Fi bitmap the band uses without the
+// generated icon atlas)
+
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include <unity.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "host.h"
+#include "trace.h"
+#include "ui.h"
+
+#if __has_include("ui_icon_atlas.h")
+#include "ui_icon_atlas.h"
+#endif
+
+// Header strip holding the band; its windows start right of the title
+static const int16_t STRIP_W = 240;
+static const int16_t STRIP_H = 24;
+static const int16_t BAND_MIN_X = STRIP_W / 2;
+
+struct Rect {
+  int16_t x, y, w, h;
+};
+
+struct Frame {
+  bool flushed;
+  Rect rect;
+  std::string image;  // flushed rectangle, one shade letter per pixel
+};
+
+static std::mutex s_mutex;
+static std::vector<Rect> s_windows;
+static std::vector<uint16_t> s_atFlush;  // strip as it was when the band flushed
+static std::vector<Frame> s_frames;
+
+static std::vector<uint16_t> strip() {
+  std::vector<uint16_t> px((size_t)STRIP_W * STRIP_H);
+  for (int16_t y = 0; y < STRIP_H; ++y) {
+    for (int16_t x = 0; x < STRIP_W; ++x) px[y * STRIP_W + x] = Host::panelPixel(x, y);
+  }
+  return px;
+}
+
+static char shade(uint16_t c) {
+  switch (c) {
+    case UI::COLOR_BG: return '.';
+    case UI::COLOR_WHITE_SMOKE: return 'W';
+    case UI::COLOR_SIGNAL_BLUE: return 'B';
+    case UI::COLOR_HIVE_YELLOW: return 'Y';
+    default: return '?';
+  }
+}
+
+static std::string image(const std::vector<uint16_t> &px, const Rect &r) {
+  std::string out;
+  for (int16_t y = r.y; y < r.y + r.h; ++y) {
+    for (int16_t x = r.x; x < r.x + r.w; ++x) out += shade(px[y * STRIP_W + x]);
+    out += '\n';
+  }
+  return out;
+}
+
+static uint32_t bandFrames() {
+  Trace::Site site("ui.wifi_icon");
+  return Trace::snapshot("ui.wifi_icon", site) ? site.count : 0;
+}
+
+static void waitBandFrames(uint32_t count) {
+  while (bandFrames() < count) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+// Post an update, wait for the band repaint and check what it flushed
+static void step(void (*post)()) {
+  std::vector<uint16_t> before = strip();
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_windows.clear();
+    s_atFlush.clear();
+  }
+  uint32_t frames = bandFrames();
+  post();
+  waitBandFrames(frames + 1);
+  std::vector<uint16_t> after = strip();
+
+  std::lock_guard<std::mutex> lock(s_mutex);
+  Frame f = {false, {0, 0, 0, 0}, ""};
+  TEST_ASSERT_TRUE_MESSAGE(s_windows.size() <= 1, "band flushed in more than one window");
+  if (s_windows.empty()) {
+    TEST_ASSERT_TRUE_MESSAGE(before == after, "band changed without a flush");
+    s_frames.push_back(f);
+    return;
+  }
+  f.flushed = true;
+  f.rect = s_windows[0];
+  // The window is the bounding box of the pixels the flush changed
+  int16_t x0 = STRIP_W, y0 = STRIP_H, x1 = -1, y1 = -1;
+  for (int16_t y = 0; y < STRIP_H; ++y) {
+    for (int16_t x = 0; x < STRIP_W; ++x) {
+      if (s_atFlush[y * STRIP_W + x] == after[y * STRIP_W + x]) continue;
+      if (x < x0) x0 = x;
+      if (x > x1) x1 = x;
+      if (y < y0) y0 = y;
+      y1 = y;
+    }
+  }
+  TEST_ASSERT_TRUE_MESSAGE(x1 >= 0, "flush changed no pixels");
+  TEST_ASSERT_EQUAL_INT16(x0, f.rect.x);
+  TEST_ASSERT_EQUAL_INT16(y0, f.rect.y);
+  TEST_ASSERT_EQUAL_INT16(x1 - x0 + 1, f.rect.w);
+  TEST_ASSERT_EQUAL_INT16(y1 - y0 + 1, f.rect.h);
+  f.image = image(after, f.rect);
+  s_frames.push_back(f);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_band_flushes_only_changed_pixels() {
+  Host::setPanelWindowHandler([](int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (x < BAND_MIN_X || y >= STRIP_H) return;  // clears and text lines
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_windows.push_back(Rect{x, y, w, h});
+    s_atFlush = strip();
+  });
+  UI::init();
+  while (!UI::ready()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  waitBandFrames(1);
+
+  step([] { UI::drawWifiIcon(true); });      // icon turns blue
+  step([] { UI::setBatteryPercent(57); });   // SoC appears, icon moves left
+  step([] { UI::setBatteryPercent(58); });   // one digit
+  step([] { UI::setBatteryPercent(100); });  // wider SoC
+  step([] { UI::drawWifiIcon(true); });      // same state: no SPI traffic
+  // The clear starts at LINE_HEIGHT + 1, inside the band's last rows
+  step([] { UI::clearContentBelowHeader(); UI::drawWifiIcon(true); });
+  step([] { UI::printHeader(); });           // blank panel: the whole band
+  step([] { UI::setBatteryPercent(-1); });   // SoC hidden, icon back right
+  step([] { UI::drawWifiIcon(false); });     // back to the first frame
+  Host::setPanelWindowHandler(nullptr);
+}
+
+// Golden flushed rectangles of the steps above; nullptr: nothing flushed
+struct Golden {
+  Rect rect;
+  const char *image;
+};
+
+static const Golden GOLDENS[] = {
+  // Connected: the icon recolored in place
+  {{210, 0, 24, 20},
+   ".......BBBBBBBBBB.......\n"
+   "....BBBBBBBBBBBBBBBB....\n"
+   "..BBBBBBBBBBBBBBBBBBBB..\n"
+   "BBBBBBB..........BBBBBBB\n"
+   "BBBBB..............BBBBB\n"
+   "BB....................BB\n"
+   "B......................B\n"
+   ".........BBBBBB.........\n"
+   "......BBBBBBBBBBBB......\n"
+   "....BBBBBBBBBBBBBBBB....\n"
+   "...BBBBBB......BBBBBB...\n"
+   "...BBBB..........BBBB...\n"
+   "...BB..............BB...\n"
+   "........................\n"
+   "........................\n"
+   "..........BBBB..........\n"
+   ".........BBBBBB.........\n"
+   ".........BBBBBB.........\n"
+   ".........BBBBBB.........\n"
+   "..........BBBB..........\n"},
+  // 57%: text and the icon moved left of it
+  {{166, 0, 68, 20},
+   ".......BBBBBBBBBB...................................................\n"
+   "....BBBBBBBBBBBBBBBB................................................\n"
+   "..BBBBBBBBBBBBBBBBBBBB..........WW..WW..WW..WWWWWW..WW..WW..WW......\n"
+   "BBBBBBB..........BBBBBBB........WW..WW..WW..WWWWWW..WW..WW..WW......\n"
+   "BBBBB..............BBBBB..........WW..WWWW..WWWW..WWWW....WW....WW..\n"
+   "BB....................BB..........WW..WWWW..WWWW..WWWW....WW....WW..\n"
+   "B......................B........WW..WWWW....WW..WWWW....WW....WW....\n"
+   ".........BBBBBB.................WW..WWWW....WW..WWWW....WW....WW....\n"
+   "......BBBBBBBBBBBB................WWWW........WWWW..........WW......\n"
+   "....BBBBBBBBBBBBBBBB..............WWWW........WWWW..........WW......\n"
+   "...BBBBBB......BBBBBB...........WWWW....WW..WWWW....WW....WW....WW..\n"
+   "...BBBB..........BBBB...........WWWW....WW..WWWW....WW....WW....WW..\n"
+   "...BB..............BB...........WW....WW....WW....WWWW..WW....WW....\n"
+   "................................WW....WW....WW....WWWW..WW....WW....\n"
+   "....................................WW..WW......WWWWWW......WW..WW..\n"
+   "..........BBBB......................WW..WW......WWWWWW......WW..WW..\n"
+   ".........BBBBBB.....................................................\n"
+   ".........BBBBBB.....................................................\n"
+   ".........BBBBBB.....................................................\n"
+   "..........BBBB......................................................\n"},
+  // 58%: only the last digit
+  {{210, 2, 10, 14},
+   "......WWWW\n"
+   "......WWWW\n"
+   "....WWWWWW\n"
+   "....WWWWWW\n"
+   "..WWWWWW..\n"
+   "..WWWWWW..\n"
+   "WWWWWW....\n"
+   "WWWWWW....\n"
+   "WWWW......\n"
+   "WWWW......\n"
+   "WW........\n"
+   "WW........\n"
+   "..........\n"
+   "..........\n"},
+  // 100%: a digit more, the icon moves again
+  {{154, 0, 64, 20},
+   ".......BBBBBBBBBB...............................................\n"
+   "....BBBBBBBBBBBBBBBB............................................\n"
+   "..BBBBBBBBBBBBBBBBBBBB..........WW......WW..........WW..........\n"
+   "BBBBBBB..........BBBBBBB........WW......WW..........WW..........\n"
+   "BBBBB..............BBBBB..............WWWW........WWWW........WW\n"
+   "BB....................BB..............WWWW........WWWW........WW\n"
+   "B......................B............WWWW........WWWW........WWWW\n"
+   ".........BBBBBB.....................WWWW........WWWW........WWWW\n"
+   "......BBBBBBBBBBBB................WWWW........WWWW........WWWW..\n"
+   "....BBBBBBBBBBBBBBBB..............WWWW........WWWW........WWWW..\n"
+   "...BBBBBB......BBBBBB...........WWWW....WW..WWWW........WWWW....\n"
+   "...BBBB..........BBBB...........WWWW....WW..WWWW........WWWW....\n"
+   "...BB..............BB...........WW....WW....WW..........WW......\n"
+   "................................WW....WW....WW..........WW......\n"
+   "....................................WW..........................\n"
+   "..........BBBB......................WW..........................\n"
+   ".........BBBBBB.................................................\n"
+   ".........BBBBBB.................................................\n"
+   ".........BBBBBB.................................................\n"
+   "..........BBBB..................................................\n"},
+  // Nothing changed
+  {{0, 0, 0, 0}, nullptr},
+  // The clear cut into the band's last rows; only its icon pixels return
+  {{164, 19, 4, 1},
+   "BBBB\n"},
+  // Header repaint: the whole band on a blank panel
+  {{154, 0, 78, 20},
+   ".......BBBBBBBBBB.............................................................\n"
+   "....BBBBBBBBBBBBBBBB..........................................................\n"
+   "..BBBBBBBBBBBBBBBBBBBB..........WW......WW..........WW..........WW..WW..WW....\n"
+   "BBBBBBB..........BBBBBBB........WW......WW..........WW..........WW..WW..WW....\n"
+   "BBBBB..............BBBBB..............WWWW........WWWW........WWWW....WW....WW\n"
+   "BB....................BB..............WWWW........WWWW........WWWW....WW....WW\n"
+   "B......................B............WWWW........WWWW........WWWW....WW....WW..\n"
+   ".........BBBBBB.....................WWWW........WWWW........WWWW....WW....WW..\n"
+   "......BBBBBBBBBBBB................WWWW........WWWW........WWWW..........WW....\n"
+   "....BBBBBBBBBBBBBBBB..............WWWW........WWWW........WWWW..........WW....\n"
+   "...BBBBBB......BBBBBB...........WWWW....WW..WWWW........WWWW..........WW....WW\n"
+   "...BBBB..........BBBB...........WWWW....WW..WWWW........WWWW..........WW....WW\n"
+   "...BB..............BB...........WW....WW....WW..........WW..........WW....WW..\n"
+   "................................WW....WW....WW..........WW..........WW....WW..\n"
+   "....................................WW..................................WW..WW\n"
+   "..........BBBB......................WW..................................WW..WW\n"
+   ".........BBBBBB...............................................................\n"
+   ".........BBBBBB...............................................................\n"
+   ".........BBBBBB...............................................................\n"
+   "..........BBBB................................................................\n"},
+  // SoC hidden: the icon back at the right edge, the rest cleared
+  {{154, 0, 80, 20},
+   "...............................................................BBBBBBBBBB.......\n"
+   "............................................................BBBBBBBBBBBBBBBB....\n"
+   "..........................................................BBBBBBBBBBBBBBBBBBBB..\n"
+   "........................................................BBBBBBB..........BBBBBBB\n"
+   "........................................................BBBBB..............BBBBB\n"
+   "........................................................BB....................BB\n"
+   "........................................................B......................B\n"
+   ".................................................................BBBBBB.........\n"
+   "..............................................................BBBBBBBBBBBB......\n"
+   "............................................................BBBBBBBBBBBBBBBB....\n"
+   "...........................................................BBBBBB......BBBBBB...\n"
+   "...........................................................BBBB..........BBBB...\n"
+   "...........................................................BB..............BB...\n"
+   "................................................................................\n"
+   "................................................................................\n"
+   "..................................................................BBBB..........\n"
+   ".................................................................BBBBBB.........\n"
+   ".................................................................BBBBBB.........\n"
+   ".................................................................BBBBBB.........\n"
+   "..................................................................BBBB..........\n"},
+  // Disconnected again: the first frame
+  {{210, 0, 24, 20},
+   ".......WWWWWWWWWW.......\n"
+   "....WWWWWWWWWWWWWWWW....\n"
+   "..WWWWWWWWWWWWWWWWWWWW..\n"
+   "WWWWWWW..........WWWWWWW\n"
+   "WWWWW..............WWWWW\n"
+   "WW....................WW\n"
+   "W......................W\n"
+   ".........WWWWWW.........\n"
+   "......WWWWWWWWWWWW......\n"
+   "....WWWWWWWWWWWWWWWW....\n"
+   "...WWWWWW......WWWWWW...\n"
+   "...WWWW..........WWWW...\n"
+   "...WW..............WW...\n"
+   "........................\n"
+   "........................\n"
+   "..........WWWW..........\n"
+   ".........WWWWWW.........\n"
+   ".........WWWWWW.........\n"
+   ".........WWWWWW.........\n"
+   "..........WWWW..........\n"},
+};
+
+void test_band_matches_goldens() {
+#ifdef UI_ICON_ATLAS_AVAILABLE
+  TEST_IGNORE_MESSAGE("goldens are of the band without the icon atlas");
+#else
+  TEST_ASSERT_EQUAL_size_t(sizeof(GOLDENS) / sizeof(GOLDENS[0]), s_frames.size());
+  for (size_t i = 0; i < s_frames.size(); ++i) {
+    char msg[16];
+    snprintf(msg, sizeof(msg), "step %u", (unsigned)i + 1);
+    const Golden &g = GOLDENS[i];
+    TEST_ASSERT_TRUE_MESSAGE((g.image != nullptr) == s_frames[i].flushed, msg);
+    if (!g.image) continue;
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(g.rect.x, s_frames[i].rect.x, msg);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(g.rect.y, s_frames[i].rect.y, msg);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(g.rect.w, s_frames[i].rect.w, msg);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(g.rect.h, s_frames[i].rect.h, msg);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(g.image, s_frames[i].image.c_str(), msg);
+  }
+#endif
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_band_flushes_only_changed_pixels);
+  RUN_TEST(test_band_matches_goldens);
+  return UNITY_END();
+}
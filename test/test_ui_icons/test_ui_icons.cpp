@@ -0,0 +1,115 @@
+// Status icon atlas: the firmware's run-length decoder against hand-coded
+// runs and, when the build script has generated the atlas, against the
+// renders every icon was coded from
+
+#include <Arduino.h>
+#include <unity.h>
+#include <string>
+#include <vector>
+
+#include "ui_draw.h"
+
+#if __has_include("ui_icon_atlas.h") && __has_include("ui_icon_renders.h")
+#include "ui_icon_atlas.h"
+#include "ui_icon_renders.h"
+#endif
+
+// Decode into one digit per pixel, the format of UI_ICON_RENDERS
+static std::string decode(const uint8_t *rle, uint8_t w, uint8_t h, size_t *used) {
+  std::string out((size_t)w * h, '0');
+  const uint8_t *end = UI::forEachIconSpan(rle, w, h, [&](uint8_t x, uint8_t y, uint8_t n, uint8_t level) {
+    TEST_ASSERT_TRUE_MESSAGE(x + n <= w, "span crosses the row");
+    for (uint8_t i = 0; i < n; ++i) out[y * w + x + i] = (char)('0' + level);
+  });
+  if (used) *used = end - rle;
+  return out;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_runs_decode_to_rows() {
+  // 5x3: "01230", "33333", "00000"
+  static const uint8_t RLE[] PROGMEM = {
+      0x00, 0x40, 0x80, 0xC0, 0x00, // one pixel each
+      0xC4,                         // five 3s
+      0x04,                         // five 0s
+  };
+  size_t used = 0;
+  std::string rows = decode(RLE, 5, 3, &used);
+  TEST_ASSERT_EQUAL_STRING("012303333300000", rows.c_str());
+  TEST_ASSERT_EQUAL_size_t(sizeof(RLE), used);
+}
+
+void test_level_zero_runs_are_skipped() {
+  static const uint8_t RLE[] PROGMEM = {0x03, 0x41, 0x01, 0xBF, 0xBF};
+  std::vector<uint8_t> spans;
+  UI::forEachIconSpan(RLE, 8, 1, [&](uint8_t x, uint8_t, uint8_t n, uint8_t level) {
+    spans.push_back(x);
+    spans.push_back(n);
+    spans.push_back(level);
+  });
+  static const uint8_t EXPECTED[] = {4, 2, 1};
+  TEST_ASSERT_EQUAL_size_t(sizeof(EXPECTED), spans.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED, spans.data(), sizeof(EXPECTED));
+}
+
+void test_longest_run_fills_a_row() {
+  // One byte covers the 64-pixel maximum; rows still start a new run
+  static const uint8_t RLE[] PROGMEM = {0xFF, 0x7F};
+  size_t used = 0;
+  std::string rows = decode(RLE, 64, 2, &used);
+  std::string expected = std::string(64, '3') + std::string(64, '1');
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), rows.c_str());
+  TEST_ASSERT_EQUAL_size_t(2, used);
+}
+
+void test_atlas_matches_the_renders() {
+#ifdef UI_ICON_ATLAS_AVAILABLE
+  TEST_ASSERT_EQUAL_size_t(UI_ICON_COUNT, sizeof(UI_ICON_RENDERS) / sizeof(UI_ICON_RENDERS[0]));
+  for (uint8_t id = 0; id < UI_ICON_COUNT; ++id) {
+    const UiIcon &icon = UI_ICONS[id];
+    size_t used = 0;
+    std::string got = decode(UI_ICON_RLE + icon.offset, icon.w, icon.h, &used);
+    char msg[32];
+    snprintf(msg, sizeof(msg), "icon %u", (unsigned)id);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(UI_ICON_RENDERS[id], got.c_str(), msg);
+    // The index is contiguous: each icon ends where the next starts
+    size_t next = id + 1 < UI_ICON_COUNT ? UI_ICONS[id + 1].offset : sizeof(UI_ICON_RLE);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(next - icon.offset, used, msg);
+    TEST_ASSERT_TRUE_MESSAGE(icon.w <= UI_ICON_MAX_W, msg);
+    TEST_ASSERT_TRUE_MESSAGE(icon.w == 0 || icon.h == UI_ICON_H, msg);
+  }
+#else
+  TEST_IGNORE_MESSAGE("icon atlas not generated (scripts/gen_fa_wifi_bitmap.py needs Pillow)");
+#endif
+}
+
+void test_level_icons_are_consecutive() {
+#ifdef UI_ICON_ATLAS_AVAILABLE
+  // UI picks SIGNAL_0 + bars and BATT_0 + level
+  TEST_ASSERT_EQUAL_INT(UI_ICON_SIGNAL_0 + 4, UI_ICON_SIGNAL_4);
+  TEST_ASSERT_EQUAL_INT(UI_ICON_BATT_0 + 4, UI_ICON_BATT_4);
+  // Lit bars only add coverage
+  for (uint8_t bars = 1; bars <= 4; ++bars) {
+    const char *less = UI_ICON_RENDERS[UI_ICON_SIGNAL_0 + bars - 1];
+    const char *more = UI_ICON_RENDERS[UI_ICON_SIGNAL_0 + bars];
+    TEST_ASSERT_EQUAL_size_t(strlen(less), strlen(more));
+    for (size_t i = 0; less[i]; ++i) TEST_ASSERT_TRUE(more[i] >= less[i]);
+    TEST_ASSERT_TRUE(strcmp(less, more) != 0);
+  }
+#else
+  TEST_IGNORE_MESSAGE("icon atlas not generated (scripts/gen_fa_wifi_bitmap.py needs Pillow)");
+#endif
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_runs_decode_to_rows);
+  RUN_TEST(test_level_zero_runs_are_skipped);
+  RUN_TEST(test_longest_run_fills_a_row);
+  RUN_TEST(test_atlas_matches_the_renders);
+  RUN_TEST(test_level_icons_are_consecutive);
+  return UNITY_END();
+}
@@ -0,0 +1,165 @@
+// Default-style text lines through the UI task with the generated glyph
+// atlas: glyphs must be the GFX built-in font at TEXT_SIZE, a new message
+// must only redraw the cells that differ (one address window per run), and
+// what a line shows afterwards must equal the message drawn on a blank line
+
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include <unity.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "host.h"
+#include "trace.h"
+#include "ui.h"
+
+#if __has_include("ui_glyph_atlas.h")
+#include "ui_glyph_atlas.h"
+#endif
+
+static const int16_t SCREEN_W = 240;
+static const int16_t TEXT_X = 2;
+static const int16_t CELL_W = 6 * UI::TEXT_SIZE;
+static const int16_t CELL_H = 8 * UI::TEXT_SIZE;
+static const int16_t BAND_H = 24;  // windows above are the status band's
+
+// Adafruit GFX glcdfont.c columns, bit 0 at the top
+static const uint8_t FONT_A[5] = {0x7C, 0x12, 0x11, 0x12, 0x7C};
+static const uint8_t FONT_I[5] = {0x00, 0x44, 0x7D, 0x40, 0x00};
+
+struct Rect {
+  int16_t x, y, w, h;
+};
+
+static std::mutex s_mutex;
+static std::vector<Rect> s_windows;
+
+static int16_t lineTop(int line) {
+  return (line - 1) * UI::LINE_HEIGHT + 2;
+}
+
+static uint32_t linesDrawn() {
+  Trace::Site site("ui.print_line");
+  return Trace::snapshot("ui.print_line", site) ? site.count : 0;
+}
+
+// Print one line, wait for the UI task to draw it and return its windows
+static std::vector<Rect> print(int line, const char *msg, uint16_t color = UI::COLOR_WHITE_SMOKE,
+                               UI::FontStyle style = UI::FontStyle::Default) {
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_windows.clear();
+  }
+  uint32_t drawn = linesDrawn();
+  UI::printLine(line, msg, color, style);
+  while (linesDrawn() < drawn + 1) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return s_windows;
+}
+
+static void assertWindow(const Rect &r, int16_t x, int16_t y, int16_t w, int16_t h) {
+  TEST_ASSERT_EQUAL_INT16(x, r.x);
+  TEST_ASSERT_EQUAL_INT16(y, r.y);
+  TEST_ASSERT_EQUAL_INT16(w, r.w);
+  TEST_ASSERT_EQUAL_INT16(h, r.h);
+}
+
+// A cell against the font columns, scaled as GFX drawChar() does
+static void assertGlyph(int line, uint8_t cell, const uint8_t columns[5], uint16_t color) {
+  int16_t x0 = TEXT_X + cell * CELL_W, y0 = lineTop(line);
+  for (int16_t y = 0; y < CELL_H; ++y) {
+    for (int16_t x = 0; x < CELL_W; ++x) {
+      int16_t col = x / UI::TEXT_SIZE, row = y / UI::TEXT_SIZE;
+      bool on = col < 5 && (columns[col] >> row & 1);
+      TEST_ASSERT_EQUAL_HEX16(on ? color : UI::COLOR_BG, Host::panelPixel(x0 + x, y0 + y));
+    }
+  }
+}
+
+// Both lines show the same pixels
+static void assertSameLine(int line, int reference) {
+  for (int16_t y = 0; y < UI::LINE_HEIGHT; ++y) {
+    for (int16_t x = 0; x < SCREEN_W; ++x) {
+      TEST_ASSERT_EQUAL_HEX16(Host::panelPixel(x, lineTop(reference) + y), Host::panelPixel(x, lineTop(line) + y));
+    }
+  }
+}
+
+void setUp() {
+#ifndef UI_GLYPH_ATLAS_AVAILABLE
+  TEST_IGNORE_MESSAGE("no generated glyph atlas");
+#endif
+}
+
+void tearDown() {}
+
+void test_glyphs_are_the_gfx_font() {
+  Host::setPanelWindowHandler([](int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (y < BAND_H) return;
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_windows.push_back(Rect{x, y, w, h});
+  });
+  UI::init();
+  while (!UI::ready()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // The header clear left the line blank: no fill, one run of two cells
+  std::vector<Rect> w = print(3, "Ai");
+  TEST_ASSERT_EQUAL_UINT32(1, w.size());
+  assertWindow(w[0], TEXT_X, lineTop(3), 2 * CELL_W, CELL_H);
+  assertGlyph(3, 0, FONT_A, UI::COLOR_WHITE_SMOKE);
+  assertGlyph(3, 1, FONT_I, UI::COLOR_WHITE_SMOKE);
+}
+
+void test_new_text_redraws_only_changed_cells() {
+  print(3, "Temp 21.5C");
+  std::vector<Rect> w = print(3, "Temp 21.7C");
+  TEST_ASSERT_EQUAL_UINT32(1, w.size());
+  assertWindow(w[0], TEXT_X + 8 * CELL_W, lineTop(3), CELL_W, CELL_H);
+  print(5, "Temp 21.7C");
+  assertSameLine(3, 5);
+
+  // The same message again costs nothing
+  TEST_ASSERT_EQUAL_UINT32(0, print(3, "Temp 21.7C").size());
+}
+
+void test_shorter_text_blanks_the_cells_past_its_end() {
+  std::vector<Rect> w = print(3, "Temp 2");
+  TEST_ASSERT_EQUAL_UINT32(1, w.size());
+  assertWindow(w[0], TEXT_X + 6 * CELL_W, lineTop(3), 4 * CELL_W, CELL_H);
+  print(6, "Temp 2");
+  assertSameLine(3, 6);
+}
+
+void test_new_color_skips_blank_cells() {
+  std::vector<Rect> w = print(3, "Temp 2", UI::COLOR_HIVE_YELLOW);
+  TEST_ASSERT_EQUAL_UINT32(2, w.size());
+  assertWindow(w[0], TEXT_X, lineTop(3), 4 * CELL_W, CELL_H);
+  assertWindow(w[1], TEXT_X + 5 * CELL_W, lineTop(3), CELL_W, CELL_H);
+  print(4, "Temp 2", UI::COLOR_HIVE_YELLOW);
+  assertSameLine(3, 4);
+}
+
+void test_proportional_text_forces_a_full_repaint() {
+  std::vector<Rect> w = print(3, "Hive", UI::COLOR_WHITE_SMOKE, UI::FontStyle::RoundedSans);
+  TEST_ASSERT_TRUE(w.size() >= 1);
+  assertWindow(w[0], 0, lineTop(3), SCREEN_W, UI::LINE_HEIGHT);
+
+  // The cells no longer describe the line: clear it, then draw every cell
+  w = print(3, "Hive");
+  TEST_ASSERT_EQUAL_UINT32(2, w.size());
+  assertWindow(w[0], 0, lineTop(3), SCREEN_W, UI::LINE_HEIGHT);
+  assertWindow(w[1], TEXT_X, lineTop(3), 4 * CELL_W, CELL_H);
+  print(7, "Hive");
+  assertSameLine(3, 7);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_glyphs_are_the_gfx_font);
+  RUN_TEST(test_new_text_redraws_only_changed_cells);
+  RUN_TEST(test_shorter_text_blanks_the_cells_past_its_end);
+  RUN_TEST(test_new_color_skips_blank_cells);
+  RUN_TEST(test_proportional_text_forces_a_full_repaint);
+  return UNITY_END();
+}
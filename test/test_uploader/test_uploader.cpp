@@ -0,0 +1,154 @@
+// Uploader against the HTTP and LittleFS stand-ins: staging to flash while
+// offline, grouped POSTs on one kept-alive connection, back-off, rejected
+// readings and a full partition
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+#include "host.h"
+#include "measurement.h"
+#include "uploader.h"
+
+static const uint32_t T0 = 1700000000;
+static const char *const KEYS[] = {"weight_kg", "t_i", "h", "bv"};
+
+static std::vector<std::string> s_bodies;
+static int s_status = 200;
+
+static Host::HttpReply handle(const Host::HttpRequest &req) {
+  Host::HttpReply r;
+  s_bodies.push_back(req.body);
+  r.code = s_status;
+  r.body = "{\"result\":\"ok\"}";
+  return r;
+}
+
+// count readings: four keys per timestamp, values derived from the index
+static void publishReadings(uint32_t first, uint32_t count) {
+  for (uint32_t i = first; i < first + count; ++i) {
+    Measurement m;
+    m.time = T0 + (i / 4) * 60;
+    m.value = 40.0f + (i % 4) + (i / 4) * 0.25f;
+    strlcpy(m.key, KEYS[i % 4], sizeof(m.key));
+    Measurements::publish(m);
+    Uploader::loop();
+  }
+}
+
+// Run loop() until the queue is empty or it stops making progress
+static void drain() {
+  for (int i = 0; i < 100 && Uploader::stats().pending; ++i) Uploader::loop();
+}
+
+void setUp() {
+  s_bodies.clear();
+  s_status = 200;
+  Host::setHttpHandler(handle);
+  Host::resetHttpStats();
+  Host::resetFsStats();
+}
+
+void tearDown() {}
+
+void test_offline_readings_are_appended_in_blocks() {
+  Host::resetFs();
+  Host::clearNvs();
+  Host::setWifiConnected(false);
+  Uploader::begin();
+
+  publishReadings(0, 40);
+  Uploader::Stats st = Uploader::stats();
+  TEST_ASSERT_EQUAL_UINT32(40, st.queued);
+  TEST_ASSERT_EQUAL_UINT32(40, st.pending);
+  TEST_ASSERT_EQUAL_UINT32(0, st.posts);
+  // 16 staged readings per append; the last 8 are still in RAM
+  TEST_ASSERT_EQUAL_UINT32(2, Host::fsStats().writes);
+  File f = LittleFS.open("/upq.bin", FILE_READ);
+  TEST_ASSERT_TRUE((bool)f);
+  TEST_ASSERT_EQUAL_UINT32(32 * sizeof(Measurement), f.size());
+}
+
+void test_online_sends_one_post_per_timestamp_on_one_connection() {
+  Host::setWifiConnected(true);
+  drain();
+  Uploader::Stats st = Uploader::stats();
+  TEST_ASSERT_EQUAL_UINT32(0, st.pending);
+  TEST_ASSERT_EQUAL_UINT32(40, st.sent);
+  TEST_ASSERT_EQUAL_UINT32(10, st.posts);
+  TEST_ASSERT_EQUAL_size_t(10, s_bodies.size());
+  TEST_ASSERT_EQUAL_STRING("key=host-test-key&time=1700000000&weight_kg=40&t_i=41&h=42&bv=43",
+                           s_bodies[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("key=host-test-key&time=1700000540&weight_kg=42.25&t_i=43.25&h=44.25&bv=45.25",
+                           s_bodies[9].c_str());
+  TEST_ASSERT_EQUAL_UINT32(1, Host::httpStats().connects);
+  // The sent queue is deleted rather than rewritten
+  TEST_ASSERT_FALSE(LittleFS.exists("/upq.bin"));
+}
+
+void test_server_error_keeps_readings_until_flush() {
+  s_status = 503;
+  const uint32_t posts = Uploader::stats().posts;
+  publishReadings(40, 16);
+  TEST_ASSERT_EQUAL_UINT32(posts + 1, Uploader::stats().posts);
+  TEST_ASSERT_EQUAL_UINT32(16, Uploader::stats().pending);
+  // Backing off: no retry on the next rounds
+  for (int i = 0; i < 10; ++i) Uploader::loop();
+  TEST_ASSERT_EQUAL_UINT32(posts + 1, Uploader::stats().posts);
+
+  s_status = 200;
+  TEST_ASSERT_TRUE(Uploader::flush(5000));
+  TEST_ASSERT_EQUAL_UINT32(0, Uploader::stats().pending);
+  TEST_ASSERT_EQUAL_UINT32(56, Uploader::stats().sent);
+}
+
+void test_rejected_readings_are_dropped() {
+  s_status = 422;
+  const uint32_t dropped = Uploader::stats().dropped;
+  publishReadings(56, 8);
+  TEST_ASSERT_TRUE(Uploader::flush(5000));
+  TEST_ASSERT_EQUAL_UINT32(dropped + 8, Uploader::stats().dropped);
+  TEST_ASSERT_EQUAL_UINT32(0, Uploader::stats().pending);
+}
+
+void test_full_partition_keeps_records_aligned() {
+  Host::setWifiConnected(false);
+  // Room for the first append and 4 records plus 4 bytes of the second
+  Host::setFsCapacity(20 * sizeof(Measurement) + 4);
+  const uint32_t dropped = Uploader::stats().dropped;
+  publishReadings(64, 32);
+  TEST_ASSERT_EQUAL_UINT32(dropped + 12, Uploader::stats().dropped);
+  TEST_ASSERT_EQUAL_UINT32(20, Uploader::stats().pending);
+
+  // Space comes back: the torn bytes are compacted away before the next
+  // append, which lands right behind the last whole record
+  Host::setFsCapacity(0x0F0000);
+  publishReadings(96, 16);
+  TEST_ASSERT_EQUAL_UINT32(36, Uploader::stats().pending);
+  File f = LittleFS.open("/upq.bin", FILE_READ);
+  TEST_ASSERT_EQUAL_UINT32(36 * sizeof(Measurement), f.size());
+  f.seek(20 * sizeof(Measurement));
+  Measurement m;
+  TEST_ASSERT_EQUAL_size_t(sizeof(m), f.read((uint8_t *)&m, sizeof(m)));
+  TEST_ASSERT_EQUAL_STRING("weight_kg", m.key);
+  TEST_ASSERT_EQUAL_UINT32(T0 + 24 * 60, m.time);
+  f.close();
+
+  Host::setWifiConnected(true);
+  s_bodies.clear();
+  TEST_ASSERT_TRUE(Uploader::flush(5000));
+  TEST_ASSERT_EQUAL_UINT32(0, Uploader::stats().pending);
+  TEST_ASSERT_EQUAL_size_t(9, s_bodies.size());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_offline_readings_are_appended_in_blocks);
+  RUN_TEST(test_online_sends_one_post_per_timestamp_on_one_connection);
+  RUN_TEST(test_server_error_keeps_readings_until_flush);
+  RUN_TEST(test_rejected_readings_are_dropped);
+  RUN_TEST(test_full_partition_keeps_records_aligned);
+  return UNITY_END();
+}
@@ -0,0 +1,263 @@
+// WeightFilter with the scale's configuration on raw 80 SPS traces: HX711
+// noise, wind gusts rocking the hive, bees landing on the stand, a super
+// added, the lid lifted, a day's nectar flow and cell temperature drift
+
+#include <math.h>
+#include <unity.h>
+#include <vector>
+
+#include "weight_filter.h"
+
+static const uint32_t SPS = 80;
+static const int32_t LEVEL = 850000;       // counts of a loaded hive
+static const float NOISE_RMS = 100.0f;     // HX711 at 80 SPS
+
+// The firmware's scale tuning, tempco set per test
+static WeightFilter::Config config(int32_t tempco = 0) {
+  WeightFilter::Config cfg = WeightFilter::SCALE_DEFAULTS;
+  cfg.tempco = tempco;
+  return cfg;
+}
+
+// Seeded, so every run replays the same trace
+class Trace {
+public:
+  explicit Trace(uint32_t seed) : _s(seed) {}
+
+  float uniform() {
+    _s ^= _s << 13;
+    _s ^= _s >> 17;
+    _s ^= _s << 5;
+    return (_s >> 8) * (1.0f / 16777216.0f);
+  }
+
+  float gauss() {
+    float u = uniform() + 1e-7f, v = uniform();
+    return sqrtf(-2.0f * logf(u)) * cosf(6.2831853f * v);
+  }
+
+  // Gusts at 0.3 and 1.1 Hz with a slowly varying strength
+  float wind(uint32_t i, float counts) {
+    float t = (float)i / SPS;
+    float strength = 0.6f + 0.4f * sinf(0.05f * t);
+    return counts * strength * (0.6f * sinf(1.88f * t) + 0.4f * sinf(6.91f * t + 1.0f));
+  }
+
+  // Bees bumping the stand: one- or two-sample spikes, about one a
+  // second and never two inside the median window
+  float bees(float counts) {
+    if (_bee) {
+      _bee--;
+      return _bee >= WeightFilter::MEDIAN_N ? counts : 0;
+    }
+    if (uniform() < 1.0f / SPS) {
+      _bee = WeightFilter::MEDIAN_N + (uniform() < 0.5f ? 1 : 0);
+      return counts;
+    }
+    return 0;
+  }
+
+private:
+  uint32_t _s;
+  uint8_t _bee = 0;
+};
+
+struct Run {
+  uint32_t settled = 0;
+  uint32_t steps = 0;
+  std::vector<int32_t> stepDeltas;
+  std::vector<uint32_t> settledAt;
+  std::vector<uint32_t> stepAt;
+  double sqErr = 0;    // filtered vs truth, once settled
+  double sqRaw = 0;    // raw vs truth over the same samples
+  uint32_t compared = 0;
+  int32_t maxErr = 0;
+};
+
+static void feed(WeightFilter &f, Run &r, uint32_t i, int32_t raw, int32_t truth) {
+  switch (f.add(raw)) {
+    case WeightFilter::Event::Settled:
+      r.settled++;
+      r.settledAt.push_back(i);
+      break;
+    case WeightFilter::Event::Step:
+      r.steps++;
+      r.stepAt.push_back(i);
+      r.stepDeltas.push_back(f.stepDelta());
+      break;
+    case WeightFilter::Event::None:
+      break;
+  }
+  if (f.settled()) {
+    int32_t err = f.value() - truth;
+    r.sqErr += (double)err * err;
+    r.sqRaw += (double)(raw - truth) * (raw - truth);
+    r.compared++;
+    if (abs(err) > r.maxErr) r.maxErr = abs(err);
+  }
+}
+
+static double rms(double sq, uint32_t n) {
+  return n ? sqrt(sq / n) : 0;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_noise_only_settles_once_near_the_truth() {
+  WeightFilter f(config());
+  Trace tr(1);
+  Run r;
+  for (uint32_t i = 0; i < 60 * SPS; ++i) feed(f, r, i, LEVEL + (int32_t)(NOISE_RMS * tr.gauss()), LEVEL);
+  TEST_ASSERT_EQUAL_UINT32(1, r.settled);
+  TEST_ASSERT_EQUAL_UINT32(0, r.steps);
+  // Five median samples to fill, the fifth starts, then settleSamples
+  TEST_ASSERT_EQUAL_UINT32(4 + config().settleSamples, r.settledAt[0]);
+  TEST_ASSERT_INT_WITHIN(40, LEVEL, f.value());
+  TEST_ASSERT_TRUE(rms(r.sqErr, r.compared) < 25);
+}
+
+void test_wind_does_not_trigger_steps() {
+  WeightFilter f(config());
+  Trace tr(2);
+  Run r;
+  for (uint32_t i = 0; i < 10 * 60 * SPS; ++i) {
+    int32_t raw = LEVEL + (int32_t)(tr.wind(i, 1200) + NOISE_RMS * tr.gauss());
+    feed(f, r, i, raw, LEVEL);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, r.steps);
+  TEST_ASSERT_EQUAL_UINT32(1, r.settled);
+  // Gusts are smoothed, never followed sample by sample
+  TEST_ASSERT_TRUE(rms(r.sqErr, r.compared) < 0.6 * rms(r.sqRaw, r.compared));
+  TEST_ASSERT_TRUE(r.maxErr < 800);
+}
+
+void test_bee_traffic_is_rejected() {
+  WeightFilter f(config());
+  Trace tr(3);
+  Run r;
+  for (uint32_t i = 0; i < 10 * 60 * SPS; ++i) {
+    int32_t raw = LEVEL + (int32_t)(tr.bees(4000) + NOISE_RMS * tr.gauss());
+    feed(f, r, i, raw, LEVEL);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, r.steps);
+  TEST_ASSERT_EQUAL_UINT32(1, r.settled);
+  TEST_ASSERT_TRUE(r.maxErr < 100);
+  TEST_ASSERT_INT_WITHIN(40, LEVEL, f.value());
+}
+
+void test_a_longer_bump_holds_the_estimate() {
+  // Three samples out of five pass the median: the estimate holds and is
+  // unsettled until the quiet run is seen again, but no step is reported
+  WeightFilter f(config());
+  Run r;
+  for (uint32_t i = 0; i < 400; ++i) feed(f, r, i, LEVEL, LEVEL);
+  int32_t before = f.value();
+  for (uint32_t i = 400; i < 403; ++i) feed(f, r, i, LEVEL + 6000, LEVEL);
+  for (uint32_t i = 403; i < 406; ++i) feed(f, r, i, LEVEL, LEVEL);
+  TEST_ASSERT_FALSE(f.settled());
+  TEST_ASSERT_EQUAL_INT32(before, f.value());
+  for (uint32_t i = 406; i < 800; ++i) feed(f, r, i, LEVEL, LEVEL);
+  TEST_ASSERT_EQUAL_UINT32(0, r.steps);
+  TEST_ASSERT_EQUAL_UINT32(2, r.settled);
+  TEST_ASSERT_EQUAL_INT32(LEVEL, f.value());
+}
+
+void test_super_added_in_wind_and_traffic() {
+  const int32_t SUPER = 15000;
+  const uint32_t at = 2 * 60 * SPS;
+  WeightFilter f(config());
+  Trace tr(4);
+  Run r;
+  for (uint32_t i = 0; i < 5 * 60 * SPS; ++i) {
+    int32_t truth = LEVEL + (i >= at ? SUPER : 0);
+    int32_t raw = truth + (int32_t)(tr.wind(i, 600) + tr.bees(4000) + NOISE_RMS * tr.gauss());
+    feed(f, r, i, raw, truth);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, r.steps);
+  TEST_ASSERT_INT_WITHIN(600, SUPER, r.stepDeltas[0]);
+  // Confirmed after stepConfirm samples plus the median's delay
+  TEST_ASSERT_TRUE(r.stepAt[0] >= at + config().stepConfirm && r.stepAt[0] <= at + config().stepConfirm + 4);
+  // Settled again about two seconds later, and reported at the new level
+  TEST_ASSERT_EQUAL_UINT32(2, r.settled);
+  TEST_ASSERT_EQUAL_UINT32(r.stepAt[0] + config().settleSamples, r.settledAt[1]);
+  TEST_ASSERT_INT_WITHIN(200, LEVEL + SUPER, f.value());
+}
+
+void test_lid_lifted_and_put_back() {
+  const int32_t LID = -8000;
+  const uint32_t off = 60 * SPS, on = 80 * SPS;
+  WeightFilter f(config());
+  Trace tr(5);
+  Run r;
+  for (uint32_t i = 0; i < 3 * 60 * SPS; ++i) {
+    int32_t truth = LEVEL + (i >= off && i < on ? LID : 0);
+    feed(f, r, i, truth + (int32_t)(tr.bees(3000) + NOISE_RMS * tr.gauss()), truth);
+  }
+  TEST_ASSERT_EQUAL_UINT32(2, r.steps);
+  TEST_ASSERT_INT_WITHIN(300, LID, r.stepDeltas[0]);
+  TEST_ASSERT_INT_WITHIN(300, -LID, r.stepDeltas[1]);
+  TEST_ASSERT_INT_WITHIN(40, LEVEL, f.value());
+}
+
+void test_nectar_flow_is_tracked_without_steps() {
+  // 3000 counts over six hours of foraging, as a strong flow day
+  const uint32_t n = 6 * 3600 * SPS;
+  WeightFilter f(config());
+  Trace tr(6);
+  Run r;
+  for (uint32_t i = 0; i < n; ++i) {
+    int32_t truth = LEVEL + (int32_t)(3000.0 * i / n);
+    feed(f, r, i, truth + (int32_t)(tr.wind(i, 400) + tr.bees(2500) + NOISE_RMS * tr.gauss()), truth);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, r.steps);
+  TEST_ASSERT_INT_WITHIN(150, LEVEL + 3000, f.value());
+  TEST_ASSERT_TRUE(rms(r.sqErr, r.compared) < 120);
+}
+
+void test_temperature_drift_is_compensated() {
+  // 60 counts per deg C, the cell swinging between 10 and 30 deg C
+  const int32_t TEMPCO = 60;
+  WeightFilter comp(config(TEMPCO)), plain(config());
+  Trace tr(7);
+  Run rc, rp;
+  for (uint32_t i = 0; i < 2 * 3600 * SPS; ++i) {
+    float celsius = 20.0f + 10.0f * sinf(6.2831853f * i / (2 * 3600 * SPS));
+    int16_t c100 = (int16_t)lrintf(celsius * 100);
+    int32_t raw = LEVEL + (int32_t)(TEMPCO * (celsius - 20.0f) + NOISE_RMS * tr.gauss());
+    if (i % SPS == 0) comp.setTemperature(c100); // a probe read every second
+    feed(comp, rc, i, raw, LEVEL);
+    feed(plain, rp, i, raw, LEVEL);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, rc.steps);
+  TEST_ASSERT_TRUE(rc.maxErr < 80);
+  TEST_ASSERT_TRUE(rp.maxErr > 500);
+}
+
+void test_reset_starts_over() {
+  WeightFilter f(config());
+  Run r;
+  for (uint32_t i = 0; i < 400; ++i) feed(f, r, i, LEVEL, LEVEL);
+  TEST_ASSERT_TRUE(f.settled());
+  f.reset();
+  TEST_ASSERT_FALSE(f.settled());
+  TEST_ASSERT_EQUAL_INT32(0, f.value());
+  for (uint32_t i = 0; i < 4; ++i) TEST_ASSERT_TRUE(f.add(1000) == WeightFilter::Event::None);
+  f.add(1000);
+  TEST_ASSERT_EQUAL_INT32(1000, f.value());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_noise_only_settles_once_near_the_truth);
+  RUN_TEST(test_wind_does_not_trigger_steps);
+  RUN_TEST(test_bee_traffic_is_rejected);
+  RUN_TEST(test_a_longer_bump_holds_the_estimate);
+  RUN_TEST(test_super_added_in_wind_and_traffic);
+  RUN_TEST(test_lid_lifted_and_put_back);
+  RUN_TEST(test_nectar_flow_is_tracked_without_steps);
+  RUN_TEST(test_temperature_drift_is_compensated);
+  RUN_TEST(test_reset_starts_over);
+  return UNITY_END();
+}
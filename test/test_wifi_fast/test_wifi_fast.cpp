@@ -0,0 +1,167 @@
+// WifiFast on a frozen clock with two APs of the stored SSID in range: the
+// first connect scans and joins the stronger one, later ones join it
+// directly with the cached lease, a failed direct connect falls back to a
+// scan but keeps the AP, and only WIFI_DIRECT_RETRIES failures in a row
+// forget it. The tests drive the Wi-Fi events themselves.
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <unity.h>
+
+#include "host.h"
+#include "wifi_fast.h"
+
+static const uint32_t SCAN_MS = 300;
+static const uint32_t ASSOC_MS = 800;
+static const uint32_t DHCP_MS = 1200;
+static const uint8_t WEAK_BSSID[6] = {0x02, 0, 0, 0, 0, 0x01};
+static const uint8_t STRONG_BSSID[6] = {0x02, 0, 0, 0, 0, 0x06};
+static const uint32_t LEASE_IP = 0x2a01a8c0;  // 192.168.1.42
+
+static void post(arduino_event_id_t id) {
+  arduino_event_t e;
+  memset(&e, 0, sizeof(e));
+  e.event_id = id;
+  if (id == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+    e.event_info.got_ip.ip_info.ip.addr = LEASE_IP;
+    e.event_info.got_ip.ip_info.gw.addr = 0x0101a8c0;
+    e.event_info.got_ip.ip_info.netmask.addr = 0x00ffffff;
+  }
+  if (id == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) e.event_info.wifi_sta_disconnected.reason = 201;  // no AP found
+  WifiFast::onEvent(&e);
+}
+
+// The join WifiFast started gets through: associated, then an address
+static void connect() {
+  Host::advanceClock(ASSOC_MS);
+  post(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+  Host::advanceClock(DHCP_MS);
+  post(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+}
+
+// A direct connect to the cached AP that gets turned down
+static void failDirect() {
+  Host::resetWifiStats();
+  WifiFast::begin();
+  TEST_ASSERT_TRUE(WifiFast::timings().direct);
+  post(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+}
+
+static bool nvsHasCache() {
+  Preferences prefs;
+  if (!prefs.begin("wifi", true)) return false;
+  bool has = prefs.isKey("cache");
+  prefs.end();
+  return has;
+}
+
+void setUp() {
+  Host::resetWifiStats();
+}
+
+void tearDown() {}
+
+void test_first_connect_scans_and_joins_the_strongest_ap() {
+  Host::freezeClock(true);
+  Host::clearNvs();
+  Host::setWifiCredentials("hive", "secret");
+  Host::WifiAp weak = {"hive", {0}, 1, -70};
+  Host::WifiAp strong = {"hive", {0}, 6, -50};
+  Host::WifiAp other = {"neighbour", {0x02, 0, 0, 0, 0, 0x0b}, 11, -30};
+  memcpy(weak.bssid, WEAK_BSSID, 6);
+  memcpy(strong.bssid, STRONG_BSSID, 6);
+  Host::setWifiAps({weak, strong, other});
+
+  WifiFast::begin();
+  TEST_ASSERT_EQUAL_UINT32(1, Host::wifiStats().scans);
+  TEST_ASSERT_EQUAL_UINT32(0, Host::wifiStats().joins);
+  Host::advanceClock(SCAN_MS);
+  post(ARDUINO_EVENT_WIFI_SCAN_DONE);
+  TEST_ASSERT_EQUAL_UINT32(1, Host::wifiStats().joins);
+  TEST_ASSERT_EQUAL_INT32(6, Host::wifiStats().joinChannel);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(STRONG_BSSID, Host::wifiStats().joinBssid, 6);
+  connect();
+
+  WifiFast::Timings t = WifiFast::timings();
+  TEST_ASSERT_EQUAL_UINT32(SCAN_MS, t.scanMs);
+  TEST_ASSERT_EQUAL_UINT32(ASSOC_MS, t.assocMs);
+  TEST_ASSERT_EQUAL_UINT32(DHCP_MS, t.dhcpMs);
+  TEST_ASSERT_FALSE(t.direct);
+  TEST_ASSERT_FALSE(t.staticIp);
+  TEST_ASSERT_TRUE(nvsHasCache());
+}
+
+void test_next_connect_joins_the_cached_ap_with_its_lease() {
+  WifiFast::begin();
+  TEST_ASSERT_EQUAL_UINT32(0, Host::wifiStats().scans);
+  TEST_ASSERT_EQUAL_UINT32(1, Host::wifiStats().joins);
+  TEST_ASSERT_EQUAL_INT32(6, Host::wifiStats().joinChannel);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(STRONG_BSSID, Host::wifiStats().joinBssid, 6);
+  TEST_ASSERT_EQUAL_HEX32(LEASE_IP, Host::wifiStats().staticIp);
+  connect();
+
+  WifiFast::Timings t = WifiFast::timings();
+  TEST_ASSERT_EQUAL_UINT32(0, t.scanMs);
+  TEST_ASSERT_TRUE(t.direct);
+  TEST_ASSERT_TRUE(t.staticIp);
+}
+
+void test_failed_direct_connect_scans_and_keeps_the_ap() {
+  failDirect();
+  // Back on DHCP, scanning for the SSID
+  TEST_ASSERT_EQUAL_UINT32(1, Host::wifiStats().scans);
+  TEST_ASSERT_EQUAL_HEX32(0, Host::wifiStats().staticIp);
+  WifiFast::Timings t = WifiFast::timings();
+  TEST_ASSERT_EQUAL_UINT8(1, t.fallbacks);
+  TEST_ASSERT_FALSE(t.direct);
+  Host::advanceClock(SCAN_MS);
+  post(ARDUINO_EVENT_WIFI_SCAN_DONE);
+  TEST_ASSERT_EQUAL_UINT32(2, Host::wifiStats().joins);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(STRONG_BSSID, Host::wifiStats().joinBssid, 6);
+  // That join does not get through either (the AP is busy)
+  TEST_ASSERT_TRUE(nvsHasCache());
+
+  // The AP is still tried directly, but the lease is not reused
+  Host::resetWifiStats();
+  WifiFast::begin();
+  TEST_ASSERT_EQUAL_UINT32(0, Host::wifiStats().scans);
+  TEST_ASSERT_EQUAL_INT32(6, Host::wifiStats().joinChannel);
+  TEST_ASSERT_EQUAL_HEX32(0, Host::wifiStats().staticIp);
+  TEST_ASSERT_TRUE(WifiFast::timings().direct);
+  TEST_ASSERT_FALSE(WifiFast::timings().staticIp);
+}
+
+void test_success_resets_the_failure_count() {
+  connect();
+  failDirect();
+  failDirect();
+  // Two failures since the success: still below WIFI_DIRECT_RETRIES
+  Host::resetWifiStats();
+  WifiFast::begin();
+  TEST_ASSERT_TRUE(WifiFast::timings().direct);
+  TEST_ASSERT_EQUAL_UINT32(0, Host::wifiStats().scans);
+}
+
+void test_repeated_direct_failures_forget_the_ap() {
+  // The third one in a row
+  post(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+  TEST_ASSERT_FALSE(nvsHasCache());
+
+  WifiFast::begin();
+  TEST_ASSERT_FALSE(WifiFast::timings().direct);
+  TEST_ASSERT_EQUAL_UINT32(2, Host::wifiStats().scans);
+  Host::advanceClock(SCAN_MS);
+  post(ARDUINO_EVENT_WIFI_SCAN_DONE);
+  connect();
+  TEST_ASSERT_TRUE(nvsHasCache());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_connect_scans_and_joins_the_strongest_ap);
+  RUN_TEST(test_next_connect_joins_the_cached_ap_with_its_lease);
+  RUN_TEST(test_failed_direct_connect_scans_and_keeps_the_ap);
+  RUN_TEST(test_success_resets_the_failure_count);
+  RUN_TEST(test_repeated_direct_failures_forget_the_ap);
+  return UNITY_END();
+}